@@ -0,0 +1,79 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> g_count(0);
+static std::atomic<size_t> g_bytes(0);
+
+size_t allocationCount() {
+    return g_count.load(std::memory_order_relaxed);
+}
+
+size_t allocationBytes() {
+    return g_bytes.load(std::memory_order_relaxed);
+}
+
+void AllocationMeter::frame() {
+    size_t c = allocationCount(), b = allocationBytes();
+    last = c - count;
+    lastBytes = b - bytes;
+    count = c;
+    bytes = b;
+    // o primeiro frame conta tudo desde o inicio do programa
+    if (frames++ > warmupFrames && last > worst) worst = last;
+}
+
+static void* countedAlloc(size_t size) {
+    g_count.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+static void* countedAlignedAlloc(size_t size, size_t alignment) {
+    g_count.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+#ifdef _MSC_VER
+    void* p = _aligned_malloc(size == 0 ? 1 : size, alignment);
+#else
+    size_t rounded = (size + alignment - 1) / alignment * alignment;
+    void* p = std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+#endif
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+static void alignedFree(void* p) {
+#ifdef _MSC_VER
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+// as versoes de array e nothrow padrao chamam estas, mas nem toda biblioteca
+// garante isso, entao todas sao substituidas
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAlloc(size); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAlloc(size); } catch (...) { return nullptr; }
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+
+void* operator new(size_t size, std::align_val_t a) { return countedAlignedAlloc(size, (size_t)a); }
+void* operator new[](size_t size, std::align_val_t a) { return countedAlignedAlloc(size, (size_t)a); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { alignedFree(p); }
@@ -0,0 +1,29 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+
+// Conta as alocacoes feitas com new/delete (o que inclui std::string,
+// std::vector etc.) em todas as threads. AllocationCounter.cpp substitui o
+// operator new/delete global; o linker so puxa esse arquivo da biblioteca
+// PGCommon quando o programa chama uma das funcoes abaixo, entao quem nao usa
+// o contador continua com o new padrao. malloc direto (stb_image, driver) nao
+// entra na conta.
+size_t allocationCount();
+size_t allocationBytes();
+
+// Alocacoes por frame: chame frame() uma vez por frame, no mesmo ponto do laco.
+// last eh quanto foi alocado desde a chamada anterior; worst eh o pior frame
+// depois dos primeiros warmupFrames (caches enchendo, vetores crescendo).
+struct AllocationMeter {
+    int warmupFrames = 60;
+    size_t last = 0, lastBytes = 0, worst = 0;
+    long frames = 0;
+
+    void frame();
+
+private:
+    size_t count = 0, bytes = 0;
+};
+
+#endif
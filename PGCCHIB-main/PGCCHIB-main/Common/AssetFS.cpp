@@ -0,0 +1,424 @@
+#include "AssetFS.h"
+#include "Lz4.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// pasta include do projeto (o CMake define com o caminho absoluto)
+#ifndef PG_ASSET_DIR
+#define PG_ASSET_DIR "include"
+#endif
+
+std::string normalizeAssetPath(const std::string& path) {
+    std::string out;
+    out.reserve(path.size());
+    size_t i = 0;
+    while (i < path.size()) {
+        size_t j = i;
+        while (j < path.size() && path[j] != '/' && path[j] != '\\') j++;
+        size_t length = j - i;
+        if (length == 2 && path[i] == '.' && path[i + 1] == '.')
+            return "";
+        // pula partes vazias ("//") e "."
+        if (length > 0 && !(length == 1 && path[i] == '.')) {
+            if (!out.empty()) out += '/';
+            out.append(path, i, length);
+        }
+        i = j + 1;
+    }
+    return out;
+}
+
+uint64_t assetHash(const std::string& path) {
+    uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : path) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static bool readWholeFile(const std::string& path, std::vector<unsigned char>& out) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    out.resize(size > 0 ? (size_t)size : 0);
+    size_t got = out.empty() ? 0 : fread(out.data(), 1, out.size(), f);
+    fclose(f);
+    return got == out.size();
+}
+
+// ------------------------------------------------------------------ AssetPack
+
+bool AssetPack::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "AssetPack: nao foi possivel abrir " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    HANDLE mapping = size.QuadPart > 0 ? CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+    void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    fileHandle = file;
+    mappingHandle = mapping;
+    if (!view) {
+        std::cerr << "AssetPack: nao foi possivel mapear " << path << std::endl;
+        close();
+        return false;
+    }
+    base = (const unsigned char*)view;
+    mappedSize = (size_t)size.QuadPart;
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "AssetPack: nao foi possivel abrir " << path << std::endl;
+        return false;
+    }
+    struct stat st;
+    void* view = fstat(fd, &st) == 0 && st.st_size > 0
+                     ? mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0)
+                     : MAP_FAILED;
+    if (view == MAP_FAILED) {
+        std::cerr << "AssetPack: nao foi possivel mapear " << path << std::endl;
+        close();
+        return false;
+    }
+    base = (const unsigned char*)view;
+    mappedSize = (size_t)st.st_size;
+#endif
+
+    // confere tudo uma vez aqui para o find e o read nao precisarem
+    const AssetPackHeader* h = (const AssetPackHeader*)base;
+    bool valid = mappedSize >= sizeof(AssetPackHeader) && h->magic == ASSET_PACK_MAGIC &&
+                 h->version == ASSET_PACK_VERSION && h->fileSize == mappedSize && h->slotCount > 0 &&
+                 (h->slotCount & (h->slotCount - 1)) == 0 && h->slotCount >= h->entryCount &&
+                 h->entriesOffset + (uint64_t)h->entryCount * sizeof(AssetPackEntry) <= mappedSize &&
+                 h->slotsOffset + (uint64_t)h->slotCount * sizeof(uint32_t) <= mappedSize &&
+                 h->namesOffset <= mappedSize && h->entriesOffset % 8 == 0 && h->slotsOffset % 4 == 0;
+    if (valid) {
+        const AssetPackEntry* e = (const AssetPackEntry*)(base + h->entriesOffset);
+        const uint32_t* s = (const uint32_t*)(base + h->slotsOffset);
+        for (uint32_t i = 0; valid && i < h->entryCount; ++i)
+            valid = e[i].offset + e[i].storedSize <= mappedSize &&
+                    h->namesOffset + e[i].nameOffset + e[i].nameLength <= mappedSize &&
+                    (e[i].compression == ASSET_LZ4 || (e[i].compression == ASSET_STORED && e[i].storedSize == e[i].size));
+        for (uint32_t i = 0; valid && i < h->slotCount; ++i)
+            valid = s[i] <= h->entryCount;
+    }
+    if (!valid) {
+        std::cerr << "AssetPack: " << path << " nao eh um pacote valido (versao " << ASSET_PACK_VERSION << ")" << std::endl;
+        close();
+        return false;
+    }
+
+    header = h;
+    entries = (const AssetPackEntry*)(base + h->entriesOffset);
+    slots = (const uint32_t*)(base + h->slotsOffset);
+    names = (const char*)(base + h->namesOffset);
+    return true;
+}
+
+void AssetPack::close() {
+#ifdef _WIN32
+    if (base) UnmapViewOfFile(base);
+    if (mappingHandle) CloseHandle((HANDLE)mappingHandle);
+    if (fileHandle) CloseHandle((HANDLE)fileHandle);
+    fileHandle = mappingHandle = nullptr;
+#else
+    if (base) munmap((void*)base, mappedSize);
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+#endif
+    base = nullptr;
+    mappedSize = 0;
+    header = nullptr;
+    entries = nullptr;
+    slots = nullptr;
+    names = nullptr;
+}
+
+const AssetPackEntry* AssetPack::find(const std::string& path) const {
+    if (!header) return nullptr;
+    uint64_t h = assetHash(path);
+    uint32_t mask = header->slotCount - 1;
+    // a tabela fica no maximo meio cheia: quase sempre o primeiro slot resolve
+    for (uint32_t i = (uint32_t)h & mask, probes = 0; probes < header->slotCount; i = (i + 1) & mask, ++probes) {
+        uint32_t slot = slots[i];
+        if (slot == 0) return nullptr;
+        const AssetPackEntry& e = entries[slot - 1];
+        if (e.hash == h && e.nameLength == path.size() && memcmp(names + e.nameOffset, path.data(), path.size()) == 0)
+            return &e;
+    }
+    return nullptr;
+}
+
+bool AssetPack::read(const AssetPackEntry& entry, AssetData& out) const {
+    const unsigned char* stored = base + entry.offset;
+    if (entry.compression == ASSET_STORED) {
+        out.owned.clear();
+        out.data = stored;
+        out.size = (size_t)entry.size;
+        return true;
+    }
+    out.owned.resize((size_t)entry.size);
+    if (!lz4Decompress(stored, (size_t)entry.storedSize, out.owned.data(), out.owned.size())) {
+        std::cerr << "AssetPack: entrada corrompida " << entryName(entry) << std::endl;
+        out.owned.clear();
+        out.data = nullptr;
+        out.size = 0;
+        return false;
+    }
+    out.data = out.owned.data();
+    out.size = out.owned.size();
+    return true;
+}
+
+// -------------------------------------------------------------------- AssetFS
+
+bool AssetFS::mountDirectory(const std::string& directory, const std::string& mountPoint) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        std::cerr << "AssetFS: pasta nao encontrada " << directory << std::endl;
+        return false;
+    }
+    Mount m;
+    m.point = normalizeAssetPath(mountPoint);
+    m.directory = directory;
+    if (!m.directory.empty() && m.directory.back() != '/' && m.directory.back() != '\\')
+        m.directory += '/';
+    mounts.push_back(std::move(m));
+    return true;
+}
+
+bool AssetFS::mountArchive(const std::string& path, const std::string& mountPoint) {
+    Mount m;
+    m.point = normalizeAssetPath(mountPoint);
+    m.pack.reset(new AssetPack());
+    if (!m.pack->open(path))
+        return false;
+    mounts.push_back(std::move(m));
+    return true;
+}
+
+bool AssetFS::relativeTo(const Mount& m, const std::string& path, std::string& relative) {
+    if (m.point.empty()) {
+        relative = path;
+        return true;
+    }
+    if (path.size() <= m.point.size() || path.compare(0, m.point.size(), m.point) != 0 || path[m.point.size()] != '/')
+        return false;
+    relative = path.substr(m.point.size() + 1);
+    return true;
+}
+
+bool AssetFS::read(const std::string& path, AssetData& out) const {
+    std::string p = normalizeAssetPath(path);
+    std::string relative;
+    for (size_t i = mounts.size(); !p.empty() && i-- > 0;) {
+        const Mount& m = mounts[i];
+        if (!relativeTo(m, p, relative)) continue;
+        if (m.pack) {
+            if (const AssetPackEntry* e = m.pack->find(relative))
+                return m.pack->read(*e, out);
+        } else if (readWholeFile(m.directory + relative, out.owned)) {
+            out.data = out.owned.data();
+            out.size = out.owned.size();
+            return true;
+        }
+    }
+    std::cerr << "AssetFS: asset nao encontrado: " << path << std::endl;
+    out.owned.clear();
+    out.data = nullptr;
+    out.size = 0;
+    return false;
+}
+
+bool AssetFS::exists(const std::string& path) const {
+    std::string p = normalizeAssetPath(path);
+    std::string relative;
+    for (size_t i = mounts.size(); !p.empty() && i-- > 0;) {
+        const Mount& m = mounts[i];
+        if (!relativeTo(m, p, relative)) continue;
+        std::error_code error;
+        if (m.pack ? m.pack->find(relative) != nullptr
+                   : std::filesystem::is_regular_file(m.directory + relative, error))
+            return true;
+    }
+    return false;
+}
+
+AssetFS& defaultAssets() {
+    // inicializacao de static local: uma vez so, mesmo com varias threads
+    static AssetFS* fs = [] {
+        static AssetFS assets;
+        std::error_code error;
+        // PG_ASSETS=pacote.pak (ou uma pasta) monta so ele: testa a copia distribuida
+        if (const char* only = getenv("PG_ASSETS")) {
+            if (std::filesystem::is_directory(only, error))
+                assets.mountDirectory(only);
+            else
+                assets.mountArchive(only);
+            return &assets;
+        }
+        if (std::filesystem::is_regular_file("assets.pak", error))
+            assets.mountArchive("assets.pak");
+        if (std::filesystem::is_directory(PG_ASSET_DIR, error))
+            assets.mountDirectory(PG_ASSET_DIR);
+        if (assets.mountCount() == 0)
+            std::cerr << "AssetFS: nem assets.pak nem a pasta " << PG_ASSET_DIR << " encontrados" << std::endl;
+        return &assets;
+    }();
+    return *fs;
+}
+
+// ------------------------------------------------------------------ packer
+
+bool writeAssetPack(const std::string& directory, const std::string& outputPath,
+                    const std::vector<std::string>& extensions, bool storeOnly, AssetPackStats* stats) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    if (!fs::is_directory(directory, error)) {
+        std::cerr << "writeAssetPack: pasta nao encontrada " << directory << std::endl;
+        return false;
+    }
+
+    // arquivos com as extensoes pedidas, em ordem de caminho (pacote reproduzivel)
+    std::vector<std::string> files;
+    for (fs::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file(error)) continue;
+        std::string ext = it->path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        if (std::find(extensions.begin(), extensions.end(), ext) == extensions.end()) continue;
+        std::string name = normalizeAssetPath(fs::relative(it->path(), directory, error).generic_string());
+        if (!name.empty()) files.push_back(name);
+    }
+    if (error) {
+        std::cerr << "writeAssetPack: erro listando " << directory << ": " << error.message() << std::endl;
+        return false;
+    }
+    std::sort(files.begin(), files.end());
+
+    uint32_t n = (uint32_t)files.size();
+    uint32_t slotCount = 1;
+    while (slotCount < 2 * n) slotCount *= 2;
+
+    std::vector<AssetPackEntry> entries(n);
+    std::vector<std::vector<unsigned char>> blobs(n);
+    std::string names;
+    AssetPackStats s;
+    std::vector<unsigned char> original, packed;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!readWholeFile(directory + "/" + files[i], original)) {
+            std::cerr << "writeAssetPack: nao foi possivel ler " << files[i] << std::endl;
+            return false;
+        }
+        AssetPackEntry& e = entries[i];
+        memset(&e, 0, sizeof(e));
+        e.hash = assetHash(files[i]);
+        e.size = original.size();
+        e.nameOffset = (uint32_t)names.size();
+        e.nameLength = (uint32_t)files[i].size();
+        names += files[i];
+
+        e.compression = ASSET_STORED;
+        if (!storeOnly && !original.empty()) {
+            lz4Compress(original.data(), original.size(), packed);
+            if (packed.size() * 10 <= original.size() * 9) {
+                e.compression = ASSET_LZ4;
+                blobs[i].swap(packed);
+                s.compressed++;
+            }
+        }
+        if (e.compression == ASSET_STORED)
+            blobs[i].swap(original);
+        e.storedSize = blobs[i].size();
+        s.files++;
+        s.originalBytes += e.size;
+        s.storedBytes += e.storedSize;
+    }
+
+    // indice: sondagem linear a partir do hash
+    std::vector<uint32_t> slots(slotCount, 0);
+    for (uint32_t i = 0; i < n; ++i) {
+        uint32_t k = (uint32_t)entries[i].hash & (slotCount - 1);
+        while (slots[k] != 0) k = (k + 1) & (slotCount - 1);
+        slots[k] = i + 1;
+    }
+
+    AssetPackHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = ASSET_PACK_MAGIC;
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = n;
+    header.slotCount = slotCount;
+    header.entriesOffset = alignUp(sizeof(AssetPackHeader), 8);
+    header.slotsOffset = header.entriesOffset + (uint64_t)n * sizeof(AssetPackEntry);
+    header.namesOffset = alignUp(header.slotsOffset + (uint64_t)slotCount * sizeof(uint32_t), 8);
+    uint64_t offset = header.namesOffset + names.size();
+    for (uint32_t i = 0; i < n; ++i) {
+        offset = alignUp(offset, 16);
+        entries[i].offset = offset;
+        offset += entries[i].storedSize;
+    }
+    header.fileSize = offset;
+
+    FILE* f = fopen(outputPath.c_str(), "wb");
+    if (!f) {
+        std::cerr << "writeAssetPack: nao foi possivel criar " << outputPath << std::endl;
+        return false;
+    }
+    static const unsigned char zeros[16] = {};
+    uint64_t written = 0;
+    bool failed = false;
+    auto put = [&](const void* data, size_t size) {
+        if (failed || size == 0) return;
+        if (fwrite(data, 1, size, f) != size) failed = true;
+        else written += size;
+    };
+    auto padTo = [&](uint64_t target) {
+        while (!failed && written < target) put(zeros, (size_t)std::min<uint64_t>(16, target - written));
+    };
+    put(&header, sizeof(header));
+    padTo(header.entriesOffset);
+    put(entries.data(), entries.size() * sizeof(AssetPackEntry));
+    put(slots.data(), slots.size() * sizeof(uint32_t));
+    padTo(header.namesOffset);
+    put(names.data(), names.size());
+    for (uint32_t i = 0; i < n; ++i) {
+        padTo(entries[i].offset);
+        put(blobs[i].data(), blobs[i].size());
+    }
+    bool ok = fclose(f) == 0 && !failed && written == header.fileSize;
+    if (!ok) {
+        std::cerr << "writeAssetPack: erro gravando " << outputPath << std::endl;
+        return false;
+    }
+    if (stats) *stats = s;
+    return true;
+}
@@ -0,0 +1,147 @@
+#ifndef ASSET_FS_H
+#define ASSET_FS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Sistema de arquivos virtual para os assets. Os programas pedem caminhos
+// relativos a pasta include ("donatello.png", "8bitLib/PNG/grass.png") e o
+// AssetFS procura nos pontos de montagem, do ultimo montado para o primeiro:
+//   pasta   - arquivos soltos (desenvolvimento, edita e roda sem reempacotar)
+//   arquivo - um .pak gerado pelo packAssets (para distribuir): mapeado na
+//             memoria, com um indice por hash (uma sondagem por busca) e as
+//             entradas guardadas como estao ou comprimidas em LZ4
+// Montar so no inicio, antes de outras threads lerem; depois as leituras sao
+// const e podem vir de qualquer thread (o BackgroundStreamer le no worker).
+
+// Formato do .pak (little endian, tudo alinhado a 8 bytes):
+//   AssetPackHeader
+//   AssetPackEntry[entryCount]   ordenadas pelo caminho
+//   uint32_t slots[slotCount]    tabela hash: indice da entrada + 1 (0 = vazio),
+//                                slotCount potencia de 2, sondagem linear
+//   nomes                        caminhos normalizados, sem terminador
+//   dados                        cada entrada alinhada a 16 bytes
+const uint32_t ASSET_PACK_MAGIC = 0x4B504750; // "PGPK"
+const uint32_t ASSET_PACK_VERSION = 1;
+
+enum AssetCompression : uint32_t {
+    ASSET_STORED = 0, // bytes do arquivo original: leitura sem copia
+    ASSET_LZ4 = 1     // bloco LZ4 (Lz4.h) de size bytes
+};
+
+struct AssetPackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t slotCount;
+    uint64_t entriesOffset, slotsOffset, namesOffset;
+    uint64_t fileSize;
+};
+
+struct AssetPackEntry {
+    uint64_t hash;       // assetHash do caminho
+    uint64_t offset;     // inicio dos dados no arquivo
+    uint64_t size;       // tamanho original
+    uint64_t storedSize; // tamanho no arquivo (comprimido ou nao)
+    uint32_t nameOffset, nameLength;
+    uint32_t compression;
+    uint32_t reserved;
+};
+
+// caminho virtual: barras normais, sem "./" nem barras no inicio; "" se tiver
+// ".." (nao sai da pasta montada)
+std::string normalizeAssetPath(const std::string& path);
+// FNV-1a de 64 bits do caminho ja normalizado
+uint64_t assetHash(const std::string& path);
+
+// Bytes de um asset. Entrada guardada sem compressao aponta direto para o
+// arquivo mapeado (owned fica vazio, valido enquanto o AssetFS estiver montado);
+// pasta solta e LZ4 ficam em owned.
+struct AssetData {
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    std::vector<unsigned char> owned;
+
+    bool zeroCopy() const { return data && owned.empty(); }
+    std::string text() const { return std::string((const char*)data, size); }
+};
+
+// Um .pak aberto e mapeado na memoria (so leitura).
+struct AssetPack {
+    AssetPack() = default;
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+    ~AssetPack() { close(); }
+
+    // confere o cabecalho e os limites do indice; mensagem no cerr se falhar
+    bool open(const std::string& path);
+    void close();
+
+    // caminho ja normalizado; nullptr se nao existe
+    const AssetPackEntry* find(const std::string& path) const;
+    bool read(const AssetPackEntry& entry, AssetData& out) const;
+
+    uint32_t entryCount() const { return header ? header->entryCount : 0; }
+    const AssetPackEntry& entry(uint32_t i) const { return entries[i]; }
+    std::string entryName(const AssetPackEntry& e) const { return std::string(names + e.nameOffset, e.nameLength); }
+
+private:
+    const unsigned char* base = nullptr;
+    size_t mappedSize = 0;
+    const AssetPackHeader* header = nullptr;
+    const AssetPackEntry* entries = nullptr;
+    const uint32_t* slots = nullptr;
+    const char* names = nullptr;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+struct AssetFS {
+    // mountPoint vazio monta na raiz; "mapa" faz "mapa/x.tmx" virar "x.tmx" na montagem
+    bool mountDirectory(const std::string& directory, const std::string& mountPoint = "");
+    bool mountArchive(const std::string& path, const std::string& mountPoint = "");
+    void unmountAll() { mounts.clear(); }
+
+    // false (e mensagem no cerr) se nenhuma montagem tem o caminho
+    bool read(const std::string& path, AssetData& out) const;
+    bool exists(const std::string& path) const;
+
+    size_t mountCount() const { return mounts.size(); }
+
+private:
+    struct Mount {
+        std::string point;     // normalizado, sem barra no fim
+        std::string directory; // com barra no fim; vazio para arquivo
+        std::unique_ptr<AssetPack> pack;
+    };
+    std::vector<Mount> mounts;
+
+    // caminho relativo a montagem, ou false se nao passa por ela
+    static bool relativeTo(const Mount& m, const std::string& path, std::string& relative);
+};
+
+// Montagem usada pelos programas, feita na primeira chamada: o assets.pak da
+// pasta atual (se existir) e por cima a pasta include do projeto (PG_ASSET_DIR,
+// definido pelo CMake; senao "include"), se existir. Assim o build de
+// desenvolvimento le os arquivos soltos e a copia distribuida so o .pak.
+// A variavel de ambiente PG_ASSETS (um .pak ou uma pasta) substitui as duas.
+AssetFS& defaultAssets();
+
+// Empacota os arquivos de directory com as extensoes pedidas (".png", ...).
+// Cada entrada vai em LZ4 se isso economizar pelo menos 10%, senao guardada
+// como esta (PNG ja vem comprimido). storeOnly desliga a compressao.
+struct AssetPackStats {
+    size_t files = 0, compressed = 0;
+    uint64_t originalBytes = 0, storedBytes = 0;
+};
+bool writeAssetPack(const std::string& directory, const std::string& outputPath,
+                    const std::vector<std::string>& extensions, bool storeOnly, AssetPackStats* stats = nullptr);
+
+#endif
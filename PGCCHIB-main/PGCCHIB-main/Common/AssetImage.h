@@ -0,0 +1,32 @@
+#ifndef ASSET_IMAGE_H
+#define ASSET_IMAGE_H
+
+#include <string>
+
+// a parte de implementacao do stb_image nao tem guarda: se o programa ja
+// incluiu (com STB_IMAGE_IMPLEMENTATION), nao inclui de novo
+#ifndef STBI_INCLUDE_STB_IMAGE_H
+#include "stb_image.h"
+#endif
+#include "AssetFS.h"
+
+// stbi_load pelo defaultAssets(): decodifica direto dos bytes do asset (do
+// arquivo mapeado, sem copia, quando vem do .pak). Liberar com stbi_image_free.
+// Inline porque a implementacao do stb_image fica em cada programa.
+inline unsigned char* loadImageAsset(const std::string& path, int* width, int* height, int* channels,
+                                     int desiredChannels) {
+    AssetData asset;
+    if (!defaultAssets().read(path, asset))
+        return nullptr;
+    return stbi_load_from_memory(asset.data, (int)asset.size, width, height, channels, desiredChannels);
+}
+
+// so as dimensoes (le o cabecalho do PNG, sem decodificar)
+inline bool imageAssetInfo(const std::string& path, int* width, int* height, int* channels) {
+    AssetData asset;
+    if (!defaultAssets().read(path, asset))
+        return false;
+    return stbi_info_from_memory(asset.data, (int)asset.size, width, height, channels) != 0;
+}
+
+#endif
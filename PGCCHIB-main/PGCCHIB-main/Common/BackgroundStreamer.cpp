@@ -0,0 +1,374 @@
+#include "BackgroundStreamer.h"
+
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// so as declaracoes; a implementacao fica no programa (STB_IMAGE_IMPLEMENTATION)
+#include "stb_image.h"
+#include "AssetImage.h"
+
+static const char* streamerVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+
+out vec3 TexCoord;
+
+uniform float segmentX[32];
+uniform float segmentSlot[32];
+uniform vec2 viewOrigin;
+uniform vec2 viewSize;
+uniform vec2 segmentSize;
+
+void main()
+{
+    vec2 world = vec2(segmentX[gl_InstanceID], 0.0) + aPos * segmentSize;
+    gl_Position = vec4((world - viewOrigin) / viewSize * 2.0 - 1.0, 0.0, 1.0);
+    TexCoord = vec3(aPos, segmentSlot[gl_InstanceID]);
+}
+)";
+
+static const char* streamerFragmentSource = R"(
+#version 330 core
+out vec4 FragColor;
+
+in vec3 TexCoord;
+
+uniform sampler2DArray segments;
+
+void main()
+{
+    FragColor = texture(segments, TexCoord);
+}
+)";
+
+static GLuint compileStreamerShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cerr << "Erro ao compilar shader do streamer: " << infoLog << std::endl;
+    }
+    return shader;
+}
+
+bool BackgroundStreamer::init(int segmentWidth, int segmentHeight, int slotCount) {
+    this->segmentWidth = segmentWidth;
+    this->segmentHeight = segmentHeight;
+    this->slotCount = slotCount;
+    slotSegment.assign(slotCount, -1);
+
+    GLuint vertexShader = compileStreamerShader(GL_VERTEX_SHADER, streamerVertexSource);
+    GLuint fragmentShader = compileStreamerShader(GL_FRAGMENT_SHADER, streamerFragmentSource);
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Erro ao linkar shader do streamer: " << infoLog << std::endl;
+        return false;
+    }
+
+    segmentXLoc = glGetUniformLocation(program, "segmentX");
+    segmentSlotLoc = glGetUniformLocation(program, "segmentSlot");
+    viewOriginLoc = glGetUniformLocation(program, "viewOrigin");
+    viewSizeLoc = glGetUniformLocation(program, "viewSize");
+    segmentSizeLoc = glGetUniformLocation(program, "segmentSize");
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "segments"), 0);
+
+    // quad unitario, posicionado por instancia no vertex shader
+    float quadVertices[] = {
+        0.0f, 1.0f,
+        0.0f, 0.0f,
+        1.0f, 1.0f,
+        1.0f, 0.0f
+    };
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
+
+    glGenTextures(1, &textureArray);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, segmentWidth, segmentHeight, slotCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    quit = false;
+    worker = std::thread(&BackgroundStreamer::workerLoop, this);
+    return true;
+}
+
+int BackgroundStreamer::addSource(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < sources.size(); ++i)
+        if (sources[i] == path) return (int)i;
+    sources.push_back(path);
+    return (int)sources.size() - 1;
+}
+
+void BackgroundStreamer::addSegment(int source, int srcX) {
+    std::lock_guard<std::mutex> lock(mutex);
+    segments.push_back({source, srcX});
+}
+
+int BackgroundStreamer::addImageColumns(const std::string& path) {
+    int width, height, comp;
+    if (!imageAssetInfo(path, &width, &height, &comp)) {
+        std::cout << "Falha ao ler cabecalho da imagem: " << path << std::endl;
+        return 0;
+    }
+    if (height != segmentHeight)
+        std::cout << "Aviso: altura de " << path << " (" << height << ") difere da dos segmentos" << std::endl;
+
+    int source = addSource(path);
+    int count = 0;
+    for (int x = 0; x + segmentWidth <= width; x += segmentWidth, ++count)
+        addSegment(source, x);
+    return count;
+}
+
+int BackgroundStreamer::slotOf(int segment) const {
+    for (int i = 0; i < slotCount; ++i)
+        if (slotSegment[i] == segment) return i;
+    return -1;
+}
+
+bool BackgroundStreamer::isPending(int segment) const {
+    return std::find(pending.begin(), pending.end(), segment) != pending.end();
+}
+
+// slot vazio ou, se nao houver, o que guarda o segmento mais longe da janela desejada
+int BackgroundStreamer::findFreeSlot() const {
+    int best = -1;
+    int bestDistance = -1;
+    for (int i = 0; i < slotCount; ++i) {
+        int s = slotSegment[i];
+        if (s < 0) return i;
+        if (s >= firstWanted && s <= lastWanted) continue;
+        int distance = s < firstWanted ? firstWanted - s : s - lastWanted;
+        if (distance > bestDistance) {
+            bestDistance = distance;
+            best = i;
+        }
+    }
+    return best;
+}
+
+void BackgroundStreamer::update(float cameraX, float viewWidth) {
+    int count = (int)segments.size();
+    if (count == 0 || slotCount == 0) return;
+
+    if (cameraX > lastCameraX) scrollDirection = 1;
+    else if (cameraX < lastCameraX) scrollDirection = -1;
+    lastCameraX = cameraX;
+
+    // visiveis + 1 de margem de cada lado + prefetch na direcao do scroll
+    int firstVisible = (int)std::floor(cameraX / segmentWidth);
+    int lastVisible = (int)std::floor((cameraX + viewWidth) / segmentWidth);
+    int first = firstVisible - 1 - (scrollDirection < 0 ? prefetch : 0);
+    int last = lastVisible + 1 + (scrollDirection > 0 ? prefetch : 0);
+    first = std::max(first, 0);
+    last = std::min(last, count - 1);
+
+    // nunca pede mais do que cabe nos slots; corta o lado oposto ao scroll
+    if (last - first + 1 > slotCount) {
+        if (scrollDirection > 0) first = last - slotCount + 1;
+        else last = first + slotCount - 1;
+    }
+    firstWanted = first;
+    lastWanted = last;
+
+    // pedidos em ordem de prioridade: visiveis primeiro, depois o prefetch
+    std::vector<int> missing;
+    for (int s = firstVisible; s <= lastVisible; ++s)
+        if (s >= first && s <= last) missing.push_back(s);
+    if (scrollDirection > 0) {
+        for (int s = lastVisible + 1; s <= last; ++s) missing.push_back(s);
+        for (int s = firstVisible - 1; s >= first; --s) missing.push_back(s);
+    } else {
+        for (int s = firstVisible - 1; s >= first; --s) missing.push_back(s);
+        for (int s = lastVisible + 1; s <= last; ++s) missing.push_back(s);
+    }
+
+    std::vector<Decoded> uploads;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        workerFirstWanted = first;
+        workerLastWanted = last;
+
+        // descarta pedidos que sairam da janela antes de serem decodificados
+        for (size_t i = 0; i < requests.size();) {
+            if (requests[i] < first || requests[i] > last) {
+                pending.erase(std::remove(pending.begin(), pending.end(), requests[i]), pending.end());
+                requests.erase(requests.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+
+        bool added = false;
+        for (int s : missing) {
+            if (s < first || s > last) continue;
+            if (slotOf(s) >= 0 || isPending(s)) continue;
+            requests.push_back(s);
+            pending.push_back(s);
+            added = true;
+        }
+        if (added) wakeWorker.notify_one();
+
+        for (int i = 0; i < maxUploadsPerFrame && !ready.empty(); ++i) {
+            uploads.push_back(std::move(ready.front()));
+            ready.pop_front();
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+    for (Decoded& d : uploads) {
+        pending.erase(std::remove(pending.begin(), pending.end(), d.segment), pending.end());
+        if (d.valid && d.segment >= first && d.segment <= last && slotOf(d.segment) < 0) {
+            int slot = findFreeSlot();
+            if (slot >= 0) {
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, slot, segmentWidth, segmentHeight, 1,
+                                GL_RGBA, GL_UNSIGNED_BYTE, d.pixels.data());
+                slotSegment[slot] = d.segment;
+            }
+        }
+        // devolve o buffer para ser reaproveitado pela thread
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBuffers.push_back(std::move(d.pixels));
+    }
+}
+
+void BackgroundStreamer::draw(float cameraX, float viewWidth) {
+    float xs[STREAMER_MAX_VISIBLE];
+    float slots[STREAMER_MAX_VISIBLE];
+    int n = 0;
+
+    int firstVisible = std::max((int)std::floor(cameraX / segmentWidth), 0);
+    int lastVisible = std::min((int)std::floor((cameraX + viewWidth) / segmentWidth), (int)segments.size() - 1);
+    for (int s = firstVisible; s <= lastVisible && n < STREAMER_MAX_VISIBLE; ++s) {
+        int slot = slotOf(s);
+        if (slot < 0) continue; // ainda carregando
+        xs[n] = (float)s * segmentWidth;
+        slots[n] = (float)slot;
+        n++;
+    }
+    if (n == 0) return;
+
+    glUseProgram(program);
+    glUniform1fv(segmentXLoc, n, xs);
+    glUniform1fv(segmentSlotLoc, n, slots);
+    glUniform2f(viewOriginLoc, cameraX, 0.0f);
+    glUniform2f(viewSizeLoc, viewWidth, (float)segmentHeight);
+    glUniform2f(segmentSizeLoc, (float)segmentWidth, (float)segmentHeight);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+    glBindVertexArray(VAO);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, n);
+}
+
+int BackgroundStreamer::residentCount() const {
+    int n = 0;
+    for (int s : slotSegment)
+        if (s >= 0) n++;
+    return n;
+}
+
+bool BackgroundStreamer::decodeSegment(const BackgroundSegment& seg, const std::string& path, std::vector<unsigned char>& out) {
+    if (seg.source != cachedSource) {
+        int nrChannels;
+        // mesma convencao dos outros programas (origem embaixo)
+        stbi_set_flip_vertically_on_load_thread(1);
+        unsigned char* data = loadImageAsset(path, &cachedWidth, &cachedHeight, &nrChannels, STBI_rgb_alpha);
+        if (!data) {
+            std::cout << "Falha ao carregar segmento: " << path << std::endl;
+            cachedSource = -1;
+            return false;
+        }
+        cachedImage.assign(data, data + (size_t)cachedWidth * cachedHeight * 4);
+        stbi_image_free(data);
+        cachedSource = seg.source;
+    }
+
+    // copia a coluna; linhas que faltarem (imagem mais baixa) ficam transparentes
+    out.assign((size_t)segmentWidth * segmentHeight * 4, 0);
+    int rows = std::min(segmentHeight, cachedHeight);
+    int cols = std::min(segmentWidth, cachedWidth - seg.srcX);
+    if (cols <= 0) return true;
+    for (int y = 0; y < rows; ++y)
+        memcpy(&out[(size_t)y * segmentWidth * 4], &cachedImage[((size_t)y * cachedWidth + seg.srcX) * 4], (size_t)cols * 4);
+    return true;
+}
+
+void BackgroundStreamer::workerLoop() {
+    while (true) {
+        int segment;
+        BackgroundSegment seg;
+        std::string path;
+        std::vector<unsigned char> buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeWorker.wait(lock, [this] { return quit || !requests.empty(); });
+            if (quit) return;
+            segment = requests.front();
+            requests.pop_front();
+            seg = segments[segment];
+            path = sources[seg.source];
+            if (!freeBuffers.empty()) {
+                buffer = std::move(freeBuffers.back());
+                freeBuffers.pop_back();
+            }
+        }
+
+        bool ok = decodeSegment(seg, path, buffer);
+
+        // mesmo quando falha ou sai da janela o resultado volta, para o update()
+        // tirar o segmento dos pendentes e reaproveitar o buffer
+        std::lock_guard<std::mutex> lock(mutex);
+        bool wanted = segment >= workerFirstWanted && segment <= workerLastWanted;
+        ready.push_back({segment, ok && wanted, std::move(buffer)});
+    }
+}
+
+void BackgroundStreamer::destroy() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wakeWorker.notify_all();
+    if (worker.joinable()) worker.join();
+
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteTextures(1, &textureArray);
+    glDeleteProgram(program);
+    VAO = VBO = textureArray = program = 0;
+    requests.clear();
+    ready.clear();
+    freeBuffers.clear();
+    pending.clear();
+    cachedImage.clear();
+    cachedSource = -1;
+}
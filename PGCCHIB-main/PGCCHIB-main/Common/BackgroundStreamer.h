@@ -0,0 +1,108 @@
+#ifndef BACKGROUND_STREAMER_H
+#define BACKGROUND_STREAMER_H
+
+#include <glad/glad.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// maximo de segmentos desenhados por frame (tamanho dos arrays de uniforms)
+const int STREAMER_MAX_VISIBLE = 32;
+
+// Um segmento do fundo: uma coluna de largura fixa de uma imagem em disco.
+// O nivel eh so uma lista desses descritores (8 bytes cada), os pixels
+// nunca ficam todos na memoria.
+struct BackgroundSegment {
+    int source; // indice em BackgroundStreamer::sources
+    int srcX;   // coluna inicial (em pixels) dentro da imagem de origem
+};
+
+// Camada de fundo "infinita" com streaming de segmentos.
+// Apenas os segmentos perto da camera ficam residentes, em um array de texturas
+// com um numero fixo de fatias (slots). Os proximos segmentos na direcao do scroll
+// sao pedidos antes de aparecer e decodificados em uma thread separada; a thread
+// principal so faz o upload (glTexSubImage3D) de quem ja esta pronto.
+// A memoria (CPU e GPU) fica constante, nao importa o tamanho do nivel.
+struct BackgroundStreamer {
+    int segmentWidth = 0, segmentHeight = 0;
+    int slotCount = 0;
+    int prefetch = 2;           // segmentos extras pedidos na direcao do scroll
+    int maxUploadsPerFrame = 2; // limita o custo de upload em um frame
+
+    std::vector<std::string> sources;
+    std::vector<BackgroundSegment> segments;
+
+    GLuint program = 0;
+    GLuint textureArray = 0;
+    GLuint VAO = 0, VBO = 0;
+    GLint segmentXLoc = -1, segmentSlotLoc = -1;
+    GLint viewOriginLoc = -1, viewSizeLoc = -1, segmentSizeLoc = -1;
+
+    // slot -> segmento residente (-1 = vazio); poucos slots, a busca eh linear
+    std::vector<int> slotSegment;
+    // segmentos ja pedidos para a thread e ainda nao enviados para a GPU
+    std::vector<int> pending;
+
+    int firstWanted = 0, lastWanted = -1;
+    float lastCameraX = 0.0f;
+    int scrollDirection = 1;
+
+    // pedidos e resultados compartilhados com a thread de decodificacao
+    struct Decoded {
+        int segment;
+        bool valid;
+        std::vector<unsigned char> pixels;
+    };
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wakeWorker;
+    std::deque<int> requests;
+    std::deque<Decoded> ready;
+    std::vector<std::vector<unsigned char>> freeBuffers;
+    int workerFirstWanted = 0, workerLastWanted = -1;
+    bool quit = false;
+
+    // cache da ultima imagem decodificada (so acessado pela thread de decodificacao),
+    // assim as varias colunas de uma mesma imagem larga decodificam o arquivo uma vez
+    int cachedSource = -1;
+    std::vector<unsigned char> cachedImage;
+    int cachedWidth = 0, cachedHeight = 0;
+
+    // slotCount fatias de segmentWidth x segmentHeight
+    bool init(int segmentWidth, int segmentHeight, int slotCount);
+
+    // divide uma imagem larga em colunas de segmentWidth e adiciona ao final do nivel
+    // (decodifica so o cabecalho). Retorna quantos segmentos foram adicionados.
+    // Os caminhos sao do defaultAssets(), lidos tambem pela thread de decodificacao.
+    int addImageColumns(const std::string& path);
+    void addSegment(int source, int srcX);
+    int addSource(const std::string& path);
+
+    // largura total do nivel em pixels
+    float levelWidth() const { return (float)segments.size() * segmentWidth; }
+
+    // decide quem precisa estar residente para a janela [cameraX, cameraX + viewWidth),
+    // pede os segmentos que faltam e envia para a GPU os que ja foram decodificados
+    void update(float cameraX, float viewWidth);
+
+    // desenha os segmentos residentes visiveis; view em pixels do nivel
+    // (y = 0 embaixo, segmentHeight em cima)
+    void draw(float cameraX, float viewWidth);
+
+    int residentCount() const;
+
+    void destroy();
+
+private:
+    void workerLoop();
+    bool decodeSegment(const BackgroundSegment& seg, const std::string& path, std::vector<unsigned char>& out);
+    int slotOf(int segment) const;
+    bool isPending(int segment) const;
+    int findFreeSlot() const;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "Camera2D.h"
+
+#include <cmath>
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+void Camera2D::setViewport(int width, int height) {
+    // janela minimizada manda 0x0
+    if (width <= 0 || height <= 0) return;
+    viewportWidth = width;
+    viewportHeight = height;
+    applyBounds();
+}
+
+void Camera2D::setZoom(float newZoom) {
+    zoom = std::min(std::max(newZoom, minZoom), maxZoom);
+    applyBounds();
+}
+
+void Camera2D::follow(const glm::vec2& target, float deltaTime) {
+    if (followSharpness <= 0.0f) {
+        position = target;
+    } else {
+        float t = 1.0f - std::exp(-followSharpness * deltaTime);
+        position += (target - position) * t;
+    }
+    applyBounds();
+}
+
+glm::vec2 Camera2D::viewSize() const {
+    float scale = pixelsPerUnit * zoom;
+    return glm::vec2(viewportWidth / scale, viewportHeight / scale);
+}
+
+Rect2D Camera2D::viewRect() const {
+    glm::vec2 center = snappedPosition();
+    glm::vec2 half = viewSize() * 0.5f;
+    return { center.x - half.x, center.y - half.y, center.x + half.x, center.y + half.y };
+}
+
+glm::mat4 Camera2D::projection() const {
+    glm::vec2 half = viewSize() * 0.5f;
+    return glm::ortho(-half.x, half.x, -half.y, half.y, -1.0f, 1.0f);
+}
+
+glm::mat4 Camera2D::view() const {
+    glm::vec2 center = snappedPosition();
+    return glm::translate(glm::mat4(1.0f), glm::vec3(-center, 0.0f));
+}
+
+glm::vec2 Camera2D::screenToWorld(double x, double y) const {
+    Rect2D r = viewRect();
+    float u = (float)x / viewportWidth;
+    float v = 1.0f - (float)y / viewportHeight;
+    return glm::vec2(r.minX + u * (r.maxX - r.minX), r.minY + v * (r.maxY - r.minY));
+}
+
+glm::vec2 Camera2D::snappedPosition() const {
+    if (!pixelSnap) return position;
+
+    // com numero impar de pixels o centro da tela cai no meio de um pixel,
+    // entao a grade de snap desloca meio pixel nesse eixo
+    float scale = pixelsPerUnit * zoom;
+    float halfX = (viewportWidth % 2) ? 0.5f : 0.0f;
+    float halfY = (viewportHeight % 2) ? 0.5f : 0.0f;
+    return glm::vec2((std::round(position.x * scale - halfX) + halfX) / scale,
+                     (std::round(position.y * scale - halfY) + halfY) / scale);
+}
+
+void Camera2D::applyBounds() {
+    if (!clampToBounds) return;
+
+    glm::vec2 half = viewSize() * 0.5f;
+    float bw = bounds.maxX - bounds.minX;
+    float bh = bounds.maxY - bounds.minY;
+
+    // se o mundo for menor que a tela naquele eixo, centraliza
+    if (bw <= 2.0f * half.x) position.x = (bounds.minX + bounds.maxX) * 0.5f;
+    else position.x = std::min(std::max(position.x, bounds.minX + half.x), bounds.maxX - half.x);
+
+    if (bh <= 2.0f * half.y) position.y = (bounds.minY + bounds.maxY) * 0.5f;
+    else position.y = std::min(std::max(position.y, bounds.minY + half.y), bounds.maxY - half.y);
+}
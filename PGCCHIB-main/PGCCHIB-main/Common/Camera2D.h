@@ -0,0 +1,70 @@
+#ifndef CAMERA_2D_H
+#define CAMERA_2D_H
+
+#include <glm/glm.hpp>
+
+// retangulo alinhado aos eixos em coordenadas do mundo
+struct Rect2D {
+    float minX, minY, maxX, maxY;
+
+    bool intersects(const Rect2D& other) const {
+        return minX < other.maxX && maxX > other.minX &&
+               minY < other.maxY && maxY > other.minY;
+    }
+
+    // caixa centrada em (x, y) com meia largura hw e meia altura hh
+    bool intersects(float x, float y, float hw, float hh) const {
+        return x - hw < maxX && x + hw > minX &&
+               y - hh < maxY && y + hh > minY;
+    }
+
+    bool contains(float x, float y) const {
+        return x >= minX && x <= maxX && y >= minY && y <= maxY;
+    }
+};
+
+// Camera ortografica 2D.
+// Guarda o centro da camera no mundo, o zoom e quantos pixels de tela uma unidade
+// do mundo ocupa (pixelsPerUnit, no zoom 1). A projecao eh recalculada a partir do
+// tamanho do framebuffer, entao redimensionar a janela nao distorce a cena.
+// viewRect() devolve o retangulo visivel no mundo, usado para descartar tiles,
+// sprites e particulas antes de gerar qualquer vertice.
+struct Camera2D {
+    glm::vec2 position = glm::vec2(0.0f);   // centro da camera no mundo
+    float zoom = 1.0f;
+    float minZoom = 0.25f, maxZoom = 4.0f;
+    float pixelsPerUnit = 1.0f;
+    int viewportWidth = 800, viewportHeight = 600;
+
+    // seguir alvo: 0 = gruda no alvo, maior = mais rapido (1/s)
+    float followSharpness = 8.0f;
+
+    // arredonda a posicao para o pixel de tela mais proximo (sem tremer em pixel art)
+    bool pixelSnap = true;
+
+    // limites opcionais do mundo (a camera nao mostra nada fora deles)
+    bool clampToBounds = false;
+    Rect2D bounds = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    void setViewport(int width, int height);
+    void setZoom(float zoom);
+
+    // aproxima a camera do alvo com lerp exponencial (independente do FPS)
+    void follow(const glm::vec2& target, float deltaTime);
+
+    // tamanho visivel no mundo (largura, altura)
+    glm::vec2 viewSize() const;
+    Rect2D viewRect() const;
+
+    glm::mat4 projection() const;
+    glm::mat4 view() const;
+
+    // converte coordenadas de cursor (pixels, y para baixo) para o mundo
+    glm::vec2 screenToWorld(double x, double y) const;
+
+private:
+    glm::vec2 snappedPosition() const;
+    void applyBounds();
+};
+
+#endif
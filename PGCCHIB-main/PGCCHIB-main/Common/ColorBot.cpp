@@ -0,0 +1,604 @@
+#include "ColorBot.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "ParallelFor.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int INFINITE_SCORE = 1 << 20;
+
+namespace {
+
+struct Move {
+    uint64_t mask;
+    int cell;
+    int points;
+};
+
+struct Search {
+    const ColorGame* game;
+    Clock::time_point deadline;
+    bool checkTime;
+    std::atomic<bool>* aborted;
+    std::atomic<bool>* cutByDepth; // alguma folha parou antes do fim da partida
+    long nodes;
+};
+
+}
+
+static int movePoints(const ColorGameRules& rules, int removed, int attempts) {
+    int points = removed * rules.pointsPerCell - attempts * rules.penaltyPerAttempt;
+    return points < 0 ? 0 : points;
+}
+
+// jogadas distintas (mascaras diferentes), das que dao mais pontos para as que dao menos
+static int generateMoves(const ColorGame& game, uint64_t visible, int attempts, Move* moves) {
+    int count = 0;
+    for (uint64_t bits = visible; bits; bits &= bits - 1) {
+        int cell = lowestBit(bits);
+        uint64_t mask = game.similar[cell] & visible;
+        bool repeated = false;
+        for (int k = 0; k < count && !repeated; ++k)
+            repeated = moves[k].mask == mask;
+        if (repeated) continue;
+
+        Move move = { mask, cell, movePoints(game.rules, bitCount(mask), attempts) };
+        int k = count++;
+        while (k > 0 && moves[k - 1].points < move.points) {
+            moves[k] = moves[k - 1];
+            --k;
+        }
+        moves[k] = move;
+    }
+    return count;
+}
+
+// melhor (pontos de quem joga - pontos do outro) daqui ate depth jogadas
+static int negamax(Search& search, uint64_t visible, int attempts, int depth, int alpha, int beta) {
+    search.nodes++;
+    if (search.checkTime && (search.nodes & 1023) == 0 && Clock::now() > search.deadline)
+        search.aborted->store(true, std::memory_order_relaxed);
+    if (search.aborted->load(std::memory_order_relaxed))
+        return 0;
+
+    const ColorGame& game = *search.game;
+    if (attempts >= game.rules.maxAttempts || visible == 0)
+        return 0;
+
+    if (depth == 0) {
+        // estimativa: quem joga pega a gulosa e o resto da partida empata
+        search.cutByDepth->store(true, std::memory_order_relaxed);
+        int best = 0;
+        for (uint64_t bits = visible; bits; bits &= bits - 1) {
+            int removed = bitCount(game.similar[lowestBit(bits)] & visible);
+            if (removed > best) best = removed;
+        }
+        return movePoints(game.rules, best, attempts);
+    }
+
+    Move moves[ColorGame::CELLS];
+    int count = generateMoves(game, visible, attempts, moves);
+    int best = -INFINITE_SCORE;
+    for (int i = 0; i < count; ++i) {
+        // value = points - filho, entao a janela do filho eh deslocada pelos pontos
+        int value = moves[i].points - negamax(search, visible & ~moves[i].mask, attempts + 1, depth - 1,
+                                              moves[i].points - beta, moves[i].points - alpha);
+        if (value > best) best = value;
+        if (best > alpha) alpha = best;
+        if (alpha >= beta) break;
+    }
+    return best;
+}
+
+int ColorBot::chooseMove(const ColorGame& game) {
+    Clock::time_point start = Clock::now();
+    nodes = 0;
+    depthReached = 0;
+    solved = false;
+    bestValue = 0;
+    lastMs = 0.0;
+    if (game.gameOver || game.visible == 0)
+        return -1;
+
+    Move moves[ColorGame::CELLS];
+    int count = generateMoves(game, game.visible, game.attempts, moves);
+    int remaining = game.rules.maxAttempts - game.attempts;
+    int workerCount = threads > 0 ? threads : defaultThreadCount();
+    if (workerCount > count) workerCount = count;
+
+    Clock::time_point deadline = start + std::chrono::microseconds((long long)(budgetMs * 1000.0));
+    int bestIndex = 0;
+
+    for (int depth = 1; depth <= remaining; ++depth) {
+        std::atomic<bool> aborted(false), cutByDepth(false);
+        std::atomic<int> next(0), sharedAlpha(-INFINITE_SCORE);
+        std::atomic<long> totalNodes(0);
+        std::mutex bestMutex;
+        int iterationBest = -1, iterationValue = -INFINITE_SCORE;
+
+        auto worker = [&]() {
+            // a profundidade 1 sempre termina: eh a gulosa e garante uma resposta
+            Search search = { &game, deadline, depth > 1, &aborted, &cutByDepth, 0 };
+            for (int i = next++; i < count; i = next++) {
+                // janela aberta ate alpha - 1: um valor igual ao alfa ainda sai exato e
+                // pode desempatar; abaixo disso eh so um limite superior
+                int alpha = sharedAlpha.load() - 1;
+                int value = moves[i].points - negamax(search, game.visible & ~moves[i].mask, game.attempts + 1,
+                                                      depth - 1, moves[i].points - INFINITE_SCORE, moves[i].points - alpha);
+                if (aborted.load(std::memory_order_relaxed))
+                    break;
+                if (value <= alpha)
+                    continue;
+                std::lock_guard<std::mutex> lock(bestMutex);
+                // empate: a de indice menor (ordem gulosa), para o resultado nao depender das threads
+                if (value > iterationValue || (value == iterationValue && i < iterationBest)) {
+                    iterationValue = value;
+                    iterationBest = i;
+                }
+                if (iterationValue > sharedAlpha.load())
+                    sharedAlpha.store(iterationValue);
+            }
+            totalNodes += search.nodes;
+        };
+
+        std::vector<std::thread> helpers;
+        for (int t = 1; t < workerCount; ++t)
+            helpers.emplace_back(worker);
+        worker();
+        for (std::thread& h : helpers)
+            h.join();
+        nodes += totalNodes.load();
+
+        if (aborted.load())
+            break;
+
+        bestIndex = iterationBest;
+        bestValue = iterationValue;
+        depthReached = depth;
+        if (!cutByDepth.load()) {
+            solved = true;
+            break;
+        }
+        // a melhor da raiz vai na frente na proxima profundidade
+        Move first = moves[bestIndex];
+        memmove(&moves[1], &moves[0], bestIndex * sizeof(Move));
+        moves[0] = first;
+        bestIndex = 0;
+    }
+
+    lastMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return moves[bestIndex].cell;
+}
+
+static const int MAX_SUBDIVISIONS = 16;
+static const int BOUND_CHUNK = 256;
+
+// folga relativa nas comparacoes com o limiar: balde "inteiro dentro" ou
+// "inteiro fora" so quando nenhum arredondamento do teste por celula mudaria isso
+static const float GRID_MARGIN = 1e-4f;
+
+bool SimilarityGrid::build(const Color* colors, int count, float threshold) {
+    if (count <= 0 || threshold <= 0.0f)
+        return false;
+    limit = threshold * threshold;
+
+    float lo[3] = { colors[0].r, colors[0].g, colors[0].b }, hi[3] = { lo[0], lo[1], lo[2] };
+    for (int i = 1; i < count; ++i) {
+        const float c[3] = { colors[i].r, colors[i].g, colors[i].b };
+        for (int a = 0; a < 3; ++a) {
+            if (c[a] < lo[a]) lo[a] = c[a];
+            if (c[a] > hi[a]) hi[a] = c[a];
+        }
+    }
+    // limiar pequeno demais para as cores que existem: baldes maiores, para a
+    // grade nao ter muito mais baldes que celulas
+    int parts = subdivisions < 1 ? 1 : (subdivisions > MAX_SUBDIVISIONS ? MAX_SUBDIVISIONS : subdivisions);
+    size = threshold / parts;
+    for (;;) {
+        size_t total = 1;
+        for (int a = 0; a < 3; ++a) {
+            dims[a] = (int)((hi[a] - lo[a]) / size) + 1;
+            total *= (size_t)dims[a];
+        }
+        if (total <= (size_t)count * 2 + 64) break;
+        size *= 2.0f;
+    }
+    for (int a = 0; a < 3; ++a)
+        origin[a] = lo[a];
+
+    // vizinhos pela distancia entre as caixas de dois baldes com esse
+    // deslocamento; os inteiros dentro ficam no comeco (insideCount deles).
+    // A folga tira o arredondamento de threshold / size (4.0000001 seria 5)
+    reach = (int)std::ceil(threshold / size - GRID_MARGIN);
+    offsets.clear();
+    for (int dz = -reach; dz <= reach; ++dz)
+        for (int dy = -reach; dy <= reach; ++dy)
+            for (int dx = -reach; dx <= reach; ++dx) {
+                const int d[3] = { std::abs(dx), std::abs(dy), std::abs(dz) };
+                float nearest = 0.0f, farthest = 0.0f;
+                for (int a = 0; a < 3; ++a) {
+                    float gap = (d[a] > 0 ? d[a] - 1 : 0) * size, span = (d[a] + 1) * size;
+                    nearest += gap * gap;
+                    farthest += span * span;
+                }
+                if (nearest < limit * (1.0f + GRID_MARGIN))
+                    offsets.push_back({ dx, dy, dz, farthest < limit * (1.0f - GRID_MARGIN) });
+            }
+    std::stable_partition(offsets.begin(), offsets.end(), [](const Offset& o) { return o.inside; });
+    insideCount = (int)(std::find_if(offsets.begin(), offsets.end(), [](const Offset& o) { return !o.inside; }) -
+                        offsets.begin());
+
+    // ordena as celulas por balde (counting sort), cores separadas por canal
+    int buckets = dims[0] * dims[1] * dims[2];
+    std::vector<int> bucketOfCell(count);
+    bucketStart.assign(buckets + 1, 0);
+    for (int i = 0; i < count; ++i) {
+        int cell[3];
+        const float c[3] = { colors[i].r, colors[i].g, colors[i].b };
+        for (int a = 0; a < 3; ++a) {
+            cell[a] = (int)((c[a] - origin[a]) / size);
+            if (cell[a] >= dims[a]) cell[a] = dims[a] - 1;
+        }
+        bucketOfCell[i] = (cell[2] * dims[1] + cell[1]) * dims[0] + cell[0];
+        bucketStart[bucketOfCell[i] + 1]++;
+    }
+    for (int k = 0; k < buckets; ++k)
+        bucketStart[k + 1] += bucketStart[k];
+
+    r.resize(count);
+    g.resize(count);
+    b.resize(count);
+    cellOf.resize(count);
+    slotOf.resize(count);
+    std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+    for (int i = 0; i < count; ++i) {
+        int slot = fill[bucketOfCell[i]]++;
+        r[slot] = colors[i].r;
+        g[slot] = colors[i].g;
+        b[slot] = colors[i].b;
+        cellOf[slot] = i;
+        slotOf[i] = slot;
+    }
+    showAll();
+    return true;
+}
+
+void SimilarityGrid::showAll() {
+    alive.assign(r.size(), 1);
+    bucketVisible.resize(bucketStart.size() - 1);
+    for (size_t k = 0; k + 1 < bucketStart.size(); ++k)
+        bucketVisible[k] = bucketStart[k + 1] - bucketStart[k];
+}
+
+int SimilarityGrid::bucketOf(int slot) const {
+    // busca binaria nos inicios dos baldes (o slot ja esta ordenado por balde)
+    return (int)(std::upper_bound(bucketStart.begin(), bucketStart.end(), slot) - bucketStart.begin()) - 1;
+}
+
+template <typename Full, typename Partial>
+void SimilarityGrid::forNeighbors(int slot, bool withInside, Full full, Partial partial) const {
+    int bucket = bucketOf(slot);
+    const int center[3] = { bucket % dims[0], bucket / dims[0] % dims[1], bucket / (dims[0] * dims[1]) };
+    float inner = limit * (1.0f - GRID_MARGIN), outer = limit * (1.0f + GRID_MARGIN);
+
+    // a distancia ate a caixa de um balde separa por eixo: menor e maior
+    // distancia ao quadrado para cada deslocamento, em cada eixo, calculadas uma vez
+    const float p[3] = { r[slot], g[slot], b[slot] };
+    float pad = size * GRID_MARGIN;
+    float gap[3][2 * MAX_SUBDIVISIONS + 1], span[3][2 * MAX_SUBDIVISIONS + 1];
+    for (int a = 0; a < 3; ++a)
+        for (int d = -reach; d <= reach; ++d) {
+            // caixa um pouco maior que o balde, pelo arredondamento
+            float lo = origin[a] + (center[a] + d) * size - pad, hi = lo + size + 2.0f * pad;
+            float outside = p[a] < lo ? lo - p[a] : (p[a] > hi ? p[a] - hi : 0.0f);
+            float across = std::max(p[a] - lo, hi - p[a]);
+            gap[a][d + reach] = outside * outside;
+            span[a][d + reach] = across * across;
+        }
+
+    for (size_t i = withInside ? 0 : insideCount; i < offsets.size(); ++i) {
+        const Offset& o = offsets[i];
+        const int c[3] = { center[0] + o.dx, center[1] + o.dy, center[2] + o.dz };
+        if (c[0] < 0 || c[0] >= dims[0] || c[1] < 0 || c[1] >= dims[1] || c[2] < 0 || c[2] >= dims[2])
+            continue;
+        int neighbor = (c[2] * dims[1] + c[1]) * dims[0] + c[0];
+        if (bucketVisible[neighbor] == 0)
+            continue;
+        if (o.inside) {
+            full(neighbor);
+            continue;
+        }
+        int x = o.dx + reach, y = o.dy + reach, z = o.dz + reach;
+        if (span[0][x] + span[1][y] + span[2][z] < inner)
+            full(neighbor);
+        else if (gap[0][x] + gap[1][y] + gap[2][z] < outer)
+            partial(neighbor);
+    }
+}
+
+int SimilarityGrid::countNear(int slot, int floor, std::vector<int>& partial) const {
+    int total = 0, remaining = 0;
+    partial.clear();
+    forNeighbors(slot, true, [&](int k) { total += bucketVisible[k]; },
+                 [&](int k) { partial.push_back(k); remaining += bucketVisible[k]; });
+    if (total + remaining <= floor)
+        return total + remaining;
+
+    // mesmo teste do ColorGame, sem desvio para vetorizar
+    float pr = r[slot], pg = g[slot], pb = b[slot];
+    for (int k : partial) {
+        int n = 0;
+        for (int j = bucketStart[k]; j < bucketStart[k + 1]; ++j) {
+            float dr = pr - r[j], dg = pg - g[j], db = pb - b[j];
+            n += (dr * dr + dg * dg + db * db < limit) & alive[j];
+        }
+        total += n;
+        remaining -= bucketVisible[k];
+        if (total + remaining <= floor)
+            return total + remaining;
+    }
+    return total;
+}
+
+int SimilarityGrid::removalCount(int cell) const {
+    int slot = slotOf[cell];
+    if (!alive[slot])
+        return 0;
+    std::vector<int> partial;
+    return countNear(slot, -1, partial);
+}
+
+int SimilarityGrid::remove(int cell, Undo* undo) {
+    int slot = slotOf[cell];
+    if (!alive[slot])
+        return 0;
+    float pr = r[slot], pg = g[slot], pb = b[slot];
+    std::vector<int> full, partial;
+    forNeighbors(slot, true, [&](int k) { full.push_back(k); }, [&](int k) { partial.push_back(k); });
+
+    int removed = 0;
+    for (int k : full) {
+        if (undo) {
+            for (int j = bucketStart[k]; j < bucketStart[k + 1]; ++j)
+                if (alive[j]) undo->slots.push_back(j);
+            undo->buckets.push_back(k);
+            undo->counts.push_back(bucketVisible[k]);
+        }
+        std::fill(alive.begin() + bucketStart[k], alive.begin() + bucketStart[k + 1], 0);
+        removed += bucketVisible[k];
+        bucketVisible[k] = 0;
+    }
+    for (int k : partial) {
+        int before = bucketVisible[k];
+        for (int j = bucketStart[k]; j < bucketStart[k + 1]; ++j) {
+            float dr = pr - r[j], dg = pg - g[j], db = pb - b[j];
+            if (alive[j] && dr * dr + dg * dg + db * db < limit) {
+                alive[j] = 0;
+                bucketVisible[k]--;
+                removed++;
+                if (undo) undo->slots.push_back(j);
+            }
+        }
+        if (undo && bucketVisible[k] != before) {
+            undo->buckets.push_back(k);
+            undo->counts.push_back(before - bucketVisible[k]);
+        }
+    }
+    return removed;
+}
+
+void SimilarityGrid::restore(Undo& undo) {
+    for (int slot : undo.slots)
+        alive[slot] = 1;
+    for (size_t i = 0; i < undo.buckets.size(); ++i)
+        bucketVisible[undo.buckets[i]] += undo.counts[i];
+    undo.slots.clear();
+    undo.buckets.clear();
+    undo.counts.clear();
+}
+
+int SimilarityGrid::bestMove(double budgetMs, int threadCount, int* removed) {
+    std::vector<Click> moves;
+    topMoves(1, budgetMs, threadCount, moves);
+    if (removed) *removed = moves.empty() ? 0 : moves[0].removed;
+    return moves.empty() ? -1 : moves[0].cell;
+}
+
+void SimilarityGrid::topMoves(int count, double budgetMs, int threadCount, std::vector<Click>& moves) {
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::microseconds((long long)(budgetMs * 1000.0));
+    evaluated = 0;
+    exact = false;
+
+    // limite superior de cada balde: visiveis em todos os vizinhos possiveis;
+    // inside: so os vizinhos que ficam inteiros dentro (iguais para todo o balde)
+    std::vector<int> order, upper(bucketVisible.size(), 0), inside(bucketVisible.size(), 0);
+    for (int k = 0; k < (int)bucketVisible.size(); ++k) {
+        if (bucketVisible[k] == 0) continue;
+        const int center[3] = { k % dims[0], k / dims[0] % dims[1], k / (dims[0] * dims[1]) };
+        for (size_t i = 0; i < offsets.size(); ++i) {
+            const Offset& o = offsets[i];
+            const int c[3] = { center[0] + o.dx, center[1] + o.dy, center[2] + o.dz };
+            if (c[0] < 0 || c[0] >= dims[0] || c[1] < 0 || c[1] >= dims[1] || c[2] < 0 || c[2] >= dims[2])
+                continue;
+            int visible = bucketVisible[(c[2] * dims[1] + c[1]) * dims[0] + c[0]];
+            upper[k] += visible;
+            if ((int)i < insideCount) inside[k] += visible;
+        }
+        order.push_back(k);
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int c) { return upper[a] > upper[c]; });
+
+    // os melhores ate aqui, do maior para o menor (removidas, slot, balde);
+    // floor eh o que um clique precisa passar para entrar (o pior deles com a
+    // lista cheia) e found diz se ja tem algum
+    if (count < 1) count = 1;
+    std::vector<std::array<int, 3>> best;
+    std::atomic<int> next(0), floor(0), found(0);
+    std::atomic<long> evaluatedCount(0);
+    std::atomic<bool> timedOut(false);
+    std::mutex bestMutex;
+
+    auto worker = [&]() {
+        std::vector<int> partial;
+        std::vector<std::pair<int, int>> candidates; // (limite da celula, slot)
+        // o mais lento de cada etapa, para nao comecar uma que passe do prazo
+        Clock::duration slowestEvaluation = Clock::duration::zero(), slowestChunk = Clock::duration::zero();
+        for (int i = next++; i < (int)order.size() && !timedOut.load(); i = next++) {
+            int k = order[i];
+            // a lista esta em ordem decrescente: daqui para frente nada passa do melhor
+            if (upper[k] <= floor.load())
+                break;
+
+            // limite de cada celula, sem testar celula nenhuma, em pedacos de
+            // BOUND_CHUNK celulas: num balde grande o prazo acaba antes de
+            // precisar dos limites de todas
+            for (int first = bucketStart[k]; first < bucketStart[k + 1] && !timedOut.load(); first += BOUND_CHUNK) {
+                int last = std::min(first + BOUND_CHUNK, bucketStart[k + 1]);
+                Clock::time_point chunkStart = Clock::now();
+                if (found.load() > 0 && chunkStart + slowestChunk > deadline) {
+                    timedOut.store(true);
+                    break;
+                }
+                candidates.clear();
+                for (int slot = first; slot < last; ++slot) {
+                    if (!alive[slot]) continue;
+                    int bound = inside[k];
+                    forNeighbors(slot, false, [&](int n) { bound += bucketVisible[n]; },
+                                 [&](int n) { bound += bucketVisible[n]; });
+                    if (bound > floor.load())
+                        candidates.push_back({ bound, slot });
+                }
+                std::sort(candidates.begin(), candidates.end(),
+                          [](const std::pair<int, int>& a, const std::pair<int, int>& c) { return a.first > c.first; });
+                slowestChunk = std::max(slowestChunk, Clock::now() - chunkStart);
+
+                for (const std::pair<int, int>& candidate : candidates) {
+                    int least = floor.load();
+                    if (candidate.first <= least)
+                        break;
+                    // o primeiro clique sempre eh avaliado: garante uma resposta. Os outros
+                    // so comecam se ainda cabe um clique do tamanho do mais lento ate aqui
+                    Clock::time_point now = Clock::now();
+                    if (found.load() > 0 && now + slowestEvaluation > deadline) {
+                        timedOut.store(true);
+                        break;
+                    }
+                    int near = countNear(candidate.second, least, partial);
+                    slowestEvaluation = std::max(slowestEvaluation, Clock::now() - now);
+                    evaluatedCount++;
+                    if (near <= least) continue;
+
+                    // entra na lista no lugar do outro do mesmo balde (se for
+                    // melhor que ele) ou no lugar do pior
+                    std::lock_guard<std::mutex> lock(bestMutex);
+                    if (near <= floor.load()) continue;
+                    auto same = std::find_if(best.begin(), best.end(),
+                                             [&](const std::array<int, 3>& e) { return e[2] == k; });
+                    if (same != best.end()) {
+                        if (near <= (*same)[0]) continue;
+                        *same = { near, candidate.second, k };
+                    } else {
+                        best.push_back({ near, candidate.second, k });
+                    }
+                    std::sort(best.begin(), best.end(),
+                              [](const std::array<int, 3>& a, const std::array<int, 3>& c) { return a[0] > c[0]; });
+                    if ((int)best.size() > count) best.pop_back();
+                    if ((int)best.size() == count) floor.store(best.back()[0]);
+                    found.store(1);
+                }
+            }
+        }
+    };
+
+    int workerCount = threadCount > 0 ? threadCount : defaultThreadCount();
+    std::vector<std::thread> helpers;
+    for (int t = 1; t < workerCount; ++t)
+        helpers.emplace_back(worker);
+    worker();
+    for (std::thread& h : helpers)
+        h.join();
+
+    evaluated = evaluatedCount.load();
+    exact = !timedOut.load();
+    lastMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    moves.clear();
+    for (const std::array<int, 3>& e : best)
+        moves.push_back({ cellOf[e[1]], e[0] });
+}
+
+// cliques jogados contra a resposta e parte do prazo para acha-los (o resto
+// fica para as respostas)
+static const int PLAN_WIDTH = 4;
+static const double PLAN_ROOT_SHARE = 0.4;
+
+int SimilarityGrid::planMove(const ColorGameRules& rules, int attempts, double budgetMs, int threadCount,
+                             int* removed) {
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + std::chrono::microseconds((long long)(budgetMs * 1000.0));
+    auto msUntil = [](Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    };
+    lookahead = 0;
+
+    // ultima jogada da partida: sem resposta, a gulosa eh a melhor
+    if (rules.maxAttempts - attempts <= 1) {
+        int cell = bestMove(budgetMs, threadCount, removed);
+        lastMs = msUntil(start, Clock::now());
+        return cell;
+    }
+
+    std::vector<Click> roots;
+    topMoves(PLAN_WIDTH, budgetMs * PLAN_ROOT_SHARE, threadCount, roots);
+    long totalEvaluated = evaluated;
+    bool allExact = exact;
+    if (roots.empty()) {
+        if (removed) *removed = 0;
+        lastMs = msUntil(start, Clock::now());
+        return -1;
+    }
+
+    // cada clique: joga, acha a melhor resposta com a parte dele do prazo e
+    // desfaz. O primeiro (o guloso) sempre vai; os outros so se cabe um do
+    // tamanho do mais lento ate aqui
+    Undo undo;
+    int bestIndex = 0, bestValue = -INFINITE_SCORE;
+    Clock::duration slowest = Clock::duration::zero();
+    for (size_t i = 0; i < roots.size(); ++i) {
+        Clock::time_point now = Clock::now();
+        if (i > 0 && now + slowest > deadline)
+            break;
+        remove(roots[i].cell, &undo);
+        Clock::time_point played = Clock::now();
+        // desfazer custa mais ou menos o mesmo que jogar
+        double share = (msUntil(played, deadline) - msUntil(now, played)) / (double)(roots.size() - i);
+        int reply = 0;
+        bestMove(share > 0.0 ? share : 0.0, threadCount, &reply);
+        totalEvaluated += evaluated;
+        allExact = allExact && exact;
+        restore(undo);
+
+        int value = movePoints(rules, roots[i].removed, attempts) - movePoints(rules, reply, attempts + 1);
+        if (value > bestValue) {
+            bestValue = value;
+            bestIndex = (int)i;
+        }
+        lookahead++;
+        slowest = std::max(slowest, Clock::now() - now);
+    }
+
+    evaluated = totalEvaluated;
+    exact = allExact && lookahead == (int)roots.size();
+    lastMs = msUntil(start, Clock::now());
+    if (removed) *removed = roots[bestIndex].removed;
+    return roots[bestIndex].cell;
+}
@@ -0,0 +1,122 @@
+#ifndef COLOR_BOT_H
+#define COLOR_BOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ColorGame.h"
+
+// Adversario e dicas do jogo das cores.
+// O jogo nao tem sorte depois que a grade eh gerada (os dois veem tudo), entao
+// em vez de expectimax/MCTS o bot faz busca exata: negamax com poda alfa-beta
+// sobre a diferenca de pontos ate o fim da partida (no maximo maxAttempts
+// jogadas). Cada jogada eh similar[cell] & visible; cliques que removem a
+// mesma mascara sao a mesma jogada e so entram uma vez, e as jogadas sao
+// ordenadas pelos pontos imediatos (a gulosa primeiro, que poda mais).
+// Aprofundamento iterativo com prazo (budgetMs): se o tempo acabar no meio de
+// uma profundidade, vale a melhor jogada da profundidade anterior. As jogadas
+// da raiz sao divididas entre as threads, que compartilham o alfa.
+struct ColorBot {
+    double budgetMs = 16.0;
+    int threads = 0;       // 0 = todos os nucleos
+
+    // estatisticas do ultimo chooseMove()
+    long nodes = 0;
+    int depthReached = 0;  // ultima profundidade completa
+    bool solved = false;   // chegou ao fim da partida (resultado exato)
+    int bestValue = 0;     // pontos do bot - pontos do adversario daqui ate o fim
+    double lastMs = 0.0;
+
+    // celula para o jogador da vez; -1 se o jogo acabou
+    int chooseMove(const ColorGame& game);
+};
+
+// Melhor clique em grades grandes (1000 x 1000 = um milhao de celulas), sem
+// grafo par a par (seriam ~116 GB): as celulas sao separadas em baldes no
+// espaco de cores, com lado threshold / subdivisions. Um clique so olha os
+// baldes a menos de threshold do seu: os que ficam inteiros dentro da esfera
+// entram pela contagem de visiveis do balde, sem testar celula; so os baldes da
+// borda testam celula por celula.
+// topMoves eh um branch and bound com prazo: os baldes vao do maior limite
+// superior para o menor, e dentro de cada balde as celulas tambem, pelo limite
+// de cada uma (baldes inteiros + baldes da borda). Para quando nenhum limite
+// passa do pior dos melhores ja achados (resultado exato) ou quando o prazo
+// acaba (os melhores avaliados ate ali). bestMove eh o melhor clique so.
+// planMove olha uma jogada a frente, sem o resto da partida: os melhores
+// cliques de baldes diferentes sao jogados (remove com desfazer), cada um
+// contra a melhor resposta do adversario, e ganha o maior saldo de pontos
+// das duas jogadas. Numa grade de um milhao de celulas so achar o melhor
+// clique ja gasta o prazo de 16 ms, entao buscar as 6 jogadas nao cabe; a
+// ultima jogada da partida eh so a gulosa (nao tem resposta).
+struct SimilarityGrid {
+    int subdivisions = 4; // baldes por threshold em cada eixo (1 a 16)
+
+    // estatisticas do ultimo bestMove()/planMove()
+    long evaluated = 0;   // cliques contados celula por celula
+    bool exact = false;   // provou que nao ha clique (ou resposta) melhor
+    int lookahead = 0;    // planMove: cliques jogados contra a resposta
+    double lastMs = 0.0;
+
+    struct Click {
+        int cell;
+        int removed;
+    };
+    // o que remove() escondeu, para restore() devolver
+    struct Undo {
+        std::vector<int> slots;
+        std::vector<int> buckets, counts;
+    };
+
+    // monta os baldes com todas as celulas visiveis
+    bool build(const Color* colors, int count, float threshold);
+    void showAll();
+
+    int cellCount() const { return (int)slotOf.size(); }
+    bool visible(int cell) const { return alive[slotOf[cell]] != 0; }
+    // celulas que sairiam clicando cell (0 se ja saiu)
+    int removalCount(int cell) const;
+    // joga cell: esconde as parecidas e devolve quantas sairam; com undo
+    // anota o que escondeu
+    int remove(int cell, Undo* undo = nullptr);
+    // mostra de novo o que foi anotado em undo e esvazia ele
+    void restore(Undo& undo);
+
+    // clique visivel que remove mais celulas; -1 se nao sobrou nenhuma
+    int bestMove(double budgetMs, int threads = 0, int* removed = nullptr);
+    // ate count cliques, do que remove mais para o que remove menos, no
+    // maximo um por balde (cliques do mesmo balde removem quase as mesmas)
+    void topMoves(int count, double budgetMs, int threads, std::vector<Click>& moves);
+    // jogada para quem joga com attempts jogadas ja feitas, pelo saldo desta
+    // jogada e da melhor resposta; -1 se nao sobrou nenhuma
+    int planMove(const ColorGameRules& rules, int attempts, double budgetMs, int threads = 0, int* removed = nullptr);
+
+private:
+    struct Offset {
+        int dx, dy, dz;
+        bool inside; // o balde inteiro fica a menos de threshold de qualquer ponto do balde central
+    };
+
+    float limit = 0.0f, size = 1.0f; // threshold ao quadrado, lado do balde
+    float origin[3] = { 0.0f, 0.0f, 0.0f };
+    int dims[3] = { 1, 1, 1 };
+    int reach = 1;                     // vizinhos ate reach baldes de distancia em cada eixo
+    std::vector<Offset> offsets;       // baldes vizinhos que podem ter celula parecida
+    int insideCount = 0;               // os primeiros offsets, com inside = true
+    std::vector<int> bucketStart;      // celulas do balde b: slots [bucketStart[b], bucketStart[b + 1])
+    std::vector<int> bucketVisible;
+    std::vector<float> r, g, b;        // cores por slot (ordem dos baldes)
+    std::vector<unsigned char> alive;  // 1 = visivel, por slot
+    std::vector<int> cellOf, slotOf;   // slot -> celula e celula -> slot
+
+    int bucketOf(int slot) const;
+    // percorre os baldes vizinhos do slot: full(balde) para os inteiros dentro,
+    // partial(balde) para os da borda. Sem withInside pula os offsets inside
+    template <typename Full, typename Partial>
+    void forNeighbors(int slot, bool withInside, Full full, Partial partial) const;
+    // contagem exata; desiste (e devolve <= floor) quando nao da mais para passar
+    // de floor. partial eh so espaco de trabalho (um por thread)
+    int countNear(int slot, int floor, std::vector<int>& partial) const;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#include "ColorGame.h"
+
+#include <cstring>
+
+void ColorGame::reset(GameRng& rng) {
+    for (int i = 0; i < CELLS; ++i) {
+        colors[i].r = 0.5f + rng.nextFloat() * 0.5f;
+        colors[i].g = 0.5f + rng.nextFloat() * 0.5f;
+        colors[i].b = 0.5f + rng.nextFloat() * 0.5f;
+    }
+    buildSimilarity();
+    visible = (1ull << CELLS) - 1;
+    lastRemoved = 0;
+    attempts = 0;
+    currentPlayer = 1;
+    scores[0] = scores[1] = 0;
+    gameOver = false;
+}
+
+void ColorGame::buildSimilarity() {
+    // distancia ao quadrado: mesma comparacao sem a raiz. Com as cores
+    // separadas por canal e o resultado em bytes o laco de dentro vetoriza (sem
+    // desvio: metade dos pares eh parecida, o preditor erraria muito); depois
+    // cada 8 bytes 0/1 viram 8 bits com uma multiplicacao
+    float limit = rules.similarityThreshold * rules.similarityThreshold;
+    float r[CELLS], g[CELLS], b[CELLS];
+    for (int i = 0; i < CELLS; ++i) {
+        r[i] = colors[i].r;
+        g[i] = colors[i].g;
+        b[i] = colors[i].b;
+    }
+    static_assert(CELLS % 8 == 0, "CELLS precisa ser multiplo de 8");
+    for (int i = 0; i < CELLS; ++i) {
+        unsigned char near[CELLS];
+        for (int j = 0; j < CELLS; ++j) {
+            float dr = r[i] - r[j], dg = g[i] - g[j], db = b[i] - b[j];
+            near[j] = dr * dr + dg * dg + db * db < limit;
+        }
+        uint64_t mask = 0;
+        for (int j = 0; j < CELLS; j += 8) {
+            uint64_t bytes;
+            memcpy(&bytes, near + j, 8);
+            mask |= ((bytes * 0x0102040810204080ull) >> 56) << j;
+        }
+        similar[i] = mask;
+    }
+}
+
+int ColorGame::play(int cell) {
+    lastRemoved = 0;
+    if (gameOver)
+        return -1;
+    if (attempts >= rules.maxAttempts) {
+        gameOver = true;
+        return -1;
+    }
+    if (cell < 0 || cell >= CELLS || !cellVisible(cell))
+        return -1;
+
+    lastRemoved = removalMask(cell);
+    visible &= ~lastRemoved;
+    int removed = bitCount(lastRemoved);
+
+    int points = removed * rules.pointsPerCell - attempts * rules.penaltyPerAttempt;
+    if (points < 0) points = 0;
+    scores[currentPlayer - 1] += points;
+
+    attempts++;
+    if (attempts >= rules.maxAttempts)
+        gameOver = true;
+    currentPlayer = currentPlayer == 1 ? 2 : 1;
+    return points;
+}
+
+int ColorGame::winner() const {
+    if (scores[0] > scores[1]) return 1;
+    if (scores[1] > scores[0]) return 2;
+    return 0;
+}
@@ -0,0 +1,117 @@
+#ifndef COLOR_GAME_H
+#define COLOR_GAME_H
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// indice do bit ligado mais baixo (bits != 0) e quantidade de bits ligados
+inline int lowestBit(uint64_t bits) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+inline int bitCount(uint64_t bits) {
+#ifdef _MSC_VER
+    return (int)__popcnt64(bits);
+#else
+    return __builtin_popcountll(bits);
+#endif
+}
+
+// Gerador pseudoaleatorio pequeno (xorshift64*), um por thread ou por partida,
+// no lugar do rand() (estado global, lento e com RAND_MAX pequeno no Windows).
+// A semente passa pelo splitmix64, entao sementes vizinhas (0, 1, 2...) dao
+// sequencias independentes.
+struct GameRng {
+    uint64_t state;
+
+    explicit GameRng(uint64_t seed = 1) { this->seed(seed); }
+
+    void seed(uint64_t value) {
+        uint64_t z = value + 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        state = (z ^ (z >> 31)) | 1; // estado 0 trava o xorshift
+    }
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1Dull;
+    }
+
+    // [0, 1) com 24 bits
+    float nextFloat() { return (next() >> 40) * (1.0f / 16777216.0f); }
+
+    // [0, n)
+    int nextInt(int n) { return (int)(((next() >> 32) * (uint64_t)n) >> 32); }
+};
+
+struct Color {
+    float r, g, b;
+
+    float distanceSquared(const Color& other) const {
+        return (r - other.r) * (r - other.r) +
+               (g - other.g) * (g - other.g) +
+               (b - other.b) * (b - other.b);
+    }
+};
+
+// parametros de balanceamento
+struct ColorGameRules {
+    float similarityThreshold = 0.25f; // distancia RGB abaixo da qual a cor sai junto
+    int maxAttempts = 6;               // jogadas somadas dos dois jogadores
+    int pointsPerCell = 10;
+    int penaltyPerAttempt = 5;         // descontado por jogada ja feita
+};
+
+// Regras do jogo das cores sem janela, sem GLFW e sem alocacao: a grade eh um
+// array fixo e as celulas visiveis sao bits de uma mascara de 64 bits, entao
+// copiar o estado eh um memcpy e milhoes de partidas rodam em paralelo (uma
+// por thread, cada uma com o seu GameRng).
+// O grafo de similaridade (quem sai junto com quem) eh calculado uma vez no
+// reset(): similar[i] tem um bit por celula parecida com i. Uma jogada vira
+// similar[cell] & visible e contar os pontos de qualquer clique eh um popcount.
+struct ColorGame {
+    static const int ROWS = 6, COLS = 8;
+    static const int CELLS = ROWS * COLS;
+
+    ColorGameRules rules;
+    Color colors[CELLS];
+    uint64_t similar[CELLS];   // vizinhos no grafo de similaridade (inclui a propria celula)
+    uint64_t visible = 0;      // bit i = celula i (linha i / COLS) ainda na grade
+    uint64_t lastRemoved = 0;  // celulas removidas pela ultima jogada
+    int attempts = 0;
+    int currentPlayer = 1;     // 1 ou 2
+    int scores[2] = { 0, 0 };
+    bool gameOver = false;
+
+    // cores claras novas (0.5 a 1 em cada canal) e placar zerado
+    void reset(GameRng& rng);
+    // recalcula similar[] (chamar se mudar as cores ou o limiar depois do reset)
+    void buildSimilarity();
+
+    bool cellVisible(int cell) const { return (visible >> cell) & 1; }
+
+    // joga a celula pelo jogador da vez; devolve os pontos feitos ou -1 se a
+    // jogada nao vale (fim de jogo ou celula vazia)
+    int play(int cell);
+
+    // celulas que sairiam jogando cell (sem mudar o estado)
+    uint64_t removalMask(int cell) const { return similar[cell] & visible; }
+    int removalCount(int cell) const { return bitCount(removalMask(cell)); }
+
+    // 1 ou 2, 0 = empate (so faz sentido com gameOver)
+    int winner() const;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "Console.h"
+#include "SpscRing.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+
+struct Console::Shared {
+    SpscRing<ConsoleCommand, 4096> queue;
+    std::atomic<bool> running{true};
+    std::atomic<bool> done{false};
+    bool fromStdin = false;
+    std::thread reader;
+};
+
+bool ConsoleCommand::is(const char* name) const {
+    return count > 0 && strcmp(words[0], name) == 0;
+}
+
+float ConsoleCommand::number(int i, float fallback) const {
+    if (i >= count) return fallback;
+    char* end;
+    float value = strtof(words[i], &end);
+    return end == words[i] ? fallback : value;
+}
+
+// separa a linha em palavras; linhas vazias e comentarios (#) nao viram comando
+static bool parseLine(const std::string& line, ConsoleCommand& cmd) {
+    cmd.count = 0;
+    std::istringstream words(line);
+    std::string w;
+    while (cmd.count < CONSOLE_MAX_WORDS && words >> w) {
+        if (cmd.count == 0 && w[0] == '#') return false;
+        strncpy(cmd.words[cmd.count], w.c_str(), CONSOLE_WORD_SIZE - 1);
+        cmd.words[cmd.count][CONSOLE_WORD_SIZE - 1] = '\0';
+        cmd.count++;
+    }
+    return cmd.count > 0;
+}
+
+// fila cheia: espera o render consumir (so a thread de leitura fica parada)
+static bool pushBlocking(Console::Shared& s, const ConsoleCommand& cmd) {
+    while (!s.queue.push(cmd)) {
+        if (!s.running) return false;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return true;
+}
+
+static void readLines(Console::Shared& s, std::istream& in) {
+    std::string line;
+    ConsoleCommand cmd;
+    while (s.running && std::getline(in, line))
+        if (parseLine(line, cmd) && !pushBlocking(s, cmd)) return;
+}
+
+bool Console::start(const std::string& scriptPath, bool readStdin) {
+    stop();
+
+    std::shared_ptr<std::ifstream> script;
+    if (!scriptPath.empty()) {
+        script = std::make_shared<std::ifstream>(scriptPath);
+        if (!script->is_open()) {
+            std::cerr << "Console: nao foi possivel abrir " << scriptPath << std::endl;
+            return false;
+        }
+    }
+
+    shared = std::make_shared<Shared>();
+    shared->fromStdin = readStdin;
+
+    // a thread guarda sua propria referencia ao estado compartilhado, entao
+    // pode continuar viva (presa no std::cin) depois que o Console for destruido
+    std::shared_ptr<Shared> s = shared;
+    shared->reader = std::thread([s, script, readStdin]() {
+        if (script) readLines(*s, *script);
+        if (readStdin && s->running) readLines(*s, std::cin);
+        s->done = true;
+    });
+    return true;
+}
+
+bool Console::poll(ConsoleCommand& out) {
+    return shared && shared->queue.pop(out);
+}
+
+bool Console::finished() const {
+    return !shared || (shared->done && shared->queue.empty());
+}
+
+void Console::stop() {
+    if (!shared) return;
+    shared->running = false;
+    if (shared->reader.joinable()) {
+        if (shared->fromStdin && !shared->done)
+            shared->reader.detach();
+        else
+            shared->reader.join();
+    }
+    shared.reset();
+}
@@ -0,0 +1,50 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <memory>
+#include <string>
+
+const int CONSOLE_MAX_WORDS = 8;
+const int CONSOLE_WORD_SIZE = 32;
+
+// Linha de comando ja separada em palavras (feito na thread de leitura).
+// Tamanho fixo para passar pela fila sem alocar memoria.
+struct ConsoleCommand {
+    char words[CONSOLE_MAX_WORDS][CONSOLE_WORD_SIZE];
+    int count = 0;
+
+    // palavra i ("" se nao existir). A palavra 0 eh o comando
+    const char* word(int i) const { return i < count ? words[i] : ""; }
+    bool is(const char* name) const;
+    // palavra i como numero; fallback se nao existir ou nao for numero
+    float number(int i, float fallback = 0.0f) const;
+};
+
+// Console que nao trava o render.
+// Uma thread le linhas (de um arquivo de script e/ou do terminal), separa as
+// palavras e coloca os comandos em uma fila sem lock. O loop de render chama
+// poll() no inicio do frame e aplica quantos comandos quiser; se ninguem digitar
+// nada o frame nao espera. Com a fila cheia quem espera eh a thread de leitura.
+struct Console {
+    // comeca a ler. Se scriptPath nao for vazio executa o arquivo primeiro;
+    // readStdin diz se depois continua lendo do terminal
+    bool start(const std::string& scriptPath = "", bool readStdin = true);
+
+    // pega o proximo comando pronto; false se nao houver nenhum
+    bool poll(ConsoleCommand& out);
+
+    // true quando a leitura acabou (fim do script e do terminal) e a fila esvaziou
+    bool finished() const;
+
+    // para a thread. Se ela estiver bloqueada esperando o terminal, fica solta
+    // ate o fim do programa (nao ha como interromper a leitura do std::cin)
+    void stop();
+    ~Console() { stop(); }
+
+    struct Shared;
+
+private:
+    std::shared_ptr<Shared> shared;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "FrameArena.h"
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+
+// bloco extra pedido ao heap quando o buffer acaba no meio do frame
+struct FrameArena::Overflow {
+    Overflow* next;
+};
+
+FrameArena::FrameArena(size_t capacity) : size(capacity) {}
+
+FrameArena::~FrameArena() {
+    reset();
+    ::operator delete(buffer);
+}
+
+static size_t alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    if (!buffer) buffer = (char*)::operator new(size);
+
+    size_t start = alignUp((size_t)(uintptr_t)(buffer + offset), alignment) - (size_t)(uintptr_t)buffer;
+    if (start + bytes <= size) {
+        offset = start + bytes;
+        if (used() > peakBytes) peakBytes = used();
+        return buffer + start;
+    }
+
+    // nao coube: bloco proprio com o cabecalho da lista na frente
+    size_t header = alignUp(sizeof(Overflow), alignment);
+    char* block = (char*)::operator new(header + bytes + alignment);
+    Overflow* node = (Overflow*)block;
+    node->next = overflow;
+    overflow = node;
+    overflowCount++;
+    overflowBytes += bytes;
+    if (used() > peakBytes) peakBytes = used();
+    size_t at = alignUp((size_t)(uintptr_t)(block + header), alignment) - (size_t)(uintptr_t)block;
+    return block + at;
+}
+
+void FrameArena::reset() {
+    if (overflow) {
+        while (overflow) {
+            Overflow* next = overflow->next;
+            ::operator delete((void*)overflow);
+            overflow = next;
+        }
+        // o frame nao coube: o proximo buffer ja tem o pico com folga
+        size_t grown = peakBytes + peakBytes / 2;
+        ::operator delete(buffer);
+        buffer = nullptr;
+        size = grown;
+    }
+    offset = 0;
+    overflowBytes = 0;
+    overflowCount = 0;
+}
+
+const char* FrameArena::format(const char* fmt, ...) {
+    if (!buffer) buffer = (char*)::operator new(size);
+
+    // escreve direto no espaco livre; so se nao couber mede e pede o tamanho certo
+    va_list args, retry;
+    va_start(args, fmt);
+    va_copy(retry, args);
+    size_t room = size - offset;
+    int length = vsnprintf(buffer + offset, room, fmt, args);
+    va_end(args);
+
+    char* text;
+    if (length < 0) {
+        text = (char*)allocate(1, 1);
+        text[0] = '\0';
+    } else if ((size_t)length < room) {
+        text = buffer + offset;
+        offset += (size_t)length + 1;
+        if (used() > peakBytes) peakBytes = used();
+    } else {
+        text = (char*)allocate((size_t)length + 1, 1);
+        vsnprintf(text, (size_t)length + 1, fmt, retry);
+    }
+    va_end(retry);
+    return text;
+}
+
+FrameArena& frameArena() {
+    thread_local FrameArena arena;
+    return arena;
+}
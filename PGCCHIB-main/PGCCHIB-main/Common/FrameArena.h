@@ -0,0 +1,57 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+// Alocador linear para temporarios de um frame (strings do HUD, listas de
+// cliques, filas de desenho...). Alocar eh so avancar um ponteiro, liberar nao
+// faz nada e reset() devolve tudo de uma vez no inicio do proximo frame.
+//
+// Se um frame passar da capacidade, o que faltar vem do heap em blocos extras
+// e no reset() o buffer cresce para o pico daquele frame; depois disso os
+// frames seguintes nao tocam mais no heap.
+//
+// Eh um std::pmr::memory_resource, entao serve para os containers pmr:
+//     FrameString s(&frameArena());
+//     FrameVector<int> v(&frameArena());
+// Nada alocado aqui pode sobreviver ao reset() (nem ser guardado em variavel global).
+struct FrameArena : std::pmr::memory_resource {
+    explicit FrameArena(size_t capacity = 256 * 1024);
+    ~FrameArena();
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void reset();
+
+    // printf para uma string que vive ate o proximo reset()
+    const char* format(const char* fmt, ...);
+
+    size_t used() const { return offset + overflowBytes; }
+    size_t capacity() const { return size; }
+    size_t peak() const { return peakBytes; }
+    int overflowBlocks() const { return overflowCount; } // blocos extras neste frame
+
+private:
+    char* buffer = nullptr;
+    size_t size = 0, offset = 0;
+    size_t peakBytes = 0, overflowBytes = 0;
+    int overflowCount = 0;
+    struct Overflow;
+    Overflow* overflow = nullptr;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+// uma arena por thread (o buffer so eh criado no primeiro uso)
+FrameArena& frameArena();
+
+using FrameString = std::pmr::string;
+template <typename T>
+using FrameVector = std::pmr::vector<T>;
+
+#endif
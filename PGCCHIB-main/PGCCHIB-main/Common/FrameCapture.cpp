@@ -0,0 +1,482 @@
+#include "FrameCapture.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include "ParallelFor.h"
+
+// ---------------------------------------------------------------- PNG
+
+static uint32_t crcTable[256];
+
+static void initCrcTable() {
+    for (uint32_t n = 0; n < 256; ++n) {
+        uint32_t c = n;
+        for (int k = 0; k < 8; ++k) c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        crcTable[n] = c;
+    }
+}
+
+static uint32_t crc32(uint32_t crc, const unsigned char* data, size_t size) {
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t adler32(const unsigned char* data, size_t size) {
+    uint32_t a = 1, b = 0;
+    while (size > 0) {
+        // 5552 eh o maior bloco em que b nao passa de 32 bits antes do modulo
+        size_t block = size < 5552 ? size : 5552;
+        size -= block;
+        while (block--) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return b << 16 | a;
+}
+
+// bits saem do menos para o mais significativo, como o deflate pede
+struct BitWriter {
+    std::vector<unsigned char>& out;
+    uint32_t bits = 0;
+    int count = 0;
+
+    explicit BitWriter(std::vector<unsigned char>& out) : out(out) {}
+
+    void put(uint32_t value, int n) {
+        bits |= value << count;
+        count += n;
+        while (count >= 8) {
+            out.push_back((unsigned char)bits);
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+    // codigos de Huffman vao do bit mais significativo para o menos
+    void putCode(uint32_t code, int n) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < n; ++i) reversed |= ((code >> i) & 1) << (n - 1 - i);
+        put(reversed, n);
+    }
+    void flush() {
+        if (count > 0) out.push_back((unsigned char)bits);
+        bits = 0;
+        count = 0;
+    }
+};
+
+static const int lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const int lengthExtra[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const int distBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                  257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const int distExtra[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+// comprimento (3..258) -> codigo 0..28 e distancia (1..32768) -> codigo 0..29
+static unsigned char lengthCode[259];
+static unsigned char distCodeSmall[257]; // distancias ate 256
+static unsigned char distCodeLarge[256]; // (distancia - 1) >> 7 para as maiores
+
+static void initDeflateTables() {
+    for (int c = 0; c < 29; ++c)
+        for (int l = lengthBase[c]; l < lengthBase[c] + (1 << lengthExtra[c]) && l <= 258; ++l) lengthCode[l] = (unsigned char)c;
+    lengthCode[258] = 28;
+    for (int c = 0; c < 30; ++c)
+        for (int d = distBase[c]; d < distBase[c] + (1 << distExtra[c]); ++d) {
+            if (d <= 256) distCodeSmall[d] = (unsigned char)c;
+            else distCodeLarge[(d - 1) >> 7] = (unsigned char)c;
+        }
+}
+
+static void putLiteral(BitWriter& w, int value) {
+    if (value < 144) w.putCode(0x30 + value, 8);
+    else if (value < 256) w.putCode(0x190 + value - 144, 9);
+    else if (value < 280) w.putCode(value - 256, 7);
+    else w.putCode(0xC0 + value - 280, 8);
+}
+
+static void putMatch(BitWriter& w, int length, int distance) {
+    int lc = lengthCode[length];
+    putLiteral(w, 257 + lc);
+    if (lengthExtra[lc]) w.put(length - lengthBase[lc], lengthExtra[lc]);
+    int dc = distance <= 256 ? distCodeSmall[distance] : distCodeLarge[(distance - 1) >> 7];
+    w.putCode(dc, 5);
+    if (distExtra[dc]) w.put(distance - distBase[dc], distExtra[dc]);
+}
+
+// stream zlib com um unico bloco de Huffman fixo
+static void zlibCompress(const unsigned char* data, size_t size, std::vector<unsigned char>& out,
+                         std::vector<int>& head) {
+    const int HASH_BITS = 15, WINDOW = 32768, MAX_MATCH = 258;
+    head.assign(1 << HASH_BITS, -1);
+
+    out.push_back(0x78);
+    out.push_back(0x01);
+    BitWriter w(out);
+    w.put(1, 1); // ultimo bloco
+    w.put(1, 2); // Huffman fixo
+
+    size_t i = 0;
+    while (i < size) {
+        if (i + 3 <= size) {
+            uint32_t h = ((uint32_t)data[i] << 16 | (uint32_t)data[i + 1] << 8 | data[i + 2]) * 2654435761u >> (32 - HASH_BITS);
+            int candidate = head[h];
+            head[h] = (int)i;
+            if (candidate >= 0 && (int)i - candidate <= WINDOW && memcmp(data + candidate, data + i, 3) == 0) {
+                size_t limit = size - i < (size_t)MAX_MATCH ? size - i : (size_t)MAX_MATCH;
+                size_t length = 3;
+                while (length < limit && data[candidate + length] == data[i + length]) length++;
+                putMatch(w, (int)length, (int)(i - candidate));
+                i += length;
+                continue;
+            }
+        }
+        putLiteral(w, data[i]);
+        i++;
+    }
+    putLiteral(w, 256);
+    w.flush();
+
+    uint32_t adler = adler32(data, size);
+    for (int s = 24; s >= 0; s -= 8) out.push_back((unsigned char)(adler >> s));
+}
+
+static void putU32(std::vector<unsigned char>& out, uint32_t v) {
+    for (int s = 24; s >= 0; s -= 8) out.push_back((unsigned char)(v >> s));
+}
+
+static void putChunk(std::vector<unsigned char>& out, const char* type, const unsigned char* data, size_t size) {
+    putU32(out, (uint32_t)size);
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    putU32(out, crc32(0, &out[start], size + 4));
+}
+
+static std::once_flag tablesOnce;
+
+// scratch: [0] linhas filtradas, [1] zlib, [2] arquivo inteiro
+static bool encodePng(const char* path, const unsigned char* rgba, int width, int height, bool flipY,
+                      std::vector<unsigned char> scratch[3], std::vector<int>& head) {
+    std::call_once(tablesOnce, []() {
+        initCrcTable();
+        initDeflateTables();
+    });
+
+    // filtro Up em todas as linhas: linhas repetidas viram zeros e o LZ77 acha
+    size_t stride = (size_t)width * 3 + 1;
+    std::vector<unsigned char>& filtered = scratch[0];
+    filtered.resize(stride * height);
+    for (int y = 0; y < height; ++y) {
+        const unsigned char* row = rgba + (size_t)(flipY ? height - 1 - y : y) * width * 4;
+        const unsigned char* above = y == 0 ? nullptr : rgba + (size_t)(flipY ? height - y : y - 1) * width * 4;
+        unsigned char* out = &filtered[y * stride];
+        *out++ = 2;
+        for (int x = 0; x < width; ++x)
+            for (int c = 0; c < 3; ++c) *out++ = (unsigned char)(row[x * 4 + c] - (above ? above[x * 4 + c] : 0));
+    }
+
+    std::vector<unsigned char>& compressed = scratch[1];
+    compressed.clear();
+    zlibCompress(filtered.data(), filtered.size(), compressed, head);
+
+    std::vector<unsigned char>& file = scratch[2];
+    file.clear();
+    static const unsigned char signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    file.insert(file.end(), signature, signature + 8);
+    unsigned char ihdr[13];
+    for (int s = 0; s < 4; ++s) {
+        ihdr[s] = (unsigned char)(width >> (24 - 8 * s));
+        ihdr[4 + s] = (unsigned char)(height >> (24 - 8 * s));
+    }
+    ihdr[8] = 8;  // bits por canal
+    ihdr[9] = 2;  // RGB
+    ihdr[10] = ihdr[11] = ihdr[12] = 0;
+    putChunk(file, "IHDR", ihdr, 13);
+    putChunk(file, "IDAT", compressed.data(), compressed.size());
+    putChunk(file, "IEND", nullptr, 0);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        std::cerr << "Nao foi possivel criar " << path << std::endl;
+        return false;
+    }
+    bool ok = fwrite(file.data(), 1, file.size(), f) == file.size();
+    fclose(f);
+    return ok;
+}
+
+bool writePngRgba(const char* path, const unsigned char* rgba, int width, int height, bool flipY) {
+    std::vector<unsigned char> scratch[3];
+    std::vector<int> head;
+    return encodePng(path, rgba, width, height, flipY, scratch, head);
+}
+
+// ---------------------------------------------------------------- streams
+
+// YUV 4:2:0 BT.601 de faixa cheia (C420jpeg): cada amostra de cor eh a media de
+// um bloco 2x2. Largura e altura impares perdem a ultima coluna/linha.
+static void writeY4mFrame(FILE* f, const unsigned char* rgba, int width, int height, std::vector<unsigned char>& yuv) {
+    int w = width & ~1, h = height & ~1;
+    size_t lumaSize = (size_t)w * h, chromaSize = lumaSize / 4;
+    yuv.resize(lumaSize + 2 * chromaSize);
+    unsigned char* Y = yuv.data();
+    unsigned char* U = Y + lumaSize;
+    unsigned char* V = U + chromaSize;
+
+    for (int y = 0; y < h; y += 2) {
+        // o OpenGL entrega de baixo para cima
+        const unsigned char* row0 = rgba + (size_t)(height - 1 - y) * width * 4;
+        const unsigned char* row1 = row0 - (size_t)width * 4;
+        for (int x = 0; x < w; x += 2) {
+            int r = 0, g = 0, b = 0;
+            const unsigned char* px[4] = { row0 + x * 4, row0 + x * 4 + 4, row1 + x * 4, row1 + x * 4 + 4 };
+            for (int k = 0; k < 4; ++k) {
+                int pr = px[k][0], pg = px[k][1], pb = px[k][2];
+                Y[(size_t)(y + (k >> 1)) * w + x + (k & 1)] = (unsigned char)((77 * pr + 150 * pg + 29 * pb + 128) >> 8);
+                r += pr;
+                g += pg;
+                b += pb;
+            }
+            r = (r + 2) >> 2;
+            g = (g + 2) >> 2;
+            b = (b + 2) >> 2;
+            size_t c = (size_t)(y / 2) * (w / 2) + x / 2;
+            U[c] = (unsigned char)(((-43 * r - 85 * g + 128 * b + 128) >> 8) + 128);
+            V[c] = (unsigned char)(((128 * r - 107 * g - 21 * b + 128) >> 8) + 128);
+        }
+    }
+    fputs("FRAME\n", f);
+    fwrite(yuv.data(), 1, yuv.size(), f);
+}
+
+static void writeRawFrame(FILE* f, const unsigned char* rgba, int width, int height, std::vector<unsigned char>& rgb) {
+    rgb.resize((size_t)width * height * 3);
+    unsigned char* out = rgb.data();
+    for (int y = height - 1; y >= 0; --y) {
+        const unsigned char* row = rgba + (size_t)y * width * 4;
+        for (int x = 0; x < width; ++x) {
+            *out++ = row[x * 4];
+            *out++ = row[x * 4 + 1];
+            *out++ = row[x * 4 + 2];
+        }
+    }
+    fwrite(rgb.data(), 1, rgb.size(), f);
+}
+
+// ---------------------------------------------------------------- FrameCapture
+
+CaptureFormat captureFormatFromPath(const std::string& path) {
+    auto endsWith = [&](const char* suffix) {
+        size_t n = strlen(suffix);
+        return path.size() >= n && path.compare(path.size() - n, n, suffix) == 0;
+    };
+    if (endsWith(".y4m")) return CAPTURE_Y4M;
+    if (endsWith(".rgb") || endsWith(".raw")) return CAPTURE_RAW;
+    return CAPTURE_PNG;
+}
+
+bool FrameCapture::start(const std::string& path, int width, int height) {
+    return start(path, captureFormatFromPath(path), width, height);
+}
+
+bool FrameCapture::start(const std::string& path, CaptureFormat format, int width, int height) {
+    if (active) stop();
+    if (ringSize < 2) ringSize = 2;
+    if (ringSize > MAX_RING) ringSize = MAX_RING;
+
+    this->path = path;
+    this->format = format;
+    this->width = width;
+    this->height = height;
+    captured = dropped = 0;
+    written = 0;
+    mainThreadMs = 0.0;
+    frameCounter = 0;
+    writeIndex = 0;
+
+    if (format != CAPTURE_PNG) {
+        stream = fopen(path.c_str(), "wb");
+        if (!stream) {
+            std::cerr << "Nao foi possivel criar " << path << std::endl;
+            return false;
+        }
+        if (format == CAPTURE_Y4M)
+            fprintf(stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width & ~1, height & ~1, fps);
+    }
+
+    size_t bytes = (size_t)width * height * 4;
+    for (int i = 0; i < ringSize; ++i) {
+        glGenBuffers(1, &slots[i].pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slots[i].pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+        slots[i].state = SLOT_FREE;
+        slots[i].fence = 0;
+        released[i] = false;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    // PNG eh caro (dezenas de ms por frame em 1080p), entao usa varias threads;
+    // os streams precisam dos frames em ordem e sao baratos, uma thread basta
+    int threads = 1;
+    if (format == CAPTURE_PNG) {
+        threads = encodeThreads > 0 ? encodeThreads : defaultThreadCount() - 1;
+        if (encodeThreads <= 0 && threads > 4) threads = 4;
+        if (threads < 1) threads = 1;
+    }
+    quit = false;
+    for (int t = 0; t < threads; ++t) workers.emplace_back(&FrameCapture::workerLoop, this);
+    active = true;
+    return true;
+}
+
+// devolve ao anel os PBOs que as threads ja copiaram
+void FrameCapture::releaseCopiedSlots() {
+    for (int i = 0; i < ringSize; ++i) {
+        Slot& s = slots[i];
+        if (s.state != SLOT_MAPPED || !released[i].load(std::memory_order_acquire)) continue;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        s.state = SLOT_FREE;
+    }
+}
+
+// mapeia, do mais antigo para o mais novo, os PBOs com a leitura terminada e
+// entrega para as threads; para no primeiro que ainda nao terminou, assim os
+// frames chegam em ordem. wait = esperar a GPU (so no stop)
+void FrameCapture::handOffFinished(bool wait) {
+    size_t bytes = (size_t)width * height * 4;
+    for (int k = 0; k < ringSize; ++k) {
+        int i = (writeIndex + k) % ringSize;
+        Slot& s = slots[i];
+        if (s.state != SLOT_READING) continue;
+
+        GLenum status = glClientWaitSync(s.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000000ull : 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) break;
+        glDeleteSync(s.fence);
+        s.fence = 0;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        const unsigned char* pixels = (const unsigned char*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+        if (!pixels) {
+            std::cerr << "FrameCapture: falha ao mapear o PBO" << std::endl;
+            s.state = SLOT_FREE;
+            continue;
+        }
+        s.state = SLOT_MAPPED;
+        released[i] = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back({ i, pixels, s.frame });
+        }
+        wake.notify_one();
+    }
+}
+
+void FrameCapture::capture() {
+    if (!active) return;
+    auto start = std::chrono::steady_clock::now();
+
+    releaseCopiedSlots();
+    handOffFinished(false);
+
+    Slot& s = slots[writeIndex];
+    if (s.state != SLOT_FREE) {
+        // anel cheio: a GPU ou as threads estao atrasadas; perde o frame em vez de esperar
+        dropped++;
+    } else {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        s.state = SLOT_READING;
+        s.frame = frameCounter;
+        writeIndex = (writeIndex + 1) % ringSize;
+        captured++;
+    }
+    frameCounter++;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    mainThreadMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void FrameCapture::stop() {
+    if (!active) return;
+
+    // mapeia o que falta (esperando a GPU) e deixa as threads esvaziarem a fila
+    releaseCopiedSlots();
+    handOffFinished(true);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers) t.join();
+    workers.clear();
+
+    for (int i = 0; i < ringSize; ++i) {
+        Slot& s = slots[i];
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        if (s.state == SLOT_MAPPED) glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        if (s.fence) glDeleteSync(s.fence);
+        glDeleteBuffers(1, &s.pbo);
+        s = Slot();
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (stream) {
+        fclose(stream);
+        stream = nullptr;
+    }
+    active = false;
+}
+
+void FrameCapture::printStats() const {
+    long requested = captured + dropped;
+    printf("captura %s: %ld frames gravados, %ld descartados, %.3f ms/frame na thread principal\n", path.c_str(),
+           written.load(), dropped, requested > 0 ? mainThreadMs / requested : 0.0);
+}
+
+void FrameCapture::workerLoop() {
+    // cada thread tem a sua copia do frame e os buffers do codificador
+    std::vector<unsigned char> frame((size_t)width * height * 4);
+    std::vector<unsigned char> scratch;
+    size_t bytes = frame.size();
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return quit || !jobs.empty(); });
+            if (jobs.empty()) break; // quit e nada mais a fazer
+            job = jobs.front();
+            jobs.pop_front();
+        }
+        // copia e libera o PBO antes de codificar: o slot volta para o anel ja
+        memcpy(frame.data(), job.pixels, bytes);
+        released[job.slot].store(true, std::memory_order_release);
+
+        writeFrame(frame.data(), job.frame, scratch);
+        written++;
+    }
+}
+
+void FrameCapture::writeFrame(const unsigned char* rgba, long frame, std::vector<unsigned char>& scratch) {
+    if (format == CAPTURE_Y4M) {
+        writeY4mFrame(stream, rgba, width, height, scratch);
+    } else if (format == CAPTURE_RAW) {
+        writeRawFrame(stream, rgba, width, height, scratch);
+    } else {
+        thread_local std::vector<unsigned char> pngScratch[3];
+        thread_local std::vector<int> head;
+        char name[32];
+        snprintf(name, sizeof(name), "%06ld.png", frame + 1);
+        encodePng((path + name).c_str(), rgba, width, height, true, pngScratch, head);
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <glad/glad.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum CaptureFormat {
+    CAPTURE_PNG, // sequencia prefixo000001.png, prefixo000002.png...
+    CAPTURE_Y4M, // YUV 4:2:0 em um arquivo so (ffmpeg, mpv e vlc abrem direto)
+    CAPTURE_RAW  // RGB de 8 bits, linhas de cima para baixo, sem cabecalho:
+                 // ffmpeg -f rawvideo -pixel_format rgb24 -video_size LxA -framerate fps -i arquivo
+};
+
+// .y4m e .rgb/.raw escolhem os formatos de stream; o resto vira prefixo de PNG
+CaptureFormat captureFormatFromPath(const std::string& path);
+
+// PNG RGB de 8 bits a partir de pixels RGBA (o alfa eh descartado); flipY para
+// imagens lidas do OpenGL, que vem de baixo para cima. Deflate com Huffman fixo
+// e LZ77 guloso: comprime bem as areas lisas e nao gasta tempo procurando o
+// melhor casamento.
+bool writePngRgba(const char* path, const unsigned char* rgba, int width, int height, bool flipY);
+
+// Gravacao de frames sem travar o render.
+// capture() pede um glReadPixels para um pixel buffer object (PBO) do anel e
+// volta na hora: a copia acontece na GPU/driver enquanto o programa segue. Nas
+// chamadas seguintes, os PBOs cuja leitura ja terminou (fence sinalizada) sao
+// mapeados e entregues as threads de codificacao, que copiam os pixels para
+// fora do PBO (liberando o slot) e codificam/gravam no disco. A thread
+// principal nunca espera: se o anel estiver todo ocupado o frame eh descartado
+// e contado em dropped.
+// Le do framebuffer ligado em GL_READ_FRAMEBUFFER (o back buffer, ou o FBO no
+// modo sem janela); chame depois de desenhar e antes do glfwSwapBuffers.
+struct FrameCapture {
+    static const int MAX_RING = 8;
+    int ringSize = 3;      // PBOs; um frame eh mapeado ate ringSize - 1 frames depois
+    int encodeThreads = 0; // PNG: 0 = nucleos - 1 (no maximo 4); streams sempre usam 1
+    int fps = 60;          // so vai no cabecalho do Y4M
+
+    // estatisticas (frames pedidos = captured + dropped)
+    long captured = 0, dropped = 0;
+    std::atomic<long> written{0};
+    double mainThreadMs = 0.0; // soma do tempo gasto dentro de capture()
+
+    bool start(const std::string& path, int width, int height);
+    bool start(const std::string& path, CaptureFormat format, int width, int height);
+    void capture();
+    // espera as leituras e a codificacao pendentes e fecha o arquivo
+    void stop();
+    bool recording() const { return active; }
+    int frameWidth() const { return width; }
+    int frameHeight() const { return height; }
+    // uma linha com frames gravados/descartados e o custo medio na thread principal
+    void printStats() const;
+
+private:
+    enum SlotState { SLOT_FREE, SLOT_READING, SLOT_MAPPED };
+    struct Slot {
+        GLuint pbo = 0;
+        GLsync fence = 0;
+        SlotState state = SLOT_FREE;
+        long frame = 0;
+    };
+    struct Job {
+        int slot;
+        const unsigned char* pixels;
+        long frame;
+    };
+
+    bool active = false;
+    CaptureFormat format = CAPTURE_PNG;
+    std::string path;
+    int width = 0, height = 0;
+    Slot slots[MAX_RING];
+    int writeIndex = 0; // proximo slot a receber um glReadPixels (o mais antigo em voo)
+    long frameCounter = 0;
+    FILE* stream = nullptr;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> jobs;
+    bool quit = false;
+    std::atomic<bool> released[MAX_RING];
+
+    void releaseCopiedSlots();
+    void handOffFinished(bool wait);
+    void workerLoop();
+    void writeFrame(const unsigned char* rgba, long frame, std::vector<unsigned char>& scratch);
+};
+
+#endif
@@ -0,0 +1,206 @@
+#include "GLHandles.h"
+
+#include <cstdio>
+#include <iostream>
+
+static GLResourceStats g_stats;
+
+long long GLResourceStats::totalBytes() const {
+    long long total = 0;
+    for (int t = 0; t < GL_RES_TYPE_COUNT; ++t) total += bytes[t];
+    return total;
+}
+
+const GLResourceStats& glResourceStats() {
+    return g_stats;
+}
+
+const char* glResourceName(GLResourceType type) {
+    switch (type) {
+    case GL_RES_BUFFER: return "buffers";
+    case GL_RES_VERTEX_ARRAY: return "VAOs";
+    case GL_RES_TEXTURE: return "texturas";
+    case GL_RES_PROGRAM: return "programas";
+    default: return "?";
+    }
+}
+
+void printGLResources(bool onlyLive) {
+    for (int t = 0; t < GL_RES_TYPE_COUNT; ++t) {
+        if (onlyLive && g_stats.live[t] == 0) continue;
+        printf("  %-10s %6ld vivos %10.1f KB  (%ld criados)\n", glResourceName((GLResourceType)t),
+               g_stats.live[t], g_stats.bytes[t] / 1024.0, g_stats.created[t]);
+    }
+}
+
+bool reportGLLeaks() {
+    bool leaked = false;
+    for (int t = 0; t < GL_RES_TYPE_COUNT; ++t)
+        if (g_stats.live[t] != 0) leaked = true;
+    if (leaked) {
+        std::cerr << "Objetos OpenGL ainda vivos no fim:" << std::endl;
+        printGLResources(true);
+    }
+    return leaked;
+}
+
+template <GLResourceType Type>
+static GLuint genObject() {
+    GLuint id = 0;
+    switch (Type) {
+    case GL_RES_BUFFER: glGenBuffers(1, &id); break;
+    case GL_RES_VERTEX_ARRAY: glGenVertexArrays(1, &id); break;
+    case GL_RES_TEXTURE: glGenTextures(1, &id); break;
+    case GL_RES_PROGRAM: id = glCreateProgram(); break;
+    default: break;
+    }
+    return id;
+}
+
+template <GLResourceType Type>
+static void deleteObject(GLuint id) {
+    switch (Type) {
+    case GL_RES_BUFFER: glDeleteBuffers(1, &id); break;
+    case GL_RES_VERTEX_ARRAY: glDeleteVertexArrays(1, &id); break;
+    case GL_RES_TEXTURE: glDeleteTextures(1, &id); break;
+    case GL_RES_PROGRAM: glDeleteProgram(id); break;
+    default: break;
+    }
+}
+
+template <GLResourceType Type>
+void GLHandle<Type>::create() {
+    reset();
+    id = genObject<Type>();
+    if (id == 0) {
+        std::cout << "Erro ao criar objeto OpenGL (" << glResourceName(Type) << ")" << std::endl;
+        return;
+    }
+    g_stats.live[Type]++;
+    g_stats.created[Type]++;
+}
+
+template <GLResourceType Type>
+void GLHandle<Type>::reset() {
+    if (id == 0) return;
+    deleteObject<Type>(id);
+    g_stats.live[Type]--;
+    g_stats.bytes[Type] -= (long long)size;
+    id = 0;
+    size = 0;
+}
+
+template <GLResourceType Type>
+void GLHandle<Type>::setBytes(size_t bytes) {
+    g_stats.bytes[Type] += (long long)bytes - (long long)size;
+    size = bytes;
+}
+
+template struct GLHandle<GL_RES_BUFFER>;
+template struct GLHandle<GL_RES_VERTEX_ARRAY>;
+template struct GLHandle<GL_RES_TEXTURE>;
+template struct GLHandle<GL_RES_PROGRAM>;
+
+void GLBuffer::data(GLenum target, size_t bytes, const void* data, GLenum usage) {
+    if (id == 0) create();
+    glBindBuffer(target, id);
+    glBufferData(target, (GLsizeiptr)bytes, data, usage);
+    setBytes(bytes);
+}
+
+void GLBuffer::subData(GLenum target, size_t offset, size_t bytes, const void* data) {
+    if (offset + bytes > size) {
+        std::cout << "GLBuffer::subData fora do buffer (" << offset + bytes << " > " << size << " bytes)" << std::endl;
+        return;
+    }
+    glBindBuffer(target, id);
+    glBufferSubData(target, (GLintptr)offset, (GLsizeiptr)bytes, data);
+}
+
+// estimativa: o driver pode alinhar linhas ou guardar RGB como RGBA
+static size_t bytesPerTexel(GLint internalFormat) {
+    switch (internalFormat) {
+    case GL_RED: case GL_R8: return 1;
+    case GL_RG: case GL_RG8: return 2;
+    case GL_RGB: case GL_RGB8: case GL_SRGB8: return 3;
+    case GL_RGBA16F: return 8;
+    case GL_RGBA32F: return 16;
+    case GL_RGB16F: return 6;
+    case GL_RGB32F: return 12;
+    case GL_R32F: case GL_DEPTH24_STENCIL8: case GL_DEPTH_COMPONENT24: return 4;
+    default: return 4;
+    }
+}
+
+void GLTexture::image2D(GLint internalFormat, int width, int height, GLenum format, GLenum type, const void* pixels) {
+    if (id == 0) create();
+    glBindTexture(GL_TEXTURE_2D, id);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, type, pixels);
+    setBytes((size_t)width * height * bytesPerTexel(internalFormat));
+}
+
+void GLTexture::generateMipmap() {
+    if (id == 0) return;
+    glBindTexture(GL_TEXTURE_2D, id);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    setBytes(size + size / 3);
+}
+
+int GLBufferPool::classOf(size_t bytes) const {
+    if (bytes > maxBytes) return -1;
+    int index = 0;
+    size_t classBytes = MIN_BYTES;
+    while (classBytes < bytes) {
+        classBytes <<= 1;
+        index++;
+    }
+    return index;
+}
+
+GLBuffer GLBufferPool::acquire(size_t bytes) {
+    GLBuffer buffer;
+    int index = classOf(bytes);
+    if (index < 0) {
+        misses++;
+        buffer.data(GL_ARRAY_BUFFER, bytes, nullptr, usage);
+        return buffer;
+    }
+    if (index < (int)classes.size() && !classes[index].empty()) {
+        hits++;
+        buffer = std::move(classes[index].back());
+        classes[index].pop_back();
+        glBindBuffer(GL_ARRAY_BUFFER, buffer.get());
+        return buffer;
+    }
+    misses++;
+    buffer.data(GL_ARRAY_BUFFER, MIN_BYTES << index, nullptr, usage);
+    return buffer;
+}
+
+void GLBufferPool::release(GLBuffer&& buffer) {
+    if (!buffer) return;
+    int index = classOf(buffer.bytes());
+    // so volta para a lista se ainda tem o tamanho exato da classe
+    if (index < 0 || (MIN_BYTES << index) != buffer.bytes()) {
+        buffer.reset();
+        return;
+    }
+    if (index >= (int)classes.size()) classes.resize(index + 1);
+    classes[index].push_back(std::move(buffer));
+}
+
+void GLBufferPool::clear() {
+    classes.clear();
+}
+
+size_t GLBufferPool::freeBuffers() const {
+    size_t count = 0;
+    for (const auto& list : classes) count += list.size();
+    return count;
+}
+
+size_t GLBufferPool::freeBytes() const {
+    size_t total = 0;
+    for (size_t i = 0; i < classes.size(); ++i) total += classes[i].size() * (MIN_BYTES << i);
+    return total;
+}
@@ -0,0 +1,119 @@
+#ifndef GL_HANDLES_H
+#define GL_HANDLES_H
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <vector>
+
+// Objetos OpenGL com dono: o destrutor apaga o objeto, so da para mover (nao
+// copiar) e cada criacao/destruicao passa pelo contador de objetos vivos.
+// Como o destrutor chama glDelete*, os handles precisam morrer (ou levar
+// reset()) antes do glfwTerminate; depois dele nao ha contexto para apagar.
+
+enum GLResourceType {
+    GL_RES_BUFFER,
+    GL_RES_VERTEX_ARRAY,
+    GL_RES_TEXTURE,
+    GL_RES_PROGRAM,
+    GL_RES_TYPE_COUNT
+};
+
+// objetos vivos e bytes na GPU por tipo (so o que foi criado pelos handles)
+struct GLResourceStats {
+    long live[GL_RES_TYPE_COUNT] = {};
+    long created[GL_RES_TYPE_COUNT] = {};
+    long long bytes[GL_RES_TYPE_COUNT] = {};
+
+    long long totalBytes() const;
+};
+
+const GLResourceStats& glResourceStats();
+const char* glResourceName(GLResourceType type);
+// imprime uma linha por tipo; com onlyLive so os que ainda tem objetos
+void printGLResources(bool onlyLive = false);
+// chame no fim, depois de soltar tudo: avisa no std::cerr o que ficou vivo
+bool reportGLLeaks();
+
+template <GLResourceType Type>
+struct GLHandle {
+    GLHandle() = default;
+    ~GLHandle() { reset(); }
+    GLHandle(GLHandle&& other) noexcept : id(other.id), size(other.size) {
+        other.id = 0;
+        other.size = 0;
+    }
+    GLHandle& operator=(GLHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            id = other.id;
+            size = other.size;
+            other.id = 0;
+            other.size = 0;
+        }
+        return *this;
+    }
+    GLHandle(const GLHandle&) = delete;
+    GLHandle& operator=(const GLHandle&) = delete;
+
+    // cria o objeto (apagando o anterior, se houver)
+    void create();
+    void reset();
+
+    GLuint get() const { return id; }
+    explicit operator bool() const { return id != 0; }
+    size_t bytes() const { return size; }
+
+protected:
+    GLuint id = 0;
+    size_t size = 0; // bytes contados para este objeto
+
+    void setBytes(size_t bytes);
+};
+
+using GLVertexArray = GLHandle<GL_RES_VERTEX_ARRAY>;
+using GLProgram = GLHandle<GL_RES_PROGRAM>;
+
+struct GLBuffer : GLHandle<GL_RES_BUFFER> {
+    // glBufferData com o tamanho registrado no contador (deixa o buffer ligado em target)
+    void data(GLenum target, size_t bytes, const void* data, GLenum usage);
+    void subData(GLenum target, size_t offset, size_t bytes, const void* data);
+};
+
+struct GLTexture : GLHandle<GL_RES_TEXTURE> {
+    // glTexImage2D com o tamanho estimado pelo formato (RGBA8 = 4 bytes por texel...)
+    void image2D(GLint internalFormat, int width, int height, GLenum format, GLenum type, const void* pixels);
+    // glGenerateMipmap: os niveis menores somam mais 1/3
+    void generateMipmap();
+};
+
+// Reaproveita buffers pequenos em vez de criar e apagar a cada uso.
+// Os tamanhos sao arredondados para potencias de 2 (de 64 B a maxBytes) e cada
+// classe tem uma lista de buffers livres que mantem o armazenamento na GPU;
+// acquire() devolve um buffer da classe, release() devolve para a lista.
+// Buffers maiores que maxBytes nao entram no pool (acquire cria, release apaga).
+struct GLBufferPool {
+    static const size_t MIN_BYTES = 64;
+    size_t maxBytes = 64 * 1024;
+    GLenum usage = GL_DYNAMIC_DRAW;
+
+    // estatisticas desde o inicio
+    long hits = 0, misses = 0;
+
+    ~GLBufferPool() { clear(); }
+
+    // buffer com pelo menos bytes de capacidade (conteudo indefinido), ligado em GL_ARRAY_BUFFER
+    GLBuffer acquire(size_t bytes);
+    void release(GLBuffer&& buffer);
+    // apaga os buffers livres (chame antes do glfwTerminate)
+    void clear();
+
+    size_t freeBuffers() const;
+    size_t freeBytes() const;
+
+private:
+    std::vector<std::vector<GLBuffer>> classes;
+    int classOf(size_t bytes) const;
+};
+
+#endif
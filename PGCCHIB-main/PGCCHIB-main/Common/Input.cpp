@@ -0,0 +1,244 @@
+#include "Input.h"
+
+#include <iostream>
+#include <cstring>
+
+static const char INPUT_MAGIC[4] = { 'P', 'G', 'I', 'N' };
+static const uint32_t INPUT_VERSION = 1;
+
+void Input::install(GLFWwindow* window) {
+    glfwSetWindowUserPointer(window, this);
+    previousKey = glfwSetKeyCallback(window, keyCallback);
+    previousMouseButton = glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    previousCursor = glfwSetCursorPosCallback(window, cursorCallback);
+
+    double x, y;
+    glfwGetCursorPos(window, &x, &y);
+    callbackCursorX = cursorX = (float)x;
+    callbackCursorY = cursorY = (float)y;
+    frameStart = glfwGetTime();
+}
+
+void Input::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    Input* input = (Input*)glfwGetWindowUserPointer(window);
+    if (input) {
+        InputEvent e = { glfwGetTime(), INPUT_KEY, (uint8_t)action, (int16_t)key, input->callbackCursorX, input->callbackCursorY };
+        input->push(e);
+        if (input->previousKey) input->previousKey(window, key, scancode, action, mods);
+    }
+}
+
+void Input::mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
+    Input* input = (Input*)glfwGetWindowUserPointer(window);
+    if (input) {
+        InputEvent e = { glfwGetTime(), INPUT_MOUSE_BUTTON, (uint8_t)action, (int16_t)button, input->callbackCursorX, input->callbackCursorY };
+        input->push(e);
+        if (input->previousMouseButton) input->previousMouseButton(window, button, action, mods);
+    }
+}
+
+void Input::cursorCallback(GLFWwindow* window, double x, double y) {
+    Input* input = (Input*)glfwGetWindowUserPointer(window);
+    if (input) {
+        input->callbackCursorX = (float)x;
+        input->callbackCursorY = (float)y;
+        InputEvent e = { glfwGetTime(), INPUT_CURSOR, 0, 0, (float)x, (float)y };
+        input->push(e);
+        if (input->previousCursor) input->previousCursor(window, x, y);
+    }
+}
+
+void Input::push(const InputEvent& e) {
+    if (!queue.push(e))
+        dropped++;
+}
+
+void Input::bindKey(int key, int action) {
+    if (action < 0 || action >= INPUT_MAX_ACTIONS) return;
+    bindings.push_back({ INPUT_KEY, key, action });
+}
+
+void Input::bindMouseButton(int button, int action) {
+    if (action < 0 || action >= INPUT_MAX_ACTIONS) return;
+    bindings.push_back({ INPUT_MOUSE_BUTTON, button, action });
+}
+
+void Input::apply(const InputEvent& e) {
+    frameEvents.push_back(e);
+
+    if (e.type == INPUT_CURSOR) {
+        cursorX = e.x;
+        cursorY = e.y;
+        return;
+    }
+    if (e.action == GLFW_REPEAT) return;
+
+    for (const Binding& b : bindings) {
+        if (b.type != e.type || b.code != e.code) continue;
+
+        uint32_t bit = 1u << b.action;
+        if (e.action == GLFW_PRESS) {
+            // varias teclas na mesma acao: so solta quando a ultima for solta
+            if (downCount[b.action]++ == 0) {
+                heldMask |= bit;
+                pressedMask |= bit;
+            }
+            if (e.type == INPUT_MOUSE_BUTTON)
+                frameClicks.push_back({ b.action, e.x, e.y });
+        } else if (e.action == GLFW_RELEASE && downCount[b.action] > 0) {
+            if (--downCount[b.action] == 0) {
+                heldMask &= ~bit;
+                releasedMask |= bit;
+            }
+        }
+    }
+}
+
+float Input::beginFrame(float deltaTime) {
+    pressedMask = releasedMask = 0;
+    frameEvents.clear();
+    frameClicks.clear();
+
+    InputEvent e;
+    if (replayMode) {
+        // no replay o que vale eh o arquivo; o que chegar do GLFW eh descartado
+        while (queue.pop(e)) {}
+        float recorded;
+        if (readFrame(recorded))
+            return recorded;
+        replayDone = true;
+        return deltaTime;
+    }
+
+    while (queue.pop(e))
+        apply(e);
+
+    if (recordFile)
+        writeFrame(deltaTime);
+    frameStart = glfwGetTime();
+    return deltaTime;
+}
+
+bool Input::startRecording(const std::string& path) {
+    close();
+    recordFile = fopen(path.c_str(), "wb");
+    if (!recordFile) {
+        std::cerr << "Input: nao foi possivel criar " << path << std::endl;
+        return false;
+    }
+    fwrite(INPUT_MAGIC, 1, 4, recordFile);
+    fwrite(&INPUT_VERSION, sizeof(INPUT_VERSION), 1, recordFile);
+    return true;
+}
+
+template <typename T>
+static void appendValue(std::vector<unsigned char>& out, T value) {
+    size_t at = out.size();
+    out.resize(at + sizeof(T));
+    memcpy(&out[at], &value, sizeof(T));
+}
+
+void Input::writeFrame(float deltaTime) {
+    // do cursor so interessa onde ele terminou o frame (cliques ja levam a posicao)
+    int lastCursor = -1;
+    for (size_t i = 0; i < frameEvents.size(); ++i)
+        if (frameEvents[i].type == INPUT_CURSOR) lastCursor = (int)i;
+
+    recordBuffer.clear();
+    appendValue(recordBuffer, deltaTime);
+    appendValue(recordBuffer, (uint16_t)0); // contagem, preenchida abaixo
+
+    uint16_t count = 0;
+    for (size_t i = 0; i < frameEvents.size() && count < 0xFFFF; ++i) {
+        const InputEvent& e = frameEvents[i];
+        if (e.type == INPUT_CURSOR && (int)i != lastCursor) continue;
+
+        appendValue(recordBuffer, e.type);
+        appendValue(recordBuffer, e.action);
+        appendValue(recordBuffer, e.code);
+        appendValue(recordBuffer, (float)(e.time - frameStart));
+        if (e.type != INPUT_KEY) {
+            appendValue(recordBuffer, e.x);
+            appendValue(recordBuffer, e.y);
+        }
+        count++;
+    }
+    memcpy(&recordBuffer[sizeof(float)], &count, sizeof(count));
+    fwrite(recordBuffer.data(), 1, recordBuffer.size(), recordFile);
+}
+
+bool Input::startReplay(const std::string& path) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        std::cerr << "Input: nao foi possivel abrir " << path << std::endl;
+        return false;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    replayData.resize(size > 0 ? (size_t)size : 0);
+    size_t got = replayData.empty() ? 0 : fread(replayData.data(), 1, replayData.size(), f);
+    fclose(f);
+
+    uint32_t version = 0;
+    if (got < 8 || memcmp(replayData.data(), INPUT_MAGIC, 4) != 0 ||
+        (memcpy(&version, &replayData[4], 4), version != INPUT_VERSION)) {
+        std::cerr << "Input: " << path << " nao eh uma gravacao de input valida" << std::endl;
+        replayData.clear();
+        return false;
+    }
+
+    replayMode = true;
+    replayDone = false;
+    replayPos = 8;
+    replayClock = 0.0;
+    return true;
+}
+
+template <typename T>
+static bool readValue(const std::vector<unsigned char>& data, size_t& pos, T& value) {
+    if (pos + sizeof(T) > data.size()) return false;
+    memcpy(&value, &data[pos], sizeof(T));
+    pos += sizeof(T);
+    return true;
+}
+
+bool Input::readFrame(float& deltaTime) {
+    size_t pos = replayPos;
+    uint16_t count;
+    if (!readValue(replayData, pos, deltaTime) || !readValue(replayData, pos, count)) {
+        replayPos = replayData.size();
+        return false;
+    }
+
+    for (uint16_t i = 0; i < count; ++i) {
+        InputEvent e = {};
+        float offset;
+        if (!readValue(replayData, pos, e.type) || !readValue(replayData, pos, e.action) ||
+            !readValue(replayData, pos, e.code) || !readValue(replayData, pos, offset)) {
+            replayPos = replayData.size();
+            return false;
+        }
+        if (e.type != INPUT_KEY && (!readValue(replayData, pos, e.x) || !readValue(replayData, pos, e.y))) {
+            replayPos = replayData.size();
+            return false;
+        }
+        if (e.type == INPUT_KEY) {
+            e.x = cursorX;
+            e.y = cursorY;
+        }
+        e.time = replayClock + offset;
+        apply(e);
+    }
+
+    replayClock += deltaTime;
+    replayPos = pos;
+    return true;
+}
+
+void Input::close() {
+    if (recordFile) {
+        fclose(recordFile);
+        recordFile = nullptr;
+    }
+}
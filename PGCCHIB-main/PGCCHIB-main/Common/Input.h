@@ -0,0 +1,126 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <GLFW/glfw3.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "SpscRing.h"
+
+enum InputEventType : uint8_t {
+    INPUT_KEY = 0,
+    INPUT_MOUSE_BUTTON,
+    INPUT_CURSOR
+};
+
+// Evento bruto vindo dos callbacks do GLFW
+struct InputEvent {
+    double time;     // glfwGetTime() no momento do callback
+    uint8_t type;    // InputEventType
+    uint8_t action;  // GLFW_PRESS, GLFW_RELEASE ou GLFW_REPEAT
+    int16_t code;    // tecla ou botao do mouse
+    float x, y;      // posicao do cursor em pixels da janela (y para baixo)
+};
+
+// clique em um botao mapeado para uma acao, com a posicao do cursor naquela hora
+struct InputClick {
+    int action;
+    float x, y;
+};
+
+// numero maximo de acoes (cada acao eh um bit das mascaras de estado)
+const int INPUT_MAX_ACTIONS = 32;
+
+// Sistema de input orientado a eventos.
+// Os callbacks do GLFW so empurram eventos com timestamp em uma fila sem lock;
+// uma vez por frame beginFrame() consome a fila e traduz teclas e botoes em acoes
+// do jogo (held / pressed / released), em vez de varios glfwGetKey por frame.
+//
+// Gravacao: cada frame vira um registro binario com o dt do frame e os eventos
+// consumidos nele. Replay: beginFrame() ignora o GLFW e devolve o dt e os eventos
+// gravados, entao a simulacao passa exatamente pelos mesmos estados, inclusive
+// sem janela visivel e em qualquer velocidade (util para benchmark e regressao).
+// Formato: "PGIN", versao (uint32) e depois, por frame: dt (float), numero de
+// eventos (uint16) e os eventos (tipo, acao, codigo, offset de tempo no frame em
+// float e, para mouse e cursor, x e y em float). Little-endian.
+struct Input {
+    float cursorX = 0.0f, cursorY = 0.0f;
+
+    // instala os callbacks de teclado, mouse e cursor. Callbacks que o programa ja
+    // tinha registrado continuam sendo chamados.
+    void install(GLFWwindow* window);
+
+    void bindKey(int key, int action);
+    void bindMouseButton(int button, int action);
+
+    bool startRecording(const std::string& path);
+    bool startReplay(const std::string& path);
+    bool replaying() const { return replayMode; }
+    // true depois que beginFrame() nao encontrou mais frames gravados
+    bool replayFinished() const { return replayDone; }
+
+    // consome os eventos do frame e atualiza as acoes. Recebe o dt medido pelo
+    // relogio e retorna o dt que a simulacao deve usar (o gravado, no replay)
+    float beginFrame(float deltaTime);
+
+    bool held(int action) const { return (heldMask >> action) & 1u; }
+    bool pressed(int action) const { return (pressedMask >> action) & 1u; }
+    bool released(int action) const { return (releasedMask >> action) & 1u; }
+
+    const std::vector<InputClick>& clicks() const { return frameClicks; }
+    const std::vector<InputEvent>& events() const { return frameEvents; }
+
+    // eventos perdidos porque a fila encheu entre dois frames
+    size_t droppedEvents() const { return dropped; }
+
+    // fecha o arquivo de gravacao (tambem chamado pelo destrutor)
+    void close();
+    ~Input() { close(); }
+
+private:
+    static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void cursorCallback(GLFWwindow* window, double x, double y);
+    void push(const InputEvent& e);
+
+    struct Binding {
+        uint8_t type;
+        int code;
+        int action;
+    };
+
+    SpscRing<InputEvent, 1024> queue;
+    std::atomic<size_t> dropped{0};
+
+    // callbacks que o programa tinha antes do install
+    GLFWkeyfun previousKey = nullptr;
+    GLFWmousebuttonfun previousMouseButton = nullptr;
+    GLFWcursorposfun previousCursor = nullptr;
+    float callbackCursorX = 0.0f, callbackCursorY = 0.0f; // so usado na thread dos callbacks
+
+    std::vector<Binding> bindings;
+    uint32_t heldMask = 0, pressedMask = 0, releasedMask = 0;
+    int downCount[INPUT_MAX_ACTIONS] = {};
+
+    std::vector<InputEvent> frameEvents;
+    std::vector<InputClick> frameClicks;
+    double frameStart = 0.0;
+
+    FILE* recordFile = nullptr;
+    std::vector<unsigned char> recordBuffer;
+
+    bool replayMode = false;
+    std::vector<unsigned char> replayData;
+    size_t replayPos = 0;
+    bool replayDone = false;
+    double replayClock = 0.0;
+
+    void apply(const InputEvent& e);
+    void writeFrame(float deltaTime);
+    bool readFrame(float& deltaTime);
+};
+
+#endif
@@ -0,0 +1,414 @@
+#include "IsoRenderer.h"
+
+#include <iostream>
+#include <cmath>
+#include <cstddef>
+
+#include <glm/gtc/type_ptr.hpp>
+
+// o ponto do mesh (no retangulo do frame) vira canto do quad e coordenada de
+// textura; o resto vem dos atributos por instancia
+static const char* isoVertexSource = R"(
+layout (location = 0) in vec4 rect;
+layout (location = 1) in vec4 uvRect;
+layout (location = 2) in float depth;
+layout (location = 3) in vec2 meshPoint;
+
+uniform mat4 viewProjection;
+
+// mesma posicao nos dois programas, senao o GL_EQUAL depois do prepass falha
+invariant gl_Position;
+out vec2 TexCoord;
+flat out float FlipX;
+
+void main()
+{
+    // o ponto eh do frame na textura; espelhado, o x da tela eh o contrario
+    vec2 t = meshPoint;
+    if (uvRect.z < 0.0)
+        t.x = 1.0 - t.x;
+    // (0, 0) -> (-1, 1) e (1, 1) -> (1, -1), igual aos quads do tilemap
+    vec2 corner = vec2(t.x * 2.0 - 1.0, 1.0 - t.y * 2.0);
+    vec4 p = viewProjection * vec4(rect.xy + corner * rect.zw, 0.0, 1.0);
+    gl_Position = vec4(p.xy, depth * p.w, p.w);
+
+    TexCoord = uvRect.xy + t * uvRect.zw;
+    // du negativo espelha o sprite, e o x da normal junto
+    FlipX = uvRect.z < 0.0 ? -1.0 : 1.0;
+}
+)";
+
+// CUTOUT definido: descarta alfa < 0.5 (recorte e prepass)
+static const char* isoFragmentSource = R"(
+in vec2 TexCoord;
+flat in float FlipX;
+layout (location = 0) out vec4 FragColor;
+// normal para o Lighting2D; sem normal map a textura 0 devolve z = 0 (normal reta).
+// Sem o Lighting2D nao ha alvo na location 1 e a saida eh ignorada
+layout (location = 1) out vec4 NormalColor;
+
+uniform sampler2D tileTexture;
+uniform sampler2D normalMap;
+
+void main()
+{
+    vec4 c = texture(tileTexture, TexCoord);
+#ifdef CUTOUT
+    // recorte: sem isso o pixel transparente escreveria profundidade
+    if (c.a < 0.5)
+        discard;
+#endif
+    FragColor = c;
+
+    // com normal map a normal substitui a de tras (alfa 1, mesmo na borda
+    // misturada do recorte); sem, alfa 0 deixa a de tras
+    vec4 n = texture(normalMap, TexCoord);
+    NormalColor = n.z > 0.0 ? vec4((n.x - 0.5) * FlipX + 0.5, n.yz, 1.0) : vec4(0.0);
+}
+)";
+
+// header vai antes do codigo: o #version e os #define da variante
+static GLuint compileIsoShader(GLenum type, const char* header, const char* source) {
+    GLuint shader = glCreateShader(type);
+    const char* sources[] = { header, source };
+    glShaderSource(shader, 2, sources, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cerr << "Erro ao compilar shader isometrico: " << infoLog << std::endl;
+    }
+    return shader;
+}
+
+uint32_t isoKey(int layer, float rowPlusCol, int height) {
+    long d = std::lround(rowPlusCol * 16.0f);
+    if (d < 0) d = 0;
+    if (d > 0xFFFFF) d = 0xFFFFF;
+    uint32_t diagonal = 0xFFFFFu - (uint32_t)d;
+
+    uint32_t l = (uint32_t)(layer < 0 ? 0 : (layer > 15 ? 15 : layer));
+    uint32_t h = (uint32_t)(height < 0 ? 0 : (height > 255 ? 255 : height));
+    return (l << 28) | (diagonal << 8) | h;
+}
+
+void radixSortByKey(std::vector<uint64_t>& items, std::vector<uint64_t>& scratch) {
+    size_t n = items.size();
+    if (n < 2) return;
+    scratch.resize(n);
+
+    // os 4 histogramas saem de uma unica leitura dos dados
+    size_t histogram[4][256] = {};
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t key = (uint32_t)(items[i] >> 32);
+        histogram[0][key & 0xFF]++;
+        histogram[1][(key >> 8) & 0xFF]++;
+        histogram[2][(key >> 16) & 0xFF]++;
+        histogram[3][key >> 24]++;
+    }
+
+    uint64_t* src = items.data();
+    uint64_t* dst = scratch.data();
+    for (int pass = 0; pass < 4; ++pass) {
+        int shift = 32 + pass * 8;
+        size_t* h = histogram[pass];
+
+        // todas as chaves com o mesmo byte: a passada nao mudaria nada
+        if (h[(src[0] >> shift) & 0xFF] == n)
+            continue;
+
+        size_t offset[256];
+        size_t sum = 0;
+        for (int b = 0; b < 256; ++b) {
+            offset[b] = sum;
+            sum += h[b];
+        }
+        for (size_t i = 0; i < n; ++i)
+            dst[offset[(src[i] >> shift) & 0xFF]++] = src[i];
+
+        uint64_t* tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != items.data())
+        items.swap(scratch);
+}
+
+static GLuint linkIsoProgram(const char* fragmentHeader) {
+    GLuint vertexShader = compileIsoShader(GL_VERTEX_SHADER, "#version 330 core\n", isoVertexSource);
+    GLuint fragmentShader = compileIsoShader(GL_FRAGMENT_SHADER, fragmentHeader, isoFragmentSource);
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Erro ao linkar shader isometrico: " << infoLog << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "tileTexture"), 0);
+    glUniform1i(glGetUniformLocation(program, "normalMap"), 1);
+    return program;
+}
+
+bool IsoRenderer::init() {
+    program = linkIsoProgram("#version 330 core\n#define CUTOUT\n");
+    opaqueProgram = linkIsoProgram("#version 330 core\n");
+    if (!program || !opaqueProgram)
+        return false;
+    viewProjectionLoc = glGetUniformLocation(program, "viewProjection");
+    opaqueViewProjectionLoc = glGetUniformLocation(opaqueProgram, "viewProjection");
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &instanceVBO);
+    glGenBuffers(1, &meshVBO);
+    glGenBuffers(1, &meshEBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    for (int i = 0; i < 3; ++i) {
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void*)0);
+    glEnableVertexAttribArray(3);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshEBO);
+    glBindVertexArray(0);
+
+    // mesh 0: o quad inteiro
+    SpriteMesh quad;
+    quad.quad();
+    addMesh(quad);
+
+    return true;
+}
+
+int IsoRenderer::addTexture(GLuint texture, GLuint normalMap) {
+    textures.push_back(texture);
+    normalMaps.push_back(normalMap);
+    return (int)textures.size() - 1;
+}
+
+int IsoRenderer::addMesh(const SpriteMesh& mesh) {
+    // indices absolutos no buffer de todos os meshes (sem base vertex no GL 3.3)
+    MeshRange range = { meshIndices.size(), (GLsizei)mesh.indices.size(), mesh.coverage, mesh.alpha };
+    uint32_t base = (uint32_t)meshPoints.size();
+    meshPoints.insert(meshPoints.end(), mesh.points.begin(), mesh.points.end());
+    for (uint32_t i : mesh.indices)
+        meshIndices.push_back(base + i);
+    meshes.push_back(range);
+    meshesDirty = true;
+    return (int)meshes.size() - 1;
+}
+
+void IsoRenderer::draw(const glm::mat4& viewProjection) {
+    size_t n = items.size();
+    lastItemCount = (int)n;
+    lastDrawCalls = 0;
+    lastShadedArea = lastQuadArea = 0.0;
+    if (n == 0) return;
+
+    // 1) ordena de tras para frente pela chave, o indice vai junto nos 32 bits baixos
+    order.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        order[i] = ((uint64_t)items[i].key << 32) | (uint64_t)i;
+    radixSortByKey(order, scratch);
+
+    // 2) conta quantos itens usam cada par textura e mesh (counting sort pelo
+    // grupo); os translucidos ficam fora, no fim, na ordem da chave
+    int textureCount = (int)textures.size();
+    int meshCount = (int)meshes.size();
+    int groupCount = textureCount * meshCount;
+    groupStart.assign(groupCount + 1, 0);
+    lastAlphaCount[0] = lastAlphaCount[1] = lastAlphaCount[2] = 0;
+    int translucentCount = 0;
+    for (size_t i = 0; i < n; ++i) {
+        int g = groupOf(items[i]);
+        if (g < 0)
+            continue;
+        SpriteAlpha alpha = alphaOf(items[i]);
+        lastAlphaCount[alpha]++;
+        if (alpha == SPRITE_TRANSLUCENT)
+            translucentCount++;
+        else
+            groupStart[g + 1]++;
+    }
+    for (int g = 0; g < groupCount; ++g)
+        groupStart[g + 1] += groupStart[g];
+    groupFill.assign(groupStart.begin(), groupStart.end() - 1);
+
+    // 3) profundidade pela posicao na ordem (o primeiro fica mais longe) e
+    // preenche cada grupo da frente para tras; os translucidos de tras para frente
+    size_t firstTranslucent = (size_t)groupStart[groupCount];
+    instances.resize(firstTranslucent + translucentCount);
+    translucentGroups.resize(translucentCount);
+    size_t translucentFill = instances.size();
+    double depthStep = 2.0 / (double)(n + 1);
+    for (size_t r = n; r-- > 0;) {
+        const IsoItem& it = items[(uint32_t)order[r]];
+        int g = groupOf(it);
+        if (g < 0)
+            continue;
+
+        double area = 4.0 * it.halfW * it.halfH;
+        lastQuadArea += area;
+        lastShadedArea += area * meshes[g % meshCount].coverage;
+
+        size_t slot;
+        if (alphaOf(it) == SPRITE_TRANSLUCENT) {
+            slot = --translucentFill;
+            translucentGroups[slot - firstTranslucent] = g;
+        } else {
+            slot = groupFill[g]++;
+        }
+        Instance& inst = instances[slot];
+        inst.rect[0] = it.x;
+        inst.rect[1] = it.y;
+        inst.rect[2] = it.halfW;
+        inst.rect[3] = it.halfH;
+        inst.uv[0] = it.u;
+        inst.uv[1] = it.v;
+        inst.uv[2] = it.du;
+        inst.uv[3] = it.dv;
+        inst.depth = (float)(1.0 - (double)(r + 1) * depthStep);
+    }
+    if (instances.empty()) return;
+
+    // 4) envia os meshes novos e as instancias (orfana o buffer antigo para
+    // nao esperar a GPU)
+    if (meshesDirty) {
+        glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+        glBufferData(GL_ARRAY_BUFFER, meshPoints.size() * sizeof(glm::vec2), meshPoints.data(), GL_STATIC_DRAW);
+        glBindVertexArray(VAO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, meshIndices.size() * sizeof(uint32_t), meshIndices.data(), GL_STATIC_DRAW);
+        glBindVertexArray(0);
+        meshesDirty = false;
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    size_t bytes = instances.size() * sizeof(Instance);
+    if (instances.size() > instanceCapacity)
+        instanceCapacity = instances.size() * 2;
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(Instance), NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, instances.data());
+
+    GLboolean blend = glIsEnabled(GL_BLEND);
+    glDisable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+
+    glUseProgram(opaqueProgram);
+    glUniformMatrix4fv(opaqueViewProjectionLoc, 1, GL_FALSE, glm::value_ptr(viewProjection));
+    glUseProgram(program);
+    glUniformMatrix4fv(viewProjectionLoc, 1, GL_FALSE, glm::value_ptr(viewProjection));
+    glBindVertexArray(VAO);
+
+    // 5) opacos da frente para tras, sem discard
+    glUseProgram(opaqueProgram);
+    for (int g = 0; g < groupCount; ++g)
+        if (meshes[g % meshCount].alpha == SPRITE_OPAQUE)
+            drawGroup(g, groupStart[g], groupStart[g + 1] - groupStart[g]);
+
+    // 6) recortados: prepass de profundidade e cor so onde a profundidade bate,
+    // ou direto com discard. A cor vai com o blending de quem chamou: com
+    // filtro linear a borda do recorte tem alfa entre 0.5 e 1 (o texel eh 0 ou
+    // 255 so no nivel base) e precisa misturar com o que ja esta atras; com
+    // GL_EQUAL cada pixel continua sombreado uma vez so
+    bool cutouts = lastAlphaCount[SPRITE_CUTOUT] > 0;
+    if (cutouts && depthPrepass) {
+        glUseProgram(program);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        for (int g = 0; g < groupCount; ++g)
+            if (meshes[g % meshCount].alpha == SPRITE_CUTOUT)
+                drawGroup(g, groupStart[g], groupStart[g + 1] - groupStart[g]);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthFunc(GL_EQUAL);
+        glDepthMask(GL_FALSE);
+        glUseProgram(opaqueProgram);
+    } else {
+        glUseProgram(program);
+    }
+    if (cutouts) {
+        if (blend) glEnable(GL_BLEND);
+        for (int g = 0; g < groupCount; ++g)
+            if (meshes[g % meshCount].alpha == SPRITE_CUTOUT)
+                drawGroup(g, groupStart[g], groupStart[g + 1] - groupStart[g]);
+    }
+
+    // 7) translucidos de tras para frente com blending; itens seguidos do mesmo
+    // grupo saem num draw so
+    if (translucentCount > 0) {
+        glUseProgram(opaqueProgram);
+        glEnable(GL_BLEND);
+        glDepthFunc(GL_LESS);
+        glDepthMask(GL_FALSE);
+        for (int i = 0; i < translucentCount;) {
+            int g = translucentGroups[i];
+            int j = i + 1;
+            while (j < translucentCount && translucentGroups[j] == g)
+                j++;
+            drawGroup(g, firstTranslucent + i, j - i);
+            i = j;
+        }
+    }
+
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    if (blend) glEnable(GL_BLEND);
+    else glDisable(GL_BLEND);
+    glBindVertexArray(0);
+}
+
+// um draw instanciado; sem base instance no GL 3.3, entao os ponteiros dos
+// atributos apontam para a primeira instancia
+void IsoRenderer::drawGroup(int g, size_t firstInstance, int count) {
+    int meshCount = (int)meshes.size();
+    const MeshRange& mesh = meshes[g % meshCount];
+    if (count == 0 || mesh.indexCount == 0) return;
+    int t = g / meshCount;
+
+    size_t base = firstInstance * sizeof(Instance);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(base + offsetof(Instance, rect)));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(base + offsetof(Instance, uv)));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(base + offsetof(Instance, depth)));
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, normalMaps[t]);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, textures[t]);
+    glDrawElementsInstanced(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT,
+                            (void*)(mesh.firstIndex * sizeof(uint32_t)), count);
+    lastDrawCalls++;
+}
+
+void IsoRenderer::destroy() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &instanceVBO);
+    glDeleteBuffers(1, &meshVBO);
+    glDeleteBuffers(1, &meshEBO);
+    glDeleteProgram(program);
+    glDeleteProgram(opaqueProgram);
+    VAO = instanceVBO = meshVBO = meshEBO = program = opaqueProgram = 0;
+    instanceCapacity = 0;
+    textures.clear();
+    normalMaps.clear();
+    items.clear();
+    meshes.clear();
+    meshPoints.clear();
+    meshIndices.clear();
+}
@@ -0,0 +1,141 @@
+#ifndef ISO_RENDERER_H
+#define ISO_RENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "SpriteMesh.h"
+
+// Chave de profundidade de 32 bits para cenas isometricas (ordem crescente = de tras para frente):
+//   bits 28-31: camada  (0 = chao plano, sempre atras; 1 = objetos, tiles altos e personagens)
+//   bits  8-27: diagonal row + col em ponto fixo 16.4 (invertida: maior row + col = mais ao fundo)
+//   bits  0-7 : altura  (blocos empilhados na mesma celula, o de cima depois)
+// rowPlusCol pode ser fracionario (personagens entre tiles usam a posicao dos pes).
+// A diagonal vai ate 65535: mapas de ate 32768 x 32768.
+uint32_t isoKey(int layer, float rowPlusCol, int height = 0);
+
+// Ordena pares (chave << 32 | indice) pela chave (32 bits altos) com radix sort LSD
+// de 8 bits por passada. Estavel e O(n); passadas em que todas as chaves tem o mesmo
+// byte sao puladas. scratch eh reaproveitado entre chamadas para nao alocar por frame.
+void radixSortByKey(std::vector<uint64_t>& items, std::vector<uint64_t>& scratch);
+
+// Um quad na cena: centro e meia largura/altura no mundo e o recorte na textura
+// (du negativo espelha na horizontal).
+struct IsoItem {
+    float x, y;
+    float halfW, halfH;
+    float u, v, du, dv;
+    int texture;   // indice retornado por IsoRenderer::addTexture
+    uint32_t key;  // isoKey(...)
+    int mesh = 0;  // indice retornado por IsoRenderer::addMesh (0 = quad inteiro)
+};
+
+// Renderer isometrico com ordenacao por chave e teste de profundidade.
+// A cada frame os itens visiveis sao ordenados pela chave (radix sort) e cada um
+// recebe uma profundidade pela posicao na ordem. Com o depth test ligado a ordem
+// dos draws sem blending nao importa mais, entao esses itens sao agrupados por
+// textura (um draw instanciado por textura) e enviados da frente para tras,
+// aproveitando o early-z.
+// Cada item pode usar um SpriteMesh (poligono justo do frame) no lugar do quad:
+// os pixels transparentes em volta do boneco nem chegam ao fragment shader. Os
+// grupos passam a ser por textura e mesh (um draw por par usado no frame).
+// O alfa do mesh (SpriteMesh::alpha, classificado quando a folha eh tracada)
+// escolhe a passada:
+//   opaco       - shader sem discard, da frente para tras: o early-z descarta o
+//                 que fica atras antes do fragment shader
+//   recorte     - com depthPrepass, primeiro so a profundidade (com discard e
+//                 sem cor) e depois a cor com GL_EQUAL e o shader sem discard,
+//                 entao cada pixel eh pintado uma vez so; sem prepass, o
+//                 discard com alfa < 0.5 de antes. A cor vai com o blending
+//                 de quem chamou (a borda filtrada tem alfa entre 0.5 e 1)
+//   translucido - por ultimo, de tras para frente pela chave, com blending e
+//                 sem escrever profundidade (o que ja foi pintado na frente
+//                 esconde pelo depth test)
+// Meshes sem classificacao (o quad) contam como recorte. O estado de blending
+// eh ligado e desligado aqui e volta como estava no fim do draw.
+struct IsoRenderer {
+    GLuint program = 0;       // com discard (recorte e prepass)
+    GLuint opaqueProgram = 0; // sem discard
+    GLuint VAO = 0, instanceVBO = 0;
+    GLuint meshVBO = 0, meshEBO = 0;
+    GLint viewProjectionLoc = -1, opaqueViewProjectionLoc = -1;
+    size_t instanceCapacity = 0;
+
+    std::vector<GLuint> textures;
+    std::vector<GLuint> normalMaps; // 0 = sem normal map
+    std::vector<IsoItem> items;
+
+    // false desenha tudo com o quad inteiro (para comparar)
+    bool useMeshes = true;
+    // false desenha os recortados direto com discard, numa passada so
+    bool depthPrepass = true;
+
+    // estatisticas do ultimo frame
+    int lastDrawCalls = 0;
+    int lastItemCount = 0;
+    int lastAlphaCount[3] = {}; // itens por SpriteAlpha
+    double lastShadedArea = 0.0; // area (no mundo) coberta pelos triangulos
+    double lastQuadArea = 0.0;   // a mesma area se todos fossem quads
+
+    bool init();
+    // normalMap (opcional) eh usado so quando a cena eh desenhada dentro do Lighting2D
+    int addTexture(GLuint texture, GLuint normalMap = 0);
+    // guarda o mesh (pontos no retangulo do frame, ver SpriteMesh.h) e devolve o
+    // indice para IsoItem::mesh. Meshes de uma folha adicionados em sequencia
+    // ficam com indices seguidos (frame transparente vira mesh vazio, nao desenha)
+    int addMesh(const SpriteMesh& mesh);
+
+    void clear() { items.clear(); }
+    void add(const IsoItem& item) { items.push_back(item); }
+
+    // ordena, agrupa e desenha tudo o que foi adicionado desde o clear().
+    // Liga o GL_DEPTH_TEST; o framebuffer precisa de depth buffer e o chamador
+    // limpa GL_DEPTH_BUFFER_BIT junto com a cor.
+    void draw(const glm::mat4& viewProjection);
+
+    void destroy();
+
+private:
+    // dados por instancia enviados para a GPU
+    struct Instance {
+        float rect[4];  // x, y, halfW, halfH
+        float uv[4];    // u, v, du, dv
+        float depth;
+    };
+
+    // trecho do meshEBO de cada mesh
+    struct MeshRange {
+        size_t firstIndex;
+        GLsizei indexCount;
+        float coverage;
+        SpriteAlpha alpha;
+    };
+
+    std::vector<uint64_t> order, scratch;
+    std::vector<int> groupStart, groupFill;
+    std::vector<int> translucentGroups; // grupo de cada instancia translucida, na ordem
+    std::vector<Instance> instances;
+
+    std::vector<MeshRange> meshes;
+    std::vector<glm::vec2> meshPoints;
+    std::vector<uint32_t> meshIndices;
+    bool meshesDirty = false;
+
+    // grupo (textura, mesh) do item; -1 se a textura nao existe
+    int groupOf(const IsoItem& item) const {
+        if (item.texture < 0 || item.texture >= (int)textures.size())
+            return -1;
+        int mesh = useMeshes && item.mesh > 0 && item.mesh < (int)meshes.size() ? item.mesh : 0;
+        return item.texture * (int)meshes.size() + mesh;
+    }
+    // a classe vem do mesh do item mesmo com useMeshes desligado
+    SpriteAlpha alphaOf(const IsoItem& item) const {
+        return item.mesh > 0 && item.mesh < (int)meshes.size() ? meshes[item.mesh].alpha : SPRITE_CUTOUT;
+    }
+    void drawGroup(int g, size_t firstInstance, int count);
+};
+
+#endif
@@ -0,0 +1,293 @@
+#include "LayerCache.h"
+
+#include <iostream>
+#include <cmath>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+static const char* cacheVertexSource = R"(
+#version 330 core
+void main()
+{
+    vec2 p = vec2((gl_VertexID & 1) != 0 ? 3.0 : -1.0, (gl_VertexID & 2) != 0 ? 3.0 : -1.0);
+    gl_Position = vec4(p, 0.0, 1.0);
+}
+)";
+
+static const char* cacheFragmentSource = R"(
+#version 330 core
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out vec4 NormalColor;
+
+uniform sampler2D cacheColor;
+uniform sampler2D cacheNormal;
+uniform ivec2 origin; // texel do canto inferior esquerdo da tela (ja no anel)
+uniform ivec2 size;
+
+void main()
+{
+    // origin < size e a tela cabe na textura: no maximo uma volta, sem divisao
+    ivec2 texel = origin + ivec2(gl_FragCoord.xy);
+    texel -= size * ivec2(greaterThanEqual(texel, size));
+    FragColor = texelFetch(cacheColor, texel, 0);
+    NormalColor = texelFetch(cacheNormal, texel, 0);
+}
+)";
+
+static GLuint compileCacheShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cerr << "Erro ao compilar shader da cache de camadas: " << infoLog << std::endl;
+    }
+    return shader;
+}
+
+// divisao e resto arredondando para baixo (pixels do mundo podem ser negativos)
+static int floorDiv(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+static int floorMod(int a, int b) {
+    return a - floorDiv(a, b) * b;
+}
+
+bool LayerCache::init() {
+    GLuint vertexShader = compileCacheShader(GL_VERTEX_SHADER, cacheVertexSource);
+    GLuint fragmentShader = compileCacheShader(GL_FRAGMENT_SHADER, cacheFragmentSource);
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Erro ao linkar shader da cache de camadas: " << infoLog << std::endl;
+        return false;
+    }
+
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "cacheColor"), 0);
+    glUniform1i(glGetUniformLocation(program, "cacheNormal"), 1);
+    originLoc = glGetUniformLocation(program, "origin");
+    sizeLoc = glGetUniformLocation(program, "size");
+
+    glGenVertexArrays(1, &emptyVAO);
+    return true;
+}
+
+static GLuint createCacheTexture(int width, int height) {
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    return texture;
+}
+
+void LayerCache::createTarget() {
+    width = viewportWidth + 2 * margin;
+    height = viewportHeight + 2 * margin;
+    color = createCacheTexture(width, height);
+    normal = createCacheTexture(width, height);
+    glGenRenderbuffers(1, &depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+
+    GLint previous;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, normal, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+    GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "LayerCache: framebuffer incompleto" << std::endl;
+    glBindFramebuffer(GL_FRAMEBUFFER, previous);
+}
+
+void LayerCache::destroyTarget() {
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    glDeleteTextures(1, &normal);
+    glDeleteRenderbuffers(1, &depth);
+    fbo = color = normal = depth = 0;
+}
+
+void LayerCache::addWrapped(const PixelRect& r) {
+    for (int x0 = r.x0; x0 < r.x1;) {
+        int x1 = (floorDiv(x0, width) + 1) * width;
+        if (x1 > r.x1) x1 = r.x1;
+        for (int y0 = r.y0; y0 < r.y1;) {
+            int y1 = (floorDiv(y0, height) + 1) * height;
+            if (y1 > r.y1) y1 = r.y1;
+            if (regionCount < MAX_REGIONS)
+                regions[regionCount++] = { x0, y0, x1, y1 };
+            y0 = y1;
+        }
+        x0 = x1;
+    }
+}
+
+int LayerCache::update(const Camera2D& camera, uint64_t contentVersion) {
+    frames++;
+    regionCount = 0;
+    lastPixels = 0;
+    lastFull = false;
+
+    if (camera.viewportWidth != viewportWidth || camera.viewportHeight != viewportHeight) {
+        viewportWidth = camera.viewportWidth;
+        viewportHeight = camera.viewportHeight;
+        destroyTarget();
+        createTarget();
+        valid = false;
+    }
+    float s = camera.pixelsPerUnit * camera.zoom;
+    if (s != scale) {
+        scale = s;
+        valid = false;
+    }
+    if (contentVersion != version) {
+        version = contentVersion;
+        valid = false;
+    }
+
+    // com pixelSnap o canto da tela cai em um pixel inteiro do mundo
+    Rect2D view = camera.viewRect();
+    screenX = (int)std::lround(view.minX * scale);
+    screenY = (int)std::lround(view.minY * scale);
+    PixelRect wanted = { screenX - margin, screenY - margin, screenX - margin + width, screenY - margin + height };
+
+    if (!valid) {
+        window = wanted;
+        addWrapped(window);
+        lastFull = true;
+        fullRedraws++;
+        valid = true;
+    } else if (screenX < window.x0 || screenY < window.y0 ||
+               screenX + viewportWidth > window.x1 || screenY + viewportHeight > window.y1) {
+        // a tela saiu da janela: recentra e redesenha so o que entrou
+        PixelRect old = window;
+        window = wanted;
+        int ix0 = window.x0 > old.x0 ? window.x0 : old.x0;
+        int ix1 = window.x1 < old.x1 ? window.x1 : old.x1;
+        int iy0 = window.y0 > old.y0 ? window.y0 : old.y0;
+        int iy1 = window.y1 < old.y1 ? window.y1 : old.y1;
+        if (ix0 >= ix1 || iy0 >= iy1) {
+            // pulo maior que a janela (teleporte)
+            addWrapped(window);
+            lastFull = true;
+            fullRedraws++;
+        } else {
+            // faixas verticais inteiras e horizontais so no trecho que sobrou
+            if (window.x0 < ix0) addWrapped({ window.x0, window.y0, ix0, window.y1 });
+            if (window.x1 > ix1) addWrapped({ ix1, window.y0, window.x1, window.y1 });
+            if (window.y0 < iy0) addWrapped({ ix0, window.y0, ix1, iy0 });
+            if (window.y1 > iy1) addWrapped({ ix0, iy1, ix1, window.y1 });
+        }
+    }
+
+    for (int i = 0; i < regionCount; ++i)
+        lastPixels += (long)(regions[i].x1 - regions[i].x0) * (regions[i].y1 - regions[i].y0);
+    lastRegions = regionCount;
+    pixelsRedrawn += lastPixels;
+    if (regionCount == 0) framesWithoutRedraw++;
+    return regionCount;
+}
+
+void LayerCache::saveBlend() {
+    previousBlend = glIsEnabled(GL_BLEND);
+    glGetIntegerv(GL_BLEND_SRC_RGB, &previousBlendFunc[0]);
+    glGetIntegerv(GL_BLEND_DST_RGB, &previousBlendFunc[1]);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &previousBlendFunc[2]);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &previousBlendFunc[3]);
+}
+
+void LayerCache::restoreBlend() {
+    glBlendFuncSeparate(previousBlendFunc[0], previousBlendFunc[1], previousBlendFunc[2], previousBlendFunc[3]);
+    if (previousBlend) glEnable(GL_BLEND);
+    else glDisable(GL_BLEND);
+}
+
+Rect2D LayerCache::beginRegion(int index, glm::mat4& viewProjection) {
+    if (index == 0) {
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFBO);
+        glGetIntegerv(GL_VIEWPORT, previousViewport);
+        saveBlend();
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+        glEnable(GL_BLEND);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        glEnable(GL_SCISSOR_TEST);
+    }
+
+    const PixelRect& r = regions[index];
+    int tx = floorMod(r.x0, width), ty = floorMod(r.y0, height);
+    int w = r.x1 - r.x0, h = r.y1 - r.y0;
+    glViewport(tx, ty, w, h);
+    glScissor(tx, ty, w, h);
+    const float clear[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    const float farDepth = 1.0f;
+    glClearBufferfv(GL_COLOR, 0, clear);
+    glClearBufferfv(GL_COLOR, 1, clear);
+    glClearBufferfv(GL_DEPTH, 0, &farDepth);
+
+    Rect2D area = { r.x0 / scale, r.y0 / scale, r.x1 / scale, r.y1 / scale };
+    viewProjection = glm::ortho(area.minX, area.maxX, area.minY, area.maxY, -1.0f, 1.0f);
+    return area;
+}
+
+void LayerCache::endRegions() {
+    if (regionCount == 0) return;
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    restoreBlend();
+}
+
+void LayerCache::draw() {
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_DEPTH_TEST);
+    saveBlend();
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(program);
+    glUniform2i(originLoc, floorMod(screenX, width), floorMod(screenY, height));
+    glUniform2i(sizeLoc, width, height);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, normal);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glBindVertexArray(emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    restoreBlend();
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+}
+
+void LayerCache::destroy() {
+    destroyTarget();
+    glDeleteProgram(program);
+    glDeleteVertexArrays(1, &emptyVAO);
+    program = emptyVAO = 0;
+    viewportWidth = viewportHeight = 0;
+    valid = false;
+}
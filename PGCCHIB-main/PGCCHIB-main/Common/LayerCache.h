@@ -0,0 +1,89 @@
+#ifndef LAYER_CACHE_H
+#define LAYER_CACHE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+#include "Camera2D.h"
+
+// Cache de camadas estaticas (chao de tilemap, fundo) em uma textura um pouco
+// maior que a tela (margin pixels de cada lado).
+// A textura eh enderecada em anel: o pixel p do mundo (em pixels de tela no
+// zoom atual) fica no texel p mod tamanho. Quando a camera anda, so as faixas
+// que entraram na janela sao redesenhadas, o resto dos texels continua valido.
+// Zoom, tamanho da tela ou version diferentes redesenham tudo.
+// Como a cache nao sabe desenhar a camada, o update devolve as regioes que
+// faltam e o chamador desenha cada uma:
+//     int n = cache.update(camera, layer.version);
+//     for (int i = 0; i < n; ++i) {
+//         glm::mat4 viewProjection;
+//         Rect2D area = cache.beginRegion(i, viewProjection);
+//         ... desenha o que cai em area com viewProjection ...
+//     }
+//     cache.endRegions();
+//     ...
+//     cache.draw(); // no lugar de desenhar a camada
+// O alvo tem cor (location 0), normal (location 1, para o Lighting2D) e
+// profundidade. As regioes sao desenhadas com alfa pre-multiplicado (a cor
+// mistura com SRC_ALPHA e o alfa acumula com ONE), e o draw() compoe com
+// ONE, ONE_MINUS_SRC_ALPHA por cima do que ja estiver no framebuffer: o
+// resultado eh o mesmo de desenhar a camada direto com blending normal.
+// Precisa da camera com pixelSnap, senao a textura fica meio pixel deslocada.
+struct LayerCache {
+    static const int MAX_REGIONS = 16;
+    int margin = 64;
+
+    // estatisticas do ultimo update()
+    int lastRegions = 0;
+    long lastPixels = 0;    // pixels redesenhados
+    bool lastFull = false;  // redesenho completo
+    // acumuladas
+    long frames = 0, framesWithoutRedraw = 0, fullRedraws = 0;
+    long long pixelsRedrawn = 0;
+
+    bool init();
+    int update(const Camera2D& camera, uint64_t version);
+    Rect2D beginRegion(int index, glm::mat4& viewProjection);
+    void endRegions();
+    // desenha a camada em tela cheia (um triangulo, texelFetch com o anel)
+    void draw();
+    // forca o redesenho completo no proximo update
+    void invalidate() { valid = false; }
+    void destroy();
+
+private:
+    // retangulo em pixels do mundo, [x0, x1) x [y0, y1)
+    struct PixelRect {
+        int x0, y0, x1, y1;
+    };
+
+    GLuint fbo = 0, color = 0, normal = 0, depth = 0;
+    GLuint program = 0, emptyVAO = 0;
+    GLint originLoc = -1, sizeLoc = -1;
+
+    int width = 0, height = 0;  // tamanho da textura
+    int viewportWidth = 0, viewportHeight = 0;
+    float scale = 0.0f;         // pixels por unidade do mundo
+    uint64_t version = 0;
+    bool valid = false;
+    PixelRect window = {};      // pixels do mundo guardados na textura
+    int screenX = 0, screenY = 0; // pixel do mundo no canto inferior esquerdo da tela
+
+    PixelRect regions[MAX_REGIONS];
+    int regionCount = 0;
+    GLint previousFBO = 0;
+    GLint previousViewport[4] = {};
+    GLboolean previousBlend = GL_FALSE;
+    GLint previousBlendFunc[4] = {};
+
+    void createTarget();
+    void destroyTarget();
+    void saveBlend();
+    void restoreBlend();
+    // quebra um retangulo do mundo nos pedacos que nao dao a volta no anel
+    void addWrapped(const PixelRect& r);
+};
+
+#endif
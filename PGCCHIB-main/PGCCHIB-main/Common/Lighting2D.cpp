@@ -0,0 +1,424 @@
+#include "Lighting2D.h"
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include <glm/gtc/type_ptr.hpp>
+
+// triangulo que cobre a tela inteira, sem vertex buffer
+static const char* fullscreenVertexSource = R"(
+#version 330 core
+void main()
+{
+    vec2 p = vec2((gl_VertexID & 1) != 0 ? 3.0 : -1.0, (gl_VertexID & 2) != 0 ? 3.0 : -1.0);
+    gl_Position = vec4(p, 0.0, 1.0);
+}
+)";
+
+static const char* accumulateFragmentSource = R"(
+#version 330 core
+out vec4 LightColor;
+
+uniform samplerBuffer lights;    // 2 texels por luz: (x, y, raio, altura), (r, g, b, 0)
+uniform usamplerBuffer ranges;   // por tile: (offset, count) em indices
+uniform usamplerBuffer indices;
+uniform sampler2D normals;
+
+uniform int tilesX;
+uniform float tileSize;
+uniform float downscale;
+uniform vec2 screenSize;
+
+void main()
+{
+    // centro deste pixel em pixels da tela cheia
+    vec2 pixel = gl_FragCoord.xy * downscale;
+    ivec2 tile = ivec2(pixel / tileSize);
+    uvec2 range = texelFetch(ranges, tile.y * tilesX + tile.x).xy;
+
+    vec4 encoded = texture(normals, pixel / screenSize);
+    // z = 0: nada foi desenhado ou o shader nao tem normal map
+    vec3 n = encoded.z > 0.25 ? normalize(encoded.xyz * 2.0 - 1.0) : vec3(0.0, 0.0, 1.0);
+
+    vec3 sum = vec3(0.0);
+    for (uint i = 0u; i < range.y; ++i) {
+        int light = int(texelFetch(indices, int(range.x + i)).r);
+        vec4 a = texelFetch(lights, light * 2);
+        vec3 color = texelFetch(lights, light * 2 + 1).rgb;
+
+        vec2 d = a.xy - pixel;
+        float falloff = clamp(1.0 - dot(d, d) / (a.z * a.z), 0.0, 1.0);
+        vec3 l = normalize(vec3(d, a.w));
+        sum += color * (falloff * falloff * max(dot(n, l), 0.0));
+    }
+    LightColor = vec4(sum, 1.0);
+}
+)";
+
+static const char* compositeFragmentSource = R"(
+#version 330 core
+out vec4 FragColor;
+
+uniform sampler2D sceneColor;
+uniform sampler2D lightColor;
+uniform vec3 ambient;
+uniform vec2 screenSize;
+
+void main()
+{
+    vec2 uv = gl_FragCoord.xy / screenSize;
+    vec4 c = texture(sceneColor, uv);
+    FragColor = vec4(c.rgb * (ambient + texture(lightColor, uv).rgb), 1.0);
+}
+)";
+
+static GLuint compileLightingShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cerr << "Erro ao compilar shader de iluminacao: " << infoLog << std::endl;
+    }
+    return shader;
+}
+
+static GLuint linkLightingProgram(const char* fragmentSource) {
+    GLuint vertexShader = compileLightingShader(GL_VERTEX_SHADER, fullscreenVertexSource);
+    GLuint fragmentShader = compileLightingShader(GL_FRAGMENT_SHADER, fragmentSource);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Erro ao linkar shader de iluminacao: " << infoLog << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+GLuint createNormalMap(const unsigned char* rgba, int width, int height, bool topDown, float strength) {
+    // altura = brilho * alfa, entre 0 e 1
+    std::vector<float> h((size_t)width * height);
+    for (size_t i = 0; i < h.size(); ++i) {
+        const unsigned char* p = rgba + i * 4;
+        h[i] = (0.299f * p[0] + 0.587f * p[1] + 0.114f * p[2]) * p[3] / (255.0f * 255.0f);
+    }
+    auto at = [&](int x, int y) {
+        x = x < 0 ? 0 : (x >= width ? width - 1 : x);
+        y = y < 0 ? 0 : (y >= height ? height - 1 : y);
+        return h[(size_t)y * width + x];
+    };
+
+    std::vector<unsigned char> normals((size_t)width * height * 4);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            // Sobel
+            float gx = (at(x + 1, y - 1) + 2.0f * at(x + 1, y) + at(x + 1, y + 1)) -
+                       (at(x - 1, y - 1) + 2.0f * at(x - 1, y) + at(x - 1, y + 1));
+            float gy = (at(x - 1, y + 1) + 2.0f * at(x, y + 1) + at(x + 1, y + 1)) -
+                       (at(x - 1, y - 1) + 2.0f * at(x, y - 1) + at(x + 1, y - 1));
+            // gy cresce com a linha; com as linhas de cima para baixo isso eh para baixo na tela
+            if (topDown) gy = -gy;
+            glm::vec3 n = glm::normalize(glm::vec3(-gx * strength, -gy * strength, 1.0f));
+            unsigned char* out = &normals[((size_t)y * width + x) * 4];
+            out[0] = (unsigned char)std::lround((n.x * 0.5f + 0.5f) * 255.0f);
+            out[1] = (unsigned char)std::lround((n.y * 0.5f + 0.5f) * 255.0f);
+            out[2] = (unsigned char)std::lround((n.z * 0.5f + 0.5f) * 255.0f);
+            out[3] = 255;
+        }
+    }
+
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, normals.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    return texture;
+}
+
+bool Lighting2D::init(int width, int height) {
+    accumulateProgram = linkLightingProgram(accumulateFragmentSource);
+    compositeProgram = linkLightingProgram(compositeFragmentSource);
+    if (!accumulateProgram || !compositeProgram)
+        return false;
+
+    glUseProgram(accumulateProgram);
+    glUniform1i(glGetUniformLocation(accumulateProgram, "lights"), 0);
+    glUniform1i(glGetUniformLocation(accumulateProgram, "ranges"), 1);
+    glUniform1i(glGetUniformLocation(accumulateProgram, "indices"), 2);
+    glUniform1i(glGetUniformLocation(accumulateProgram, "normals"), 3);
+    tilesXLoc = glGetUniformLocation(accumulateProgram, "tilesX");
+    tileSizeLoc = glGetUniformLocation(accumulateProgram, "tileSize");
+    downscaleLoc = glGetUniformLocation(accumulateProgram, "downscale");
+    screenSizeLoc = glGetUniformLocation(accumulateProgram, "screenSize");
+
+    glUseProgram(compositeProgram);
+    glUniform1i(glGetUniformLocation(compositeProgram, "sceneColor"), 0);
+    glUniform1i(glGetUniformLocation(compositeProgram, "lightColor"), 1);
+    ambientLoc = glGetUniformLocation(compositeProgram, "ambient");
+    compositeScreenSizeLoc = glGetUniformLocation(compositeProgram, "screenSize");
+
+    glGenVertexArrays(1, &emptyVAO);
+
+    GLuint* buffers[3] = { &lightBuffer, &rangeBuffer, &indexBuffer };
+    GLuint* textures[3] = { &lightTexture, &rangeTexture, &indexTexture };
+    GLenum formats[3] = { GL_RGBA32F, GL_RG32UI, GL_R32UI };
+    for (int i = 0; i < 3; ++i) {
+        glGenBuffers(1, buffers[i]);
+        glBindBuffer(GL_TEXTURE_BUFFER, *buffers[i]);
+        // buffer de textura sem conteudo nao eh valido; comeca com um elemento
+        glBufferData(GL_TEXTURE_BUFFER, 16, NULL, GL_STREAM_DRAW);
+        glGenTextures(1, textures[i]);
+        glBindTexture(GL_TEXTURE_BUFFER, *textures[i]);
+        glTexBuffer(GL_TEXTURE_BUFFER, formats[i], *buffers[i]);
+    }
+    lightCapacity = rangeCapacity = indexCapacity = 16;
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    sceneWidth = width;
+    sceneHeight = height;
+    createTargets();
+    return true;
+}
+
+static GLuint createTargetTexture(GLenum internalFormat, int width, int height, GLenum filter) {
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    return texture;
+}
+
+void Lighting2D::createTargets() {
+    if (downscale < 1) downscale = 1;
+    lightWidth = (sceneWidth + downscale - 1) / downscale;
+    lightHeight = (sceneHeight + downscale - 1) / downscale;
+    tilesX = (sceneWidth + tileSize - 1) / tileSize;
+    tilesY = (sceneHeight + tileSize - 1) / tileSize;
+
+    sceneColor = createTargetTexture(GL_RGBA8, sceneWidth, sceneHeight, GL_NEAREST);
+    sceneNormal = createTargetTexture(GL_RGBA8, sceneWidth, sceneHeight, GL_NEAREST);
+    glGenRenderbuffers(1, &sceneDepth);
+    glBindRenderbuffer(GL_RENDERBUFFER, sceneDepth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, sceneWidth, sceneHeight);
+
+    glGenFramebuffers(1, &sceneFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sceneColor, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, sceneNormal, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, sceneDepth);
+    GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    glDrawBuffers(2, drawBuffers);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "Lighting2D: framebuffer da cena incompleto" << std::endl;
+
+    // a luz eh suave, o filtro linear disfarca a resolucao menor
+    lightColor = createTargetTexture(GL_RGBA16F, lightWidth, lightHeight, GL_LINEAR);
+    glGenFramebuffers(1, &lightFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, lightFBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, lightColor, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "Lighting2D: framebuffer de luz incompleto" << std::endl;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void Lighting2D::destroyTargets() {
+    glDeleteFramebuffers(1, &sceneFBO);
+    glDeleteFramebuffers(1, &lightFBO);
+    glDeleteTextures(1, &sceneColor);
+    glDeleteTextures(1, &sceneNormal);
+    glDeleteTextures(1, &lightColor);
+    glDeleteRenderbuffers(1, &sceneDepth);
+    sceneFBO = lightFBO = sceneColor = sceneNormal = lightColor = sceneDepth = 0;
+}
+
+void Lighting2D::resize(int width, int height) {
+    if (width <= 0 || height <= 0) return; // janela minimizada
+    destroyTargets();
+    sceneWidth = width;
+    sceneHeight = height;
+    createTargets();
+}
+
+void Lighting2D::beginScene(const glm::vec4& clearColor) {
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
+    glViewport(0, 0, sceneWidth, sceneHeight);
+
+    const float noNormal[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    const float farDepth = 1.0f;
+    glClearBufferfv(GL_COLOR, 0, glm::value_ptr(clearColor));
+    glClearBufferfv(GL_COLOR, 1, noNormal);
+    glClearBufferfv(GL_DEPTH, 0, &farDepth);
+}
+
+void Lighting2D::upload(GLuint buffer, size_t& capacity, const void* data, size_t bytes) {
+    glBindBuffer(GL_TEXTURE_BUFFER, buffer);
+    if (bytes > capacity)
+        capacity = bytes > capacity * 2 ? bytes : capacity * 2;
+    // orfana o conteudo do frame anterior, sem esperar a GPU
+    glBufferData(GL_TEXTURE_BUFFER, capacity, NULL, GL_STREAM_DRAW);
+    if (bytes > 0)
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, data);
+}
+
+void Lighting2D::binLights(const glm::mat4& viewProjection) {
+    // mundo -> pixels; o raio usa a escala do eixo x (camera 2D sem distorcao)
+    float pixelsPerUnit = glm::length(glm::vec2(viewProjection[0][0], viewProjection[0][1])) * sceneWidth * 0.5f;
+
+    screenLights.clear();
+    for (const Light2D& light : lights) {
+        glm::vec4 clip = viewProjection * glm::vec4(light.position, 0.0f, 1.0f);
+        float x = (clip.x / clip.w * 0.5f + 0.5f) * sceneWidth;
+        float y = (clip.y / clip.w * 0.5f + 0.5f) * sceneHeight;
+        float r = light.radius * pixelsPerUnit;
+        // fora da tela
+        if (r <= 0.0f || x + r < 0.0f || y + r < 0.0f || x - r > sceneWidth || y - r > sceneHeight)
+            continue;
+        screenLights.push_back({ x, y, r, light.height * pixelsPerUnit, light.color.r, light.color.g, light.color.b, 0.0f });
+    }
+    visibleLights = (int)screenLights.size();
+
+    // faixa de tiles que o circulo toca em cada linha de tiles: mais justa que a
+    // caixa do circulo (corta os cantos)
+    size_t tileCount = (size_t)tilesX * tilesY;
+    counts.assign(tileCount, 0);
+    auto forEachTile = [&](const ScreenLight& l, auto&& visit) {
+        float ts = (float)tileSize;
+        int ty0 = (int)std::floor((l.y - l.radius) / ts), ty1 = (int)std::floor((l.y + l.radius) / ts);
+        if (ty0 < 0) ty0 = 0;
+        if (ty1 >= tilesY) ty1 = tilesY - 1;
+        for (int ty = ty0; ty <= ty1; ++ty) {
+            // ponto da linha de tiles mais perto do centro
+            float top = ty * ts, bottom = top + ts;
+            float dy = l.y < top ? top - l.y : (l.y > bottom ? l.y - bottom : 0.0f);
+            if (dy >= l.radius) continue;
+            float half = std::sqrt(l.radius * l.radius - dy * dy);
+            int tx0 = (int)std::floor((l.x - half) / ts), tx1 = (int)std::floor((l.x + half) / ts);
+            if (tx0 < 0) tx0 = 0;
+            if (tx1 >= tilesX) tx1 = tilesX - 1;
+            for (int tx = tx0; tx <= tx1; ++tx)
+                visit((size_t)ty * tilesX + tx);
+        }
+    };
+
+    // 1) conta, 2) offsets, 3) preenche
+    for (const ScreenLight& l : screenLights)
+        forEachTile(l, [&](size_t tile) { counts[tile]++; });
+
+    ranges.resize(tileCount * 2);
+    uint32_t offset = 0;
+    maxLightsPerTile = 0;
+    for (size_t t = 0; t < tileCount; ++t) {
+        ranges[t * 2] = offset;
+        ranges[t * 2 + 1] = counts[t];
+        if ((int)counts[t] > maxLightsPerTile) maxLightsPerTile = (int)counts[t];
+        offset += counts[t];
+        counts[t] = ranges[t * 2];
+    }
+    lightTilePairs = offset;
+
+    indices.resize(offset);
+    for (size_t i = 0; i < screenLights.size(); ++i)
+        forEachTile(screenLights[i], [&](size_t tile) { indices[counts[tile]++] = (uint32_t)i; });
+
+    upload(lightBuffer, lightCapacity, screenLights.data(), screenLights.size() * sizeof(ScreenLight));
+    upload(rangeBuffer, rangeCapacity, ranges.data(), ranges.size() * sizeof(uint32_t));
+    upload(indexBuffer, indexCapacity, indices.data(), indices.size() * sizeof(uint32_t));
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void Lighting2D::endScene(const glm::mat4& viewProjection) {
+    auto start = std::chrono::steady_clock::now();
+    binLights(viewProjection);
+    binMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    GLboolean blend = glIsEnabled(GL_BLEND), depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glBindVertexArray(emptyVAO);
+
+    // acumulacao
+    glBindFramebuffer(GL_FRAMEBUFFER, lightFBO);
+    glViewport(0, 0, lightWidth, lightHeight);
+    if (screenLights.empty()) {
+        const float black[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        glClearBufferfv(GL_COLOR, 0, black);
+    } else {
+        glUseProgram(accumulateProgram);
+        glUniform1i(tilesXLoc, tilesX);
+        glUniform1f(tileSizeLoc, (float)tileSize);
+        glUniform1f(downscaleLoc, (float)downscale);
+        glUniform2f(screenSizeLoc, (float)sceneWidth, (float)sceneHeight);
+        GLuint buffers[3] = { lightTexture, rangeTexture, indexTexture };
+        for (int i = 0; i < 3; ++i) {
+            glActiveTexture(GL_TEXTURE0 + i);
+            glBindTexture(GL_TEXTURE_BUFFER, buffers[i]);
+        }
+        glActiveTexture(GL_TEXTURE3);
+        glBindTexture(GL_TEXTURE_2D, sceneNormal);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    }
+
+    // composicao no framebuffer de antes do beginScene
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFBO);
+    glViewport(0, 0, sceneWidth, sceneHeight);
+    glUseProgram(compositeProgram);
+    glUniform3fv(ambientLoc, 1, glm::value_ptr(ambient));
+    glUniform2f(compositeScreenSizeLoc, (float)sceneWidth, (float)sceneHeight);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sceneColor);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, lightColor);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+
+    // nao deixa as texturas da iluminacao ligadas para os shaders da cena
+    for (int unit = 3; unit >= 0; --unit) {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glBindTexture(GL_TEXTURE_BUFFER, 0);
+    }
+    glBindVertexArray(0);
+    if (blend) glEnable(GL_BLEND);
+    if (depthTest) glEnable(GL_DEPTH_TEST);
+}
+
+void Lighting2D::destroy() {
+    destroyTargets();
+    glDeleteProgram(accumulateProgram);
+    glDeleteProgram(compositeProgram);
+    glDeleteVertexArrays(1, &emptyVAO);
+    glDeleteBuffers(1, &lightBuffer);
+    glDeleteBuffers(1, &rangeBuffer);
+    glDeleteBuffers(1, &indexBuffer);
+    glDeleteTextures(1, &lightTexture);
+    glDeleteTextures(1, &rangeTexture);
+    glDeleteTextures(1, &indexTexture);
+    accumulateProgram = compositeProgram = emptyVAO = 0;
+    lightBuffer = rangeBuffer = indexBuffer = lightTexture = rangeTexture = indexTexture = 0;
+    lightCapacity = rangeCapacity = indexCapacity = 0;
+}
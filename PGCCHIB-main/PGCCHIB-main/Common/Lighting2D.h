@@ -0,0 +1,96 @@
+#ifndef LIGHTING_2D_H
+#define LIGHTING_2D_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Luz pontual no mundo. height eh a altura da luz acima do plano da cena, na
+// mesma unidade do mundo: baixa deixa o relevo do normal map mais marcado.
+struct Light2D {
+    glm::vec2 position;
+    float radius;
+    glm::vec3 color;    // ja multiplicada pela intensidade
+    float height;
+};
+
+// Normal map (RGBA8, normal * 0.5 + 0.5) a partir do brilho dos pixels: pixel
+// mais claro = mais alto, borda do alfa = degrau. Para sprite sheets sem normal
+// map desenhado a mao. topDown: a primeira linha de rgba eh a de cima na tela
+// (stbi sem flip). Filtro GL_NEAREST, como a pixel art.
+GLuint createNormalMap(const unsigned char* rgba, int width, int height, bool topDown, float strength = 2.0f);
+
+// Iluminacao 2D com luzes agrupadas por tile da tela.
+// A cena eh desenhada entre beginScene() e endScene() em dois alvos: cor
+// (location 0) e normal (location 1, normal * 0.5 + 0.5 com alfa; z = 0 vira
+// normal reta, entao shaders sem normal map podem escrever vec4(0)).
+// No endScene() a CPU projeta as luzes na tela e guarda em cada tile de
+// tileSize x tileSize pixels a lista das luzes cujo circulo encosta nele; a
+// passada de acumulacao le so a lista do seu tile, entao cada pixel avalia as
+// luzes proximas em vez de todas. A acumulacao pode rodar em resolucao menor
+// (downscale 2 = metade em cada eixo) e a composicao final (cor * (ambiente +
+// luz)) sai na resolucao cheia, no framebuffer que estava ligado antes do
+// beginScene().
+struct Lighting2D {
+    int tileSize = 16;
+    int downscale = 1;
+    glm::vec3 ambient = glm::vec3(0.25f);
+    std::vector<Light2D> lights; // preenchidas pelo jogo a cada frame
+
+    // estatisticas do ultimo endScene()
+    int visibleLights = 0;
+    size_t lightTilePairs = 0; // soma das luzes de todos os tiles
+    int maxLightsPerTile = 0;
+    double binMs = 0.0;        // CPU: projetar, agrupar e enviar
+
+    bool init(int width, int height);
+    // recria os alvos (chamar no callback de tamanho do framebuffer)
+    void resize(int width, int height);
+    // liga os alvos da cena e limpa cor, normal e profundidade
+    void beginScene(const glm::vec4& clearColor);
+    // agrupa as luzes, acumula e compoe; viewProjection leva as luzes do mundo para a tela
+    void endScene(const glm::mat4& viewProjection);
+    void destroy();
+
+    int width() const { return sceneWidth; }
+    int height() const { return sceneHeight; }
+
+private:
+    GLuint sceneFBO = 0, sceneColor = 0, sceneNormal = 0, sceneDepth = 0;
+    GLuint lightFBO = 0, lightColor = 0;
+    GLuint accumulateProgram = 0, compositeProgram = 0;
+    GLuint emptyVAO = 0;
+    // buffer textures: dados das luzes (RGBA32F), faixa de cada tile (RG32UI) e indices (R32UI)
+    GLuint lightBuffer = 0, lightTexture = 0;
+    GLuint rangeBuffer = 0, rangeTexture = 0;
+    GLuint indexBuffer = 0, indexTexture = 0;
+    size_t lightCapacity = 0, rangeCapacity = 0, indexCapacity = 0;
+
+    GLint tilesXLoc = -1, tileSizeLoc = -1, downscaleLoc = -1, screenSizeLoc = -1;
+    GLint ambientLoc = -1, compositeScreenSizeLoc = -1;
+
+    int sceneWidth = 0, sceneHeight = 0;
+    int lightWidth = 0, lightHeight = 0;
+    int tilesX = 0, tilesY = 0;
+    GLint previousFBO = 0;
+
+    // luz ja na tela: centro, raio e altura em pixels + cor
+    struct ScreenLight {
+        float x, y, radius, height;
+        float r, g, b, pad;
+    };
+    std::vector<ScreenLight> screenLights;
+    std::vector<uint32_t> ranges;  // offset, count por tile
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> counts;
+
+    void createTargets();
+    void destroyTargets();
+    void binLights(const glm::mat4& viewProjection);
+    // cresce (dobrando) e envia o conteudo de um buffer de textura
+    void upload(GLuint buffer, size_t& capacity, const void* data, size_t bytes);
+};
+
+#endif
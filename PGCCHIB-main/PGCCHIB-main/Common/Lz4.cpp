@@ -0,0 +1,137 @@
+#include "Lz4.h"
+
+#include <cstdint>
+#include <cstring>
+
+// regras do formato: o ultimo match comeca 12 bytes antes do fim e os 5
+// ultimos bytes sao sempre literais
+static const size_t MIN_MATCH = 4;
+static const size_t LAST_LITERALS = 5;
+static const size_t MATCH_LIMIT = 12;
+static const int HASH_BITS = 12;
+
+static uint32_t read32(const unsigned char* p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// comprimento em nibble + bytes de 255 ate o resto
+static void writeLength(std::vector<unsigned char>& out, size_t length) {
+    for (; length >= 255; length -= 255)
+        out.push_back(255);
+    out.push_back((unsigned char)length);
+}
+
+static void writeSequence(std::vector<unsigned char>& out, const unsigned char* literals, size_t literalCount,
+                          size_t offset, size_t matchLength) {
+    size_t m = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+    out.push_back((unsigned char)((literalCount < 15 ? literalCount : 15) << 4 | (m < 15 ? m : 15)));
+    if (literalCount >= 15)
+        writeLength(out, literalCount - 15);
+    out.insert(out.end(), literals, literals + literalCount);
+    if (matchLength == 0)
+        return; // ultima sequencia: so literais
+    out.push_back((unsigned char)(offset & 0xFF));
+    out.push_back((unsigned char)(offset >> 8));
+    if (m >= 15)
+        writeLength(out, m - 15);
+}
+
+size_t lz4CompressBound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+void lz4Compress(const unsigned char* src, size_t size, std::vector<unsigned char>& out) {
+    out.clear();
+    out.reserve(lz4CompressBound(size));
+
+    size_t anchor = 0;
+    if (size > MATCH_LIMIT) {
+        int64_t table[1 << HASH_BITS];
+        for (int64_t& t : table) t = -1;
+
+        size_t end = size - MATCH_LIMIT;
+        size_t matchEnd = size - LAST_LITERALS;
+        size_t i = 0;
+        while (i < end) {
+            uint32_t sequence = read32(src + i);
+            uint32_t h = (sequence * 2654435761u) >> (32 - HASH_BITS);
+            int64_t candidate = table[h];
+            table[h] = (int64_t)i;
+            if (candidate < 0 || i - (size_t)candidate > 0xFFFF || read32(src + candidate) != sequence) {
+                i++;
+                continue;
+            }
+
+            size_t c = (size_t)candidate;
+            // volta enquanto os bytes antes tambem batem (sem passar do ultimo match)
+            while (i > anchor && c > 0 && src[i - 1] == src[c - 1]) {
+                i--;
+                c--;
+            }
+            size_t length = MIN_MATCH;
+            while (i + length < matchEnd && src[c + length] == src[i + length])
+                length++;
+
+            writeSequence(out, src + anchor, i - anchor, i - c, length);
+            i += length;
+            anchor = i;
+        }
+    }
+    writeSequence(out, src + anchor, size - anchor, 0, 0);
+}
+
+bool lz4Decompress(const unsigned char* src, size_t srcSize, unsigned char* dst, size_t dstSize) {
+    const unsigned char* ip = src;
+    const unsigned char* ipEnd = src + srcSize;
+    unsigned char* op = dst;
+    unsigned char* opEnd = dst + dstSize;
+
+    while (ip < ipEnd) {
+        unsigned token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals == 15) {
+            unsigned char b;
+            do {
+                if (ip >= ipEnd) return false;
+                b = *ip++;
+                literals += b;
+            } while (b == 255);
+        }
+        if (literals > (size_t)(ipEnd - ip) || literals > (size_t)(opEnd - op)) return false;
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == ipEnd) break; // ultima sequencia
+
+        if (ipEnd - ip < 2) return false;
+        size_t offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst)) return false;
+
+        size_t length = token & 15;
+        if (length == 15) {
+            unsigned char b;
+            do {
+                if (ip >= ipEnd) return false;
+                b = *ip++;
+                length += b;
+            } while (b == 255);
+        }
+        length += MIN_MATCH;
+        if (length > (size_t)(opEnd - op)) return false;
+
+        // byte a byte: a copia pode se sobrepor (offset < length repete o trecho)
+        const unsigned char* match = op - offset;
+        if (offset >= length) {
+            memcpy(op, match, length);
+            op += length;
+        } else {
+            for (size_t k = 0; k < length; ++k)
+                *op++ = match[k];
+        }
+    }
+    return op == opEnd;
+}
@@ -0,0 +1,23 @@
+#ifndef LZ4_H
+#define LZ4_H
+
+#include <cstddef>
+#include <vector>
+
+// Formato de bloco do LZ4 (compativel com LZ4_compress_default /
+// LZ4_decompress_safe), sem o frame: o tamanho original fica com quem guarda o
+// bloco. Sequencias de literais + copia (offset de 16 bits, match minimo de 4);
+// descomprimir eh so memcpy e copia de bytes, sem tabelas.
+
+// pior caso do bloco comprimido (dados sem repeticao nenhuma)
+size_t lz4CompressBound(size_t size);
+
+// compressao gulosa com uma tabela de 4096 posicoes pelo hash de 4 bytes;
+// out recebe o bloco inteiro
+void lz4Compress(const unsigned char* src, size_t size, std::vector<unsigned char>& out);
+
+// descomprime exatamente dstSize bytes; false se o bloco estiver corrompido
+// (nunca le nem escreve fora dos buffers)
+bool lz4Decompress(const unsigned char* src, size_t srcSize, unsigned char* dst, size_t dstSize);
+
+#endif
@@ -0,0 +1,403 @@
+#include "MapGenerator.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAPGEN_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// tiles do tilesetIso.png, na ordem da imagem
+enum {
+    ISO_SAND, ISO_GRASS, ISO_STONE, ISO_LAVA, ISO_ICE, ISO_DEEP_WATER, ISO_FLOWERS
+};
+
+// periodos (em tiles) das oitavas; todos multiplos de 4 por causa do SSE
+static const int HEIGHT_PERIODS[] = { 256, 128, 64, 32, 16, 8 };
+static const int MOISTURE_PERIODS[] = { 128, 32 };
+
+static inline int bits16(uint16_t v) {
+#ifdef _MSC_VER
+    return (int)__popcnt16(v);
+#else
+    return __builtin_popcount(v);
+#endif
+}
+
+static inline int lowest16(uint16_t v) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return (int)index;
+#else
+    return __builtin_ctz(v);
+#endif
+}
+
+static inline uint32_t hashCell(int x, int y, uint32_t seed) {
+    uint32_t h = (uint32_t)x * 0x8da6b343u ^ (uint32_t)y * 0xd8163841u ^ seed * 0xcb1ab31fu;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    return h;
+}
+
+static inline float smooth(float t) {
+    return t * t * (3.0f - 2.0f * t);
+}
+
+void MapRules::allow(int a, int b) {
+    compatible[a] |= (uint16_t)(1u << b);
+    compatible[b] |= (uint16_t)(1u << a);
+}
+
+void MapRules::finish() {
+    support.assign((size_t)1 << tileCount, 0);
+    for (size_t mask = 1; mask < support.size(); ++mask) {
+        // dominio = o menor bit mais o resto, que ja foi calculado
+        int t = lowest16((uint16_t)mask);
+        support[mask] = compatible[t] | support[mask & (mask - 1)];
+    }
+}
+
+MapRules isoTerrainRules() {
+    MapRules r;
+    r.tileCount = 7;
+    const float weights[] = { 1.0f, 3.0f, 2.0f, 0.3f, 1.0f, 1.0f, 0.6f };
+    for (int t = 0; t < r.tileCount; ++t) {
+        r.weight[t] = weights[t];
+        r.allow(t, t);
+    }
+    // agua funda so encosta em gelo, lava so em pedra, flores no meio da grama
+    r.allow(ISO_DEEP_WATER, ISO_ICE);
+    r.allow(ISO_ICE, ISO_SAND);
+    r.allow(ISO_ICE, ISO_GRASS);
+    r.allow(ISO_SAND, ISO_GRASS);
+    r.allow(ISO_SAND, ISO_STONE);
+    r.allow(ISO_GRASS, ISO_STONE);
+    r.allow(ISO_GRASS, ISO_FLOWERS);
+    r.allow(ISO_SAND, ISO_FLOWERS);
+    r.allow(ISO_STONE, ISO_LAVA);
+
+    const uint16_t deep = 1 << ISO_DEEP_WATER, ice = 1 << ISO_ICE, sand = 1 << ISO_SAND;
+    const uint16_t grass = 1 << ISO_GRASS, stone = 1 << ISO_STONE, lava = 1 << ISO_LAVA, flowers = 1 << ISO_FLOWERS;
+    r.bands.push_back({ 0.36f, deep, deep, -1, true });
+    r.bands.push_back({ 0.41f, (uint16_t)(ice | deep), (uint16_t)(ice | deep), -1, false });
+    r.bands.push_back({ 0.45f, (uint16_t)(sand | ice), (uint16_t)(sand | ice), -1, false });
+    r.bands.push_back({ 0.58f, (uint16_t)(sand | grass), (uint16_t)(grass | flowers), -1, false });
+    r.bands.push_back({ 0.65f, (uint16_t)(stone | grass | sand), (uint16_t)(grass | stone | flowers), -1, false });
+    r.bands.push_back({ 0.70f, (uint16_t)(stone | lava), stone, -1, false });
+    r.bands.push_back({ 2.0f, (uint16_t)(stone | lava), (uint16_t)(stone | lava), ISO_STONE, true });
+    r.finish();
+    return r;
+}
+
+bool mapGeneratorHasSimd() {
+#ifdef MAPGEN_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+void MapGenerator::chunkRect(int chunk, int& x0, int& y0, int& w, int& h) const {
+    x0 = (chunk % chunksX()) * chunkSize;
+    y0 = (chunk / chunksX()) * chunkSize;
+    w = std::min(chunkSize, width - x0);
+    h = std::min(chunkSize, height - y0);
+}
+
+bool MapGenerator::prepare() {
+    stop();
+    if (width <= 0 || height <= 0 || chunkSize < 4 || chunkSize % 4 != 0) {
+        std::cerr << "MapGenerator: tamanho " << width << "x" << height << " ou chunk " << chunkSize << " invalido" << std::endl;
+        return false;
+    }
+    if (rules.tileCount <= 0 || rules.tileCount > MAPGEN_MAX_TILES || rules.bands.empty() ||
+        rules.support.size() != ((size_t)1 << rules.tileCount)) {
+        std::cerr << "MapGenerator: regras incompletas (faltou MapRules::finish?)" << std::endl;
+        return false;
+    }
+    size_t cells = (size_t)width * height;
+    floor.assign(cells, 0);
+    wall.assign(cells, -1);
+    solid.assign(cells, 1);
+    ready.clear();
+    conflicts = 0;
+    elapsedMs = 0.0;
+    quit = false;
+    done = false;
+    return true;
+}
+
+bool MapGenerator::generate() {
+    if (!prepare())
+        return false;
+    run(width / 2, height / 2);
+    return true;
+}
+
+bool MapGenerator::start(int focusX, int focusY) {
+    if (!prepare())
+        return false;
+    worker = std::thread(&MapGenerator::run, this, focusX, focusY);
+    return true;
+}
+
+void MapGenerator::stop() {
+    quit = true;
+    if (worker.joinable())
+        worker.join();
+}
+
+int MapGenerator::collect(std::vector<int>& chunks) {
+    std::lock_guard<std::mutex> lock(mutex);
+    int count = (int)ready.size();
+    chunks.insert(chunks.end(), ready.begin(), ready.end());
+    ready.clear();
+    return count;
+}
+
+static inline int phaseOf(int cx, int cy) {
+    return (cy & 1) * 2 + (cx & 1);
+}
+
+void MapGenerator::run(int focusX, int focusY) {
+    auto startTime = std::chrono::steady_clock::now();
+    int threads = threadCount > 0 ? threadCount : defaultThreadCount();
+    std::vector<int> order;
+
+    for (int phase = 0; phase < 4 && !quit; ++phase) {
+        order.clear();
+        for (int cy = 0; cy < chunksY(); ++cy)
+            for (int cx = 0; cx < chunksX(); ++cx)
+                if (phaseOf(cx, cy) == phase)
+                    order.push_back(cy * chunksX() + cx);
+        auto distance = [&](int chunk) {
+            long dx = (long)(chunk % chunksX()) * chunkSize + chunkSize / 2 - focusX;
+            long dy = (long)(chunk / chunksX()) * chunkSize + chunkSize / 2 - focusY;
+            return dx * dx + dy * dy;
+        };
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return distance(a) < distance(b); });
+
+        // cada thread pega o proximo chunk da lista (os perto do foco saem
+        // primeiro e chunks caros nao seguram uma faixa inteira)
+        std::atomic<size_t> next{ 0 };
+        parallelFor((size_t)threads, threads, 1, [&](size_t, size_t) {
+            Scratch s;
+            for (;;) {
+                size_t i = next++;
+                if (i >= order.size() || quit)
+                    break;
+                generateChunk(order[i], phase, s);
+                std::lock_guard<std::mutex> lock(mutex);
+                ready.push_back(order[i]);
+            }
+        });
+    }
+
+    elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    done = true;
+}
+
+// soma das oitavas de ruido de valor em out (stride = w arredondado para 4);
+// cada oitava tem uma rede de valores aleatorios com um ponto a cada period
+// tiles e interpola com smoothstep entre os 4 pontos em volta da celula
+void MapGenerator::noise(Scratch& s, float* out, int x0, int y0, int w, int h, const int* periods, int octaves, uint32_t salt) {
+    int stride = (w + 3) & ~3;
+    std::fill(out, out + (size_t)stride * h, 0.0f);
+    s.fraction.resize(stride);
+
+    float amplitude = 1.0f, total = 0.0f;
+    for (int o = 0; o < octaves; ++o) {
+        int period = periods[o];
+        float inv = 1.0f / period;
+        uint32_t octaveSeed = seed * 0x9e3779b9u + salt + (uint32_t)o * 0x632be5abu;
+
+        // pontos da rede que cobrem o chunk (coordenadas nunca negativas)
+        int lx0 = x0 / period, ly0 = y0 / period;
+        int nx = (x0 + stride - 1) / period - lx0 + 2;
+        int ny = (y0 + h - 1) / period - ly0 + 2;
+        s.lattice.resize((size_t)nx * ny);
+        for (int j = 0; j < ny; ++j)
+            for (int i = 0; i < nx; ++i)
+                s.lattice[j * nx + i] = (hashCell(lx0 + i, ly0 + j, octaveSeed) >> 8) * (1.0f / 16777216.0f);
+        for (int x = 0; x < stride; ++x)
+            s.fraction[x] = smooth(((x0 + x) % period) * inv);
+
+        for (int y = 0; y < h; ++y) {
+            int gy = y0 + y;
+            const float* row0 = &s.lattice[(gy / period - ly0) * nx];
+            const float* row1 = row0 + nx;
+            float ty = smooth((gy % period) * inv);
+            float* dst = out + (size_t)y * stride;
+#ifdef MAPGEN_SSE2
+            if (simd) {
+                // period e x0 multiplos de 4: as 4 celulas do grupo estao entre
+                // os mesmos pontos da rede, so a fracao em x muda
+                __m128 amp = _mm_set1_ps(amplitude);
+                for (int x = 0; x < stride; x += 4) {
+                    int i = (x0 + x) / period - lx0;
+                    float left = row0[i] + (row1[i] - row0[i]) * ty;
+                    float right = row0[i + 1] + (row1[i + 1] - row0[i + 1]) * ty;
+                    __m128 l = _mm_set1_ps(left);
+                    __m128 v = _mm_add_ps(l, _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(right), l), _mm_loadu_ps(&s.fraction[x])));
+                    _mm_storeu_ps(dst + x, _mm_add_ps(_mm_loadu_ps(dst + x), _mm_mul_ps(v, amp)));
+                }
+                continue;
+            }
+#endif
+            for (int x = 0; x < stride; ++x) {
+                int i = (x0 + x) / period - lx0;
+                float left = row0[i] + (row1[i] - row0[i]) * ty;
+                float right = row0[i + 1] + (row1[i + 1] - row0[i + 1]) * ty;
+                dst[x] += (left + (right - left) * s.fraction[x]) * amplitude;
+            }
+        }
+        total += amplitude;
+        amplitude *= 0.5f;
+    }
+
+    float scale = 1.0f / total;
+    for (size_t i = 0; i < (size_t)stride * h; ++i)
+        out[i] *= scale;
+}
+
+void MapGenerator::generateChunk(int chunk, int phase, Scratch& s) {
+    int x0, y0, w, h;
+    chunkRect(chunk, x0, y0, w, h);
+    int stride = (w + 3) & ~3;
+    int cx = chunk % chunksX(), cy = chunk / chunksX();
+
+    // 1) altura e umidade -> opcoes iniciais, parede e colisao
+    s.heightField.resize((size_t)stride * h);
+    s.moisture.resize((size_t)stride * h);
+    noise(s, s.heightField.data(), x0, y0, w, h, HEIGHT_PERIODS, 6, 0);
+    noise(s, s.moisture.data(), x0, y0, w, h, MOISTURE_PERIODS, 2, 0x51ed27u);
+
+    s.domain.resize((size_t)w * h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            float height = s.heightField[y * stride + x];
+            size_t b = 0;
+            while (b + 1 < rules.bands.size() && height > rules.bands[b].maxHeight)
+                b++;
+            const MapBand& band = rules.bands[b];
+            s.domain[y * w + x] = s.moisture[y * stride + x] < 0.5f ? band.dryTiles : band.wetTiles;
+            size_t cell = (size_t)(y0 + y) * width + x0 + x;
+            wall[cell] = (int8_t)band.wallTile;
+            solid[cell] = band.solid ? 1 : 0;
+        }
+    }
+
+    long localConflicts = 0;
+    // restringe d pelo tile ja escolhido do vizinho fora do chunk, se ele for
+    // de uma fase anterior (ja pronto)
+    auto seam = [&](int x, int y, int nx, int ny) {
+        if (nx < 0 || ny < 0 || nx >= width || ny >= height)
+            return;
+        if (phaseOf(nx / chunkSize, ny / chunkSize) >= phase)
+            return;
+        uint16_t& d = s.domain[(y - y0) * w + (x - x0)];
+        uint16_t restricted = d & rules.compatible[floor[(size_t)ny * width + nx]];
+        if (restricted)
+            d = restricted;
+        else
+            localConflicts++;
+    };
+    for (int x = x0; x < x0 + w; ++x) {
+        seam(x, y0, x, y0 - 1);
+        seam(x, y0 + h - 1, x, y0 + h);
+    }
+    for (int y = y0; y < y0 + h; ++y) {
+        seam(x0, y, x0 - 1, y);
+        seam(x0 + w - 1, y, x0 + w, y);
+    }
+
+    // 2) wave function collapse dentro do chunk
+    for (int b = 0; b <= rules.tileCount; ++b)
+        s.buckets[b].clear();
+    s.stack.clear();
+
+    // tira do vizinho n o que nao combina com as opcoes de c
+    auto propagate = [&]() {
+        while (!s.stack.empty()) {
+            int c = s.stack.back();
+            s.stack.pop_back();
+            uint16_t allowed = rules.support[s.domain[c]];
+            int x = c % w, y = c / w;
+            int neighbors[4];
+            int count = 0;
+            if (x > 0) neighbors[count++] = c - 1;
+            if (x + 1 < w) neighbors[count++] = c + 1;
+            if (y > 0) neighbors[count++] = c - w;
+            if (y + 1 < h) neighbors[count++] = c + w;
+            for (int k = 0; k < count; ++k) {
+                int n = neighbors[k];
+                uint16_t d = s.domain[n] & allowed;
+                if (d == s.domain[n])
+                    continue;
+                if (!d) {
+                    localConflicts++;
+                    continue;
+                }
+                s.domain[n] = d;
+                s.stack.push_back(n);
+                int options = bits16(d);
+                if (options > 1)
+                    s.buckets[options].push_back(n);
+            }
+        }
+    };
+
+    for (int c = w * h - 1; c >= 0; --c)
+        s.stack.push_back(c);
+    propagate();
+    for (int c = 0; c < w * h; ++c) {
+        int options = bits16(s.domain[c]);
+        if (options > 1)
+            s.buckets[options].push_back(c);
+    }
+
+    // o sorteio depende so do chunk, nao de qual thread pegou
+    std::mt19937 rng(hashCell(cx, cy, seed));
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (;;) {
+        // menos opcoes primeiro; no mesmo balde, a ultima celula que encolheu
+        // (o colapso cresce a partir do que acabou de ser decidido)
+        int b = 2;
+        while (b <= rules.tileCount && s.buckets[b].empty())
+            b++;
+        if (b > rules.tileCount)
+            break;
+        int c = s.buckets[b].back();
+        s.buckets[b].pop_back();
+        uint16_t d = s.domain[c];
+        if (bits16(d) != b)
+            continue; // entrada velha: a celula ja encolheu
+
+        float total = 0.0f;
+        for (uint16_t rest = d; rest; rest &= rest - 1)
+            total += rules.weight[lowest16(rest)];
+        float pick = unit(rng) * total;
+        int tile = lowest16(d);
+        for (uint16_t rest = d; rest; rest &= rest - 1) {
+            tile = lowest16(rest);
+            pick -= rules.weight[tile];
+            if (pick < 0.0f)
+                break;
+        }
+        s.domain[c] = (uint16_t)(1u << tile);
+        s.stack.push_back(c);
+        propagate();
+    }
+
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            floor[(size_t)(y0 + y) * width + x0 + x] = (uint8_t)lowest16(s.domain[y * w + x]);
+    conflicts += localConflicts;
+}
@@ -0,0 +1,114 @@
+#ifndef MAP_GENERATOR_H
+#define MAP_GENERATOR_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+// maximo de tiles num conjunto de regras (o dominio de uma celula eh um uint16_t)
+const int MAPGEN_MAX_TILES = 16;
+
+// Faixa do terreno: celulas com altura ate maxHeight comecam com os tiles de
+// dryTiles (umidade < 0.5) ou wetTiles como opcoes. wallTile >= 0 empilha uma
+// parede com esse tile; solid faz a celula bloquear (agua funda: solida sem parede).
+struct MapBand {
+    float maxHeight;
+    uint16_t dryTiles, wetTiles;
+    int wallTile;
+    bool solid;
+};
+
+// Regras do gerador para um tileset: peso de cada tile no sorteio, quais tiles
+// podem ficar lado a lado (simetrico, vale para as 4 direcoes) e as faixas de
+// altura do ruido. Os indices sao do tileset (coluna no tilesetIso, por exemplo);
+// o gerador nao sabe se o mapa eh isometrico ou ortogonal.
+struct MapRules {
+    int tileCount = 0;
+    float weight[MAPGEN_MAX_TILES] = {};
+    uint16_t compatible[MAPGEN_MAX_TILES] = {};
+    std::vector<MapBand> bands; // em ordem crescente de maxHeight
+
+    // tiles a e b podem ser vizinhos
+    void allow(int a, int b);
+    // uniao dos compatible de cada tile do dominio, uma entrada por dominio;
+    // montada por finish()
+    std::vector<uint16_t> support;
+    void finish();
+};
+
+// regras para os 7 tiles do tilesetIso.png (areia, grama, pedra, lava, gelo,
+// agua funda, flores)
+MapRules isoTerrainRules();
+
+// Gerador de mapas grandes em chunks de chunkSize x chunkSize.
+// 1) Ruido de valor (fBm, varias oitavas) da a altura e a umidade de cada
+//    celula; a faixa da altura decide as opcoes iniciais e a parede. O ruido
+//    depende so da coordenada global, entao nao tem emenda entre chunks. Com
+//    SSE2 a interpolacao anda 4 celulas por vez (periodos multiplos de 4 fazem
+//    as 4 cairem na mesma celula da rede).
+// 2) Wave function collapse escolhe o tile do chao respeitando as vizinhancas
+//    das regras: colapsa a celula com menos opcoes e propaga. Se uma restricao
+//    esvaziaria uma celula ela eh ignorada e contada em conflicts (o mapa sai
+//    sempre, sem recomecar).
+// Os chunks rodam em 4 fases pela paridade (cx, cy): chunks da mesma fase nao
+// se tocam, entao rodam em paralelo, e a borda de um chunk ja comeca
+// restringida pelos vizinhos de fases anteriores. O resultado nao depende do
+// numero de threads. Dentro de cada fase os chunks perto do foco vao primeiro.
+struct MapGenerator {
+    int width = 0, height = 0;
+    int chunkSize = 64;  // multiplo de 4
+    uint32_t seed = 1;
+    int threadCount = 0; // 0 = todos os nucleos
+    bool simd = true;    // false forca o ruido escalar (para comparar)
+    MapRules rules;
+
+    // resultado, uma entrada por celula (linha por linha)
+    std::vector<uint8_t> floor; // tile do chao
+    std::vector<int8_t> wall;   // tile da parede, -1 = sem parede
+    std::vector<uint8_t> solid; // 1 = bloqueia
+
+    // estatisticas
+    std::atomic<long> conflicts{ 0 };
+    double elapsedMs = 0.0;     // da geracao inteira, quando termina
+
+    // gera tudo e volta quando acabar
+    bool generate();
+    // gera numa thread; os chunks perto de (focusX, focusY) saem primeiro em cada fase
+    bool start(int focusX, int focusY);
+    // chunks prontos desde a ultima chamada (indice cy * chunksX + cx); os dados
+    // deles em floor/wall/solid podem ser lidos
+    int collect(std::vector<int>& chunks);
+    bool finished() const { return done; }
+    // interrompe (se ainda estiver gerando) e espera a thread
+    void stop();
+    ~MapGenerator() { stop(); }
+
+    int chunksX() const { return (width + chunkSize - 1) / chunkSize; }
+    int chunksY() const { return (height + chunkSize - 1) / chunkSize; }
+    void chunkRect(int chunk, int& x0, int& y0, int& w, int& h) const;
+
+    // uso interno
+    struct Scratch {
+        std::vector<float> heightField, moisture, lattice, fraction;
+        std::vector<uint16_t> domain;
+        std::vector<int> stack;
+        std::vector<int> buckets[MAPGEN_MAX_TILES + 1];
+    };
+    std::thread worker;
+    std::mutex mutex;
+    std::deque<int> ready;
+    std::atomic<bool> quit{ false };
+    std::atomic<bool> done{ false };
+    bool prepare();
+    void run(int focusX, int focusY);
+    void generateChunk(int chunk, int phase, Scratch& s);
+    void noise(Scratch& s, float* out, int x0, int y0, int w, int h, const int* periods, int octaves, uint32_t salt);
+};
+
+bool mapGeneratorHasSimd();
+
+#endif
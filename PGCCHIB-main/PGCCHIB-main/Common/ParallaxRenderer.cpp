@@ -0,0 +1,174 @@
+#include "ParallaxRenderer.h"
+
+#include <iostream>
+
+static const char* parallaxVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+
+out vec2 TexCoord;
+
+uniform float scale;
+
+void main()
+{
+    gl_Position = vec4(aPos * scale, 0.0, 1.0);
+    TexCoord = aTexCoord;
+}
+)";
+
+// compoe da frente para tras (operador "under"): cada camada so contribui
+// com o que sobra de transparencia, e o loop termina quando o pixel fica opaco
+static const char* parallaxFragmentSource = R"(
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoord;
+
+uniform sampler2DArray layers;
+uniform float offsets[8];
+uniform int layerCount;
+uniform vec3 background;
+
+void main()
+{
+    vec3 color = vec3(0.0);
+    float alpha = 0.0;
+
+    for (int i = layerCount - 1; i >= 0; --i) {
+        vec4 c = textureLod(layers, vec3(TexCoord.x + offsets[i], TexCoord.y, float(i)), 0.0);
+        float w = (1.0 - alpha) * c.a;
+        color += w * c.rgb;
+        alpha += w;
+        if (alpha >= 0.996)
+            break;
+    }
+
+    FragColor = vec4(color + (1.0 - alpha) * background, 1.0);
+}
+)";
+
+static GLuint compileParallaxShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cerr << "Erro ao compilar shader do parallax: " << infoLog << std::endl;
+    }
+    return shader;
+}
+
+bool ParallaxRenderer::init(int width, int height, int layerCount) {
+    if (layerCount < 1 || layerCount > PARALLAX_MAX_LAYERS) {
+        std::cerr << "ParallaxRenderer: numero de camadas invalido (" << layerCount << ")" << std::endl;
+        return false;
+    }
+    this->width = width;
+    this->height = height;
+    this->layerCount = layerCount;
+
+    GLuint vertexShader = compileParallaxShader(GL_VERTEX_SHADER, parallaxVertexSource);
+    GLuint fragmentShader = compileParallaxShader(GL_FRAGMENT_SHADER, parallaxFragmentSource);
+
+    program = glCreateProgram();
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Erro ao linkar shader do parallax: " << infoLog << std::endl;
+        return false;
+    }
+
+    offsetsLoc = glGetUniformLocation(program, "offsets");
+    layerCountLoc = glGetUniformLocation(program, "layerCount");
+    scaleLoc = glGetUniformLocation(program, "scale");
+    backgroundLoc = glGetUniformLocation(program, "background");
+
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "layers"), 0);
+    glUniform1i(layerCountLoc, layerCount);
+
+    // quad de tela cheia
+    float quadVertices[] = {
+        // positions    // texcoords
+        -1.0f,  1.0f,   0.0f, 1.0f,
+        -1.0f, -1.0f,   0.0f, 0.0f,
+         1.0f,  1.0f,   1.0f, 1.0f,
+         1.0f, -1.0f,   1.0f, 0.0f
+    };
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+
+    // array de texturas com uma fatia por camada
+    glGenTextures(1, &textureArray);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, layerCount, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    return true;
+}
+
+void ParallaxRenderer::setLayer(int index, const unsigned char* rgba) {
+    if (index < 0 || index >= layerCount || !rgba) return;
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, index, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+}
+
+void ParallaxRenderer::draw(float scale) {
+    // o shader ja compoe sobre a cor de fundo, entao nao precisa de blending
+    GLboolean blendWasEnabled = glIsEnabled(GL_BLEND);
+    if (blendWasEnabled) glDisable(GL_BLEND);
+
+    glUseProgram(program);
+    glUniform1fv(offsetsLoc, layerCount, offsets);
+    glUniform1f(scaleLoc, scale);
+    glUniform3fv(backgroundLoc, 1, backgroundColor);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray);
+
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    if (blendWasEnabled) glEnable(GL_BLEND);
+}
+
+void ParallaxRenderer::destroy() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteTextures(1, &textureArray);
+    glDeleteProgram(program);
+    VAO = VBO = textureArray = program = 0;
+    layerCount = 0;
+}
@@ -0,0 +1,47 @@
+#ifndef PARALLAX_RENDERER_H
+#define PARALLAX_RENDERER_H
+
+#include <glad/glad.h>
+
+// numero maximo de camadas no array de texturas (tamanho do array de uniforms no shader)
+const int PARALLAX_MAX_LAYERS = 8;
+
+// Renderer de parallax que compoe todas as camadas em uma unica passada.
+// As camadas ficam em uma GL_TEXTURE_2D_ARRAY (todas com o mesmo tamanho),
+// cada uma com seu offset em um array de uniforms. O fragment shader compoe
+// da camada da frente para a de tras e para assim que o pixel fica opaco,
+// entao cada pixel da tela eh escrito uma unica vez.
+struct ParallaxRenderer {
+    GLuint program = 0;
+    GLuint textureArray = 0;
+    GLuint VAO = 0, VBO = 0;
+
+    int width = 0, height = 0;
+    int layerCount = 0;
+
+    // offset horizontal de cada camada, em coordenadas de textura
+    // (camada 0 eh a do fundo, layerCount - 1 a da frente)
+    float offsets[PARALLAX_MAX_LAYERS] = {};
+
+    // cor atras de todas as camadas (substitui o glClear + blending)
+    float backgroundColor[3] = {0.0f, 0.0f, 0.0f};
+
+    // locations cacheadas no init, nada de glGetUniformLocation por frame
+    GLint offsetsLoc = -1;
+    GLint layerCountLoc = -1;
+    GLint scaleLoc = -1;
+    GLint backgroundLoc = -1;
+
+    // cria o programa, o quad e o array de texturas (width x height x layerCount)
+    bool init(int width, int height, int layerCount);
+
+    // envia os pixels RGBA (width * height * 4 bytes) da camada index
+    void setLayer(int index, const unsigned char* rgba);
+
+    // desenha todas as camadas com um unico draw call
+    void draw(float scale = 1.0f);
+
+    void destroy();
+};
+
+#endif
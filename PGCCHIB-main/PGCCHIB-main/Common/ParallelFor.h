@@ -0,0 +1,45 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+// numero de threads a usar quando o chamador passa 0
+inline int defaultThreadCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : (int)n;
+}
+
+// Divide [0, count) em faixas contiguas e chama fn(begin, end) para cada uma,
+// uma faixa por thread. A thread que chama tambem trabalha (processa a ultima faixa).
+// Com poucos itens (menos que minPerThread por thread) roda tudo na thread atual.
+template <typename Fn>
+void parallelFor(size_t count, int threadCount, size_t minPerThread, Fn fn) {
+    if (threadCount <= 0) threadCount = defaultThreadCount();
+    if (minPerThread == 0) minPerThread = 1;
+
+    size_t maxThreads = count / minPerThread;
+    if (maxThreads < (size_t)threadCount) threadCount = (int)(maxThreads == 0 ? 1 : maxThreads);
+    if (threadCount <= 1) {
+        fn((size_t)0, count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount - 1);
+    size_t per = (count + threadCount - 1) / threadCount;
+    for (int t = 0; t < threadCount - 1; ++t) {
+        size_t begin = t * per;
+        size_t end = begin + per < count ? begin + per : count;
+        if (begin >= end) break;
+        workers.emplace_back([=]() { fn(begin, end); });
+    }
+
+    size_t last = (size_t)(threadCount - 1) * per;
+    if (last < count) fn(last, count);
+
+    for (std::thread& w : workers) w.join();
+}
+
+#endif
@@ -0,0 +1,534 @@
+#include "ParticleSystem.h"
+#include "ParallelFor.h"
+
+#include <iostream>
+#include <cstddef>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLES_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// CPU
+
+static inline uint32_t xorshift(uint32_t s) {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+// [0, 1) a partir dos 23 bits altos do estado (mantissa de um float em [1, 2))
+static inline float unitFloat(uint32_t s) {
+    union { uint32_t u; float f; } bits;
+    bits.u = (s >> 9) | 0x3F800000u;
+    return bits.f - 1.0f;
+}
+
+static inline float dampFactor(const ParticleEmitter& e, float dt) {
+    float damp = 1.0f - e.drag * dt;
+    return damp < 0.0f ? 0.0f : damp;
+}
+
+void ParticlePool::init(size_t n, const ParticleEmitter& emitter, uint32_t baseSeed) {
+    count = (n + 3) & ~(size_t)3;
+    x.assign(count, 0.0f);
+    y.assign(count, 0.0f);
+    vx.assign(count, 0.0f);
+    vy.assign(count, 0.0f);
+    age.resize(count);
+    life.assign(count, 0.0f);
+    seed.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        // semente diferente por particula (nunca zero, senao o xorshift para)
+        uint32_t s = (uint32_t)(i + 1) * 2654435761u ^ baseSeed * 0x9E3779B9u;
+        s = xorshift(s == 0 ? 1u : s);
+        seed[i] = s;
+        age[i] = -unitFloat(s) * emitter.maxLife;
+    }
+}
+
+void updateParticlesScalar(ParticlePool& p, size_t begin, size_t end, const ParticleEmitter& e, float dt) {
+    float damp = dampFactor(e, dt);
+    float axdt = e.acceleration.x * dt, aydt = e.acceleration.y * dt;
+    float lifeRange = e.maxLife - e.minLife;
+
+    for (size_t i = begin; i < end; ++i) {
+        float age = p.age[i] + dt;
+        float vx = (p.vx[i] + axdt) * damp;
+        float vy = (p.vy[i] + aydt) * damp;
+        float x = p.x[i] + vx * dt;
+        float y = p.y[i] + vy * dt;
+        float life = p.life[i];
+
+        if (e.emitting && age >= life) {
+            uint32_t s0 = xorshift(p.seed[i]);
+            uint32_t s1 = xorshift(s0), s2 = xorshift(s1), s3 = xorshift(s2), s4 = xorshift(s3);
+            x = e.position.x + (unitFloat(s0) * 2.0f - 1.0f) * e.radius;
+            y = e.position.y + (unitFloat(s1) * 2.0f - 1.0f) * e.radius;
+            vx = e.velocity.x + (unitFloat(s2) * 2.0f - 1.0f) * e.velocitySpread.x;
+            vy = e.velocity.y + (unitFloat(s3) * 2.0f - 1.0f) * e.velocitySpread.y;
+            life = e.minLife + unitFloat(s4) * lifeRange;
+            age = 0.0f;
+            p.seed[i] = s4;
+        }
+
+        p.x[i] = x;
+        p.y[i] = y;
+        p.vx[i] = vx;
+        p.vy[i] = vy;
+        p.age[i] = age;
+        p.life[i] = life;
+    }
+}
+
+bool particlesHaveSimd() {
+#ifdef PARTICLES_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef PARTICLES_SSE2
+static inline __m128i xorshift4(__m128i s) {
+    s = _mm_xor_si128(s, _mm_slli_epi32(s, 13));
+    s = _mm_xor_si128(s, _mm_srli_epi32(s, 17));
+    s = _mm_xor_si128(s, _mm_slli_epi32(s, 5));
+    return s;
+}
+
+// (unitFloat * 2 - 1) nas 4 lanes
+static inline __m128 signedUnit4(__m128i s) {
+    __m128i bits = _mm_or_si128(_mm_srli_epi32(s, 9), _mm_set1_epi32(0x3F800000));
+    __m128 u = _mm_sub_ps(_mm_castsi128_ps(bits), _mm_set1_ps(1.0f));
+    return _mm_sub_ps(_mm_mul_ps(u, _mm_set1_ps(2.0f)), _mm_set1_ps(1.0f));
+}
+
+static inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+void updateParticlesSimd(ParticlePool& p, size_t begin, size_t end, const ParticleEmitter& e, float dt) {
+#ifdef PARTICLES_SSE2
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 damp = _mm_set1_ps(dampFactor(e, dt));
+    const __m128 axdt = _mm_set1_ps(e.acceleration.x * dt), aydt = _mm_set1_ps(e.acceleration.y * dt);
+    const __m128 ex = _mm_set1_ps(e.position.x), ey = _mm_set1_ps(e.position.y);
+    const __m128 radius = _mm_set1_ps(e.radius);
+    const __m128 evx = _mm_set1_ps(e.velocity.x), evy = _mm_set1_ps(e.velocity.y);
+    const __m128 spreadX = _mm_set1_ps(e.velocitySpread.x), spreadY = _mm_set1_ps(e.velocitySpread.y);
+    const __m128 minLife = _mm_set1_ps(e.minLife), lifeRange = _mm_set1_ps(e.maxLife - e.minLife);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (size_t i = begin; i < end; i += 4) {
+        __m128 age = _mm_add_ps(_mm_loadu_ps(&p.age[i]), vdt);
+        __m128 vx = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&p.vx[i]), axdt), damp);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&p.vy[i]), aydt), damp);
+        __m128 x = _mm_add_ps(_mm_loadu_ps(&p.x[i]), _mm_mul_ps(vx, vdt));
+        __m128 y = _mm_add_ps(_mm_loadu_ps(&p.y[i]), _mm_mul_ps(vy, vdt));
+        __m128 life = _mm_loadu_ps(&p.life[i]);
+
+        __m128 dead = _mm_cmpge_ps(age, life);
+        if (e.emitting && _mm_movemask_ps(dead)) {
+            // renasce nas lanes mortas: gera para as 4 e escolhe pela mascara
+            __m128i s0 = xorshift4(_mm_loadu_si128((const __m128i*)&p.seed[i]));
+            __m128i s1 = xorshift4(s0), s2 = xorshift4(s1), s3 = xorshift4(s2), s4 = xorshift4(s3);
+
+            x = select4(dead, _mm_add_ps(ex, _mm_mul_ps(signedUnit4(s0), radius)), x);
+            y = select4(dead, _mm_add_ps(ey, _mm_mul_ps(signedUnit4(s1), radius)), y);
+            vx = select4(dead, _mm_add_ps(evx, _mm_mul_ps(signedUnit4(s2), spreadX)), vx);
+            vy = select4(dead, _mm_add_ps(evy, _mm_mul_ps(signedUnit4(s3), spreadY)), vy);
+
+            __m128 u4 = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_srli_epi32(s4, 9), _mm_set1_epi32(0x3F800000))), one);
+            life = select4(dead, _mm_add_ps(minLife, _mm_mul_ps(u4, lifeRange)), life);
+            age = _mm_andnot_ps(dead, age);
+
+            __m128i deadBits = _mm_castps_si128(dead);
+            __m128i oldSeed = _mm_loadu_si128((const __m128i*)&p.seed[i]);
+            __m128i seed = _mm_or_si128(_mm_and_si128(deadBits, s4), _mm_andnot_si128(deadBits, oldSeed));
+            _mm_storeu_si128((__m128i*)&p.seed[i], seed);
+        }
+
+        _mm_storeu_ps(&p.x[i], x);
+        _mm_storeu_ps(&p.y[i], y);
+        _mm_storeu_ps(&p.vx[i], vx);
+        _mm_storeu_ps(&p.vy[i], vy);
+        _mm_storeu_ps(&p.age[i], age);
+        _mm_storeu_ps(&p.life[i], life);
+    }
+#else
+    updateParticlesScalar(p, begin, end, e, dt);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// shaders
+
+// desenho: os dois backends entregam x, y, idade e vida por particula
+static const char* particleVertexSource = R"(
+#version 330 core
+layout (location = 0) in float px;
+layout (location = 1) in float py;
+layout (location = 2) in float age;
+layout (location = 3) in float life;
+
+uniform mat4 viewProjection;
+uniform float pointScale;
+
+out float t;
+
+void main()
+{
+    // nao nasceu ou ja morreu: joga para fora do volume de recorte
+    if (age < 0.0 || age >= life) {
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        gl_PointSize = 1.0;
+        t = 1.0;
+        return;
+    }
+    t = age / life;
+    gl_Position = viewProjection * vec4(px, py, 0.0, 1.0);
+    gl_PointSize = pointScale * (0.6 + 0.8 * t);
+}
+)";
+
+static const char* particleFragmentSource = R"(
+#version 330 core
+in float t;
+out vec4 FragColor;
+
+uniform sampler2D sheet;
+uniform float frames;
+uniform vec4 rect;
+
+void main()
+{
+    float frame = min(floor(t * frames), frames - 1.0);
+    vec2 uv = vec2(mix(rect.x, rect.z, gl_PointCoord.x) + frame / frames,
+                   mix(rect.w, rect.y, gl_PointCoord.y));
+    vec4 c = texture(sheet, uv);
+    c.a *= 1.0 - smoothstep(0.7, 1.0, t);
+    if (c.a < 0.01)
+        discard;
+    FragColor = c;
+}
+)";
+
+// atualizacao por transform feedback: as mesmas contas do updateParticlesScalar
+static const char* particleUpdateSource = R"(
+#version 330 core
+layout (location = 0) in float px;
+layout (location = 1) in float py;
+layout (location = 2) in float vx;
+layout (location = 3) in float vy;
+layout (location = 4) in float age;
+layout (location = 5) in float life;
+layout (location = 6) in uint seed;
+
+uniform float dt;
+uniform vec2 emitterPos;
+uniform float emitterRadius;
+uniform vec2 velocity;
+uniform vec2 spread;
+uniform vec2 acceleration;
+uniform float damp;
+uniform vec2 lifeRange; // min, max - min
+uniform bool emitting;
+
+out float outPx;
+out float outPy;
+out float outVx;
+out float outVy;
+out float outAge;
+out float outLife;
+flat out uint outSeed;
+
+uint xorshift(uint s)
+{
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+}
+
+float signedUnit(uint s)
+{
+    return (uintBitsToFloat((s >> 9) | 0x3F800000u) - 1.0) * 2.0 - 1.0;
+}
+
+void main()
+{
+    float a = age + dt;
+    float nvx = (vx + acceleration.x * dt) * damp;
+    float nvy = (vy + acceleration.y * dt) * damp;
+    float x = px + nvx * dt;
+    float y = py + nvy * dt;
+    float l = life;
+    uint s = seed;
+
+    if (emitting && a >= l) {
+        uint s0 = xorshift(s);
+        uint s1 = xorshift(s0);
+        uint s2 = xorshift(s1);
+        uint s3 = xorshift(s2);
+        uint s4 = xorshift(s3);
+        x = emitterPos.x + signedUnit(s0) * emitterRadius;
+        y = emitterPos.y + signedUnit(s1) * emitterRadius;
+        nvx = velocity.x + signedUnit(s2) * spread.x;
+        nvy = velocity.y + signedUnit(s3) * spread.y;
+        l = lifeRange.x + (uintBitsToFloat((s4 >> 9) | 0x3F800000u) - 1.0) * lifeRange.y;
+        a = 0.0;
+        s = s4;
+    }
+
+    outPx = x;
+    outPy = y;
+    outVx = nvx;
+    outVy = nvy;
+    outAge = a;
+    outLife = l;
+    outSeed = s;
+}
+)";
+
+static GLuint compileParticleShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, NULL);
+    glCompileShader(shader);
+
+    GLint success;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetShaderInfoLog(shader, 512, NULL, infoLog);
+        std::cerr << "Erro ao compilar shader de particulas: " << infoLog << std::endl;
+    }
+    return shader;
+}
+
+static bool linkParticleProgram(GLuint program) {
+    glLinkProgram(program);
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Erro ao linkar shader de particulas: " << infoLog << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// ParticleSystem
+
+// layout intercalado do backend GPU (a mesma ordem dos varyings)
+struct GpuParticle {
+    float x, y, vx, vy, age, life;
+    uint32_t seed;
+};
+
+static const char* particleVaryings[] = { "outPx", "outPy", "outVx", "outVy", "outAge", "outLife", "outSeed" };
+
+bool ParticleSystem::init(size_t n, ParticleBackend backend) {
+    destroy();
+    mode = backend;
+
+    GLuint vs = compileParticleShader(GL_VERTEX_SHADER, particleVertexSource);
+    GLuint fs = compileParticleShader(GL_FRAGMENT_SHADER, particleFragmentSource);
+    drawProgram = glCreateProgram();
+    glAttachShader(drawProgram, vs);
+    glAttachShader(drawProgram, fs);
+    bool ok = linkParticleProgram(drawProgram);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    if (!ok) return false;
+
+    viewProjectionLoc = glGetUniformLocation(drawProgram, "viewProjection");
+    pointScaleLoc = glGetUniformLocation(drawProgram, "pointScale");
+    framesLoc = glGetUniformLocation(drawProgram, "frames");
+    rectLoc = glGetUniformLocation(drawProgram, "rect");
+    sheetLoc = glGetUniformLocation(drawProgram, "sheet");
+
+    // os dois backends comecam do mesmo estado
+    pool.init(n, emitter);
+    capacity = pool.count;
+
+    return mode == PARTICLES_GPU ? initGpu() : initCpu();
+}
+
+bool ParticleSystem::initCpu() {
+    glGenBuffers(1, &buffers[0]);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+    glBufferData(GL_ARRAY_BUFFER, capacity * 4 * sizeof(float), NULL, GL_STREAM_DRAW);
+
+    // x, y, idade e vida um depois do outro no mesmo buffer (SoA tambem na GPU)
+    glGenVertexArrays(1, &drawVAO[0]);
+    glBindVertexArray(drawVAO[0]);
+    for (GLuint field = 0; field < 4; ++field) {
+        glVertexAttribPointer(field, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(field * capacity * sizeof(float)));
+        glEnableVertexAttribArray(field);
+    }
+    glBindVertexArray(0);
+    return true;
+}
+
+bool ParticleSystem::initGpu() {
+    GLuint vs = compileParticleShader(GL_VERTEX_SHADER, particleUpdateSource);
+    updateProgram = glCreateProgram();
+    glAttachShader(updateProgram, vs);
+    glTransformFeedbackVaryings(updateProgram, 7, particleVaryings, GL_INTERLEAVED_ATTRIBS);
+    bool ok = linkParticleProgram(updateProgram);
+    glDeleteShader(vs);
+    if (!ok) return false;
+
+    dtLoc = glGetUniformLocation(updateProgram, "dt");
+    emitterPosLoc = glGetUniformLocation(updateProgram, "emitterPos");
+    emitterRadiusLoc = glGetUniformLocation(updateProgram, "emitterRadius");
+    velocityLoc = glGetUniformLocation(updateProgram, "velocity");
+    spreadLoc = glGetUniformLocation(updateProgram, "spread");
+    accelerationLoc = glGetUniformLocation(updateProgram, "acceleration");
+    dampLoc = glGetUniformLocation(updateProgram, "damp");
+    lifeLoc = glGetUniformLocation(updateProgram, "lifeRange");
+    emittingLoc = glGetUniformLocation(updateProgram, "emitting");
+
+    std::vector<GpuParticle> initial(capacity);
+    for (size_t i = 0; i < capacity; ++i)
+        initial[i] = { pool.x[i], pool.y[i], pool.vx[i], pool.vy[i], pool.age[i], pool.life[i], pool.seed[i] };
+    // o estado fica so na GPU daqui para frente
+    pool = ParticlePool();
+
+    glGenBuffers(2, buffers);
+    glGenVertexArrays(2, updateVAO);
+    glGenVertexArrays(2, drawVAO);
+    const GLsizei stride = sizeof(GpuParticle);
+    for (int b = 0; b < 2; ++b) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[b]);
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(GpuParticle), b == 0 ? initial.data() : NULL, GL_DYNAMIC_COPY);
+
+        glBindVertexArray(updateVAO[b]);
+        for (GLuint field = 0; field < 6; ++field) {
+            glVertexAttribPointer(field, 1, GL_FLOAT, GL_FALSE, stride, (void*)(field * sizeof(float)));
+            glEnableVertexAttribArray(field);
+        }
+        glVertexAttribIPointer(6, 1, GL_UNSIGNED_INT, stride, (void*)offsetof(GpuParticle, seed));
+        glEnableVertexAttribArray(6);
+
+        glBindVertexArray(drawVAO[b]);
+        glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GpuParticle, x));
+        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GpuParticle, y));
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GpuParticle, age));
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(GpuParticle, life));
+        for (GLuint field = 0; field < 4; ++field)
+            glEnableVertexAttribArray(field);
+    }
+    glBindVertexArray(0);
+    current = 0;
+    return true;
+}
+
+void ParticleSystem::update(float dt) {
+    if (capacity == 0) return;
+
+    if (mode == PARTICLES_CPU) {
+        // blocos de 4 particulas; faixas grandes para a thread compensar
+        const ParticleEmitter& e = emitter;
+        parallelFor(capacity / 4, threads, 4096, [&](size_t begin, size_t end) {
+            updateParticlesSimd(pool, begin * 4, end * 4, e, dt);
+        });
+
+        // orphan + um upload por campo
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[0]);
+        glBufferData(GL_ARRAY_BUFFER, capacity * 4 * sizeof(float), NULL, GL_STREAM_DRAW);
+        const std::vector<float>* fields[4] = { &pool.x, &pool.y, &pool.age, &pool.life };
+        for (size_t f = 0; f < 4; ++f)
+            glBufferSubData(GL_ARRAY_BUFFER, f * capacity * sizeof(float), capacity * sizeof(float), fields[f]->data());
+        return;
+    }
+
+    float damp = 1.0f - emitter.drag * dt;
+    glUseProgram(updateProgram);
+    glUniform1f(dtLoc, dt);
+    glUniform2f(emitterPosLoc, emitter.position.x, emitter.position.y);
+    glUniform1f(emitterRadiusLoc, emitter.radius);
+    glUniform2f(velocityLoc, emitter.velocity.x, emitter.velocity.y);
+    glUniform2f(spreadLoc, emitter.velocitySpread.x, emitter.velocitySpread.y);
+    glUniform2f(accelerationLoc, emitter.acceleration.x, emitter.acceleration.y);
+    glUniform1f(dampLoc, damp < 0.0f ? 0.0f : damp);
+    glUniform2f(lifeLoc, emitter.minLife, emitter.maxLife - emitter.minLife);
+    glUniform1i(emittingLoc, emitter.emitting ? 1 : 0);
+
+    // le de buffers[current] e escreve em buffers[1 - current], sem rasterizar
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(updateVAO[current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, buffers[1 - current]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, (GLsizei)capacity);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    current = 1 - current;
+}
+
+void ParticleSystem::download(ParticlePool& out) {
+    if (mode == PARTICLES_CPU) {
+        out = pool;
+        return;
+    }
+
+    std::vector<GpuParticle> data(capacity);
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[current]);
+    glGetBufferSubData(GL_ARRAY_BUFFER, 0, capacity * sizeof(GpuParticle), data.data());
+    out.count = capacity;
+    out.x.resize(capacity); out.y.resize(capacity);
+    out.vx.resize(capacity); out.vy.resize(capacity);
+    out.age.resize(capacity); out.life.resize(capacity);
+    out.seed.resize(capacity);
+    for (size_t i = 0; i < capacity; ++i) {
+        out.x[i] = data[i].x; out.y[i] = data[i].y;
+        out.vx[i] = data[i].vx; out.vy[i] = data[i].vy;
+        out.age[i] = data[i].age; out.life[i] = data[i].life;
+        out.seed[i] = data[i].seed;
+    }
+}
+
+void ParticleSystem::draw(const glm::mat4& viewProjection, float pixelsPerUnit) {
+    if (capacity == 0) return;
+
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    glUseProgram(drawProgram);
+    glUniformMatrix4fv(viewProjectionLoc, 1, GL_FALSE, glm::value_ptr(viewProjection));
+    glUniform1f(pointScaleLoc, size * pixelsPerUnit);
+    glUniform1f(framesLoc, (float)sheet.frames);
+    glUniform4fv(rectLoc, 1, glm::value_ptr(sheet.rect));
+    glUniform1i(sheetLoc, 0);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sheet.texture);
+
+    glBindVertexArray(mode == PARTICLES_GPU ? drawVAO[current] : drawVAO[0]);
+    glDrawArrays(GL_POINTS, 0, (GLsizei)capacity);
+    glBindVertexArray(0);
+}
+
+void ParticleSystem::destroy() {
+    if (drawProgram) glDeleteProgram(drawProgram);
+    if (updateProgram) glDeleteProgram(updateProgram);
+    glDeleteBuffers(2, buffers);
+    glDeleteVertexArrays(2, updateVAO);
+    glDeleteVertexArrays(2, drawVAO);
+    drawProgram = updateProgram = 0;
+    buffers[0] = buffers[1] = 0;
+    updateVAO[0] = updateVAO[1] = drawVAO[0] = drawVAO[1] = 0;
+    capacity = 0;
+    pool = ParticlePool();
+}
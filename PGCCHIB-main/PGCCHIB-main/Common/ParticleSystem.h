@@ -0,0 +1,105 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Parametros de emissao e movimento (iguais para os dois backends).
+// Cada particula nasce em um quadrado de lado 2 * radius em volta de position,
+// com velocidade velocity +- velocitySpread, e vive entre minLife e maxLife
+// segundos. Quando morre ela eh reaproveitada (renasce) se emitting for true;
+// a taxa de emissao fica capacidade / vida media.
+struct ParticleEmitter {
+    glm::vec2 position = glm::vec2(0.0f);
+    float radius = 1.0f;
+    glm::vec2 velocity = glm::vec2(0.0f, 1.0f);
+    glm::vec2 velocitySpread = glm::vec2(0.5f);
+    glm::vec2 acceleration = glm::vec2(0.0f); // vento, empuxo da fumaca etc.
+    float drag = 0.0f;                         // fracao da velocidade perdida por segundo
+    float minLife = 1.0f, maxLife = 2.0f;
+    bool emitting = true;
+};
+
+// Particulas em SoA: um vetor por campo, para o laco de atualizacao carregar
+// 4 particulas de cada vez em registradores SSE. age < 0 = ainda nao nasceu,
+// age >= life = morta (nenhuma das duas eh desenhada).
+struct ParticlePool {
+    std::vector<float> x, y, vx, vy, age, life;
+    std::vector<uint32_t> seed; // estado do xorshift de cada particula
+    size_t count = 0;           // sempre multiplo de 4
+
+    // count eh arredondado para cima para multiplo de 4. As particulas comecam
+    // com idades negativas espalhadas em maxLife, entao vao nascendo aos poucos
+    void init(size_t count, const ParticleEmitter& emitter, uint32_t seed = 1);
+};
+
+// Atualiza as particulas [begin, end) (begin e end multiplos de 4).
+// A versao SIMD usa SSE2 quando o compilador tem (x86-64 sempre tem) e cai na
+// escalar caso contrario; as duas fazem as mesmas contas na mesma ordem.
+void updateParticlesScalar(ParticlePool& pool, size_t begin, size_t end, const ParticleEmitter& emitter, float dt);
+void updateParticlesSimd(ParticlePool& pool, size_t begin, size_t end, const ParticleEmitter& emitter, float dt);
+bool particlesHaveSimd();
+
+enum ParticleBackend {
+    PARTICLES_CPU, // SoA + SSE em varias threads, enviado para a GPU a cada frame
+    PARTICLES_GPU  // transform feedback: as particulas nunca saem da GPU
+};
+
+// Recorte da folha de animacao: frames lado a lado na horizontal, rect eh a
+// area usada dentro do primeiro frame em UV (u0, v0, u1, v1) e os outros frames
+// sao deslocados de 1 / frames em u. O frame desenhado segue a idade da particula.
+struct ParticleSheet {
+    GLuint texture = 0;
+    int frames = 1;
+    glm::vec4 rect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+};
+
+// Sistema de particulas com dois backends e o mesmo desenho: um unico
+// glDrawArrays(GL_POINTS) com point sprites amostrando a folha de animacao.
+struct ParticleSystem {
+    ParticleEmitter emitter;
+    ParticleSheet sheet;
+    float size = 1.0f; // lado da particula em unidades do mundo (cresce com a idade)
+    int threads = 0;   // backend CPU: 0 = todas
+
+    bool init(size_t count, ParticleBackend backend);
+    void update(float dt);
+    // pixelsPerUnit converte size para pixels (gl_PointSize). Liga o blending
+    // alfa e o GL_PROGRAM_POINT_SIZE
+    void draw(const glm::mat4& viewProjection, float pixelsPerUnit);
+    void destroy();
+
+    size_t count() const { return capacity; }
+    ParticleBackend backend() const { return mode; }
+    // copia o estado atual (no backend GPU le o buffer de volta; lento, so para conferir)
+    void download(ParticlePool& out);
+
+private:
+    ParticleBackend mode = PARTICLES_CPU;
+    size_t capacity = 0;
+
+    ParticlePool pool;
+
+    GLuint drawProgram = 0;
+    GLint viewProjectionLoc = -1, pointScaleLoc = -1, framesLoc = -1, rectLoc = -1, sheetLoc = -1;
+
+    GLuint updateProgram = 0;
+    GLint dtLoc = -1, emitterPosLoc = -1, emitterRadiusLoc = -1, velocityLoc = -1, spreadLoc = -1;
+    GLint accelerationLoc = -1, dampLoc = -1, lifeLoc = -1, emittingLoc = -1;
+
+    // CPU: um VBO com os campos um depois do outro; GPU: dois VBOs intercalados
+    // (ping-pong), com um VAO de atualizacao e um de desenho para cada
+    GLuint buffers[2] = { 0, 0 };
+    GLuint updateVAO[2] = { 0, 0 };
+    GLuint drawVAO[2] = { 0, 0 };
+    int current = 0;
+
+    bool initCpu();
+    bool initGpu();
+};
+
+#endif
@@ -0,0 +1,870 @@
+#include "Pathfinding.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+static const float SQRT2 = 1.41421356f;
+static const float INF = 1e30f;
+
+// 8 direcoes; a oposta de i eh i ^ 1
+const int FLOW_DX[8] = { 1, -1, 0, 0, 1, -1, 1, -1 };
+const int FLOW_DY[8] = { 0, 0, 1, -1, 1, -1, -1, 1 };
+
+typedef GridSearch::OpenEntry OpenEntry;
+
+// std::push_heap faz heap de maximo; invertendo a comparacao sai o menor f
+static bool greaterF(const OpenEntry& a, const OpenEntry& b) { return a.f > b.f; }
+
+static void pushOpen(std::vector<OpenEntry>& heap, float f, int cell) {
+    heap.push_back({ f, cell });
+    std::push_heap(heap.begin(), heap.end(), greaterF);
+}
+
+static OpenEntry popOpen(std::vector<OpenEntry>& heap) {
+    std::pop_heap(heap.begin(), heap.end(), greaterF);
+    OpenEntry top = heap.back();
+    heap.pop_back();
+    return top;
+}
+
+// distancia sem paredes andando em 8 direcoes
+static float octile(int dx, int dy) {
+    dx = std::abs(dx);
+    dy = std::abs(dy);
+    return (float)(dx + dy) + (SQRT2 - 2.0f) * (float)std::min(dx, dy);
+}
+
+static int sign(int v) { return (v > 0) - (v < 0); }
+
+// novo searchId; os vetores de marca so sao zerados quando crescem ou o id da volta
+static uint32_t nextSearch(uint32_t& searchId, std::vector<uint32_t>& seen, std::vector<uint32_t>& closed, size_t cells) {
+    if (seen.size() < cells) {
+        seen.assign(cells, 0);
+        closed.assign(cells, 0);
+        searchId = 0;
+    }
+    if (++searchId == 0) {
+        std::fill(seen.begin(), seen.end(), 0);
+        std::fill(closed.begin(), closed.end(), 0);
+        searchId = 1;
+    }
+    return searchId;
+}
+
+// ---------------------------------------------------------------- GridSearch
+
+// anda de (x, y) na direcao (dx, dy) ate achar um ponto de salto: o objetivo
+// ou uma celula com vizinho forcado (uma celula que so se alcanca bem passando
+// por ela). Na diagonal, para tambem onde um salto reto acharia algo.
+// Devolve o indice da celula ou -1 se bateu em parede
+int GridSearch::jumpFrom(int x, int y, int dx, int dy) const {
+    int w = boxW;
+    for (;;) {
+        if (dx && dy && !(walkable(x + dx, y) && walkable(x, y + dy)))
+            return -1;
+        x += dx;
+        y += dy;
+        if (!walkable(x, y))
+            return -1;
+        if (x == goalX && y == goalY)
+            return y * w + x;
+
+        if (dx && dy) {
+            if (jumpFrom(x, y, dx, 0) >= 0 || jumpFrom(x, y, 0, dy) >= 0)
+                return y * w + x;
+        } else if (dx) {
+            if ((walkable(x, y - 1) && !walkable(x - dx, y - 1)) || (walkable(x, y + 1) && !walkable(x - dx, y + 1)))
+                return y * w + x;
+        } else {
+            if ((walkable(x - 1, y) && !walkable(x - 1, y - dy)) || (walkable(x + 1, y) && !walkable(x + 1, y - dy)))
+                return y * w + x;
+        }
+    }
+}
+
+// os vetores so crescem: com window o retangulo muda a cada busca
+void GridSearch::reserve(size_t cells) {
+    if (g.size() < cells) {
+        g.resize(cells);
+        parent.resize(cells);
+    }
+    if (seen.size() < cells) {
+        seen.assign(cells, 0);
+        closed.assign(cells, 0);
+        searchId = 0;
+    }
+}
+
+void GridSearch::prepare(const TileCollisionMap& grid, int clusterSize) {
+    size_t side = (size_t)2 * clusterSize + 2 * window;
+    if (window > 0 && side * side < (size_t)grid.width * grid.height)
+        reserve(side * side);
+    else
+        reserve((size_t)grid.width * grid.height);
+}
+
+bool GridSearch::findPath(const TileCollisionMap& grid, PathPoint start, PathPoint goal,
+                          std::vector<PathPoint>& path, long maxExpansions) {
+    map = &grid;
+    path.clear();
+    expanded = 0;
+
+    // retangulo da busca, em celulas da grade (sem a origem)
+    int sx = start.x - grid.originX, sy = start.y - grid.originY;
+    int gx = goal.x - grid.originX, gy = goal.y - grid.originY;
+    boxX = 0;
+    boxY = 0;
+    boxW = grid.width;
+    boxH = grid.height;
+    if (window > 0) {
+        boxX = std::max(0, std::min(sx, gx) - window);
+        boxY = std::max(0, std::min(sy, gy) - window);
+        boxW = std::max(0, std::min(grid.width, std::max(sx, gx) + window + 1) - boxX);
+        boxH = std::max(0, std::min(grid.height, std::max(sy, gy) + window + 1) - boxY);
+    }
+    sx -= boxX;
+    sy -= boxY;
+    goalX = gx - boxX;
+    goalY = gy - boxY;
+
+    int w = boxW;
+    size_t cells = (size_t)boxW * boxH;
+    reserve(cells);
+    uint32_t id = nextSearch(searchId, seen, closed, cells);
+    if (!walkable(sx, sy) || !walkable(goalX, goalY))
+        return false;
+
+    int startCell = sy * w + sx, goalCell = goalY * w + goalX;
+    g[startCell] = 0.0f;
+    parent[startCell] = -1;
+    seen[startCell] = id;
+    open.clear();
+    pushOpen(open, octile(goalX - sx, goalY - sy), startCell);
+
+    while (!open.empty()) {
+        int cell = popOpen(open).cell;
+        if (closed[cell] == id)
+            continue;
+        closed[cell] = id;
+        expanded++;
+
+        if (cell == goalCell) {
+            for (int c = goalCell; c >= 0; c = parent[c])
+                path.push_back({ c % w + boxX + grid.originX, c / w + boxY + grid.originY });
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+        if (maxExpansions > 0 && expanded >= maxExpansions)
+            break;
+
+        int x = cell % w, y = cell / w;
+
+        // direcoes a tentar: no JPS so as que o caminho vindo do pai pode
+        // seguir (as outras celulas tem caminho tao bom sem passar por aqui)
+        int dirs[8][2], count = 0;
+        if (jump && parent[cell] >= 0) {
+            int dx = sign(x - parent[cell] % w), dy = sign(y - parent[cell] / w);
+            if (dx && dy) {
+                bool nextX = walkable(x + dx, y), nextY = walkable(x, y + dy);
+                if (nextY) { dirs[count][0] = 0; dirs[count++][1] = dy; }
+                if (nextX) { dirs[count][0] = dx; dirs[count++][1] = 0; }
+                if (nextX && nextY) { dirs[count][0] = dx; dirs[count++][1] = dy; }
+            } else if (dx) {
+                bool next = walkable(x + dx, y), up = walkable(x, y - 1), down = walkable(x, y + 1);
+                if (next) {
+                    dirs[count][0] = dx; dirs[count++][1] = 0;
+                    if (up) { dirs[count][0] = dx; dirs[count++][1] = -1; }
+                    if (down) { dirs[count][0] = dx; dirs[count++][1] = 1; }
+                }
+                if (up) { dirs[count][0] = 0; dirs[count++][1] = -1; }
+                if (down) { dirs[count][0] = 0; dirs[count++][1] = 1; }
+            } else {
+                bool next = walkable(x, y + dy), left = walkable(x - 1, y), right = walkable(x + 1, y);
+                if (next) {
+                    dirs[count][0] = 0; dirs[count++][1] = dy;
+                    if (left) { dirs[count][0] = -1; dirs[count++][1] = dy; }
+                    if (right) { dirs[count][0] = 1; dirs[count++][1] = dy; }
+                }
+                if (left) { dirs[count][0] = -1; dirs[count++][1] = 0; }
+                if (right) { dirs[count][0] = 1; dirs[count++][1] = 0; }
+            }
+        } else {
+            for (int d = 0; d < 8; ++d) {
+                dirs[count][0] = FLOW_DX[d];
+                dirs[count++][1] = FLOW_DY[d];
+            }
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int dx = dirs[i][0], dy = dirs[i][1];
+            int next;
+            if (jump) {
+                next = jumpFrom(x, y, dx, dy);
+            } else {
+                bool corner = !dx || !dy || (walkable(x + dx, y) && walkable(x, y + dy));
+                next = corner && walkable(x + dx, y + dy) ? (y + dy) * w + x + dx : -1;
+            }
+            if (next < 0 || closed[next] == id)
+                continue;
+
+            int nx = next % w, ny = next / w;
+            float cost = g[cell] + octile(nx - x, ny - y);
+            if (seen[next] != id || cost < g[next]) {
+                seen[next] = id;
+                g[next] = cost;
+                parent[next] = cell;
+                pushOpen(open, cost + octile(goalX - nx, goalY - ny), next);
+            }
+        }
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------- PathHierarchy
+
+void PathHierarchy::build(const TileCollisionMap& grid, int size) {
+    map = &grid;
+    clusterSize = size;
+    clustersX = (grid.width + size - 1) / size;
+    clustersY = (grid.height + size - 1) / size;
+    clusters.assign((size_t)clustersX * clustersY, Cluster());
+    nodeAt.assign((size_t)grid.width * grid.height, -1);
+    local.assign((size_t)size * size, INF);
+    dirtyList.clear();
+
+    for (int c = 0; c < (int)clusters.size(); ++c)
+        rebuildCluster(c);
+    startLabeling();
+    labelComponents();
+    rebuilds = 0;
+}
+
+void PathHierarchy::tileChanged(int x, int y) {
+    x -= map->originX;
+    y -= map->originY;
+    if ((unsigned)x >= (unsigned)map->width || (unsigned)y >= (unsigned)map->height)
+        return;
+
+    int cx = x / clusterSize, cy = y / clusterSize;
+    auto mark = [&](int mx, int my) {
+        if (mx < 0 || my < 0 || mx >= clustersX || my >= clustersY) return;
+        Cluster& cluster = clusters[my * clustersX + mx];
+        if (cluster.dirty) return;
+        cluster.dirty = true;
+        dirtyList.push_back(my * clustersX + mx);
+    };
+    mark(cx, cy);
+    // na borda as entradas sao dos dois clusters
+    if (x % clusterSize == 0) mark(cx - 1, cy);
+    if (x % clusterSize == clusterSize - 1) mark(cx + 1, cy);
+    if (y % clusterSize == 0) mark(cx, cy - 1);
+    if (y % clusterSize == clusterSize - 1) mark(cx, cy + 1);
+}
+
+int PathHierarchy::update(int maxClusters) {
+    // cada cluster eh refeito so a partir do mapa, entao a ordem nao importa e
+    // da para parar no meio; as componentes so recomecam quando acabar
+    int count = 0;
+    while (!dirtyList.empty() && (maxClusters <= 0 || count < maxClusters)) {
+        rebuildCluster(dirtyList.back());
+        dirtyList.pop_back();
+        rebuilds++;
+        count++;
+    }
+    if (count > 0 && dirtyList.empty())
+        startLabeling();
+    return count;
+}
+
+void PathHierarchy::startLabeling() {
+    for (Cluster& cluster : clusters)
+        for (Node& node : cluster.nodes)
+            node.component = -1;
+    stack.clear();
+    labelCluster = labelNode = nextComponent = 0;
+    labeling = true;
+}
+
+// busca em profundidade pelas arestas (todas tem volta: a entrada do outro
+// lado liga de volta e o caminho dentro do cluster vale nos dois sentidos).
+// O estado (pilha e proxima entrada sem rotulo) fica guardado entre chamadas
+bool PathHierarchy::labelComponents(long maxNodes) {
+    long visited = 0;
+    while (labeling) {
+        while (!stack.empty()) {
+            if (maxNodes > 0 && visited >= maxNodes)
+                return false;
+            Edge at = stack.back();
+            stack.pop_back();
+            visited++;
+            const Node& from = clusters[at.cluster].nodes[nodeAt[at.cell]];
+            for (const Edge& edge : from.edges) {
+                Node& to = clusters[edge.cluster].nodes[nodeAt[edge.cell]];
+                if (to.component < 0) {
+                    to.component = nextComponent;
+                    stack.push_back(edge);
+                }
+            }
+        }
+        // a componente da pilha acabou: a proxima entrada sem rotulo comeca outra
+        while (labelCluster < (int)clusters.size() && labelNode >= (int)clusters[labelCluster].nodes.size()) {
+            labelCluster++;
+            labelNode = 0;
+        }
+        if (labelCluster == (int)clusters.size()) {
+            labeling = false;
+            break;
+        }
+        Node& node = clusters[labelCluster].nodes[labelNode++];
+        if (node.component < 0) {
+            node.component = ++nextComponent;
+            stack.push_back({ node.cell, labelCluster, 0.0f });
+        }
+    }
+    return true;
+}
+
+int PathHierarchy::nodeFor(int c, int cell) {
+    if (nodeAt[cell] >= 0)
+        return nodeAt[cell];
+    std::vector<Node>& nodes = clusters[c].nodes;
+    nodes.push_back(Node());
+    nodes.back().cell = cell;
+    nodes.back().component = -1;
+    nodeAt[cell] = (int)nodes.size() - 1;
+    return nodeAt[cell];
+}
+
+// percorre a borda: (insideX, insideY) dentro do cluster, (outsideX, outsideY)
+// do outro lado, andando (stepX, stepY) por length celulas. Cada trecho livre
+// dos dois lados vira uma entrada no meio (curto) ou uma em cada ponta (longo).
+// Os dois clusters acham os mesmos trechos, entao cada um so cria o seu lado
+void PathHierarchy::addEntrances(int c, int insideX, int insideY, int outsideX, int outsideY, int stepX, int stepY, int length) {
+    int w = map->width;
+    const std::vector<uint8_t>& cells = map->cells;
+    auto link = [&](int t) {
+        int inside = (insideY + stepY * t) * w + insideX + stepX * t;
+        int outside = (outsideY + stepY * t) * w + outsideX + stepX * t;
+        int node = nodeFor(c, inside);
+        int outsideCluster = clusterOf(outsideX + stepX * t, outsideY + stepY * t);
+        clusters[c].nodes[node].edges.push_back({ outside, outsideCluster, 1.0f });
+    };
+
+    int runStart = -1;
+    for (int t = 0; t <= length; ++t) {
+        bool free = t < length &&
+            cells[(size_t)(insideY + stepY * t) * w + insideX + stepX * t] == TILE_EMPTY &&
+            cells[(size_t)(outsideY + stepY * t) * w + outsideX + stepX * t] == TILE_EMPTY;
+        if (free && runStart < 0)
+            runStart = t;
+        if (!free && runStart >= 0) {
+            int runEnd = t - 1;
+            if (runEnd - runStart + 1 < 6) {
+                link((runStart + runEnd) / 2);
+            } else {
+                link(runStart);
+                link(runEnd);
+            }
+            runStart = -1;
+        }
+    }
+}
+
+// Dijkstra sem sair do cluster c a partir de fromCell; resultado em local
+void PathHierarchy::localCosts(int c, int fromCell) {
+    int w = map->width, cs = clusterSize;
+    int x0 = (c % clustersX) * cs, y0 = (c / clustersX) * cs;
+    int sizeX = std::min(cs, map->width - x0), sizeY = std::min(cs, map->height - y0);
+    const std::vector<uint8_t>& cells = map->cells;
+    auto free = [&](int lx, int ly) { return cells[(size_t)(y0 + ly) * w + x0 + lx] == TILE_EMPTY; };
+
+    std::fill(local.begin(), local.end(), INF);
+    int from = (fromCell / w - y0) * cs + fromCell % w - x0;
+    local[from] = 0.0f;
+    heap.clear();
+    pushOpen(heap, 0.0f, from);
+
+    while (!heap.empty()) {
+        OpenEntry top = popOpen(heap);
+        if (top.f > local[top.cell])
+            continue;
+        int lx = top.cell % cs, ly = top.cell / cs;
+        for (int d = 0; d < 8; ++d) {
+            int dx = FLOW_DX[d], dy = FLOW_DY[d];
+            int nx = lx + dx, ny = ly + dy;
+            if (nx < 0 || ny < 0 || nx >= sizeX || ny >= sizeY || !free(nx, ny))
+                continue;
+            if (dx && dy && !(free(lx + dx, ly) && free(lx, ly + dy)))
+                continue;
+            float cost = top.f + (dx && dy ? SQRT2 : 1.0f);
+            int next = ny * cs + nx;
+            if (cost < local[next]) {
+                local[next] = cost;
+                pushOpen(heap, cost, next);
+            }
+        }
+    }
+}
+
+void PathHierarchy::rebuildCluster(int c) {
+    Cluster& cluster = clusters[c];
+    for (const Node& node : cluster.nodes)
+        nodeAt[node.cell] = -1;
+    cluster.nodes.clear();
+    cluster.dirty = false;
+    version++;
+
+    int w = map->width, h = map->height, cs = clusterSize;
+    int x0 = (c % clustersX) * cs, y0 = (c / clustersX) * cs;
+    int x1 = std::min(x0 + cs, w), y1 = std::min(y0 + cs, h);
+
+    // entradas nas quatro bordas
+    if (x0 > 0) addEntrances(c, x0, y0, x0 - 1, y0, 0, 1, y1 - y0);
+    if (x1 < w) addEntrances(c, x1 - 1, y0, x1, y0, 0, 1, y1 - y0);
+    if (y0 > 0) addEntrances(c, x0, y0, x0, y0 - 1, 1, 0, x1 - x0);
+    if (y1 < h) addEntrances(c, x0, y1 - 1, x0, y1, 1, 0, x1 - x0);
+
+    // ligacoes entre as entradas pelo caminho dentro do cluster
+    for (size_t i = 0; i < cluster.nodes.size(); ++i) {
+        localCosts(c, cluster.nodes[i].cell);
+        for (size_t j = 0; j < cluster.nodes.size(); ++j) {
+            if (j == i) continue;
+            int cell = cluster.nodes[j].cell;
+            float cost = local[(cell / w - y0) * cs + cell % w - x0];
+            if (cost < INF)
+                cluster.nodes[i].edges.push_back({ cell, c, cost });
+        }
+    }
+}
+
+size_t PathHierarchy::nodeCount() const {
+    size_t count = 0;
+    for (const Cluster& cluster : clusters)
+        count += cluster.nodes.size();
+    return count;
+}
+
+bool PathHierarchy::findPath(PathPoint start, PathPoint goal, std::vector<PathPoint>& waypoints) {
+    if (!dirtyList.empty())
+        update();
+    if (labeling)
+        labelComponents();
+    PathStatus status = beginSearch(start, goal, query, waypoints);
+    if (status == PATH_RUNNING)
+        status = continueSearch(query, 0, waypoints);
+    return status == PATH_FOUND;
+}
+
+PathStatus PathHierarchy::beginSearch(PathPoint start, PathPoint goal, Search& search,
+                                      std::vector<PathPoint>& waypoints) {
+    waypoints.clear();
+    search.version = version;
+    search.expanded = 0;
+    search.open.clear();
+    search.visits.clear();
+    expanded = 0;
+
+    int w = map->width;
+    int sx = start.x - map->originX, sy = start.y - map->originY;
+    int gx = goal.x - map->originX, gy = goal.y - map->originY;
+    if (map->get(start.x, start.y) != TILE_EMPTY || map->get(goal.x, goal.y) != TILE_EMPTY)
+        return PATH_FAILED;
+    if ((unsigned)sx >= (unsigned)map->width || (unsigned)sy >= (unsigned)map->height ||
+        (unsigned)gx >= (unsigned)map->width || (unsigned)gy >= (unsigned)map->height)
+        return PATH_FAILED;
+
+    int startCell = sy * w + sx, goalCell = gy * w + gx;
+    if (startCell == goalCell) {
+        waypoints.push_back(start);
+        return PATH_FOUND;
+    }
+    int startCluster = clusterOf(sx, sy), goalCluster = clusterOf(gx, gy);
+    int cs = clusterSize;
+    auto localAt = [&](int c, int cell) {
+        int x0 = (c % clustersX) * cs, y0 = (c / clustersX) * cs;
+        return local[(cell / w - y0) * cs + cell % w - x0];
+    };
+
+    // custo de cada entrada do cluster do objetivo ate ele (e do inicio, se
+    // estiver no mesmo cluster e der para ir direto)
+    localCosts(goalCluster, goalCell);
+    const std::vector<Node>& goalNodes = clusters[goalCluster].nodes;
+    search.goalCost.resize(goalNodes.size());
+    for (size_t i = 0; i < goalNodes.size(); ++i)
+        search.goalCost[i] = localAt(goalCluster, goalNodes[i].cell);
+    if (startCluster == goalCluster && localAt(goalCluster, startCell) < INF) {
+        waypoints.push_back(start);
+        waypoints.push_back(goal);
+        return PATH_FOUND;
+    }
+
+    // o inicio entra no grafo ligado as entradas do proprio cluster; os custos
+    // sao copiados porque o proximo localCosts sobrescreve (se o inicio for uma
+    // entrada, ele mesmo entra com custo 0)
+    localCosts(startCluster, startCell);
+    const std::vector<Node>& startNodes = clusters[startCluster].nodes;
+    search.startLinks.clear();
+    for (const Node& node : startNodes) {
+        float cost = localAt(startCluster, node.cell);
+        if (cost < INF)
+            search.startLinks.push_back({ cost, node.cell });
+    }
+
+    // sem entrada do inicio e do objetivo na mesma componente nao tem caminho
+    bool connected = false;
+    for (size_t i = 0; i < goalNodes.size() && !connected; ++i) {
+        if (search.goalCost[i] >= INF) continue;
+        for (const OpenEntry& link : search.startLinks) {
+            if (startNodes[nodeAt[link.cell]].component == goalNodes[i].component) {
+                connected = true;
+                break;
+            }
+        }
+    }
+    if (!connected)
+        return PATH_FAILED;
+
+    search.startCell = startCell;
+    search.goalCell = goalCell;
+    search.goalCluster = goalCluster;
+    search.goalX = gx;
+    search.goalY = gy;
+    search.visits[startCell] = { 0.0f, -1, false };
+    pushOpen(search.open, octile(gx - sx, gy - sy), startCell);
+    return PATH_RUNNING;
+}
+
+PathStatus PathHierarchy::continueSearch(Search& search, long maxExpansions, std::vector<PathPoint>& waypoints) {
+    int w = map->width;
+    int gx = search.goalX, gy = search.goalY;
+    auto relax = [&](int from, float fromG, int next, float cost) {
+        float total = fromG + cost;
+        auto found = search.visits.find(next);
+        if (found == search.visits.end()) {
+            search.visits[next] = { total, from, false };
+        } else {
+            if (found->second.closed || total >= found->second.g) return;
+            found->second.g = total;
+            found->second.parent = from;
+        }
+        pushOpen(search.open, total + octile(gx - next % w, gy - next / w), next);
+    };
+
+    long count = 0;
+    while (!search.open.empty()) {
+        if (maxExpansions > 0 && count >= maxExpansions) {
+            expanded = search.expanded;
+            return PATH_RUNNING;
+        }
+        int cell = popOpen(search.open).cell;
+        Search::Visit& visit = search.visits[cell];
+        if (visit.closed)
+            continue;
+        visit.closed = true;
+        // o relax pode inserir no mapa e invalidar a referencia
+        float g = visit.g;
+        count++;
+        search.expanded++;
+
+        if (cell == search.goalCell) {
+            for (int c = search.goalCell; c >= 0; c = search.visits[c].parent)
+                waypoints.push_back({ c % w + map->originX, c / w + map->originY });
+            std::reverse(waypoints.begin(), waypoints.end());
+            expanded = search.expanded;
+            return PATH_FOUND;
+        }
+
+        if (cell == search.startCell)
+            for (const OpenEntry& link : search.startLinks)
+                relax(cell, g, link.cell, link.f);
+
+        int node = nodeAt[cell];
+        if (node < 0)
+            continue;
+        int c = clusterOf(cell % w, cell / w);
+        for (const Edge& edge : clusters[c].nodes[node].edges)
+            relax(cell, g, edge.cell, edge.cost);
+        if (c == search.goalCluster && search.goalCost[node] < INF)
+            relax(cell, g, search.goalCell, search.goalCost[node]);
+    }
+    expanded = search.expanded;
+    return PATH_FAILED;
+}
+
+// ---------------------------------------------------------------- FlowField
+
+// celulas zeradas no step para cada celula do limite de expansao
+static const long CLEAR_PER_CELL = 64;
+
+void FlowField::windowFor(const TileCollisionMap& map, PathPoint target, int& x0, int& y0, int& w, int& h) const {
+    x0 = map.originX;
+    y0 = map.originY;
+    w = map.width;
+    h = map.height;
+    if (radius <= 0)
+        return;
+    int x1 = std::min(x0 + w, target.x + radius + 1), y1 = std::min(y0 + h, target.y + radius + 1);
+    x0 = std::max(x0, target.x - radius);
+    y0 = std::max(y0, target.y - radius);
+    w = std::max(0, x1 - x0);
+    h = std::max(0, y1 - y0);
+}
+
+bool FlowField::current(const TileCollisionMap& map, PathPoint target) const {
+    int x0, y0, w, h;
+    windowFor(map, target, x0, y0, w, h);
+    return !distance.empty() && goal.x == target.x && goal.y == target.y && mapVersion == map.version &&
+           width == w && height == h && originX == x0 && originY == y0;
+}
+
+void FlowField::begin(const TileCollisionMap& map, PathPoint target) {
+    windowFor(map, target, nextOriginX, nextOriginY, nextWidth, nextHeight);
+    // os vetores sao preenchidos aos poucos no step (1M celulas de uma vez ja
+    // passam do orcamento); reserve nao toca na memoria
+    size_t cells = (size_t)nextWidth * nextHeight;
+    nextDistance.clear();
+    nextDirection.clear();
+    nextDistance.reserve(cells);
+    nextDirection.reserve(cells);
+    nextGoal = target;
+    nextVersion = map.version;
+    heap.clear();
+    building = true;
+
+    int gx = target.x - map.originX, gy = target.y - map.originY;
+    nextValid = cells > 0 && (unsigned)gx < (unsigned)map.width && (unsigned)gy < (unsigned)map.height &&
+                map.cells[(size_t)gy * map.width + gx] == TILE_EMPTY;
+}
+
+bool FlowField::step(const TileCollisionMap& map, long maxCells) {
+    if (!building) {
+        if (!requested)
+            return false;
+        requested = false;
+        begin(map, wanted);
+    }
+    // o mapa mudou de tamanho no meio (nao deveria): comeca de novo
+    int x0, y0, w, h;
+    windowFor(map, nextGoal, x0, y0, w, h);
+    if (x0 != nextOriginX || y0 != nextOriginY || w != nextWidth || h != nextHeight)
+        begin(map, nextGoal);
+
+    // primeiro zera os vetores (celulas por passo: limpar eh bem mais barato
+    // que expandir); com tudo zerado o objetivo entra na fila
+    size_t cells = (size_t)w * h;
+    if (nextDistance.size() < cells) {
+        size_t n = cells - nextDistance.size();
+        if (maxCells > 0 && n > (size_t)maxCells * CLEAR_PER_CELL)
+            n = (size_t)maxCells * CLEAR_PER_CELL;
+        nextDistance.insert(nextDistance.end(), n, INF);
+        nextDirection.insert(nextDirection.end(), n, (int8_t)-1);
+        if (nextDistance.size() < cells)
+            return false;
+        if (nextValid) {
+            int goalCell = (nextGoal.y - y0) * w + nextGoal.x - x0;
+            nextDistance[goalCell] = 0.0f;
+            pushOpen(heap, 0.0f, goalCell);
+        }
+    }
+
+    // Dijkstra a partir do objetivo, so dentro da janela; quem melhora a
+    // distancia de um vizinho vira a direcao dele (o vizinho anda para ca)
+    int offsetX = x0 - map.originX, offsetY = y0 - map.originY;
+    auto free = [&](int x, int y) {
+        return (unsigned)x < (unsigned)w && (unsigned)y < (unsigned)h &&
+               map.cells[(size_t)(y + offsetY) * map.width + x + offsetX] == TILE_EMPTY;
+    };
+    long count = 0;
+    while (!heap.empty()) {
+        if (maxCells > 0 && count >= maxCells)
+            return false;
+        OpenEntry top = popOpen(heap);
+        if (top.f > nextDistance[top.cell])
+            continue;
+        count++;
+        int x = top.cell % w, y = top.cell / w;
+        for (int d = 0; d < 8; ++d) {
+            int dx = FLOW_DX[d], dy = FLOW_DY[d];
+            if (!free(x + dx, y + dy))
+                continue;
+            if (dx && dy && !(free(x + dx, y) && free(x, y + dy)))
+                continue;
+            float cost = top.f + (dx && dy ? SQRT2 : 1.0f);
+            int next = (y + dy) * w + x + dx;
+            if (cost < nextDistance[next]) {
+                nextDistance[next] = cost;
+                nextDirection[next] = (int8_t)(d ^ 1);
+                pushOpen(heap, cost, next);
+            }
+        }
+    }
+
+    // pronto: o campo novo entra no lugar do antigo
+    distance.swap(nextDistance);
+    direction.swap(nextDirection);
+    width = w;
+    height = h;
+    originX = x0;
+    originY = y0;
+    goal = nextGoal;
+    mapVersion = nextVersion;
+    valid = nextValid;
+    building = false;
+    return true;
+}
+
+void FlowField::build(const TileCollisionMap& map, PathPoint target) {
+    requested = false;
+    begin(map, target);
+    step(map, 0);
+}
+
+bool FlowField::update(const TileCollisionMap& map, PathPoint target) {
+    if (current(map, target))
+        return false;
+    build(map, target);
+    return true;
+}
+
+void FlowField::request(const TileCollisionMap& map, PathPoint target) {
+    bool sameAsBuilding = building && nextGoal.x == target.x && nextGoal.y == target.y && nextVersion == map.version;
+    requested = !(sameAsBuilding || (!building && current(map, target)));
+    wanted = target;
+}
+
+bool FlowField::directionAt(int x, int y, int& dx, int& dy) const {
+    x -= originX;
+    y -= originY;
+    if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height)
+        return false;
+    int d = direction[(size_t)y * width + x];
+    if (d < 0)
+        return false;
+    dx = FLOW_DX[d];
+    dy = FLOW_DY[d];
+    return true;
+}
+
+// ---------------------------------------------------------------- PathScheduler
+
+void PathScheduler::request(int agent, PathPoint start, PathPoint goal) {
+    Job job;
+    job.agent = agent;
+    job.start = start;
+    job.goal = goal;
+    jobs.push_back(std::move(job));
+    requests++;
+}
+
+void PathScheduler::cancel(int agent) {
+    jobs.erase(std::remove_if(jobs.begin(), jobs.end(), [agent](const Job& job) { return job.agent == agent; }),
+               jobs.end());
+}
+
+// tamanho dos passos do PathScheduler (cada um ~0.1 a 0.3 ms): entradas
+// rotuladas, entradas expandidas na busca abstrata e celulas de flow field
+static const long LABEL_SLICE = 1024;
+static const long SEARCH_SLICE = 256;
+static const long FLOW_SLICE = 2048;
+
+bool PathScheduler::flowPending() const {
+    for (const FlowField* field : flowFields)
+        if (field->pending())
+            return true;
+    return false;
+}
+
+void PathScheduler::update(const TileCollisionMap& map, std::vector<PathResult>& done) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point begin = Clock::now();
+    auto elapsedMs = [&]() { return std::chrono::duration<double, std::milli>(Clock::now() - begin).count(); };
+
+    bool first = true;
+    while ((!jobs.empty() || flowPending()) && (first || elapsedMs() < budgetMs)) {
+        first = false;
+        steps++;
+
+        // flow fields e pedidos se revezam: um passo de cada
+        if (flowTurn || jobs.empty()) {
+            flowTurn = false;
+            FlowField* field = nullptr;
+            for (FlowField* f : flowFields)
+                if (f->pending()) {
+                    field = f;
+                    break;
+                }
+            if (field) {
+                field->step(map, FLOW_SLICE);
+                continue;
+            }
+        } else {
+            flowTurn = true;
+        }
+
+        // clusters marcados (muitos de uma vez quando um pedaco do mapa chega):
+        // um por passo
+        if (hierarchy && !hierarchy->dirtyList.empty()) {
+            hierarchy->update(1);
+            continue;
+        }
+
+        // componentes velhas: os pedidos esperam a rotulacao, feita em fatias
+        if (hierarchy && hierarchy->labeling) {
+            hierarchy->labelComponents(LABEL_SLICE);
+            continue;
+        }
+
+        Job& job = jobs.front();
+        bool ok = true, finished = false;
+
+        if (!job.planned) {
+            // pontos de passagem: a busca abstrata em fatias (recomeca se a
+            // hierarquia mudou no meio); sem hierarquia, so inicio e fim
+            if (hierarchy) {
+                PathStatus status;
+                if (!job.searching || job.search.version != hierarchy->version) {
+                    job.searching = true;
+                    status = hierarchy->beginSearch(job.start, job.goal, job.search, job.waypoints);
+                } else {
+                    status = hierarchy->continueSearch(job.search, SEARCH_SLICE, job.waypoints);
+                }
+                if (status == PATH_RUNNING)
+                    continue;
+                job.planned = true;
+                job.search = PathHierarchy::Search();
+                ok = status == PATH_FOUND;
+            } else {
+                job.planned = true;
+                job.waypoints.clear();
+                job.waypoints.push_back(job.start);
+                job.waypoints.push_back(job.goal);
+            }
+            if (ok && job.waypoints.size() < 2) {
+                job.path = job.waypoints;
+                finished = true;
+            }
+        } else {
+            // depois: um trecho refinado por passo
+            ok = search.findPath(map, job.waypoints[job.nextLeg], job.waypoints[job.nextLeg + 1], leg);
+            if (ok)
+                job.path.insert(job.path.end(), leg.begin() + (job.path.empty() ? 0 : 1), leg.end());
+            job.nextLeg++;
+            finished = job.nextLeg + 1 >= job.waypoints.size();
+        }
+
+        if (!ok || finished) {
+            PathResult result;
+            result.agent = job.agent;
+            result.found = ok;
+            if (ok) result.path.swap(job.path);
+            done.push_back(std::move(result));
+            if (ok) completed++;
+            else failed++;
+            jobs.pop_front();
+        }
+    }
+
+    lastMs = elapsedMs();
+    if (lastMs > worstMs) worstMs = lastMs;
+}
@@ -0,0 +1,273 @@
+#ifndef PATHFINDING_H
+#define PATHFINDING_H
+
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include "TileCollision.h"
+
+// Busca de caminho na grade do TileCollisionMap, para NPCs.
+// So celulas TILE_EMPTY sao andaveis (rampa conta como parede). O movimento eh
+// em 8 direcoes sem cortar quina: a diagonal so vale com os dois vizinhos
+// retos livres, que eh o que o moveActor consegue seguir sem enroscar.
+// Custos: 1 reto e sqrt(2) na diagonal. Coordenadas sempre em tiles do mapa
+// (com o originX/originY da grade, como TileCollisionMap::get).
+
+struct PathPoint {
+    int x, y;
+};
+
+// resultado de uma busca feita em fatias
+enum PathStatus { PATH_RUNNING, PATH_FOUND, PATH_FAILED };
+
+// A* com jump point search. Em grade uniforme o JPS so poe na fila os pontos
+// onde o caminho pode virar (vizinhos forcados), em vez de cada celula do
+// caminho. Os vetores de trabalho tem uma entrada por celula e sao reusados
+// entre buscas (zerar eh trocar o searchId), entao buscar nao aloca depois da
+// primeira vez. Uma GridSearch por thread.
+// Com window > 0 a busca fica no retangulo de start e goal aumentado de window
+// celulas para cada lado, e os vetores tem o tamanho dele em vez do mapa: para
+// trechos curtos (os do HPA*, dentro de um ou dois clusters) num mapa grande.
+struct GridSearch {
+    bool jump = true;     // false = A* comum (vizinho por vizinho), para comparar
+    int window = 0;       // 0 = o mapa inteiro
+    long expanded = 0;    // nos tirados da fila na ultima busca
+
+    // caminho de start a goal (os dois inclusive) em path; entre pontos
+    // seguidos a linha eh reta ou diagonal. maxExpansions > 0 desiste depois de
+    // tantos nos. false se nao tem caminho (path fica vazio)
+    bool findPath(const TileCollisionMap& map, PathPoint start, PathPoint goal,
+                  std::vector<PathPoint>& path, long maxExpansions = 0);
+    // aloca os vetores de trabalho para o tamanho do mapa (16 bytes por celula)
+    // ou, com window, para um trecho de ate um cluster de clusterSize; chamar
+    // na carga evita o pico da primeira busca
+    void prepare(const TileCollisionMap& map, int clusterSize = 0);
+
+    // uso interno: coordenadas e celulas relativas ao retangulo da busca
+    struct OpenEntry {
+        float f;
+        int cell;
+    };
+    const TileCollisionMap* map = nullptr;
+    int boxX = 0, boxY = 0, boxW = 0, boxH = 0;
+    int goalX = 0, goalY = 0;
+    uint32_t searchId = 0;
+    std::vector<float> g;
+    std::vector<int> parent;
+    std::vector<uint32_t> seen, closed; // == searchId: visto / fechado nesta busca
+    std::vector<OpenEntry> open;
+
+    bool walkable(int x, int y) const {
+        return (unsigned)x < (unsigned)boxW && (unsigned)y < (unsigned)boxH &&
+               map->cells[(size_t)(y + boxY) * map->width + x + boxX] == TILE_EMPTY;
+    }
+    void reserve(size_t cells);
+    int jumpFrom(int x, int y, int dx, int dy) const;
+};
+
+// Grafo abstrato para mapas grandes (HPA*): a grade eh dividida em clusters de
+// clusterSize x clusterSize e cada trecho livre da borda entre dois clusters
+// vira uma ou duas entradas (uma celula de cada lado). Dentro do cluster as
+// entradas sao ligadas pelo custo do menor caminho local. Buscar eh um A* so
+// sobre as entradas; o caminho de verdade eh refinado trecho por trecho depois
+// (cada trecho fica dentro de um cluster, entao a GridSearch eh curta).
+// Quando um tile muda, so o cluster dele (e o vizinho, se o tile estiver na
+// borda) eh refeito: tileChanged marca e update refaz. As componentes conexas
+// do grafo abstrato fazem um pedido para um lugar sem caminho falhar na hora
+// em vez de varrer o grafo inteiro; depois de uma mudanca elas sao refeitas
+// aos poucos (labelComponents com limite, chamado pelo PathScheduler dentro do
+// orcamento) ou de uma vez na proxima busca.
+// A busca abstrata tambem pode ir em fatias (beginSearch/continueSearch): o
+// estado dela fica num Search de quem pediu, nao na hierarquia.
+struct PathHierarchy {
+    struct Edge {
+        int cell;     // indice da celula na grade (y * width + x, sem origem)
+        int cluster;  // cluster da celula
+        float cost;
+    };
+    struct Node {
+        int cell;
+        int component;  // entradas ligadas entre si tem o mesmo numero
+        std::vector<Edge> edges;
+    };
+    struct Cluster {
+        std::vector<Node> nodes;
+        bool dirty = false;
+    };
+
+    // uma busca abstrata em andamento: fila aberta e custo/pai de cada entrada
+    // vista (so as entradas tocadas, nao um vetor do tamanho do mapa)
+    struct Search {
+        struct Visit {
+            float g;
+            int parent;
+            bool closed;
+        };
+        uint64_t version = 0;  // da hierarquia no beginSearch; se mudou, recomecar
+        int startCell = 0, goalCell = 0, goalCluster = 0, goalX = 0, goalY = 0;
+        long expanded = 0;
+        std::vector<GridSearch::OpenEntry> open, startLinks;
+        std::vector<float> goalCost;  // por no do cluster do objetivo
+        std::unordered_map<int, Visit> visits;
+    };
+
+    int clusterSize = 16;
+    int clustersX = 0, clustersY = 0;
+    std::vector<Cluster> clusters;
+    std::vector<int> nodeAt;    // por celula: indice em clusters[c].nodes ou -1
+    std::vector<int> dirtyList;
+    bool labeling = false;      // componentes sendo refeitas
+    long rebuilds = 0;          // clusters refeitos desde o build
+    long expanded = 0;          // nos abstratos da ultima busca
+    uint64_t version = 0;       // muda a cada cluster refeito
+
+    void build(const TileCollisionMap& map, int clusterSize = 16);
+    // o tile (x, y) do mapa mudou de andavel para parede ou o contrario
+    void tileChanged(int x, int y);
+    // refaz ate maxClusters dos clusters marcados (0 = todos); devolve quantos
+    int update(int maxClusters = 0);
+    // continua a refazer as componentes, ate maxNodes entradas (0 = todas);
+    // true quando terminou
+    bool labelComponents(long maxNodes = 0);
+
+    // pontos de passagem de start a goal (os dois inclusive), um por entrada
+    // usada. Pontos seguidos ficam no mesmo cluster ou sao vizinhos na borda.
+    // Chama update() antes se tiver cluster marcado
+    bool findPath(PathPoint start, PathPoint goal, std::vector<PathPoint>& waypoints);
+
+    // a mesma busca em fatias, com a hierarquia em dia (sem cluster marcado nem
+    // rotulacao pela metade). beginSearch prepara os custos locais do inicio e
+    // do objetivo e ja termina nos casos faceis (mesmo cluster, sem caminho);
+    // continueSearch expande ate maxExpansions entradas (0 = ate o fim). Com
+    // PATH_FOUND os pontos de passagem estao em waypoints
+    PathStatus beginSearch(PathPoint start, PathPoint goal, Search& search, std::vector<PathPoint>& waypoints);
+    PathStatus continueSearch(Search& search, long maxExpansions, std::vector<PathPoint>& waypoints);
+
+    size_t nodeCount() const;
+
+    // uso interno
+    const TileCollisionMap* map = nullptr;
+    int clusterOf(int x, int y) const { return (y / clusterSize) * clustersX + x / clusterSize; }
+    void rebuildCluster(int c);
+    void addEntrances(int c, int insideX, int insideY, int outsideX, int outsideY, int stepX, int stepY, int length);
+    int nodeFor(int c, int cell);
+    void localCosts(int c, int fromCell);
+    void startLabeling();
+
+    std::vector<float> local;     // distancias do ultimo localCosts (clusterSize^2)
+    std::vector<GridSearch::OpenEntry> heap;
+    Search query;                 // a do findPath
+    std::vector<Edge> stack;      // entradas a visitar na rotulacao
+    int labelCluster = 0, labelNode = 0, nextComponent = 0;
+};
+
+// Flow field: distancia de cada celula ate um objetivo (Dijkstra a partir dele)
+// e a direcao do melhor vizinho. Uma multidao indo para o mesmo lugar le a
+// direcao da celula onde cada um esta, sem busca por agente. Fica velho quando
+// o mapa muda (mapVersion) ou o objetivo muda.
+// Refazer eh um Dijkstra do mapa inteiro (1024 x 1024 ~180 ms), entao alem de
+// build/update (de uma vez) o campo pode ser refeito aos poucos: request()
+// pede o objetivo e step() anda o Dijkstra do campo novo, em vetores separados;
+// directionAt continua lendo o antigo ate o novo terminar. O PathScheduler
+// chama step() dentro do orcamento para os campos em flowFields.
+// Com radius > 0 o campo cobre so a janela de (2 * radius + 1)^2 celulas em
+// volta do objetivo (width/height/origin sao os da janela): num mapa grande
+// refazer custa o mesmo que num pequeno, e fora dela directionAt da false.
+struct FlowField {
+    int radius = 0;  // 0 = o mapa inteiro
+    int width = 0, height = 0;
+    int originX = 0, originY = 0;
+    PathPoint goal = { 0, 0 };
+    uint64_t mapVersion = 0;
+    bool valid = false;
+    std::vector<float> distance;   // infinito onde nao chega
+    std::vector<int8_t> direction; // 0..7 (ver FLOW_DX/FLOW_DY), -1 = parado ou sem caminho
+
+    void build(const TileCollisionMap& map, PathPoint goal);
+    // refaz se o objetivo ou o mapa mudaram; true se refez
+    bool update(const TileCollisionMap& map, PathPoint goal);
+
+    // aos poucos: pede um campo para goal (nada se ja eh o atual ou o que esta
+    // sendo montado). Um pedido no meio de uma montagem espera ela terminar, para
+    // um objetivo que muda a cada poucos frames nao recomecar o Dijkstra sempre
+    void request(const TileCollisionMap& map, PathPoint goal);
+    bool pending() const { return building || requested; }
+    // anda ate maxCells celulas (0 = ate o fim); true quando o campo novo
+    // entrou no lugar do antigo
+    bool step(const TileCollisionMap& map, long maxCells);
+
+    // direcao na celula (x, y) do mapa; false se nao tem para onde ir
+    bool directionAt(int x, int y, int& dx, int& dy) const;
+
+    // uso interno: o campo em montagem
+    bool building = false, requested = false;
+    PathPoint wanted = { 0, 0 }, nextGoal = { 0, 0 };
+    uint64_t nextVersion = 0;
+    int nextOriginX = 0, nextOriginY = 0, nextWidth = 0, nextHeight = 0;
+    bool nextValid = false;
+    std::vector<float> nextDistance;
+    std::vector<int8_t> nextDirection;
+    std::vector<GridSearch::OpenEntry> heap;
+
+    void begin(const TileCollisionMap& map, PathPoint goal);
+    // janela do campo para goal, em coordenadas do mapa (com a origem)
+    void windowFor(const TileCollisionMap& map, PathPoint goal, int& x0, int& y0, int& w, int& h) const;
+    // o campo pronto ja eh o de goal
+    bool current(const TileCollisionMap& map, PathPoint goal) const;
+};
+
+extern const int FLOW_DX[8];
+extern const int FLOW_DY[8];
+
+struct PathResult {
+    int agent;
+    bool found;
+    std::vector<PathPoint> path; // como GridSearch::findPath
+};
+
+// Fila de pedidos de caminho com orcamento por frame (budgetMs). Cada pedido
+// anda em passos curtos: a busca abstrata (PathHierarchy) em fatias de
+// entradas expandidas e depois um trecho refinado por passo (clusters marcados
+// e a rotulacao tambem sao refeitos em passos antes dos pedidos), entao um
+// caminho longo se espalha por varios frames e milhares de agentes pedindo ao
+// mesmo tempo nao travam o frame. Os flow fields em flowFields sao montados
+// em fatias tambem, um passo deles e um dos pedidos alternados. O relogio eh
+// conferido entre passos; um passo sempre roda, para a fila andar.
+// Sem hierarchy cada pedido eh uma GridSearch inteira (um passo so).
+struct PathScheduler {
+    double budgetMs = 1.0;
+    PathHierarchy* hierarchy = nullptr;
+    GridSearch search;
+    std::vector<FlowField*> flowFields;  // refeitos aqui quando tem request() pendente
+
+    // estatisticas
+    long requests = 0, completed = 0, failed = 0, steps = 0;
+    double lastMs = 0.0, worstMs = 0.0;
+
+    void request(int agent, PathPoint start, PathPoint goal);
+    // esquece os pedidos ainda na fila deste agente
+    void cancel(int agent);
+    size_t pending() const { return jobs.size(); }
+    bool flowPending() const;
+
+    // gasta ate budgetMs; os caminhos prontos (ou que falharam) vao para done
+    void update(const TileCollisionMap& map, std::vector<PathResult>& done);
+
+    struct Job {
+        int agent;
+        PathPoint start, goal;
+        bool searching = false;  // busca abstrata comecada (estado em search)
+        bool planned = false;    // pontos de passagem prontos
+        size_t nextLeg = 0;
+        PathHierarchy::Search search;
+        std::vector<PathPoint> waypoints, path;
+    };
+    std::deque<Job> jobs;
+    std::vector<PathPoint> leg;
+    bool flowTurn = true;
+};
+
+#endif
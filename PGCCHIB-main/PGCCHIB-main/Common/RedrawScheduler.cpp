@@ -0,0 +1,128 @@
+#include "RedrawScheduler.h"
+
+#include <iostream>
+#include <cmath>
+
+bool RedrawScheduler::init(int w, int h) {
+    width = w;
+    height = h;
+    createCanvas();
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "RedrawScheduler: framebuffer incompleto" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return false;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    invalidateAll();
+    return true;
+}
+
+void RedrawScheduler::createCanvas() {
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+}
+
+void RedrawScheduler::destroyCanvas() {
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    fbo = color = 0;
+}
+
+void RedrawScheduler::resize(int w, int h) {
+    // minimizada: 0 x 0, fica com o canvas antigo
+    if (w <= 0 || h <= 0 || (w == width && h == height)) return;
+    width = w;
+    height = h;
+    destroyCanvas();
+    createCanvas();
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    invalidateAll();
+}
+
+void RedrawScheduler::invalidateAll() {
+    invalidate(0, 0, width, height);
+}
+
+void RedrawScheduler::invalidate(int x0, int y0, int x1, int y1) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > width) x1 = width;
+    if (y1 > height) y1 = height;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    if (!hasDirty) {
+        dirtyX0 = x0;
+        dirtyY0 = y0;
+        dirtyX1 = x1;
+        dirtyY1 = y1;
+        hasDirty = true;
+        return;
+    }
+    if (x0 < dirtyX0) dirtyX0 = x0;
+    if (y0 < dirtyY0) dirtyY0 = y0;
+    if (x1 > dirtyX1) dirtyX1 = x1;
+    if (y1 > dirtyY1) dirtyY1 = y1;
+}
+
+void RedrawScheduler::invalidateNdc(float minX, float minY, float maxX, float maxY) {
+    // arredonda para fora: um pixel a mais nao custa nada, um a menos deixa rastro
+    invalidate((int)std::floor((minX + 1.0f) * 0.5f * width), (int)std::floor((minY + 1.0f) * 0.5f * height),
+               (int)std::ceil((maxX + 1.0f) * 0.5f * width), (int)std::ceil((maxY + 1.0f) * 0.5f * height));
+}
+
+void RedrawScheduler::waitEvents() {
+    if (!eventDriven || hasDirty || presentPending)
+        glfwPollEvents();
+    else
+        glfwWaitEventsTimeout(idleTimeout);
+}
+
+bool RedrawScheduler::begin() {
+    loops++;
+    if (!eventDriven)
+        invalidateAll();
+    if (!hasDirty)
+        return false;
+
+    drawing = true;
+    redraws++;
+    if (dirtyX0 == 0 && dirtyY0 == 0 && dirtyX1 == width && dirtyY1 == height)
+        fullRedraws++;
+    pixelsRedrawn += (long long)(dirtyX1 - dirtyX0) * (dirtyY1 - dirtyY0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, width, height);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(dirtyX0, dirtyY0, dirtyX1 - dirtyX0, dirtyY1 - dirtyY0);
+    return true;
+}
+
+void RedrawScheduler::end(GLFWwindow* window) {
+    if (drawing) {
+        glDisable(GL_SCISSOR_TEST);
+        drawing = false;
+        hasDirty = false;
+        presentPending = true;
+    }
+    if (!presentPending)
+        return;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glfwSwapBuffers(window);
+    presentPending = false;
+}
+
+void RedrawScheduler::destroy() {
+    destroyCanvas();
+    width = height = 0;
+    hasDirty = presentPending = drawing = false;
+}
@@ -0,0 +1,73 @@
+#ifndef REDRAW_SCHEDULER_H
+#define REDRAW_SCHEDULER_H
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+// Redesenho por invalidacao para cenas que so mudam com input (jogos de turno,
+// menus). Em vez de redesenhar tudo a cada volta do laco com glfwPollEvents,
+// o jogo marca o que mudou (invalidate) e o laco dorme em
+// glfwWaitEventsTimeout ate chegar um evento: parado, a CPU fica perto de 0%,
+// e um clique acorda o laco na hora, entao a latencia eh a mesma.
+//
+// A cena fica em um canvas (FBO do tamanho do framebuffer) que sobrevive entre
+// frames; so a caixa que envolve as areas invalidadas eh redesenhada, com
+// scissor, e o canvas inteiro vai para a janela com um glBlitFramebuffer. Sem
+// o canvas o scissor nao serviria: depois do swap o back buffer eh indefinido.
+//
+//     while (!glfwWindowShouldClose(window)) {
+//         redraw.waitEvents();        // callbacks chamam redraw.invalidate...()
+//         if (redraw.begin()) {       // false = nada mudou, nao desenha
+//             glClear(...);           // o clear tambem respeita o scissor
+//             ... desenha a cena inteira ...
+//         }
+//         redraw.end(window);         // blit + swap so se desenhou
+//     }
+//
+// eventDriven = false volta ao laco antigo (poll e redesenho completo sempre).
+struct RedrawScheduler {
+    bool eventDriven = true;
+    // tempo maximo dormindo sem eventos (o laco ainda acorda para titulo, timers...)
+    double idleTimeout = 1.0;
+
+    // estatisticas
+    long loops = 0;         // voltas do laco
+    long redraws = 0;       // voltas que desenharam
+    long fullRedraws = 0;   // ... com a tela inteira suja
+    long long pixelsRedrawn = 0;
+
+    bool init(int width, int height);
+    // recria o canvas (callback de tamanho do framebuffer) e suja tudo
+    void resize(int width, int height);
+
+    void invalidateAll();
+    // retangulo em pixels do framebuffer, origem embaixo a esquerda, [x0, x1) x [y0, y1)
+    void invalidate(int x0, int y0, int x1, int y1);
+    // retangulo em coordenadas normalizadas (-1 a 1)
+    void invalidateNdc(float minX, float minY, float maxX, float maxY);
+    // mostrar o canvas de novo sem redesenhar (callback de refresh da janela)
+    void requestPresent() { presentPending = true; }
+
+    bool dirty() const { return hasDirty; }
+
+    // poll se ja tem algo para desenhar, senao dorme ate um evento ou idleTimeout
+    void waitEvents();
+    // liga o canvas e o scissor na area suja; false se nao tem nada para desenhar
+    bool begin();
+    // desliga o scissor e, se algo mudou, copia o canvas para a janela e troca os buffers
+    void end(GLFWwindow* window);
+    void destroy();
+
+private:
+    GLuint fbo = 0, color = 0;
+    int width = 0, height = 0;
+    bool hasDirty = false;
+    bool presentPending = false;
+    bool drawing = false;
+    int dirtyX0 = 0, dirtyY0 = 0, dirtyX1 = 0, dirtyY1 = 0;
+
+    void createCanvas();
+    void destroyCanvas();
+};
+
+#endif
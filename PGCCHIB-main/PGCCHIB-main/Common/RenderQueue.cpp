@@ -0,0 +1,199 @@
+#include "RenderQueue.h"
+
+#include <cstring>
+
+uint64_t makeDrawKey(unsigned layer, bool translucent, GLuint program, GLuint texture, GLuint vao, float depth) {
+    if (depth < 0.0f) depth = 0.0f;
+    if (depth > 1.0f) depth = 1.0f;
+    uint64_t d = (uint64_t)(depth * 0xFFFFFF);
+    uint64_t state = (uint64_t)(program & 0xFFF) << 19 | (uint64_t)(texture & 0xFFF) << 7 | (vao & 0x7F);
+
+    uint64_t key = (uint64_t)(layer & 0xFF) << 56;
+    if (!translucent)
+        key |= state << 24 | d;
+    else
+        key |= (uint64_t)1 << 55 | (0xFFFFFF - d) << 31 | state;
+    return key;
+}
+
+// com depthTest: o bit de translucido vai para o topo e a camada dos opacos
+// inverte, entao os opacos saem da camada de cima para a de baixo (e, dentro
+// dela, da frente para tras) e os translucidos depois, na ordem de sempre
+static uint64_t depthOrderKey(uint64_t key) {
+    uint64_t layer = key >> 56, rest = key & (((uint64_t)1 << 55) - 1);
+    if (key >> 55 & 1)
+        return (uint64_t)1 << 63 | layer << 55 | rest;
+    return (255 - layer) << 55 | rest;
+}
+
+// z em NDC pela camada e pela profundidade da chave: camada de cima mais
+// perto e, dentro da camada, depth = 1 mais longe
+static float packetDepth(uint64_t key) {
+    uint64_t layer = key >> 56;
+    uint64_t d = key >> 55 & 1 ? 0xFFFFFF - (key >> 31 & 0xFFFFFF) : key & 0xFFFFFF;
+    double z = (255.0 - layer + 0.005 + 0.99 * d / 0xFFFFFF) / 256.0;
+    return (float)(z * 2.0 - 1.0);
+}
+
+// LSD radix de 8 bits: os 8 histogramas saem de uma unica leitura e as passadas
+// em que todas as chaves tem o mesmo byte (camada unica, poucos programas...)
+// sao puladas
+void RenderQueue::sort() {
+    size_t n = packets.size();
+    items.resize(n);
+    scratch.resize(n);
+    if (n == 0) return;
+    for (size_t i = 0; i < n; ++i) items[i] = { depthTest ? depthOrderKey(packets[i].key) : packets[i].key, (uint32_t)i };
+
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t key = items[i].key;
+        for (int pass = 0; pass < 8; ++pass) counts[pass][(key >> (pass * 8)) & 0xFF]++;
+    }
+
+    for (int pass = 0; pass < 8; ++pass) {
+        size_t* count = counts[pass];
+        int shift = pass * 8;
+        if (count[(items[0].key >> shift) & 0xFF] == n) continue;
+
+        size_t offset = 0;
+        for (int b = 0; b < 256; ++b) {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; ++i) scratch[count[(items[i].key >> shift) & 0xFF]++] = items[i];
+        items.swap(scratch);
+    }
+}
+
+void RenderQueue::countUnsorted() {
+    GLuint program = 0, texture = 0, vao = 0;
+    size_t changes = 0;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        const DrawPacket& p = packets[i];
+        if (i == 0 || p.program != program) changes++;
+        if (i == 0 || p.texture != texture) changes++;
+        if (i == 0 || p.vao != vao) changes++;
+        program = p.program;
+        texture = p.texture;
+        vao = p.vao;
+    }
+    stats.unsortedChanges = changes;
+}
+
+// os ponteiros dos atributos sao estado do VAO: apontam para o trecho do lote
+// no buffer de instancias
+void RenderQueue::bindInstanceAttributes(size_t firstInstance) {
+    size_t base = firstInstance * sizeof(Instance);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(base + offsetof(Instance, model)));
+    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(base + offsetof(Instance, model) + 4 * sizeof(float)));
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(base + offsetof(Instance, uvRect)));
+    glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)(base + offsetof(Instance, depth)));
+}
+
+void RenderQueue::execute() {
+    stats = RenderQueueStats();
+    size_t n = packets.size();
+    stats.packets = n;
+    if (n == 0) return;
+
+    countUnsorted();
+    sort();
+
+    // dados por instancia ja na ordem de desenho: um upload por frame
+    instances.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const DrawPacket& p = packets[items[i].index];
+        instances[i].model = p.model;
+        instances[i].uvRect = p.uvRect;
+        instances[i].depth = packetDepth(p.key);
+        if (p.key >> 55 & 1) stats.translucentPackets++;
+    }
+    if (n > instanceCapacity) instanceCapacity = n > instanceCapacity * 2 ? n : instanceCapacity * 2;
+    // data() com nullptr descarta o conteudo anterior (orphaning), sem esperar a GPU
+    instanceBuffer.data(GL_ARRAY_BUFFER, instanceCapacity * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+    instanceBuffer.subData(GL_ARRAY_BUFFER, 0, n * sizeof(Instance), instances.data());
+
+    // o GL_ARRAY_BUFFER ligado eh o que os glVertexAttribPointer abaixo usam
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer.get());
+    glActiveTexture(GL_TEXTURE0);
+
+    GLboolean blend = glIsEnabled(GL_BLEND), depth = glIsEnabled(GL_DEPTH_TEST);
+    if (depthTest) {
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LEQUAL);
+        glDepthMask(GL_TRUE);
+        glDisable(GL_BLEND);
+    }
+
+    GLuint program = 0, texture = 0, vao = 0, normalMap = 0;
+    bool translucent = false;
+    for (size_t i = 0; i < n;) {
+        const DrawPacket& p = packets[items[i].index];
+
+        // fim dos opacos: daqui em diante blending e profundidade so para leitura
+        if (depthTest && !translucent && items[i].key >> 63) {
+            translucent = true;
+            if (blend) glEnable(GL_BLEND);
+            glDepthMask(GL_FALSE);
+        }
+
+        // junta os vizinhos que desenham o mesmo mesh com o mesmo estado
+        size_t end = i + 1;
+        while (end < n) {
+            const DrawPacket& q = packets[items[end].index];
+            if (q.program != p.program || q.texture != p.texture || q.vao != p.vao || q.indexCount != p.indexCount ||
+                q.normalMap != p.normalMap || (depthTest && (items[end].key >> 63) != translucent))
+                break;
+            end++;
+        }
+
+        if (i == 0 || p.program != program) {
+            glUseProgram(p.program);
+            program = p.program;
+            stats.programChanges++;
+        }
+        if (i == 0 || p.texture != texture) {
+            glBindTexture(GL_TEXTURE_2D, p.texture);
+            texture = p.texture;
+            stats.textureChanges++;
+        }
+        // a unidade 1 pode ter ficado com qualquer coisa do frame anterior
+        if (i == 0 || p.normalMap != normalMap) {
+            glActiveTexture(GL_TEXTURE1);
+            glBindTexture(GL_TEXTURE_2D, p.normalMap);
+            glActiveTexture(GL_TEXTURE0);
+            if (i > 0 || p.normalMap != 0) stats.textureChanges++;
+            normalMap = p.normalMap;
+        }
+        if (i == 0 || p.vao != vao) {
+            glBindVertexArray(p.vao);
+            vao = p.vao;
+            stats.vaoChanges++;
+            for (GLuint location = 2; location <= 5; ++location) {
+                glEnableVertexAttribArray(location);
+                glVertexAttribDivisor(location, 1);
+            }
+        }
+        bindInstanceAttributes(i);
+        glDrawElementsInstanced(GL_TRIANGLES, p.indexCount, GL_UNSIGNED_INT, 0, (GLsizei)(end - i));
+        stats.drawCalls++;
+        i = end;
+    }
+    glBindVertexArray(0);
+    if (depthTest) {
+        glDepthMask(GL_TRUE);
+        if (blend) glEnable(GL_BLEND);
+        else glDisable(GL_BLEND);
+        if (!depth) glDisable(GL_DEPTH_TEST);
+    }
+    packets.clear();
+}
+
+void RenderQueue::destroy() {
+    instanceBuffer.reset();
+    instanceCapacity = 0;
+    packets.clear();
+}
@@ -0,0 +1,107 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "Transform2D.h"
+#include "GLHandles.h"
+
+// Chave de 64 bits de um pacote; a fila desenha em ordem crescente de chave.
+//   bits 63-56  camada (0 desenha primeiro)
+//   bit  55     translucido (os opacos da camada vem antes)
+//   opaco:       programa (12) | textura (12) | VAO (7) | profundidade (24)
+//   translucido: profundidade invertida (24) | programa (12) | textura (12) | VAO (7)
+// Opacos sao agrupados por estado; translucidos precisam ir de tras para frente,
+// entao a profundidade vem antes do estado. depth em [0, 1], 1 = mais longe.
+// Programa, textura e VAO sao os nomes do OpenGL (so os bits baixos entram na
+// chave; nomes maiores so agrupam pior, a fila confere os nomes reais antes de juntar).
+uint64_t makeDrawKey(unsigned layer, bool translucent, GLuint program, GLuint texture, GLuint vao, float depth);
+
+// Um draw: o mesh (VAO com indices GL_UNSIGNED_INT a partir de 0) desenhado com
+// programa e textura na unidade 0. model e uvRect vao como atributos por
+// instancia, entao o programa precisa declarar:
+//     layout (location = 2) in vec4 iModel;     // a, b, c, d do Affine2D
+//     layout (location = 3) in vec2 iTranslate; // tx, ty
+//     layout (location = 4) in vec4 iUvRect;    // u0, v0, u1, v1
+// e calcular a posicao com mat2(iModel.xy, iModel.zw) * aPos + iTranslate.
+// Com RenderQueue::depthTest tambem:
+//     layout (location = 5) in float iDepth;    // gl_Position.z (NDC, w = 1)
+// normalMap (opcional) vai na unidade 1; eh do sprite sheet, entao nao entra na
+// chave: pacotes com a mesma textura devem usar o mesmo normal map.
+struct DrawPacket {
+    uint64_t key;
+    GLuint program, texture, vao;
+    GLsizei indexCount;
+    Affine2D model;
+    glm::vec4 uvRect;
+    GLuint normalMap = 0;
+};
+
+// trocas de estado e draws do ultimo execute()
+struct RenderQueueStats {
+    size_t packets = 0, drawCalls = 0;
+    size_t translucentPackets = 0;
+    size_t programChanges = 0, textureChanges = 0, vaoChanges = 0;
+    // o mesmo lote na ordem de submissao, sem ordenar nem juntar (um draw por
+    // pacote, pulando so binds repetidos em sequencia)
+    size_t unsortedChanges = 0;
+
+    size_t stateChanges() const { return programChanges + textureChanges + vaoChanges; }
+};
+
+// Fila de desenho de um frame: os sistemas chamam submit() em qualquer ordem e
+// execute() ordena pela chave (radix sort estavel, entao chaves iguais mantem a
+// ordem de submissao), troca programa/textura/VAO so quando mudam e junta
+// pacotes vizinhos com o mesmo programa, textura, VAO e indexCount em um unico
+// glDrawElementsInstanced. Os uniforms de cada programa (projecao etc.) ficam
+// com quem submete, antes do execute().
+// Com depthTest a ordem muda: primeiro todos os opacos, da camada de cima para
+// a de baixo e da frente para tras, com teste e escrita de profundidade e sem
+// blending (o early-z descarta o que fica atras); depois os translucidos na
+// ordem de sempre, com o blending do chamador e sem escrever profundidade.
+// Cada pacote ganha um z pela camada e pela profundidade da chave (iDepth).
+// Pacotes opacos com pixels transparentes (recorte) precisam de discard no
+// programa, senao escondem o que fica atras. O framebuffer precisa de depth
+// buffer e o chamador limpa GL_DEPTH_BUFFER_BIT junto com a cor.
+struct RenderQueue {
+    RenderQueueStats stats;
+    bool depthTest = false;
+
+    void submit(const DrawPacket& packet) { packets.push_back(packet); }
+    // ordena, desenha e esvazia a fila
+    void execute();
+    // so ordena (para o benchmark): depois disso sortedIndex(i) eh o i-esimo pacote
+    void sort();
+    size_t sortedIndex(size_t i) const { return items[i].index; }
+    void clear() { packets.clear(); }
+    void destroy();
+
+    size_t size() const { return packets.size(); }
+
+private:
+    struct SortItem {
+        uint64_t key;
+        uint32_t index;
+    };
+    struct Instance {
+        Affine2D model;
+        glm::vec4 uvRect;
+        float depth;
+    };
+
+    std::vector<DrawPacket> packets;
+    std::vector<SortItem> items, scratch;
+    std::vector<Instance> instances;
+    GLBuffer instanceBuffer;
+    size_t instanceCapacity = 0;
+
+    void bindInstanceAttributes(size_t firstInstance);
+    void countUnsorted();
+};
+
+#endif
@@ -0,0 +1,176 @@
+#include "SceneGraph.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+
+// abaixo disso o custo de criar threads passa do ganho
+static const size_t PARALLEL_MIN_NODES = 32768;
+
+template <typename T>
+static void insertAt(std::vector<T>& v, int index, const T& value) {
+    v.insert(v.begin() + index, value);
+}
+
+template <typename T>
+static void eraseRange(std::vector<T>& v, int begin, int end) {
+    v.erase(v.begin() + begin, v.begin() + end);
+}
+
+int SceneGraph::add(const Transform2D& local, int parent) {
+    int parentIndex = parent >= 0 && contains(parent) ? indexOf[parent] : -1;
+    // o novo no entra no fim da subarvore do pai (ou no fim de tudo, se for raiz)
+    int index = parentIndex < 0 ? (int)size() : subtreeEnd[parentIndex];
+
+    int id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = (int)indexOf.size();
+        indexOf.push_back(-1);
+    }
+
+    insertAt(locals, index, local);
+    insertAt(localMatrices, index, composeAffine(local));
+    insertAt(worlds, index, Affine2D());
+    insertAt(parents, index, parentIndex);
+    insertAt(subtreeEnd, index, index + 1);
+    insertAt(dirty, index, (uint8_t)0);
+    insertAt(idOf, index, id);
+    indexOf[id] = index;
+
+    // quem estava dali para frente andou uma posicao
+    for (int k = index + 1; k < (int)size(); ++k) {
+        if (parents[k] >= index) parents[k]++;
+        subtreeEnd[k]++;
+        indexOf[idOf[k]] = k;
+    }
+    // e as subarvores dos ancestrais cresceram
+    for (int a = parentIndex; a >= 0; a = parents[a]) subtreeEnd[a]++;
+
+    markDirty(index);
+    return id;
+}
+
+void SceneGraph::remove(int node) {
+    if (!contains(node)) return;
+    int begin = indexOf[node], end = subtreeEnd[begin];
+    int count = end - begin;
+
+    for (int a = parents[begin]; a >= 0; a = parents[a]) subtreeEnd[a] -= count;
+    for (int k = begin; k < end; ++k) {
+        indexOf[idOf[k]] = -1;
+        freeIds.push_back(idOf[k]);
+    }
+
+    eraseRange(locals, begin, end);
+    eraseRange(localMatrices, begin, end);
+    eraseRange(worlds, begin, end);
+    eraseRange(parents, begin, end);
+    eraseRange(subtreeEnd, begin, end);
+    eraseRange(dirty, begin, end);
+    eraseRange(idOf, begin, end);
+
+    for (int k = begin; k < (int)size(); ++k) {
+        if (parents[k] >= end) parents[k] -= count;
+        subtreeEnd[k] -= count;
+        indexOf[idOf[k]] = k;
+    }
+}
+
+void SceneGraph::clear() {
+    locals.clear();
+    localMatrices.clear();
+    worlds.clear();
+    parents.clear();
+    subtreeEnd.clear();
+    dirty.clear();
+    idOf.clear();
+    indexOf.clear();
+    freeIds.clear();
+    dirtyIds.clear();
+}
+
+void SceneGraph::setLocal(int node, const Transform2D& local) {
+    int index = indexOf[node];
+    locals[index] = local;
+    localMatrices[index] = composeAffine(local);
+    markDirty(index);
+}
+
+void SceneGraph::setPosition(int node, glm::vec2 position) {
+    int index = indexOf[node];
+    locals[index].position = position;
+    // rotacao e escala nao mudaram: so a translacao da matriz local
+    localMatrices[index].tx = position.x;
+    localMatrices[index].ty = position.y;
+    markDirty(index);
+}
+
+int SceneGraph::parentOf(int node) const {
+    int p = parents[indexOf[node]];
+    return p < 0 ? -1 : idOf[p];
+}
+
+void SceneGraph::markDirty(int index) {
+    if (dirty[index]) return;
+    dirty[index] = 1;
+    dirtyIds.push_back(idOf[index]);
+}
+
+void SceneGraph::markAllDirty() {
+    for (int k = 0; k < (int)size(); k = subtreeEnd[k]) markDirty(k);
+}
+
+void SceneGraph::updateRange(int begin, int end) {
+    for (int k = begin; k < end; ++k) {
+        int p = parents[k];
+        worlds[k] = p < 0 ? localMatrices[k] : multiplyAffine(worlds[p], localMatrices[k]);
+        dirty[k] = 0;
+    }
+}
+
+// subarvore grande: resolve a raiz aqui e manda cada filho como tarefa separada
+void SceneGraph::splitRange(Range r, int grain) {
+    if (r.end - r.begin <= grain) {
+        tasks.push_back(r);
+        return;
+    }
+    updateRange(r.begin, r.begin + 1);
+    for (int c = r.begin + 1; c < r.end; c = subtreeEnd[c]) splitRange(Range{ c, subtreeEnd[c] }, grain);
+}
+
+size_t SceneGraph::update(int threads) {
+    // ids sujos -> indices, em ordem; um no dentro da subarvore de outro sujo ja
+    // vai ser refeito junto com ele
+    std::vector<int>& starts = dirtyIds;
+    for (int& id : starts) id = contains(id) ? indexOf[id] : -1;
+    std::sort(starts.begin(), starts.end());
+
+    ranges.clear();
+    size_t total = 0;
+    int coveredEnd = 0;
+    for (int index : starts) {
+        if (index < 0 || index < coveredEnd || !dirty[index]) continue;
+        ranges.push_back(Range{ index, subtreeEnd[index] });
+        coveredEnd = subtreeEnd[index];
+        total += coveredEnd - index;
+    }
+    dirtyIds.clear();
+    lastUpdated = total;
+
+    if (threads <= 0) threads = defaultThreadCount();
+    if (threads == 1 || total < PARALLEL_MIN_NODES) {
+        for (const Range& r : ranges) updateRange(r.begin, r.end);
+        return total;
+    }
+
+    // varias tarefas por thread para equilibrar subarvores de tamanhos diferentes
+    tasks.clear();
+    int grain = (int)std::max<size_t>(1024, total / (threads * 8));
+    for (const Range& r : ranges) splitRange(r, grain);
+    parallelFor(tasks.size(), threads, 1, [this](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) updateRange(tasks[t].begin, tasks[t].end);
+    });
+    return total;
+}
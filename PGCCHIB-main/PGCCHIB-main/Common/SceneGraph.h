@@ -0,0 +1,88 @@
+#ifndef SCENE_GRAPH_H
+#define SCENE_GRAPH_H
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Transform2D.h"
+
+// Hierarquia de transformacoes 2D (pai -> filhos) guardada em vetores.
+//
+// Os nos ficam em pre-ordem: todo pai vem antes dos filhos e a subarvore de um
+// no eh a faixa continua [indice, subtreeEnd). Entao:
+//   - recalcular a posicao no mundo eh um laco em ordem, o pai ja esta pronto
+//     quando o filho chega (world = world[pai] * local);
+//   - mover um no marca so ele como sujo e o update() refaz apenas a faixa da
+//     subarvore dele, sem percorrer a cena toda;
+//   - subarvores diferentes sao faixas disjuntas e podem ir para threads
+//     diferentes.
+//
+// Os ids devolvidos pelo add() nao mudam; o indice na pre-ordem muda quando um
+// no entra no meio ou sai. Adicionar ao ultimo no aberto (montar a cena em
+// profundidade) so empurra no fim; adicionar filho a um no antigo ou remover
+// desloca os vetores, O(n).
+struct SceneGraph {
+    // estatistica do ultimo update()
+    size_t lastUpdated = 0;
+
+    // parent = -1 cria uma raiz
+    int add(const Transform2D& local, int parent = -1);
+    // remove o no e toda a subarvore
+    void remove(int node);
+    void clear();
+
+    void setLocal(int node, const Transform2D& local);
+    void setPosition(int node, glm::vec2 position);
+    const Transform2D& local(int node) const { return locals[indexOf[node]]; }
+
+    // valido depois do update()
+    const Affine2D& world(int node) const { return worlds[indexOf[node]]; }
+    glm::vec2 worldPosition(int node) const {
+        const Affine2D& m = worlds[indexOf[node]];
+        return glm::vec2(m.tx, m.ty);
+    }
+
+    int parentOf(int node) const;
+    bool contains(int node) const { return node >= 0 && node < (int)indexOf.size() && indexOf[node] >= 0; }
+    size_t size() const { return locals.size(); }
+
+    // Recalcula o mundo das subarvores sujas e devolve quantos nos foram refeitos.
+    // Com muitos nos sujos as subarvores independentes sao divididas entre
+    // threads (threads = 0 usa todos os nucleos)
+    size_t update(int threads = 0);
+    // marca tudo como sujo (para comparar com o recalculo completo)
+    void markAllDirty();
+
+    // em pre-ordem, para desenhar em ordem ou percorrer sem os ids
+    const std::vector<Affine2D>& worldMatrices() const { return worlds; }
+    int nodeAt(size_t index) const { return idOf[index]; }
+
+private:
+    // por indice em pre-ordem
+    std::vector<Transform2D> locals;
+    std::vector<Affine2D> localMatrices; // composeAffine(local), refeita no setLocal
+    std::vector<Affine2D> worlds;
+    std::vector<int> parents;            // indice do pai (< indice do no) ou -1
+    std::vector<int> subtreeEnd;         // fim (exclusivo) da subarvore
+    std::vector<uint8_t> dirty;
+    std::vector<int> idOf;
+
+    // por id
+    std::vector<int> indexOf;            // -1 = id livre
+    std::vector<int> freeIds;
+    std::vector<int> dirtyIds;
+
+    struct Range {
+        int begin, end;
+    };
+    std::vector<Range> ranges, tasks;
+
+    void markDirty(int index);
+    void updateRange(int begin, int end);
+    void splitRange(Range r, int grain);
+};
+
+#endif
@@ -0,0 +1,220 @@
+#include "SpriteMesh.h"
+
+#include <algorithm>
+
+void SpriteMesh::quad() {
+    points = { glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f) };
+    indices = { 0, 1, 2, 2, 3, 0 };
+    coverage = 1.0f;
+}
+
+SpriteAlpha classifySpriteAlpha(const unsigned char* rgba, int imageWidth, int x, int y, int w, int h,
+                                int tolerance) {
+    SpriteAlpha result = SPRITE_OPAQUE;
+    for (int row = 0; row < h; ++row) {
+        const unsigned char* p = rgba + ((size_t)(y + row) * imageWidth + x) * 4 + 3;
+        for (int col = 0; col < w; ++col, p += 4) {
+            if (*p >= 255 - tolerance)
+                continue;
+            if (*p > tolerance)
+                return SPRITE_TRANSLUCENT;
+            result = SPRITE_CUTOUT;
+        }
+    }
+    return result;
+}
+
+// junta em left/right (por linha do frame, right exclusivo; vazia se left >= right)
+// os pixels com alfa do retangulo (x, y, w, h)
+static void addRowExtents(const unsigned char* rgba, int imageWidth, int x, int y, int w, int h, int alphaThreshold,
+                          std::vector<int>& left, std::vector<int>& right) {
+    for (int row = 0; row < h; ++row) {
+        const unsigned char* p = rgba + ((size_t)(y + row) * imageWidth + x) * 4;
+        int first = -1, last = -1;
+        for (int col = 0; col < w; ++col) {
+            if (p[col * 4 + 3] > alphaThreshold) {
+                if (first < 0) first = col;
+                last = col;
+            }
+        }
+        if (first < 0) continue;
+        left[row] = std::min(left[row], first);
+        right[row] = std::max(right[row], last + 1);
+    }
+}
+
+namespace {
+// faixa de linhas [top, bottom) com as bordas esquerda e direita como retas
+// (pontas em pixels, em cima e embaixo)
+struct Band {
+    int top, bottom;
+    float leftTop, leftBottom, rightTop, rightBottom;
+};
+
+// retas que passam pelas linhas das pontas e depois sao empurradas para fora
+// ate cobrir todas as linhas da faixa (a reta tem que estar fora nas duas
+// alturas de cada linha, em cima e embaixo do pixel)
+Band fitBand(const std::vector<int>& left, const std::vector<int>& right, int top, int bottom, int w) {
+    Band b = { top, bottom, (float)left[top], (float)left[bottom - 1], (float)right[top], (float)right[bottom - 1] };
+    float rows = (float)(bottom - top);
+    float shiftLeft = 0.0f, shiftRight = 0.0f;
+    for (int r = top; r < bottom; ++r) {
+        for (int y = r; y <= r + 1; ++y) {
+            float t = (y - top) / rows;
+            shiftLeft = std::max(shiftLeft, b.leftTop + (b.leftBottom - b.leftTop) * t - left[r]);
+            shiftRight = std::max(shiftRight, right[r] - (b.rightTop + (b.rightBottom - b.rightTop) * t));
+        }
+    }
+    b.leftTop -= shiftLeft;
+    b.leftBottom -= shiftLeft;
+    b.rightTop += shiftRight;
+    b.rightBottom += shiftRight;
+
+    // ponta fora do frame puxaria pixels do frame vizinho: borda reta
+    if (b.leftTop < 0.0f || b.leftBottom < 0.0f) {
+        int l = w;
+        for (int r = top; r < bottom; ++r) l = std::min(l, left[r]);
+        b.leftTop = b.leftBottom = (float)l;
+    }
+    if (b.rightTop > w || b.rightBottom > w) {
+        int rr = 0;
+        for (int r = top; r < bottom; ++r) rr = std::max(rr, right[r]);
+        b.rightTop = b.rightBottom = (float)rr;
+    }
+    return b;
+}
+
+// area da faixa com as pontas ajustadas aos vizinhos: a borda entre duas
+// faixas fica com a ponta mais de fora das duas (assim as duas retas continuam
+// cobrindo as suas linhas)
+float bandArea(const Band* above, const Band& band, const Band* below) {
+    float topLeft = above ? std::min(above->leftBottom, band.leftTop) : band.leftTop;
+    float topRight = above ? std::max(above->rightBottom, band.rightTop) : band.rightTop;
+    float bottomLeft = below ? std::min(below->leftTop, band.leftBottom) : band.leftBottom;
+    float bottomRight = below ? std::max(below->rightTop, band.rightBottom) : band.rightBottom;
+    return (band.bottom - band.top) * ((topRight - topLeft) + (bottomRight - bottomLeft)) * 0.5f;
+}
+}
+
+static void buildMesh(std::vector<int>& left, std::vector<int>& right, int w, int h, int maxVertices, int padding,
+                      SpriteMesh& mesh) {
+    mesh.points.clear();
+    mesh.indices.clear();
+    mesh.coverage = 0.0f;
+
+    // margem: cada linha fica com o mais largo das linhas a ate padding de
+    // distancia, mais padding pixels de cada lado
+    if (padding > 0) {
+        std::vector<int> l(h, w), r(h, 0);
+        for (int row = 0; row < h; ++row) {
+            for (int k = std::max(0, row - padding); k <= std::min(h - 1, row + padding); ++k) {
+                if (left[k] >= right[k]) continue;
+                l[row] = std::min(l[row], std::max(0, left[k] - padding));
+                r[row] = std::max(r[row], std::min(w, right[k] + padding));
+            }
+        }
+        left.swap(l);
+        right.swap(r);
+    }
+
+    int first = 0, last = h - 1;
+    while (first < h && left[first] >= right[first]) first++;
+    while (last >= first && left[last] >= right[last]) last--;
+    if (first > last) return;
+
+    std::vector<Band> bands;
+    for (int row = first; row <= last; ++row) {
+        if (left[row] >= right[row]) {
+            // linha vazia no meio: largura zero no centro da anterior
+            int center = (left[row - 1] + right[row - 1]) / 2;
+            left[row] = right[row] = center;
+        }
+        bands.push_back(fitBand(left, right, row, row + 1, w));
+    }
+
+    // junta o par vizinho que menos aumenta a area ate caber no orcamento
+    size_t maxBands = (size_t)std::max(4, maxVertices) / 2 - 1;
+    while (bands.size() > maxBands) {
+        size_t best = 0;
+        float bestCost = 0.0f;
+        Band bestMerged = bands[0];
+        for (size_t j = 0; j + 1 < bands.size(); ++j) {
+            const Band* before = j > 0 ? &bands[j - 1] : nullptr;
+            const Band* after = j + 2 < bands.size() ? &bands[j + 2] : nullptr;
+            const Band* beforeBefore = j > 1 ? &bands[j - 2] : nullptr;
+            const Band* afterAfter = j + 3 < bands.size() ? &bands[j + 3] : nullptr;
+            Band merged = fitBand(left, right, bands[j].top, bands[j + 1].bottom, w);
+
+            float old = bandArea(before, bands[j], &bands[j + 1]) + bandArea(&bands[j], bands[j + 1], after);
+            float now = bandArea(before, merged, after);
+            if (before) {
+                old += bandArea(beforeBefore, *before, &bands[j]);
+                now += bandArea(beforeBefore, *before, &merged);
+            }
+            if (after) {
+                old += bandArea(&bands[j + 1], *after, afterAfter);
+                now += bandArea(&merged, *after, afterAfter);
+            }
+            if (j == 0 || now - old < bestCost) {
+                bestCost = now - old;
+                best = j;
+                bestMerged = merged;
+            }
+        }
+        bands[best] = bestMerged;
+        bands.erase(bands.begin() + best + 1);
+    }
+
+    // dois pontos por borda (esquerda e direita), dois triangulos por faixa
+    size_t n = bands.size();
+    float area = 0.0f;
+    for (size_t k = 0; k <= n; ++k) {
+        const Band* above = k > 0 ? &bands[k - 1] : nullptr;
+        const Band* below = k < n ? &bands[k] : nullptr;
+        int y = below ? below->top : above->bottom;
+        float l = std::min(above ? above->leftBottom : (float)w, below ? below->leftTop : (float)w);
+        float r = std::max(above ? above->rightBottom : 0.0f, below ? below->rightTop : 0.0f);
+        mesh.points.push_back(glm::vec2(l / w, (float)y / h));
+        mesh.points.push_back(glm::vec2(r / w, (float)y / h));
+        if (below)
+            area += bandArea(above, *below, k + 1 < n ? &bands[k + 1] : nullptr);
+    }
+    for (uint32_t k = 0; k < (uint32_t)n; ++k) {
+        uint32_t l0 = 2 * k, r0 = l0 + 1, l1 = l0 + 2, r1 = l0 + 3;
+        mesh.indices.insert(mesh.indices.end(), { l0, r0, r1, l0, r1, l1 });
+    }
+    mesh.coverage = area / ((float)w * h);
+}
+
+void traceSpriteMesh(const unsigned char* rgba, int imageWidth, int x, int y, int w, int h,
+                     int maxVertices, SpriteMesh& mesh, int alphaThreshold, int padding) {
+    std::vector<int> left(h, w), right(h, 0);
+    addRowExtents(rgba, imageWidth, x, y, w, h, alphaThreshold, left, right);
+    buildMesh(left, right, w, h, maxVertices, padding, mesh);
+    mesh.alpha = classifySpriteAlpha(rgba, imageWidth, x, y, w, h);
+}
+
+void traceSpriteSheet(const unsigned char* rgba, int imageWidth, int imageHeight, int columns, int rows,
+                      int maxVertices, std::vector<SpriteMesh>& meshes, int alphaThreshold, int padding) {
+    int w = imageWidth / columns, h = imageHeight / rows;
+    meshes.resize((size_t)columns * rows);
+    for (int r = 0; r < rows; ++r)
+        for (int c = 0; c < columns; ++c)
+            traceSpriteMesh(rgba, imageWidth, c * w, r * h, w, h, maxVertices, meshes[r * columns + c],
+                            alphaThreshold, padding);
+}
+
+void traceSpriteSheetUnion(const unsigned char* rgba, int imageWidth, int imageHeight, int columns, int rows,
+                           int maxVertices, SpriteMesh& mesh, int alphaThreshold, int padding) {
+    int w = imageWidth / columns, h = imageHeight / rows;
+    std::vector<int> left(h, w), right(h, 0);
+    SpriteAlpha alpha = SPRITE_OPAQUE;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c) {
+            addRowExtents(rgba, imageWidth, c * w, r * h, w, h, alphaThreshold, left, right);
+            alpha = std::max(alpha, classifySpriteAlpha(rgba, imageWidth, c * w, r * h, w, h));
+        }
+    }
+    buildMesh(left, right, w, h, maxVertices, padding, mesh);
+    mesh.alpha = alpha;
+}
@@ -0,0 +1,63 @@
+#ifndef SPRITE_MESH_H
+#define SPRITE_MESH_H
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Como o frame precisa ser desenhado, pelo alfa dos pixels. A ordem importa:
+// juntando varios frames fica o maior.
+enum SpriteAlpha : uint8_t {
+    SPRITE_OPAQUE = 0,  // todo pixel opaco: sem blending nem discard (early-z livre)
+    SPRITE_CUTOUT,      // so transparente ou opaco (pixel art): discard, sem blending
+    SPRITE_TRANSLUCENT  // algum alfa no meio: blending, de tras para frente
+};
+
+// Classifica o retangulo (x, y, w, h) da imagem RGBA. Alfas ate tolerance
+// contam como 0 e a partir de 255 - tolerance como 255 (o recorte com alfa
+// 0.5 erra no maximo tolerance / 255 nesses pixels).
+SpriteAlpha classifySpriteAlpha(const unsigned char* rgba, int imageWidth, int x, int y, int w, int h,
+                                int tolerance = 0);
+
+// Mesh justo de um frame de sprite: em vez do quad inteiro, um poligono que
+// cobre so os pixels com alfa, para nao pagar o blending dos transparentes.
+// Os pontos ficam no retangulo do frame, de 0 a 1, com x para a direita e y na
+// ordem das linhas da imagem carregada (y = 0 eh a primeira linha do buffer,
+// que eh a linha t = 0 da textura). Assim o ponto vira coordenada de textura
+// com a mesma conta do canto do quad (uvMin + p * (uvMax - uvMin)).
+struct SpriteMesh {
+    std::vector<glm::vec2> points;
+    std::vector<uint32_t> indices; // triangulos
+    float coverage = 1.0f;         // area do poligono / area do quad
+    SpriteAlpha alpha = SPRITE_CUTOUT; // classificado no trace; sem trace, o recorte de sempre
+
+    // o quad inteiro (2 triangulos)
+    void quad();
+};
+
+// Traca o retangulo (x, y, w, h) da imagem RGBA (imageWidth de largura, linha
+// por linha) num poligono monotono em x: faixas de linhas, cada uma um trapezio
+// com os lados inclinados pelos pixels com alfa > alphaThreshold e empurrados
+// para fora ate conter todas as linhas da faixa, entao o poligono sempre
+// contem os pixels (pode ser concavo dos lados, como o contorno de um boneco).
+// Comeca com uma faixa por linha e junta as duas vizinhas que menos aumentam a
+// area ate caber em maxVertices (minimo 4: o retangulo justo). padding pixels a
+// mais em volta cobrem o que a filtragem linear puxa dos vizinhos.
+// Frame todo transparente da um mesh sem triangulos. alpha sai de
+// classifySpriteAlpha do frame (tolerancia 0).
+void traceSpriteMesh(const unsigned char* rgba, int imageWidth, int x, int y, int w, int h,
+                     int maxVertices, SpriteMesh& mesh, int alphaThreshold = 0, int padding = 1);
+
+// Uma folha de columns x rows frames do mesmo tamanho: um mesh por frame,
+// frame (c, r) em meshes[r * columns + c]. Os meshes sao da folha (cache junto
+// com a textura), nao de cada sprite que usa o frame.
+void traceSpriteSheet(const unsigned char* rgba, int imageWidth, int imageHeight, int columns, int rows,
+                      int maxVertices, std::vector<SpriteMesh>& meshes, int alphaThreshold = 0, int padding = 1);
+
+// Um mesh so que cobre todos os frames da folha (a uniao dos alfas), para quem
+// troca de frame so pelo deslocamento da coordenada de textura.
+void traceSpriteSheetUnion(const unsigned char* rgba, int imageWidth, int imageHeight, int columns, int rows,
+                           int maxVertices, SpriteMesh& mesh, int alphaThreshold = 0, int padding = 1);
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+
+// Fila circular sem lock para exatamente um produtor e um consumidor.
+// Capacity precisa ser potencia de 2. O produtor so escreve tail e o consumidor
+// so escreve head; cada indice fica na sua linha de cache para as duas threads
+// nao disputarem a mesma linha.
+template <typename T, size_t Capacity>
+struct SpscRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscRing: Capacity deve ser potencia de 2");
+
+    // produtor: false se a fila estiver cheia (o item nao entra)
+    bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumidor: false se a fila estiver vazia
+    bool pop(T& out) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+            return false;
+        out = items[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // aproximado se chamado enquanto a outra thread mexe na fila
+    size_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) T items[Capacity];
+};
+
+#endif
@@ -0,0 +1,487 @@
+#include "TextRenderer.h"
+#include "Font5x7.h"
+
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+// SDF: cada pixel da fonte vira 6x6 texels e o campo alcanca 4 texels para fora
+static const int SDF_SCALE = 6;
+static const int SDF_SPREAD = 4;
+static const int BITMAP_ATLAS_SIZE = 256;
+static const int SDF_ATLAS_SIZE = 1024;
+
+// strings diferentes guardadas por modo; passando disso o cache recomeca
+// (contadores que mudam todo frame nao fazem o cache crescer sem limite)
+static const size_t MAX_LAYOUTS = 512;
+
+static const char* textVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 position;
+layout (location = 1) in vec2 texCoord;
+layout (location = 2) in vec4 color;
+
+uniform vec2 screen;
+
+out vec2 TexCoord;
+out vec4 Color;
+
+void main()
+{
+    gl_Position = vec4(position.x / screen.x * 2.0 - 1.0, 1.0 - position.y / screen.y * 2.0, 0.0, 1.0);
+    TexCoord = texCoord;
+    Color = color;
+}
+)";
+
+static const char* textFragmentSource = R"(
+#version 330 core
+in vec2 TexCoord;
+in vec4 Color;
+out vec4 FragColor;
+
+uniform sampler2D atlas;
+uniform bool sdf;
+
+void main()
+{
+    float d = texture(atlas, TexCoord).r;
+    float alpha = d;
+    if (sdf) {
+        // borda em 0.5, suavizada em mais ou menos um pixel da tela
+        float w = max(fwidth(d) * 0.7, 1e-4);
+        alpha = smoothstep(0.5 - w, 0.5 + w, d);
+    }
+    if (alpha <= 0.0)
+        discard;
+    FragColor = vec4(Color.rgb, Color.a * alpha);
+}
+)";
+
+// ---------------------------------------------------------------------------
+// UTF-8 e composicao
+
+static const uint32_t GLYPH_UNKNOWN = '?';
+
+// letras acentuadas do Latin-1 (U+00C0 a U+00FF) -> letra base e marca
+struct Precomposed {
+    uint16_t codepoint;
+    char base;
+    uint8_t mark;
+};
+
+static const Precomposed PRECOMPOSED[] = {
+    { 0xC0, 'A', MARK_GRAVE }, { 0xC1, 'A', MARK_ACUTE }, { 0xC2, 'A', MARK_CIRCUMFLEX }, { 0xC3, 'A', MARK_TILDE },
+    { 0xC4, 'A', MARK_DIAERESIS }, { 0xC7, 'C', MARK_CEDILLA },
+    { 0xC8, 'E', MARK_GRAVE }, { 0xC9, 'E', MARK_ACUTE }, { 0xCA, 'E', MARK_CIRCUMFLEX }, { 0xCB, 'E', MARK_DIAERESIS },
+    { 0xCC, 'I', MARK_GRAVE }, { 0xCD, 'I', MARK_ACUTE }, { 0xCE, 'I', MARK_CIRCUMFLEX }, { 0xCF, 'I', MARK_DIAERESIS },
+    { 0xD1, 'N', MARK_TILDE },
+    { 0xD2, 'O', MARK_GRAVE }, { 0xD3, 'O', MARK_ACUTE }, { 0xD4, 'O', MARK_CIRCUMFLEX }, { 0xD5, 'O', MARK_TILDE },
+    { 0xD6, 'O', MARK_DIAERESIS },
+    { 0xD9, 'U', MARK_GRAVE }, { 0xDA, 'U', MARK_ACUTE }, { 0xDB, 'U', MARK_CIRCUMFLEX }, { 0xDC, 'U', MARK_DIAERESIS },
+    { 0xE0, 'a', MARK_GRAVE }, { 0xE1, 'a', MARK_ACUTE }, { 0xE2, 'a', MARK_CIRCUMFLEX }, { 0xE3, 'a', MARK_TILDE },
+    { 0xE4, 'a', MARK_DIAERESIS }, { 0xE7, 'c', MARK_CEDILLA },
+    { 0xE8, 'e', MARK_GRAVE }, { 0xE9, 'e', MARK_ACUTE }, { 0xEA, 'e', MARK_CIRCUMFLEX }, { 0xEB, 'e', MARK_DIAERESIS },
+    { 0xEC, 'i', MARK_GRAVE }, { 0xED, 'i', MARK_ACUTE }, { 0xEE, 'i', MARK_CIRCUMFLEX }, { 0xEF, 'i', MARK_DIAERESIS },
+    { 0xF1, 'n', MARK_TILDE },
+    { 0xF2, 'o', MARK_GRAVE }, { 0xF3, 'o', MARK_ACUTE }, { 0xF4, 'o', MARK_CIRCUMFLEX }, { 0xF5, 'o', MARK_TILDE },
+    { 0xF6, 'o', MARK_DIAERESIS },
+    { 0xF9, 'u', MARK_GRAVE }, { 0xFA, 'u', MARK_ACUTE }, { 0xFB, 'u', MARK_CIRCUMFLEX }, { 0xFC, 'u', MARK_DIAERESIS },
+};
+
+static uint8_t combiningMark(uint32_t cp) {
+    switch (cp) {
+    case 0x0300: return MARK_GRAVE;
+    case 0x0301: return MARK_ACUTE;
+    case 0x0302: return MARK_CIRCUMFLEX;
+    case 0x0303: return MARK_TILDE;
+    case 0x0308: return MARK_DIAERESIS;
+    case 0x0327: return MARK_CEDILLA;
+    default: return MARK_NONE;
+    }
+}
+
+// proximo code point; sequencias invalidas viram U+FFFD e avancam um byte
+static uint32_t decodeUtf8(const std::string& s, size_t& i) {
+    unsigned char c = (unsigned char)s[i];
+    int extra = c < 0x80 ? 0 : (c >> 5) == 0x6 ? 1 : (c >> 4) == 0xE ? 2 : (c >> 3) == 0x1E ? 3 : -1;
+    if (extra < 0 || i + extra >= s.size()) {
+        i++;
+        return 0xFFFD;
+    }
+    uint32_t cp = extra == 0 ? c : (c & (0x3F >> extra));
+    for (int k = 1; k <= extra; ++k) {
+        unsigned char cc = (unsigned char)s[i + k];
+        if ((cc & 0xC0) != 0x80) {
+            i++;
+            return 0xFFFD;
+        }
+        cp = (cp << 6) | (cc & 0x3F);
+    }
+    i += extra + 1;
+    return cp;
+}
+
+void shapeText(const std::string& utf8, std::vector<uint32_t>& glyphs) {
+    glyphs.clear();
+    size_t i = 0;
+    while (i < utf8.size()) {
+        uint32_t cp = decodeUtf8(utf8, i);
+
+        uint8_t mark = combiningMark(cp);
+        if (mark != MARK_NONE) {
+            // marca combinante: vai para a letra anterior se ela ainda nao tiver uma
+            if (!glyphs.empty() && (glyphs.back() >> 8) == 0 && glyphs.back() != '\n' && glyphs.back() != ' ')
+                glyphs.back() |= (uint32_t)mark << 8;
+            continue;
+        }
+
+        if (cp == '\n' || (cp >= 32 && cp < 127)) {
+            glyphs.push_back(cp);
+            continue;
+        }
+
+        uint32_t glyph = GLYPH_UNKNOWN;
+        for (const Precomposed& p : PRECOMPOSED)
+            if (p.codepoint == cp) {
+                glyph = (uint32_t)(unsigned char)p.base | ((uint32_t)p.mark << 8);
+                break;
+            }
+        glyphs.push_back(glyph);
+    }
+}
+
+// desenha o glifo (letra + marca) na celula CELL_WIDTH x CELL_HEIGHT (1 = tinta)
+void TextRenderer::rasterize(uint32_t glyph, std::vector<uint8_t>& cell) {
+    cell.assign(CELL_WIDTH * CELL_HEIGHT, 0);
+    char base = (char)(glyph & 0xFF);
+    int mark = (int)(glyph >> 8);
+
+    int index = base - FONT_5X7_FIRST;
+    // i acentuado usa o i sem ponto para o acento nao encostar no pingo
+    if (base == 'i' && mark != MARK_NONE && mark != MARK_CEDILLA) index = FONT_5X7_DOTLESS_I;
+    if (index < 0 || index >= FONT_5X7_COUNT) index = '?' - FONT_5X7_FIRST;
+
+    auto put = [&](int row, unsigned char bits) {
+        if (row < 0 || row >= CELL_HEIGHT) return;
+        for (int col = 0; col < 5; ++col)
+            if (bits & (0x10 >> col)) cell[row * CELL_WIDTH + col] = 1;
+    };
+
+    // linhas 0-1 da celula ficam livres para acento em maiuscula
+    for (int r = 0; r < FONT_5X7_ROWS; ++r)
+        put(r + 2, FONT_5X7[index][r]);
+
+    if (mark <= MARK_NONE || mark >= MARK_COUNT) return;
+    int markRow;
+    if (mark == MARK_CEDILLA)
+        markRow = 9;                      // embaixo da linha de base
+    else if (base >= 'A' && base <= 'Z')
+        markRow = 0;                      // acima da maiuscula
+    else
+        markRow = 2;                      // acima da altura-x da minuscula
+    put(markRow, FONT_5X7_MARKS[mark][0]);
+    put(markRow + 1, FONT_5X7_MARKS[mark][1]);
+}
+
+// ---------------------------------------------------------------------------
+// TextRenderer
+
+bool TextRenderer::init() {
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vs, 1, &textVertexSource, NULL);
+    glCompileShader(vs);
+    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fs, 1, &textFragmentSource, NULL);
+    glCompileShader(fs);
+
+    program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Erro ao linkar shader de texto: " << infoLog << std::endl;
+        return false;
+    }
+    screenLoc = glGetUniformLocation(program, "screen");
+    sdfLoc = glGetUniformLocation(program, "sdf");
+    atlasLoc = glGetUniformLocation(program, "atlas");
+
+    for (int m = 0; m < 2; ++m) {
+        Atlas& a = atlases[m];
+        bool sdf = m == TEXT_SDF;
+        a.size = sdf ? SDF_ATLAS_SIZE : BITMAP_ATLAS_SIZE;
+        a.scale = sdf ? SDF_SCALE : 1;
+        a.spread = sdf ? SDF_SPREAD : 1; // no bitmap eh so uma borda vazia
+        a.cellW = CELL_WIDTH * a.scale + 2 * a.spread;
+        a.cellH = CELL_HEIGHT * a.scale + 2 * a.spread;
+
+        std::vector<uint8_t> zeros((size_t)a.size * a.size, 0);
+        glGenTextures(1, &a.texture);
+        glBindTexture(GL_TEXTURE_2D, a.texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, a.size, a.size, 0, GL_RED, GL_UNSIGNED_BYTE, zeros.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        GLint filter = sdf ? GL_LINEAR : GL_NEAREST;
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, x));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)offsetof(Vertex, r));
+    glEnableVertexAttribArray(2);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBindVertexArray(0);
+    return true;
+}
+
+void TextRenderer::destroy() {
+    for (Atlas& a : atlases) {
+        if (a.texture) glDeleteTextures(1, &a.texture);
+        a = Atlas();
+    }
+    layouts[0].clear();
+    layouts[1].clear();
+    if (program) glDeleteProgram(program);
+    if (VAO) glDeleteVertexArrays(1, &VAO);
+    if (VBO) glDeleteBuffers(1, &VBO);
+    if (EBO) glDeleteBuffers(1, &EBO);
+    program = VAO = VBO = EBO = 0;
+    indexCapacity = 0;
+}
+
+void TextRenderer::resetAtlas(TextMode mode) {
+    // atlas cheio: recomeca do zero (os layouts guardam UVs, entao vao junto)
+    atlases[mode].slots.clear();
+    atlases[mode].used = 0;
+    layouts[mode].clear();
+}
+
+bool TextRenderer::glyphSlot(Atlas& a, TextMode mode, uint32_t glyph, int& slot) {
+    auto it = a.slots.find(glyph);
+    if (it != a.slots.end()) {
+        slot = it->second;
+        return true;
+    }
+
+    int columns = a.size / a.cellW;
+    int capacity = columns * (a.size / a.cellH);
+    if (a.used >= capacity) return false;
+    slot = a.used++;
+    a.slots.emplace(glyph, slot);
+
+    std::vector<uint8_t> cell;
+    rasterize(glyph, cell);
+
+    // texels da celula do atlas, com a borda (spread) em volta
+    std::vector<uint8_t> texels((size_t)a.cellW * a.cellH, 0);
+    auto ink = [&](int tx, int ty) {
+        int fx = (tx - a.spread), fy = (ty - a.spread);
+        if (fx < 0 || fy < 0) return false;
+        fx /= a.scale;
+        fy /= a.scale;
+        return fx < CELL_WIDTH && fy < CELL_HEIGHT && cell[fy * CELL_WIDTH + fx] != 0;
+    };
+
+    if (mode == TEXT_BITMAP) {
+        for (int ty = 0; ty < a.cellH; ++ty)
+            for (int tx = 0; tx < a.cellW; ++tx)
+                texels[ty * a.cellW + tx] = ink(tx, ty) ? 255 : 0;
+    } else {
+        // distancia ate o texel mais proximo do outro lado da borda, procurando
+        // so ate o alcance do campo (o resto satura em 0 ou 1)
+        int reach = a.spread + 1;
+        for (int ty = 0; ty < a.cellH; ++ty)
+            for (int tx = 0; tx < a.cellW; ++tx) {
+                bool inside = ink(tx, ty);
+                float best = (float)reach;
+                for (int dy = -reach; dy <= reach; ++dy)
+                    for (int dx = -reach; dx <= reach; ++dx) {
+                        if (ink(tx + dx, ty + dy) == inside) continue;
+                        float d = std::sqrt((float)(dx * dx + dy * dy));
+                        if (d < best) best = d;
+                    }
+                float signedDist = inside ? best - 0.5f : -(best - 0.5f);
+                float v = 0.5f + signedDist / (2.0f * a.spread);
+                texels[ty * a.cellW + tx] = (uint8_t)(std::min(1.0f, std::max(0.0f, v)) * 255.0f + 0.5f);
+            }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, a.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, (slot % columns) * a.cellW, (slot / columns) * a.cellH,
+                    a.cellW, a.cellH, GL_RED, GL_UNSIGNED_BYTE, texels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    return true;
+}
+
+bool TextRenderer::buildLayout(const std::string& text, TextMode mode, Layout& result) {
+    Atlas& a = atlases[mode];
+    shapeText(text, shaped);
+
+    result.quads.clear();
+    result.quads.reserve(shaped.size());
+    int columns = a.size / a.cellW;
+    // no SDF o quad inclui a borda do campo; no bitmap so a celula
+    float pad = mode == TEXT_SDF ? (float)a.spread / a.scale : 0.0f;
+    int inset = mode == TEXT_SDF ? 0 : a.spread;
+
+    float penX = 0.0f, penY = 0.0f, widest = 0.0f;
+    bool complete = true;
+    for (uint32_t glyph : shaped) {
+        if (glyph == '\n') {
+            widest = std::max(widest, penX);
+            penX = 0.0f;
+            penY += LINE_HEIGHT;
+            continue;
+        }
+        int slot;
+        if (glyph != ' ' && glyphSlot(a, mode, glyph, slot)) {
+            float cx = (float)((slot % columns) * a.cellW + inset);
+            float cy = (float)((slot / columns) * a.cellH + inset);
+            float cw = (float)(a.cellW - 2 * inset), ch = (float)(a.cellH - 2 * inset);
+            LayoutQuad q;
+            q.x0 = penX - pad;
+            q.y0 = penY - pad;
+            q.x1 = penX + CELL_WIDTH + pad;
+            q.y1 = penY + CELL_HEIGHT + pad;
+            q.u0 = cx / a.size;
+            q.v0 = cy / a.size;
+            q.u1 = (cx + cw) / a.size;
+            q.v1 = (cy + ch) / a.size;
+            result.quads.push_back(q);
+        } else if (glyph != ' ') {
+            complete = false; // atlas cheio: o glifo fica em branco
+        }
+        penX += CELL_WIDTH;
+    }
+    widest = std::max(widest, penX);
+    result.size = glm::vec2(widest, penY + CELL_HEIGHT);
+    return complete;
+}
+
+const TextRenderer::Layout& TextRenderer::layout(const std::string& text, TextMode mode) {
+    auto cached = layouts[mode].find(text);
+    if (cached != layouts[mode].end()) return cached->second;
+    if (layouts[mode].size() >= MAX_LAYOUTS) layouts[mode].clear();
+
+    Layout result;
+    if (!buildLayout(text, mode, result)) {
+        // o atlas encheu no meio: recomeca o atlas e monta de novo. O que ja foi
+        // adicionado neste frame com o atlas antigo pode sair errado por um frame
+        resetAtlas(mode);
+        buildLayout(text, mode, result);
+    }
+    return layouts[mode].emplace(text, std::move(result)).first->second;
+}
+
+void TextRenderer::begin(int screenWidth, int screenHeight) {
+    screenW = (float)std::max(1, screenWidth);
+    screenH = (float)std::max(1, screenHeight);
+    vertices[0].clear();
+    vertices[1].clear();
+}
+
+float TextRenderer::add(const std::string& text, float x, float y, float scale, const glm::vec4& color, TextMode mode) {
+    const Layout& l = layout(text, mode);
+
+    uint8_t r = (uint8_t)(glm::clamp(color.r, 0.0f, 1.0f) * 255.0f + 0.5f);
+    uint8_t g = (uint8_t)(glm::clamp(color.g, 0.0f, 1.0f) * 255.0f + 0.5f);
+    uint8_t b = (uint8_t)(glm::clamp(color.b, 0.0f, 1.0f) * 255.0f + 0.5f);
+    uint8_t a = (uint8_t)(glm::clamp(color.a, 0.0f, 1.0f) * 255.0f + 0.5f);
+
+    std::vector<Vertex>& out = vertices[mode];
+    size_t at = out.size();
+    out.resize(at + l.quads.size() * 4);
+    Vertex* v = &out[at];
+    for (const LayoutQuad& q : l.quads) {
+        float x0 = x + q.x0 * scale, y0 = y + q.y0 * scale;
+        float x1 = x + q.x1 * scale, y1 = y + q.y1 * scale;
+        v[0] = { x0, y0, q.u0, q.v0, r, g, b, a };
+        v[1] = { x1, y0, q.u1, q.v0, r, g, b, a };
+        v[2] = { x1, y1, q.u1, q.v1, r, g, b, a };
+        v[3] = { x0, y1, q.u0, q.v1, r, g, b, a };
+        v += 4;
+    }
+    return l.size.x * scale;
+}
+
+glm::vec2 TextRenderer::measure(const std::string& text, float scale) {
+    return layout(text, TEXT_BITMAP).size * scale;
+}
+
+float TextRenderer::add(const char* text, float x, float y, float scale, const glm::vec4& color, TextMode mode) {
+    lookupKey.assign(text);
+    return add(lookupKey, x, y, scale, color, mode);
+}
+
+glm::vec2 TextRenderer::measure(const char* text, float scale) {
+    lookupKey.assign(text);
+    return measure(lookupKey, scale);
+}
+
+void TextRenderer::flush() {
+    lastDrawCalls = 0;
+    lastQuads = 0;
+    size_t maxQuads = std::max(vertices[0].size(), vertices[1].size()) / 4;
+    if (maxQuads == 0) return;
+
+    glBindVertexArray(VAO);
+    // indices 0 1 2 / 2 3 0 por quad, so crescem
+    if (maxQuads > indexCapacity) {
+        indexCapacity = std::max(maxQuads, indexCapacity * 2);
+        std::vector<uint32_t> indices(indexCapacity * 6);
+        for (size_t q = 0; q < indexCapacity; ++q) {
+            uint32_t base = (uint32_t)(q * 4);
+            uint32_t* idx = &indices[q * 6];
+            idx[0] = base; idx[1] = base + 1; idx[2] = base + 2;
+            idx[3] = base + 2; idx[4] = base + 3; idx[5] = base;
+        }
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+    }
+
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glUseProgram(program);
+    glUniform2f(screenLoc, screenW, screenH);
+    glUniform1i(atlasLoc, 0);
+    glActiveTexture(GL_TEXTURE0);
+
+    // um upload so para os dois lotes; cada draw comeca no seu pedaco do buffer
+    size_t total = vertices[0].size() + vertices[1].size();
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, total * sizeof(Vertex), NULL, GL_STREAM_DRAW);
+    size_t first = 0;
+    for (int m = 0; m < 2; ++m) {
+        std::vector<Vertex>& v = vertices[m];
+        if (v.empty()) continue;
+        glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(Vertex), v.size() * sizeof(Vertex), v.data());
+        glUniform1i(sdfLoc, m == TEXT_SDF ? 1 : 0);
+        glBindTexture(GL_TEXTURE_2D, atlases[m].texture);
+        glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)(v.size() / 4 * 6), GL_UNSIGNED_INT, 0, (GLint)first);
+        lastDrawCalls++;
+        lastQuads += (int)(v.size() / 4);
+        first += v.size();
+        v.clear();
+    }
+    glBindVertexArray(0);
+}
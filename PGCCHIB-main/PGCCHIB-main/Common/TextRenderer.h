@@ -0,0 +1,103 @@
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+enum TextMode {
+    TEXT_BITMAP, // pixels da fonte como estao (nitido em escala inteira)
+    TEXT_SDF     // campo de distancia: bordas lisas em qualquer escala
+};
+
+// Decodifica UTF-8 e junta cada letra com o seu diacritico: letras acentuadas
+// prontas (a com til, c cedilha...) e marcas combinantes (U+0300...) viram o
+// par (letra base, marca). O que a fonte nao tem vira '?'.
+// Cada glifo eh (base | marca << 8); '\n' passa como esta.
+void shapeText(const std::string& utf8, std::vector<uint32_t>& glyphs);
+
+// Texto de HUD em coordenadas de tela (pixels, origem no canto de cima a
+// esquerda, y para baixo), com a fonte 5x7 do Font5x7.h (monoespacada).
+//
+// Os glifos sao rasterizados sob demanda em dois atlas (bitmap e SDF) e ficam
+// em cache. O layout de cada string (quads em unidades da fonte) tambem fica em
+// cache, entao uma string repetida de um frame para o outro custa uma busca no
+// hash e a copia dos vertices. Tudo o que foi adicionado desde o begin() vai
+// para a GPU no flush(), em um draw por atlas usado.
+struct TextRenderer {
+    // tamanho de uma celula em pixels da fonte: 5 colunas + 1 de espaco e
+    // 2 linhas para acento em maiuscula + 7 do corpo + 2 de descendente
+    static const int CELL_WIDTH = 6;
+    static const int CELL_HEIGHT = 11;
+    static const int LINE_HEIGHT = 12;
+
+    // estatisticas do ultimo flush
+    int lastDrawCalls = 0;
+    int lastQuads = 0;
+
+    bool init();
+    void destroy();
+
+    void begin(int screenWidth, int screenHeight);
+
+    // escreve text com o canto de cima a esquerda em (x, y). scale eh o tamanho
+    // de um pixel da fonte na tela. Retorna a largura da linha mais longa
+    float add(const std::string& text, float x, float y, float scale, const glm::vec4& color, TextMode mode = TEXT_BITMAP);
+    // largura e altura em pixels sem desenhar
+    glm::vec2 measure(const std::string& text, float scale);
+    // o mesmo para texto fora de std::string (literais, FrameArena::format): a
+    // busca no cache copia para uma string interna reaproveitada, sem alocar
+    float add(const char* text, float x, float y, float scale, const glm::vec4& color, TextMode mode = TEXT_BITMAP);
+    glm::vec2 measure(const char* text, float scale);
+
+    // desenha e esvazia o lote. Liga o blending alfa e desliga o depth test
+    void flush();
+
+private:
+    struct Atlas {
+        GLuint texture = 0;
+        int size = 0;
+        int cellW = 0, cellH = 0;   // celula no atlas em texels (com borda)
+        int scale = 1, spread = 0;  // texels por pixel da fonte e alcance do SDF
+        int used = 0;
+        std::unordered_map<uint32_t, int> slots; // glifo -> celula
+    };
+
+    // quad de um glifo relativo ao inicio da string, em pixels da fonte
+    struct LayoutQuad {
+        float x0, y0, x1, y1;
+        float u0, v0, u1, v1;
+    };
+    struct Layout {
+        std::vector<LayoutQuad> quads;
+        glm::vec2 size;
+    };
+
+    struct Vertex {
+        float x, y, u, v;
+        uint8_t r, g, b, a;
+    };
+
+    Atlas atlases[2];
+    std::unordered_map<std::string, Layout> layouts[2];
+    std::vector<uint32_t> shaped;
+    std::string lookupKey;
+
+    std::vector<Vertex> vertices[2];
+    GLuint program = 0, VAO = 0, VBO = 0, EBO = 0;
+    GLint screenLoc = -1, sdfLoc = -1, atlasLoc = -1;
+    size_t indexCapacity = 0; // em quads
+    float screenW = 1.0f, screenH = 1.0f;
+
+    const Layout& layout(const std::string& text, TextMode mode);
+    bool buildLayout(const std::string& text, TextMode mode, Layout& result);
+    bool glyphSlot(Atlas& atlas, TextMode mode, uint32_t glyph, int& slot);
+    void rasterize(uint32_t glyph, std::vector<uint8_t>& cell);
+    void resetAtlas(TextMode mode);
+};
+
+#endif
@@ -0,0 +1,245 @@
+#include "TileCollision.h"
+#include "ParallelFor.h"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+
+// folga entre a caixa e a parede depois de uma colisao. Precisa ser maior que a
+// precisao do float nas coordenadas usadas (em x = 4096 o passo do float eh ~0.0005),
+// senao a borda arredondada cai dentro da parede e o proximo movimento atravessa
+static const float TILE_EPS = 1e-3f;
+
+void TileCollisionMap::init(int width, int height, int originX, int originY) {
+    this->width = width;
+    this->height = height;
+    this->originX = originX;
+    this->originY = originY;
+    cells.assign((size_t)width * height, TILE_EMPTY);
+    version++;
+}
+
+static uint8_t slopeFromName(const std::string& name) {
+    if (name == "nw") return TILE_SLOPE_NW;
+    if (name == "ne") return TILE_SLOPE_NE;
+    if (name == "sw") return TILE_SLOPE_SW;
+    if (name == "se") return TILE_SLOPE_SE;
+    return TILE_EMPTY;
+}
+
+bool TileCollisionMap::loadFromTmx(const TmxMap& map, const std::string& layerName) {
+    const TmxLayer* layer = map.layer(layerName);
+    if (!layer) {
+        std::cerr << "TileCollisionMap: camada '" << layerName << "' nao encontrada" << std::endl;
+        return false;
+    }
+
+    init(layer->width, layer->height, layer->originX, layer->originY);
+
+    bool useProperties = map.hasTileProperty("solid") || map.hasTileProperty("slope");
+
+    // o mesmo gid se repete muito, entao a consulta das propriedades fica em cache
+    std::unordered_map<int, uint8_t> shapeOf;
+    for (size_t i = 0; i < layer->gids.size(); ++i) {
+        int gid = layer->gids[i];
+        if (gid == 0) continue;
+        if (!useProperties) {
+            cells[i] = TILE_SOLID;
+            continue;
+        }
+
+        auto cached = shapeOf.find(gid);
+        if (cached == shapeOf.end()) {
+            uint8_t shape = TILE_EMPTY;
+            if (map.tileProperty(gid, "solid") == "true") shape = TILE_SOLID;
+            uint8_t slope = slopeFromName(map.tileProperty(gid, "slope"));
+            if (slope != TILE_EMPTY) shape = slope;
+            cached = shapeOf.emplace(gid, shape).first;
+        }
+        cells[i] = cached->second;
+    }
+    return true;
+}
+
+bool TileCollisionMap::loadTmx(const std::string& path, const std::string& layerName) {
+    TmxMap map;
+    if (!map.load(path)) return false;
+    return loadFromTmx(map, layerName);
+}
+
+// menor deslocamento que tira a caixa do triangulo solido da rampa na celula (cx, cy).
+// Testa os 3 eixos do triangulo: os dois catetos (bordas da celula) e a diagonal.
+// Sair por um cateto so vale se a celula vizinha daquele lado nao for parede
+// (normalmente a rampa encosta na parede, e sair por ali prenderia a caixa).
+static bool slopePush(const TileCollisionMap& map, uint8_t shape, int cx, int cy, float minX, float minY, float maxX, float maxY, float& pushX, float& pushY) {
+    // canto do angulo reto em coordenadas locais da celula (y para baixo)
+    int cu = (shape == TILE_SLOPE_NE || shape == TILE_SLOPE_SE) ? 1 : 0;
+    int cv = (shape == TILE_SLOPE_SW || shape == TILE_SLOPE_SE) ? 1 : 0;
+
+    float u0 = minX - cx, u1 = maxX - cx;
+    float v0 = minY - cy, v1 = maxY - cy;
+    if (u1 <= 0.0f || u0 >= 1.0f || v1 <= 0.0f || v0 >= 1.0f) return false;
+
+    // ponto da caixa mais perto do canto; dentro do triangulo se |u - cu| + |v - cv| < 1
+    float u = cu == 0 ? std::max(u0, 0.0f) : std::min(u1, 1.0f);
+    float v = cv == 0 ? std::max(v0, 0.0f) : std::min(v1, 1.0f);
+    float depth = 1.0f - (std::fabs(u - cu) + std::fabs(v - cv));
+    if (depth <= TILE_EPS) return false;
+
+    // diagonal: afasta do canto, metade em cada eixo
+    float su = cu == 0 ? 1.0f : -1.0f;
+    float sv = cv == 0 ? 1.0f : -1.0f;
+    float bestX = su * depth * 0.5f, bestY = sv * depth * 0.5f;
+    float best = depth * 0.70710678f;
+
+    // catetos: sai pelo lado do canto, como numa parede
+    float legX = cu == 0 ? -u1 : 1.0f - u0;
+    float legY = cv == 0 ? -v1 : 1.0f - v0;
+    bool openX = map.get(cu == 0 ? cx - 1 : cx + 1, cy) != TILE_SOLID;
+    bool openY = map.get(cx, cv == 0 ? cy - 1 : cy + 1) != TILE_SOLID;
+    if (openX && std::fabs(legX) < best) { best = std::fabs(legX); bestX = legX; bestY = 0.0f; }
+    if (openY && std::fabs(legY) < best) { best = std::fabs(legY); bestX = 0.0f; bestY = legY; }
+
+    pushX = bestX;
+    pushY = bestY;
+    return true;
+}
+
+static bool overlapsSolidTiles(const TileCollisionMap& map, float minX, float minY, float maxX, float maxY, bool includeSlopes) {
+    int c0 = (int)std::floor(minX + TILE_EPS), c1 = (int)std::floor(maxX - TILE_EPS);
+    int r0 = (int)std::floor(minY + TILE_EPS), r1 = (int)std::floor(maxY - TILE_EPS);
+    for (int r = r0; r <= r1; ++r)
+        for (int c = c0; c <= c1; ++c) {
+            uint8_t shape = map.get(c, r);
+            if (shape == TILE_SOLID) return true;
+            float px, py;
+            if (includeSlopes && shape >= TILE_SLOPE_NW && slopePush(map, shape, c, r, minX, minY, maxX, maxY, px, py))
+                return true;
+        }
+    return false;
+}
+
+bool overlapsSolid(const TileCollisionMap& map, float x, float y, float halfW, float halfH) {
+    return overlapsSolidTiles(map, x - halfW, y - halfH, x + halfW, y + halfH, true);
+}
+
+static bool rowBlocked(const TileCollisionMap& map, int r, int c0, int c1) {
+    for (int c = c0; c <= c1; ++c)
+        if (map.get(c, r) == TILE_SOLID) return true;
+    return false;
+}
+
+static bool columnBlocked(const TileCollisionMap& map, int c, int r0, int r1) {
+    for (int r = r0; r <= r1; ++r)
+        if (map.get(c, r) == TILE_SOLID) return true;
+    return false;
+}
+
+// varre as colunas que a borda da frente atravessa e para na primeira parede
+static void sweepX(const TileCollisionMap& map, TileActor& a, float dx) {
+    if (dx == 0.0f) return;
+    int r0 = (int)std::floor(a.y - a.halfH + TILE_EPS);
+    int r1 = (int)std::floor(a.y + a.halfH - TILE_EPS);
+
+    if (dx > 0.0f) {
+        float edge = a.x + a.halfW;
+        int c0 = (int)std::floor(edge - TILE_EPS) + 1;
+        int c1 = (int)std::floor(edge + dx - TILE_EPS);
+        for (int c = c0; c <= c1; ++c)
+            if (columnBlocked(map, c, r0, r1)) {
+                a.x = c - a.halfW - TILE_EPS;
+                a.hits |= TILE_HIT_X;
+                return;
+            }
+    } else {
+        float edge = a.x - a.halfW;
+        int c0 = (int)std::floor(edge + TILE_EPS) - 1;
+        int c1 = (int)std::floor(edge + dx + TILE_EPS);
+        for (int c = c0; c >= c1; --c)
+            if (columnBlocked(map, c, r0, r1)) {
+                a.x = c + 1 + a.halfW + TILE_EPS;
+                a.hits |= TILE_HIT_X;
+                return;
+            }
+    }
+    a.x += dx;
+}
+
+static void sweepY(const TileCollisionMap& map, TileActor& a, float dy) {
+    if (dy == 0.0f) return;
+    int c0 = (int)std::floor(a.x - a.halfW + TILE_EPS);
+    int c1 = (int)std::floor(a.x + a.halfW - TILE_EPS);
+
+    if (dy > 0.0f) {
+        float edge = a.y + a.halfH;
+        int r0 = (int)std::floor(edge - TILE_EPS) + 1;
+        int r1 = (int)std::floor(edge + dy - TILE_EPS);
+        for (int r = r0; r <= r1; ++r)
+            if (rowBlocked(map, r, c0, c1)) {
+                a.y = r - a.halfH - TILE_EPS;
+                a.hits |= TILE_HIT_Y;
+                return;
+            }
+    } else {
+        float edge = a.y - a.halfH;
+        int r0 = (int)std::floor(edge + TILE_EPS) - 1;
+        int r1 = (int)std::floor(edge + dy + TILE_EPS);
+        for (int r = r0; r >= r1; --r)
+            if (rowBlocked(map, r, c0, c1)) {
+                a.y = r + 1 + a.halfH + TILE_EPS;
+                a.hits |= TILE_HIT_Y;
+                return;
+            }
+    }
+    a.y += dy;
+}
+
+// empurra a caixa para fora das rampas que ela sobrepoe. Retorna false se os
+// empurroes nao conseguiram deixar a caixa livre (rampas encostadas de um jeito
+// que um empurrao joga a caixa em outra parede)
+static bool resolveSlopes(const TileCollisionMap& map, TileActor& a) {
+    bool pushed = false;
+
+    int c0 = (int)std::floor(a.x - a.halfW + TILE_EPS), c1 = (int)std::floor(a.x + a.halfW - TILE_EPS);
+    int r0 = (int)std::floor(a.y - a.halfH + TILE_EPS), r1 = (int)std::floor(a.y + a.halfH - TILE_EPS);
+    for (int r = r0; r <= r1; ++r)
+        for (int c = c0; c <= c1; ++c) {
+            uint8_t shape = map.get(c, r);
+            if (shape < TILE_SLOPE_NW) continue;
+
+            float px, py;
+            if (slopePush(map, shape, c, r, a.x - a.halfW, a.y - a.halfH, a.x + a.halfW, a.y + a.halfH, px, py)) {
+                a.x += px;
+                a.y += py;
+                pushed = true;
+            }
+        }
+
+    if (!pushed) return true;
+    a.hits |= TILE_HIT_SLOPE;
+    return !overlapsSolidTiles(map, a.x - a.halfW, a.y - a.halfH, a.x + a.halfW, a.y + a.halfH, true);
+}
+
+void moveActor(const TileCollisionMap& map, TileActor& actor, float dt) {
+    float startX = actor.x, startY = actor.y;
+
+    actor.hits = 0;
+    sweepX(map, actor, actor.vx * dt);
+    sweepY(map, actor, actor.vy * dt);
+
+    // sem saida pelas rampas: fica onde estava, como se tivesse batido nos dois eixos
+    if (!resolveSlopes(map, actor)) {
+        actor.x = startX;
+        actor.y = startY;
+        actor.hits |= TILE_HIT_X | TILE_HIT_Y;
+    }
+}
+
+void moveActors(const TileCollisionMap& map, TileActor* actors, size_t count, float dt, int threadCount) {
+    // faixas de pelo menos 2048 atores: abaixo disso criar a thread custa mais que o trabalho
+    parallelFor(count, threadCount, 2048, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+            moveActor(map, actors[i], dt);
+    });
+}
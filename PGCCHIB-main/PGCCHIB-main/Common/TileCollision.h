@@ -0,0 +1,87 @@
+#ifndef TILE_COLLISION_H
+#define TILE_COLLISION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "TmxMap.h"
+
+// Formato de colisao de uma celula. Nas rampas o nome indica o canto onde fica
+// o angulo reto do triangulo solido (y cresce para baixo, como as linhas do Tiled):
+// TILE_SLOPE_SW ocupa o canto inferior esquerdo e a rampa sobe para a esquerda.
+enum TileShape : uint8_t {
+    TILE_EMPTY = 0,
+    TILE_SOLID,
+    TILE_SLOPE_NW,
+    TILE_SLOPE_NE,
+    TILE_SLOPE_SW,
+    TILE_SLOPE_SE
+};
+
+// flags de TileActor::hits, refeitas a cada movimento
+const uint32_t TILE_HIT_X = 1;     // bateu em parede no eixo x
+const uint32_t TILE_HIT_Y = 2;     // bateu em parede no eixo y
+const uint32_t TILE_HIT_SLOPE = 4; // foi empurrado por uma rampa
+
+// Caixa em movimento, em unidades de tile (1 tile = 1.0), centrada em (x, y).
+struct TileActor {
+    float x, y;
+    float halfW, halfH;
+    float vx, vy;  // tiles por segundo
+    uint32_t hits;
+};
+
+// Grade de colisao com um byte por celula (TileShape).
+// A celula (0, 0) do vetor corresponde ao tile (originX, originY) do mapa, o que
+// permite carregar mapas infinitos do Tiled com coordenadas negativas.
+struct TileCollisionMap {
+    int width = 0, height = 0;
+    int originX = 0, originY = 0;
+    bool outsideSolid = true; // fora da grade conta como parede
+    std::vector<uint8_t> cells;
+    uint64_t version = 0;     // muda a cada init/set que troca uma celula (caminhos e flow fields velhos)
+
+    void init(int width, int height, int originX = 0, int originY = 0);
+
+    uint8_t get(int x, int y) const {
+        x -= originX;
+        y -= originY;
+        if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height)
+            return outsideSolid ? TILE_SOLID : TILE_EMPTY;
+        return cells[(size_t)y * width + x];
+    }
+
+    void set(int x, int y, uint8_t shape) {
+        x -= originX;
+        y -= originY;
+        if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height) return;
+        uint8_t& cell = cells[(size_t)y * width + x];
+        if (cell == shape) return;
+        cell = shape;
+        version++;
+    }
+
+    // monta a grade a partir de uma camada do mapa. Tiles com a propriedade
+    // solid=true viram parede e slope=nw/ne/sw/se viram rampa. Se nenhum tile do
+    // mapa tiver essas propriedades, qualquer tile nao vazio da camada eh parede.
+    bool loadFromTmx(const TmxMap& map, const std::string& layerName);
+    bool loadTmx(const std::string& path, const std::string& layerName);
+};
+
+// Move uma caixa por (vx, vy) * dt contra a grade. Cada eixo eh varrido tile a tile
+// (nao atravessa parede mesmo com velocidade alta) e depois as rampas empurram a
+// caixa para fora pela diagonal, fazendo ela deslizar. A velocidade nao eh alterada;
+// o chamador decide o que fazer com as flags em hits.
+void moveActor(const TileCollisionMap& map, TileActor& actor, float dt);
+
+// Move muitos atores de uma vez. Como so colidem com o mapa (nao entre si), os
+// atores sao divididos em faixas e cada thread resolve a sua.
+// threadCount = 0 usa todos os nucleos.
+void moveActors(const TileCollisionMap& map, TileActor* actors, size_t count, float dt, int threadCount = 0);
+
+// true se a caixa sobrepoe alguma parede ou a parte solida de alguma rampa
+bool overlapsSolid(const TileCollisionMap& map, float x, float y, float halfW, float halfH);
+
+#endif
@@ -0,0 +1,218 @@
+#include "TmxMap.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <climits>
+
+#include "AssetFS.h"
+
+// bits altos do gid guardam o espelhamento do tile no Tiled
+static const unsigned long TMX_GID_MASK = 0x1FFFFFFFul;
+
+// valor do atributo name="..." dentro do texto da tag ("" se nao existir)
+static std::string tmxAttribute(const std::string& tag, const char* name) {
+    std::string key = std::string(" ") + name + "=\"";
+    size_t start = tag.find(key);
+    if (start == std::string::npos) return "";
+    start += key.size();
+    size_t end = tag.find('"', start);
+    if (end == std::string::npos) return "";
+    return tag.substr(start, end - start);
+}
+
+static int tmxIntAttribute(const std::string& tag, const char* name, int fallback = 0) {
+    std::string v = tmxAttribute(tag, name);
+    return v.empty() ? fallback : std::atoi(v.c_str());
+}
+
+// le os numeros separados por virgula entre begin e o proximo '<'
+static void tmxParseCsv(const std::string& s, size_t begin, std::vector<int>& out) {
+    const char* p = s.c_str() + begin;
+    while (*p && *p != '<') {
+        if (*p >= '0' && *p <= '9') {
+            char* end;
+            unsigned long v = std::strtoul(p, &end, 10);
+            out.push_back((int)(v & TMX_GID_MASK));
+            p = end;
+        } else {
+            ++p;
+        }
+    }
+}
+
+struct TmxChunk {
+    int x, y, width, height;
+    std::vector<int> gids;
+};
+
+// junta os chunks de uma camada em um unico retangulo
+static void tmxMergeChunks(TmxLayer& layer, const std::vector<TmxChunk>& chunks) {
+    if (chunks.empty()) {
+        layer.gids.assign((size_t)layer.width * layer.height, 0);
+        return;
+    }
+
+    int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+    for (const TmxChunk& c : chunks) {
+        if (c.x < minX) minX = c.x;
+        if (c.y < minY) minY = c.y;
+        if (c.x + c.width > maxX) maxX = c.x + c.width;
+        if (c.y + c.height > maxY) maxY = c.y + c.height;
+    }
+
+    layer.originX = minX;
+    layer.originY = minY;
+    layer.width = maxX - minX;
+    layer.height = maxY - minY;
+    layer.gids.assign((size_t)layer.width * layer.height, 0);
+
+    for (const TmxChunk& c : chunks) {
+        for (int y = 0; y < c.height; ++y)
+            for (int x = 0; x < c.width; ++x) {
+                size_t i = (size_t)y * c.width + x;
+                if (i >= c.gids.size()) break;
+                layer.gids[(size_t)(c.y - minY + y) * layer.width + (c.x - minX + x)] = c.gids[i];
+            }
+    }
+}
+
+bool TmxMap::load(const std::string& path) {
+    AssetData file;
+    if (!defaultAssets().read(path, file)) {
+        std::cerr << "TmxMap: nao foi possivel abrir " << path << std::endl;
+        return false;
+    }
+    std::string s = file.text();
+
+    tilesets.clear();
+    layers.clear();
+
+    TmxTileset* tileset = nullptr;
+    int tileId = -1;
+    TmxLayer* layer = nullptr;
+    std::vector<TmxChunk> chunks;
+
+    size_t pos = 0;
+    while (true) {
+        size_t lt = s.find('<', pos);
+        if (lt == std::string::npos) break;
+        size_t gt = s.find('>', lt);
+        if (gt == std::string::npos) break;
+        pos = gt + 1;
+
+        std::string tag = s.substr(lt + 1, gt - lt - 1);
+        if (tag.empty() || tag[0] == '?' || tag[0] == '!') continue;
+
+        bool closing = tag[0] == '/';
+        size_t nameStart = closing ? 1 : 0;
+        size_t nameEnd = tag.find_first_of(" \t\r\n/", nameStart);
+        std::string name = tag.substr(nameStart, nameEnd == std::string::npos ? std::string::npos : nameEnd - nameStart);
+
+        if (closing) {
+            if (name == "tileset") tileset = nullptr;
+            else if (name == "tile") tileId = -1;
+            else if (name == "layer" && layer) {
+                tmxMergeChunks(*layer, chunks);
+                chunks.clear();
+                layer = nullptr;
+            }
+            continue;
+        }
+
+        if (name == "map") {
+            orientation = tmxAttribute(tag, "orientation");
+            width = tmxIntAttribute(tag, "width");
+            height = tmxIntAttribute(tag, "height");
+            tileWidth = tmxIntAttribute(tag, "tilewidth");
+            tileHeight = tmxIntAttribute(tag, "tileheight");
+            infinite = tmxIntAttribute(tag, "infinite") != 0;
+        } else if (name == "tileset") {
+            if (!tmxAttribute(tag, "source").empty()) {
+                std::cerr << "TmxMap: tileset externo (.tsx) nao suportado em " << path << std::endl;
+                return false;
+            }
+            tilesets.push_back(TmxTileset());
+            tileset = &tilesets.back();
+            tileset->firstGid = tmxIntAttribute(tag, "firstgid", 1);
+            tileset->name = tmxAttribute(tag, "name");
+            tileset->tileWidth = tmxIntAttribute(tag, "tilewidth");
+            tileset->tileHeight = tmxIntAttribute(tag, "tileheight");
+            tileset->tileCount = tmxIntAttribute(tag, "tilecount");
+            tileset->columns = tmxIntAttribute(tag, "columns");
+            // tilesets vazios (<tileset .../>) fecham na propria tag
+            if (tag.back() == '/') tileset = nullptr;
+        } else if (name == "image" && tileset) {
+            tileset->image = tmxAttribute(tag, "source");
+            tileset->imageWidth = tmxIntAttribute(tag, "width");
+            tileset->imageHeight = tmxIntAttribute(tag, "height");
+        } else if (name == "tile" && tileset) {
+            tileId = tmxIntAttribute(tag, "id", -1);
+            if (tag.back() == '/') tileId = -1;
+        } else if (name == "property" && tileset && tileId >= 0) {
+            tileset->properties[tileId][tmxAttribute(tag, "name")] = tmxAttribute(tag, "value");
+        } else if (name == "layer") {
+            layers.push_back(TmxLayer());
+            layer = &layers.back();
+            layer->name = tmxAttribute(tag, "name");
+            layer->width = tmxIntAttribute(tag, "width");
+            layer->height = tmxIntAttribute(tag, "height");
+            chunks.clear();
+        } else if (name == "data" && layer) {
+            std::string encoding = tmxAttribute(tag, "encoding");
+            if (encoding != "csv") {
+                std::cerr << "TmxMap: camada '" << layer->name << "' usa encoding '" << encoding
+                          << "', so csv eh suportado" << std::endl;
+                return false;
+            }
+            // mapa fixo: os numeros vem direto; mapa infinito: so espaco ate o primeiro <chunk>
+            TmxChunk whole = { 0, 0, layer->width, layer->height, {} };
+            tmxParseCsv(s, pos, whole.gids);
+            if (!whole.gids.empty())
+                chunks.push_back(whole);
+        } else if (name == "chunk" && layer) {
+            TmxChunk chunk = { tmxIntAttribute(tag, "x"), tmxIntAttribute(tag, "y"),
+                               tmxIntAttribute(tag, "width"), tmxIntAttribute(tag, "height"), {} };
+            tmxParseCsv(s, pos, chunk.gids);
+            chunks.push_back(chunk);
+        }
+    }
+
+    return true;
+}
+
+const TmxLayer* TmxMap::layer(const std::string& name) const {
+    for (const TmxLayer& l : layers)
+        if (l.name == name) return &l;
+    return nullptr;
+}
+
+TmxLayer* TmxMap::layer(const std::string& name) {
+    for (TmxLayer& l : layers)
+        if (l.name == name) return &l;
+    return nullptr;
+}
+
+const TmxTileset* TmxMap::tilesetOf(int gid) const {
+    if (gid <= 0) return nullptr;
+    const TmxTileset* found = nullptr;
+    for (const TmxTileset& t : tilesets)
+        if (t.firstGid <= gid && (!found || t.firstGid > found->firstGid))
+            found = &t;
+    return found;
+}
+
+std::string TmxMap::tileProperty(int gid, const std::string& name) const {
+    const TmxTileset* t = tilesetOf(gid);
+    if (!t) return "";
+    auto tile = t->properties.find(gid - t->firstGid);
+    if (tile == t->properties.end()) return "";
+    auto prop = tile->second.find(name);
+    return prop == tile->second.end() ? "" : prop->second;
+}
+
+bool TmxMap::hasTileProperty(const std::string& name) const {
+    for (const TmxTileset& t : tilesets)
+        for (const auto& tile : t.properties)
+            if (tile.second.count(name)) return true;
+    return false;
+}
@@ -0,0 +1,79 @@
+#ifndef TMX_MAP_H
+#define TMX_MAP_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+
+// Tileset embutido no .tmx (tilesets externos .tsx nao sao suportados)
+struct TmxTileset {
+    int firstGid = 1;
+    int tileCount = 0;
+    int columns = 0;
+    int tileWidth = 0, tileHeight = 0;
+    std::string name;
+    std::string image;
+    int imageWidth = 0, imageHeight = 0;
+
+    // propriedades por tile local (id -> nome -> valor)
+    std::map<int, std::map<std::string, std::string>> properties;
+};
+
+// Camada de tiles ja "achatada": mapas infinitos (com chunks) viram um unico
+// retangulo que comeca em (originX, originY) nas coordenadas de tile do Tiled.
+struct TmxLayer {
+    std::string name;
+    int originX = 0, originY = 0;
+    int width = 0, height = 0;
+    std::vector<int> gids; // width * height, linha por linha, 0 = vazio (sem flags de flip)
+    uint64_t version = 0;  // muda a cada setGid (para caches da camada saberem que ficaram velhas)
+
+    int gid(int x, int y) const {
+        x -= originX;
+        y -= originY;
+        if (x < 0 || y < 0 || x >= width || y >= height) return 0;
+        return gids[y * width + x];
+    }
+
+    // troca o tile de uma celula; fora da camada nao faz nada
+    void setGid(int x, int y, int value) {
+        x -= originX;
+        y -= originY;
+        if (x < 0 || y < 0 || x >= width || y >= height) return;
+        if (gids[y * width + x] == value) return;
+        gids[y * width + x] = value;
+        version++;
+    }
+};
+
+// Leitor minimo de mapas do Tiled (.tmx) com camadas em CSV.
+// Le o cabecalho do mapa, os tilesets com as propriedades dos tiles e as camadas
+// (fixas ou infinitas). Nao depende de biblioteca de XML: o formato gerado pelo
+// Tiled eh regular o suficiente para ler tag por tag.
+struct TmxMap {
+    std::string orientation;
+    int width = 0, height = 0;
+    int tileWidth = 0, tileHeight = 0;
+    bool infinite = false;
+
+    std::vector<TmxTileset> tilesets;
+    std::vector<TmxLayer> layers;
+
+    // path no defaultAssets() (relativo a pasta include ou dentro do assets.pak)
+    bool load(const std::string& path);
+
+    const TmxLayer* layer(const std::string& name) const;
+    TmxLayer* layer(const std::string& name);
+
+    // tileset dono do gid (nullptr para 0 ou gid desconhecido)
+    const TmxTileset* tilesetOf(int gid) const;
+
+    // valor da propriedade do tile (string vazia se nao existir)
+    std::string tileProperty(int gid, const std::string& name) const;
+
+    // true se algum tile de algum tileset tem essa propriedade
+    bool hasTileProperty(const std::string& name) const;
+};
+
+#endif
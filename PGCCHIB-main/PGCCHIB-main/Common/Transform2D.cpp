@@ -0,0 +1,162 @@
+#include "Transform2D.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRANSFORMS_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// a versao SIMD grava 4 Affine2D seguidos como 24 floats
+static_assert(sizeof(Affine2D) == 6 * sizeof(float), "Affine2D deve ter 6 floats sem preenchimento");
+
+Affine2D composeAffine(glm::vec2 position, float rotation, glm::vec2 scale) {
+    float s = std::sin(rotation), c = std::cos(rotation);
+    Affine2D m;
+    m.a = c * scale.x;
+    m.b = s * scale.x;
+    m.c = -s * scale.y;
+    m.d = c * scale.y;
+    m.tx = position.x;
+    m.ty = position.y;
+    return m;
+}
+
+Affine2D multiplyAffine(const Affine2D& p, const Affine2D& q) {
+    Affine2D m;
+    m.a = p.a * q.a + p.c * q.b;
+    m.b = p.b * q.a + p.d * q.b;
+    m.c = p.a * q.c + p.c * q.d;
+    m.d = p.b * q.c + p.d * q.d;
+    m.tx = p.a * q.tx + p.c * q.ty + p.tx;
+    m.ty = p.b * q.tx + p.d * q.ty + p.ty;
+    return m;
+}
+
+glm::mat4 affineToMat4(const Affine2D& m) {
+    glm::mat4 r(1.0f);
+    r[0][0] = m.a;
+    r[0][1] = m.b;
+    r[1][0] = m.c;
+    r[1][1] = m.d;
+    r[3][0] = m.tx;
+    r[3][1] = m.ty;
+    return r;
+}
+
+void TransformArray::resize(size_t n) {
+    count = n;
+    x.resize(n, 0.0f);
+    y.resize(n, 0.0f);
+    rotation.resize(n, 0.0f);
+    scaleX.resize(n, 1.0f);
+    scaleY.resize(n, 1.0f);
+}
+
+void TransformArray::set(size_t i, const Transform2D& t) {
+    x[i] = t.position.x;
+    y[i] = t.position.y;
+    rotation[i] = t.rotation;
+    scaleX[i] = t.scale.x;
+    scaleY[i] = t.scale.y;
+}
+
+void composeAffineScalar(const TransformArray& in, size_t begin, size_t end, Affine2D* out) {
+    for (size_t i = begin; i < end; ++i) {
+        float s = std::sin(in.rotation[i]), c = std::cos(in.rotation[i]);
+        Affine2D& m = out[i];
+        m.a = c * in.scaleX[i];
+        m.b = s * in.scaleX[i];
+        m.c = -s * in.scaleY[i];
+        m.d = c * in.scaleY[i];
+        m.tx = in.x[i];
+        m.ty = in.y[i];
+    }
+}
+
+bool transformsHaveSimd() {
+#ifdef TRANSFORMS_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef TRANSFORMS_SSE2
+// Seno e cosseno de 4 angulos de uma vez (o sincosf do Cephes): reduz o angulo
+// para [-pi/4, pi/4] pelo octante e avalia os dois polinomios; o octante decide
+// qual polinomio vai para o seno e qual para o cosseno e os sinais
+static inline void sincos4(__m128 x, __m128& sinOut, __m128& cosOut) {
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+    __m128 signSin = _mm_and_ps(x, signMask);
+    x = _mm_andnot_ps(signMask, x);
+
+    // octante arredondado para par
+    __m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f))); // 4 / pi
+    j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+    __m128 y = _mm_cvtepi32_ps(j);
+
+    __m128 swapSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+    __m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+    __m128 usePolySin = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+    signSin = _mm_xor_ps(signSin, swapSin);
+
+    // x - y * pi / 4 em tres partes para nao perder precisao
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-0.78515625f)));
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-2.4187564849853515625e-4f)));
+    x = _mm_add_ps(x, _mm_mul_ps(y, _mm_set1_ps(-3.77489497744594108e-8f)));
+    __m128 z = _mm_mul_ps(x, x);
+
+    __m128 pc = _mm_set1_ps(2.443315711809948e-5f);
+    pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(-1.388731625493765e-3f));
+    pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(4.166664568298827e-2f));
+    pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+    pc = _mm_add_ps(_mm_sub_ps(pc, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+    __m128 ps = _mm_set1_ps(-1.9515295891e-4f);
+    ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(8.3321608736e-3f));
+    ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(-1.6666654611e-1f));
+    ps = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, z), x), x);
+
+    __m128 s = _mm_or_ps(_mm_and_ps(usePolySin, ps), _mm_andnot_ps(usePolySin, pc));
+    __m128 c = _mm_or_ps(_mm_and_ps(usePolySin, pc), _mm_andnot_ps(usePolySin, ps));
+    sinOut = _mm_xor_ps(s, signSin);
+    cosOut = _mm_xor_ps(c, signCos);
+}
+#endif
+
+void composeAffineSimd(const TransformArray& in, size_t begin, size_t end, Affine2D* out) {
+#ifdef TRANSFORMS_SSE2
+    const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 s, c;
+        sincos4(_mm_loadu_ps(&in.rotation[i]), s, c);
+        __m128 sx = _mm_loadu_ps(&in.scaleX[i]), sy = _mm_loadu_ps(&in.scaleY[i]);
+
+        __m128 a = _mm_mul_ps(c, sx);
+        __m128 b = _mm_mul_ps(s, sx);
+        __m128 cc = _mm_xor_ps(_mm_mul_ps(s, sy), signMask);
+        __m128 d = _mm_mul_ps(c, sy);
+        __m128 tx = _mm_loadu_ps(&in.x[i]), ty = _mm_loadu_ps(&in.y[i]);
+
+        // SoA -> AoS: depois da transposta cada registrador tem (a, b, c, d) de
+        // uma transformacao; tx e ty vao intercalados em pares
+        _MM_TRANSPOSE4_PS(a, b, cc, d);
+        __m128 t01 = _mm_unpacklo_ps(tx, ty), t23 = _mm_unpackhi_ps(tx, ty);
+
+        float* o = &out[i].a; // 4 Affine2D seguidos = 24 floats
+        _mm_storeu_ps(o + 0, a);
+        _mm_storel_pi((__m64*)(o + 4), t01);
+        _mm_storeu_ps(o + 6, b);
+        _mm_storeh_pi((__m64*)(o + 10), t01);
+        _mm_storeu_ps(o + 12, cc);
+        _mm_storel_pi((__m64*)(o + 16), t23);
+        _mm_storeu_ps(o + 18, d);
+        _mm_storeh_pi((__m64*)(o + 22), t23);
+    }
+    composeAffineScalar(in, i, end, out);
+#else
+    composeAffineScalar(in, begin, end, out);
+#endif
+}
@@ -0,0 +1,57 @@
+#ifndef TRANSFORM_2D_H
+#define TRANSFORM_2D_H
+
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+// Posicao, rotacao (radianos, anti-horario) e escala de um objeto 2D
+struct Transform2D {
+    glm::vec2 position = glm::vec2(0.0f);
+    glm::vec2 scale = glm::vec2(1.0f);
+    float rotation = 0.0f;
+};
+
+// Matriz afim 2x3: o mesmo que translate * rotate * scale em mat4, sem a linha
+// e a coluna de z que em 2D sao sempre identidade. Guardada em colunas como o
+// mat3x2 do GLSL:
+//     x' = a * x + c * y + tx
+//     y' = b * x + d * y + ty
+// Sao 24 bytes em vez dos 64 do mat4 e 6 multiplicacoes para compor em vez das
+// 3 multiplicacoes de matriz 4x4. Vai para o shader com glUniformMatrix3x2fv
+// (uniform mat3x2) ou como atributo por instancia (vec4 a,b,c,d + vec2 tx,ty).
+struct Affine2D {
+    float a = 1.0f, b = 0.0f, c = 0.0f, d = 1.0f, tx = 0.0f, ty = 0.0f;
+
+    glm::vec2 apply(glm::vec2 p) const { return glm::vec2(a * p.x + c * p.y + tx, b * p.x + d * p.y + ty); }
+    const float* data() const { return &a; }
+};
+
+Affine2D composeAffine(glm::vec2 position, float rotation, glm::vec2 scale);
+inline Affine2D composeAffine(const Transform2D& t) { return composeAffine(t.position, t.rotation, t.scale); }
+// parent * child (aplica child primeiro)
+Affine2D multiplyAffine(const Affine2D& parent, const Affine2D& child);
+// para shaders que ainda recebem mat4
+glm::mat4 affineToMat4(const Affine2D& m);
+
+// Muitas transformacoes em SoA (um vetor por campo, como o ParticlePool), para
+// a composicao em lote carregar 4 de cada vez em registradores SSE.
+// rotation em radianos.
+struct TransformArray {
+    std::vector<float> x, y, rotation, scaleX, scaleY;
+    size_t count = 0;
+
+    void resize(size_t n);
+    void set(size_t i, const Transform2D& t);
+};
+
+// Compoe as transformacoes [begin, end) em out[begin, end).
+// A versao SIMD usa SSE2 quando o compilador tem (x86-64 sempre tem), com seno
+// e cosseno por polinomio (erro < 1e-6, valido para |rotation| < 8192 rad);
+// sem SSE2 ela cai na escalar. Pode ser chamada em faixas pelo parallelFor.
+void composeAffineScalar(const TransformArray& in, size_t begin, size_t end, Affine2D* out);
+void composeAffineSimd(const TransformArray& in, size_t begin, size_t end, Affine2D* out);
+bool transformsHaveSimd();
+
+#endif
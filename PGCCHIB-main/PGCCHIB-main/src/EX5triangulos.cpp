@@ -20,6 +20,8 @@ using namespace glm;
 
 #include <cmath>
 
+#include "GLHandles.h"
+
 const int WIDTH = 800;
 const int HEIGHT = 600;
 
@@ -51,23 +53,28 @@ void main()
 }
 )";
 
-GLuint createTriangle(float x0, float y0, float x1, float y1, float x2, float y2)
+// VAO e VBO de um triangulo: os dois sao apagados juntos quando o mesh morre
+struct TriangleMesh
+{
+    GLVertexArray vao;
+    GLBuffer vbo;
+};
+
+TriangleMesh createTriangle(float x0, float y0, float x1, float y1, float x2, float y2)
 {
-    GLuint VAO, VBO;
     float vertices[] = {
         x0, y0, 0.0f,
         x1, y1, 0.0f,
         x2, y2, 0.0f
     };
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    TriangleMesh mesh;
+    mesh.vao.create();
+    glBindVertexArray(mesh.vao.get());
+    mesh.vbo.data(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glBindVertexArray(0);
-    return VAO;
+    return mesh;
 }
 
 int main()
@@ -106,21 +113,21 @@ int main()
     glUseProgram(shaderID);
 
     GLuint colorLoc = glGetUniformLocation(shaderID, "color");
+    GLuint modelLoc = glGetUniformLocation(shaderID, "model");
 
     // Criação da projeção ortográfica
     mat4 projection = ortho(0.0f, static_cast<float>(WIDTH), 0.0f, static_cast<float>(HEIGHT));
     GLuint projectionLoc = glGetUniformLocation(shaderID, "projection");
     glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, value_ptr(projection));
 
+    // Triângulo padrão no centro (sistema de coordenadas normalizado);
+    // os 5 sao iguais e so mudam pela matriz model, entao compartilham o mesmo mesh
+    TriangleMesh baseTriangle = createTriangle(-0.5f, -0.5f, 0.5f, -0.5f, 0.0f, 0.5f);
+
     // Criação de 5 triângulos
-    vector<GLuint> VAOs;
     vector<Triangle> triangles;
     for (int i = 0; i < 5; ++i)
     {
-        // Triângulo padrão no centro (sistema de coordenadas normalizado)
-        GLuint vao = createTriangle(-0.5f, -0.5f, 0.5f, -0.5f, 0.0f, 0.5f);
-        VAOs.push_back(vao);
-
         Triangle tri;
         tri.position = vec3(100.0f + i * 120.0f, 300.0f, 0.0f);
         tri.dimensions = vec3(100.0f, 100.0f, 1.0f);
@@ -134,14 +141,13 @@ int main()
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
+        glBindVertexArray(baseTriangle.vao.get());
         for (int i = 0; i < triangles.size(); i++)
         {
-            glBindVertexArray(VAOs[i]);
-
             mat4 model = mat4(1.0f);
             model = translate(model, triangles[i].position);
             model = scale(model, triangles[i].dimensions);
-            glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
+            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(model));
 
             glUniform4f(colorLoc, triangles[i].color.r, triangles[i].color.g, triangles[i].color.b, 1.0f);
             glDrawArrays(GL_TRIANGLES, 0, 3);
@@ -151,6 +157,11 @@ int main()
         glfwSwapBuffers(window);
     }
 
+    // apaga antes do glfwTerminate, enquanto o contexto existe
+    baseTriangle = TriangleMesh();
+    glDeleteProgram(shaderID);
+    reportGLLeaks();
+
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
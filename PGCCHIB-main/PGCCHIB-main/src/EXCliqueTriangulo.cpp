@@ -8,6 +8,8 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "GLHandles.h"
+
 using namespace std;
 using namespace glm;
 
@@ -21,8 +23,6 @@ GLuint modelLoc;
 
 mat4 projection;
 
-GLuint triangleVAO = 0;
-
 // Estrutura do triângulo
 struct Triangle {
     float x, y;     // posição
@@ -31,25 +31,30 @@ struct Triangle {
 
 vector<Triangle> triangles;
 
+// VAO e VBO de um triangulo: os dois sao apagados juntos quando o mesh morre
+struct TriangleMesh
+{
+    GLVertexArray vao;
+    GLBuffer vbo;
+};
+
 // Função que cria um triângulo base com os 3 vértices passados
-GLuint createTriangle(float x0, float y0, float x1, float y1, float x2, float y2)
+TriangleMesh createTriangle(float x0, float y0, float x1, float y1, float x2, float y2)
 {
-    GLuint VAO, VBO;
     float vertices[] = {
         x0, y0, 0.0f,
         x1, y1, 0.0f,
         x2, y2, 0.0f
     };
 
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+    TriangleMesh mesh;
+    mesh.vao.create();
+    glBindVertexArray(mesh.vao.get());
+    mesh.vbo.data(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
     glBindVertexArray(0);
-    return VAO;
+    return mesh;
 }
 
 // Callback do clique do mouse
@@ -140,7 +145,7 @@ int main()
     glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, value_ptr(projection));
 
     // Cria triângulo base (será usado para todos)
-    triangleVAO = createTriangle(-0.1f * WIDTH, -0.1f * HEIGHT, 0.1f * WIDTH, -0.1f * HEIGHT, 0.0f, 0.1f * HEIGHT);
+    TriangleMesh triangleMesh = createTriangle(-0.1f * WIDTH, -0.1f * HEIGHT, 0.1f * WIDTH, -0.1f * HEIGHT, 0.0f, 0.1f * HEIGHT);
 
     // Adiciona o triângulo fixo no centro da tela
     triangles.push_back({ WIDTH / 2.0f, HEIGHT / 2.0f, vec3(0.0f, 1.0f, 0.0f) }); // verde
@@ -153,7 +158,7 @@ int main()
         glClear(GL_COLOR_BUFFER_BIT);
 
         glUseProgram(shaderID);
-        glBindVertexArray(triangleVAO);
+        glBindVertexArray(triangleMesh.vao.get());
 
         // Desenha todos os triângulos
         for (const Triangle& t : triangles)
@@ -168,6 +173,11 @@ int main()
         glfwSwapBuffers(window);
     }
 
+    // apaga antes do glfwTerminate, enquanto o contexto existe
+    triangleMesh = TriangleMesh();
+    glDeleteProgram(shaderID);
+    reportGLLeaks();
+
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
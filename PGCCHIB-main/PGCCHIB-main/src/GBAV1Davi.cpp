@@ -7,6 +7,9 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <cstdio>
+
+#include "GLHandles.h"
 
 using namespace std;
 using namespace glm;
@@ -14,17 +17,55 @@ using namespace glm;
 const int WIDTH = 800;
 const int HEIGHT = 600;
 
-GLuint shaderID;
+GLProgram shader;
 GLuint colorLoc;
 GLuint projectionLoc;
+GLuint modelLoc;
 mat4 projection;
 
+// todos os triangulos ficam num VBO so (3 vertices seguidos por triangulo);
+// o buffer dobra de tamanho quando enche e nunca encolhe, entao clicar por
+// horas nao cria objetos novos na GPU
+GLVertexArray trianglesVAO;
+GLBuffer trianglesVBO;
+size_t vboTriangles = 0; // capacidade do VBO em triangulos
+bool titleDirty = true;
+
 std::vector<vec2> clickPositions;
-std::vector<GLuint> triangleVAOs;
-std::vector<GLuint> triangleVBOs;
+std::vector<float> triangleVertices;
 std::vector<mat4> triangleModels;
 std::vector<vec4> triangleColors;
 
+const size_t TRIANGLE_BYTES = 9 * sizeof(float);
+
+void addTriangle(const float* vertices)
+{
+    size_t index = triangleModels.size();
+    triangleVertices.insert(triangleVertices.end(), vertices, vertices + 9);
+    if (index >= vboTriangles)
+    {
+        // cresceu: realoca o dobro e sobe todos de uma vez
+        vboTriangles = vboTriangles == 0 ? 16 : vboTriangles * 2;
+        trianglesVBO.data(GL_ARRAY_BUFFER, vboTriangles * TRIANGLE_BYTES, nullptr, GL_DYNAMIC_DRAW);
+        trianglesVBO.subData(GL_ARRAY_BUFFER, 0, triangleVertices.size() * sizeof(float), triangleVertices.data());
+    }
+    else
+    {
+        trianglesVBO.subData(GL_ARRAY_BUFFER, index * TRIANGLE_BYTES, TRIANGLE_BYTES, vertices);
+    }
+    titleDirty = true;
+}
+
+void clearTriangles()
+{
+    // so os dados da CPU: o VBO fica com a capacidade para os proximos
+    triangleVertices.clear();
+    triangleModels.clear();
+    triangleColors.clear();
+    clickPositions.clear();
+    titleDirty = true;
+}
+
 // Vertex & Fragment Shaders
 const char* vertexShaderSource = R"(
 #version 330 core
@@ -67,19 +108,7 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
                 clickPositions[2].x, clickPositions[2].y, 0.0f
             };
 
-            GLuint VAO, VBO;
-            glGenVertexArrays(1, &VAO);
-            glGenBuffers(1, &VBO);
-
-            glBindVertexArray(VAO);
-            glBindBuffer(GL_ARRAY_BUFFER, VBO);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
-            glEnableVertexAttribArray(0);
-            glBindVertexArray(0);
-
-            triangleVAOs.push_back(VAO);
-            triangleVBOs.push_back(VBO);
+            addTriangle(vertices);
             triangleModels.push_back(mat4(1.0f));
 
             // Gera uma cor aleatória (RGB entre 0.2 e 1.0)
@@ -91,6 +120,9 @@ void mouse_button_callback(GLFWwindow* window, int button, int action, int mods)
             clickPositions.clear();
         }
     }
+    // botao direito apaga tudo
+    if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS)
+        clearTriangles();
 }
 
 int main()
@@ -121,17 +153,26 @@ int main()
     GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
     glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
     glCompileShader(fragmentShader);
-    shaderID = glCreateProgram();
-    glAttachShader(shaderID, vertexShader);
-    glAttachShader(shaderID, fragmentShader);
-    glLinkProgram(shaderID);
+    shader.create();
+    glAttachShader(shader.get(), vertexShader);
+    glAttachShader(shader.get(), fragmentShader);
+    glLinkProgram(shader.get());
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
-    glUseProgram(shaderID);
+    glUseProgram(shader.get());
 
     // Localizações dos uniforms
-    colorLoc = glGetUniformLocation(shaderID, "color");
-    projectionLoc = glGetUniformLocation(shaderID, "projection");
+    colorLoc = glGetUniformLocation(shader.get(), "color");
+    projectionLoc = glGetUniformLocation(shader.get(), "projection");
+    modelLoc = glGetUniformLocation(shader.get(), "model");
+
+    // VAO unico; o atributo aponta para o VBO compartilhado
+    trianglesVAO.create();
+    glBindVertexArray(trianglesVAO.get());
+    trianglesVBO.data(GL_ARRAY_BUFFER, 0, nullptr, GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindVertexArray(0);
 
     // Projeção ortográfica
     projection = ortho(0.0f, static_cast<float>(WIDTH), 0.0f, static_cast<float>(HEIGHT));
@@ -141,31 +182,42 @@ int main()
     while (!glfwWindowShouldClose(window))
     {
         glfwPollEvents();
+
+        if (titleDirty)
+        {
+            // objetos e memoria na GPU ficam estaveis por mais que se clique
+            const GLResourceStats& gpu = glResourceStats();
+            char title[160];
+            snprintf(title, sizeof(title), "%zu triangulos - GPU: %ld buffers, %.1f KB (botao direito limpa)",
+                     triangleModels.size(), gpu.live[GL_RES_BUFFER], gpu.bytes[GL_RES_BUFFER] / 1024.0);
+            glfwSetWindowTitle(window, title);
+            titleDirty = false;
+        }
+
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glUseProgram(shaderID);
+        glUseProgram(shader.get());
 
         // Triângulos criados por clique
-        for (size_t i = 0; i < triangleVAOs.size(); ++i)
+        glBindVertexArray(trianglesVAO.get());
+        for (size_t i = 0; i < triangleModels.size(); ++i)
         {
-            glBindVertexArray(triangleVAOs[i]);
-            glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(triangleModels[i]));
+            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(triangleModels[i]));
             vec4 color = triangleColors[i];
             glUniform4f(colorLoc, color.r, color.g, color.b, color.a);
-            glDrawArrays(GL_TRIANGLES, 0, 3);
+            glDrawArrays(GL_TRIANGLES, (GLint)(3 * i), 3);
         }
 
         glBindVertexArray(0);
         glfwSwapBuffers(window);
     }
 
-    // Liberação de recursos
-    for (size_t i = 0; i < triangleVAOs.size(); ++i)
-    {
-        glDeleteVertexArrays(1, &triangleVAOs[i]);
-        glDeleteBuffers(1, &triangleVBOs[i]);
-    }
+    // Liberação de recursos (antes do glfwTerminate, enquanto o contexto existe)
+    trianglesVAO.reset();
+    trianglesVBO.reset();
+    shader.reset();
+    reportGLLeaks();
 
     glfwTerminate();
     return 0;
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <vector>
 #include <assert.h>
 #include <cmath>
 using namespace std;
@@ -12,6 +13,15 @@ using namespace std;
 #include <glm/gtc/type_ptr.hpp>
 using namespace glm;
 
+#include "Camera2D.h"
+#include "Input.h"
+#include "TextRenderer.h"
+#include "SpriteMesh.h"
+#include "AssetImage.h"
+
+// acoes do jogo (as teclas sao mapeadas no main)
+enum Action { ACTION_RIGHT, ACTION_LEFT, ACTION_UP, ACTION_DOWN };
+
 
 struct Sprite
 {
@@ -23,20 +33,30 @@ struct Sprite
 	int iAnimation, iFrame;
 	int nAnimations, nFrames;
 	bool flipHorizontal = false;
+	int nIndices = 0; // > 0: VAO com mesh justo (GL_TRIANGLES), 0: quad (strip)
+	SpriteAlpha alpha = SPRITE_TRANSLUCENT; // classificado pelos pixels da textura
 
 };
 
 // Protótipo da função de callback de teclado
 void key_callback(GLFWwindow *window, int key, int scancode, int action, int mode);
 
+// Protótipo da função de callback de redimensionamento
+void framebuffer_size_callback(GLFWwindow *window, int width, int height);
+
 // Protótipos das funções
 int setupShader();
 int setupSprite(int nAnimations, int nFrames, float &ds, float &dt);
-int loadTexture(string filePath, int &width, int &height);
+int setupSpriteMesh(const SpriteMesh &mesh, int nAnimations, int nFrames, float &ds, float &dt);
+int loadTexture(string filePath, int &width, int &height, std::vector<unsigned char> *pixels = nullptr);
+void setSpriteAlpha(SpriteAlpha alpha);
 
 // Dimensões da janela (pode ser alterado em tempo de execução)
 const GLuint WIDTH = 800, HEIGHT = 600;
 
+// Câmera que segue o personagem pelo cenário (global para o callback de resize)
+Camera2D camera;
+
 // Código fonte do Vertex Shader (em GLSL): ainda hardcoded
 const GLchar *vertexShaderSource = R"(
  #version 400
@@ -66,25 +86,19 @@ const GLchar *fragmentShaderSource = R"(
  }
  )";
 
-void processMovement(GLFWwindow* window, Sprite &vampirao, Sprite &background, double deltaT, double FPS, double &lastTime, double currTime, vec2 &offsetTexBg)
+void processMovement(const Input &input, Sprite &vampirao, const Rect2D &worldBounds, double deltaT, double FPS, double &lastTime, double currTime)
 {
     bool moved = false;
 
-	const float bgSpeed = 0.00007f;
-	float maxOffsetS = 1.0f - (WIDTH / (1277 * 4.0f));
-
     // Movimentação horizontal
-	if ((glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS && vampirao.position.x + vampirao.dimensions.x / 1.8f < WIDTH+20))
+	if (input.held(ACTION_RIGHT))
 	{
 		vampirao.position.x += 0.1f;
 		vampirao.iAnimation = 1; // linha 0: andando pra frente
 		vampirao.flipHorizontal = false;
 		moved = true;
-
-		offsetTexBg.s += bgSpeed;
-		if (offsetTexBg.s > maxOffsetS) offsetTexBg.s = maxOffsetS;
 	}
-	else if ((glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS && vampirao.position.x - vampirao.dimensions.x / 1.8f > -20))
+	else if (input.held(ACTION_LEFT))
 	{
 		vampirao.position.x -= 0.1f;
 		vampirao.iAnimation = 0;
@@ -93,19 +107,25 @@ void processMovement(GLFWwindow* window, Sprite &vampirao, Sprite &background, d
 	}
 
 	// Movimentação vertical
-	if ((glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS && vampirao.position.y + vampirao.dimensions.y / 1.8f < 420))
+	if (input.held(ACTION_UP))
 	{
 		vampirao.position.y += 0.1f;
 		vampirao.iAnimation = 0; // linha 2: andando para cima
 		moved = true;
 	}
-	else if ((glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS && vampirao.position.y - vampirao.dimensions.y / 1.8f > -20))
+	else if (input.held(ACTION_DOWN))
 	{
 		vampirao.position.y -= 0.1f;
 		vampirao.iAnimation = 2; // linha 1: andando para baixo
 		moved = true;
 	}
 
+	// Mantém o personagem dentro do cenário (a câmera acompanha)
+	float halfW = vampirao.dimensions.x / 1.8f;
+	float halfH = vampirao.dimensions.y / 1.8f;
+	vampirao.position.x = glm::clamp(vampirao.position.x, worldBounds.minX + halfW, worldBounds.maxX - halfW);
+	vampirao.position.y = glm::clamp(vampirao.position.y, worldBounds.minY + halfH, 420.0f - halfH);
+
     // Se houve movimento, atualiza frame
     if (moved && deltaT >= 1.0 / FPS)
     {
@@ -113,7 +133,7 @@ void processMovement(GLFWwindow* window, Sprite &vampirao, Sprite &background, d
         lastTime = currTime;
     }
 
-    // Se não houve movimento, não atualiza frame nem offset
+    // Se não houve movimento, não atualiza frame
 }
 
 
@@ -152,6 +172,19 @@ int main()
 
 	// Fazendo o registro da função de callback para a janela GLFW
 	glfwSetKeyCallback(window, key_callback);
+	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+
+	// input por eventos: o key_callback do ESC continua sendo chamado
+	Input input;
+	input.install(window);
+	input.bindKey(GLFW_KEY_D, ACTION_RIGHT);
+	input.bindKey(GLFW_KEY_RIGHT, ACTION_RIGHT);
+	input.bindKey(GLFW_KEY_A, ACTION_LEFT);
+	input.bindKey(GLFW_KEY_LEFT, ACTION_LEFT);
+	input.bindKey(GLFW_KEY_W, ACTION_UP);
+	input.bindKey(GLFW_KEY_UP, ACTION_UP);
+	input.bindKey(GLFW_KEY_S, ACTION_DOWN);
+	input.bindKey(GLFW_KEY_DOWN, ACTION_DOWN);
 
 	// GLAD: carrega todos os ponteiros d funções da OpenGL
 	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
@@ -176,14 +209,28 @@ int main()
 
 	//Carregando uma textura 
 	int imgWidth, imgHeight;
-	GLuint texID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/donatello.png",imgWidth,imgHeight);
+	std::vector<unsigned char> vampPixels;
+	GLuint texID = loadTexture("donatello.png",imgWidth,imgHeight,&vampPixels);
 
 	// Gerando um buffer simples, com a geometria de um triângulo
 	Sprite vampirao;
 	vampirao.nAnimations = 3;
 	vampirao.nFrames = 3;
-	vampirao.VAO = setupSprite(vampirao.nAnimations,vampirao.nFrames,vampirao.ds,vampirao.dt);
-	vampirao.position = vec3(400.0, 150.0, 0.0);
+	// o frame troca so pelo offsetTex, entao o mesh cobre a uniao dos 9 frames
+	// (~38% do quad em vez de 100%); sem alfa fica o quad
+	SpriteMesh vampMesh;
+	if (!vampPixels.empty())
+		traceSpriteSheetUnion(vampPixels.data(), imgWidth, imgHeight, vampirao.nFrames, vampirao.nAnimations, 16, vampMesh);
+	if (!vampMesh.indices.empty())
+	{
+		vampirao.VAO = setupSpriteMesh(vampMesh, vampirao.nAnimations, vampirao.nFrames, vampirao.ds, vampirao.dt);
+		vampirao.nIndices = (int)vampMesh.indices.size();
+		vampirao.alpha = vampMesh.alpha;
+	}
+	else
+		vampirao.VAO = setupSprite(vampirao.nAnimations,vampirao.nFrames,vampirao.ds,vampirao.dt);
+	// z maior fica na frente (ortho de -1 a 1): o personagem na frente do fundo
+	vampirao.position = vec3(400.0, 150.0, 0.5);
 	vampirao.dimensions = vec3(imgWidth/vampirao.nFrames*1.5,imgHeight/vampirao.nAnimations*1.5,1.0);
 	vampirao.texID = texID;
 	vampirao.iAnimation = 1;
@@ -194,7 +241,10 @@ int main()
 	background.nFrames = 1;
 	background.VAO = setupSprite(background.nAnimations,background.nFrames,background.ds,background.dt);
 	background.position = vec3(2554.0f, 300.0f, 0.0f);
-	background.texID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/dona_bg.png",imgWidth,imgHeight);
+	std::vector<unsigned char> bgPixels;
+	background.texID = loadTexture("dona_bg.png",imgWidth,imgHeight,&bgPixels);
+	// sem canal alfa a imagem eh opaca
+	background.alpha = bgPixels.empty() ? SPRITE_OPAQUE : classifySpriteAlpha(bgPixels.data(), imgWidth, 0, 0, imgWidth, imgHeight);
 	background.dimensions = vec3(imgWidth/background.nFrames*4,imgHeight/background.nAnimations*4,1.0);
 	background.iAnimation = 0;
 	background.iFrame = 0;
@@ -203,8 +253,13 @@ int main()
 
 	glUseProgram(shaderID); // Reseta o estado do shader para evitar problemas futuros
 
-	double prev_s = glfwGetTime();	// Define o "tempo anterior" inicial.
-	double title_countdown_s = 0.1; // Intervalo para atualizar o título da janela com o FPS.
+	double prev_s = glfwGetTime();	// Início do intervalo de contagem do FPS
+	int fps_frames = 0;
+	std::string fpsText = "FPS --";
+
+	TextRenderer hud;
+	if (!hud.init())
+		return -1;
 
 	float colorValue = 0.0;
 
@@ -214,12 +269,25 @@ int main()
 	// Criando a variável uniform pra mandar a textura pro shader
 	glUniform1i(glGetUniformLocation(shaderID, "tex_buff"), 0);
 
-	// Matriz de projeção paralela ortográfica
-	mat4 projection = ortho(0.0, 800.0, 0.0, 600.0, -1.0, 1.0);
-	glUniformMatrix4fv(glGetUniformLocation(shaderID, "projection"), 1, GL_FALSE, value_ptr(projection));
-
+	// Câmera ortográfica: 1 unidade do mundo = 1 pixel, começa mostrando (0,0)-(800,600)
+	// e fica presa nos limites do cenário de fundo
+	camera.pixelsPerUnit = 1.0f;
+	camera.position = vec2(WIDTH / 2.0f, HEIGHT / 2.0f);
+	camera.setViewport(width, height);
+	camera.clampToBounds = true;
+	camera.bounds = { background.position.x - background.dimensions.x / 2.0f, background.position.y - background.dimensions.y / 2.0f,
+	                  background.position.x + background.dimensions.x / 2.0f, background.position.y + background.dimensions.y / 2.0f };
+
+	GLint projectionLoc = glGetUniformLocation(shaderID, "projection");
+	GLint modelLoc = glGetUniformLocation(shaderID, "model");
+	GLint offsetTexLoc = glGetUniformLocation(shaderID, "offsetTex");
+
+	// Opacos primeiro (da frente para tras) escrevendo profundidade e sem blending;
+	// translucidos depois, de tras para frente, so lendo a profundidade. Aqui
+	// so o fundo eh opaco e fica atras do personagem, mas um opaco na frente ja
+	// esconderia o fundo no depth test, antes do fragment shader
 	glEnable(GL_DEPTH_TEST); // Habilita o teste de profundidade
-	glDepthFunc(GL_ALWAYS); // Testa a cada ciclo
+	glDepthFunc(GL_LESS);
 
 	glEnable(GL_BLEND); //Habilita a transparência -- canal alpha
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); //Seta função de transparência
@@ -231,97 +299,123 @@ int main()
 	double FPS = 6.0;
 
 
-	vec2 offsetTexBg = vec2(0.0,0.0);
+	double prevFrame = glfwGetTime();
 	// Loop da aplicação - "game loop"
 	while (!glfwWindowShouldClose(window))
 	{
-		// Este trecho de código é totalmente opcional: calcula e mostra a contagem do FPS na barra de título
+		// Contagem do FPS (média de 0.25 s), mostrada na tela pelo TextRenderer em vez do
+		// título da janela (glfwSetWindowTitle é uma chamada lenta ao sistema de janelas)
 		{
-			double curr_s = glfwGetTime();		// Obtém o tempo atual.
-			double elapsed_s = curr_s - prev_s; // Calcula o tempo decorrido desde o último frame.
-			prev_s = curr_s;					// Atualiza o "tempo anterior" para o próximo frame.
-
-			// Exibe o FPS, mas não a cada frame, para evitar oscilações excessivas.
-			title_countdown_s -= elapsed_s;
-			if (title_countdown_s <= 0.0 && elapsed_s > 0.0)
+			double curr_s = glfwGetTime();
+			fps_frames++;
+			if (curr_s - prev_s >= 0.25)
 			{
-				double fps = 0.5 / elapsed_s; // Calcula o FPS com base no tempo decorrido.
-
-				// Cria uma string e define o FPS como título da janela.
-				char tmp[256];
-				sprintf(tmp, "Ola Triangulo! -- Rossana\tFPS %.2lf", fps);
-				glfwSetWindowTitle(window, tmp);
-
-				title_countdown_s = 0.1; // Reinicia o temporizador para atualizar o título periodicamente.
+				char tmp[32];
+				snprintf(tmp, sizeof(tmp), "FPS %.1f", fps_frames / (curr_s - prev_s));
+				fpsText = tmp;
+				prev_s = curr_s;
+				fps_frames = 0;
 			}
 		}
 
 		// Checa se houveram eventos de input (key pressed, mouse moved etc.) e chama as funções de callback correspondentes
 		glfwPollEvents();
+		input.beginFrame((float)(glfwGetTime() - prevFrame));
 
 		// Limpa o buffer de cor
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // cor de fundo
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
+		// o HUD do frame anterior troca o shader e desliga o depth test
+		glUseProgram(shaderID);
+		glEnable(GL_DEPTH_TEST);
+
 		glLineWidth(10);
 		glPointSize(20);
 
-		// Desenho do background
-		// Matriz de transformaçao do objeto - Matriz de modelo
-		mat4 model = mat4(1); //matriz identidade
-		model = translate(model,background.position);
-		model = rotate(model, radians(0.0f), vec3(0.0, 0.0, 1.0));
-		model = scale(model,background.dimensions);
-		glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
-
-		
-
 		currTime = glfwGetTime();
 		deltaT = currTime - lastTime;
 
-		processMovement(window, vampirao, background, deltaT, FPS, lastTime, currTime, offsetTexBg);
+		processMovement(input, vampirao, camera.bounds, deltaT, FPS, lastTime, currTime);
 
-		offsetTexBg.t = 0.0;
-		glUniform2f(glGetUniformLocation(shaderID, "offsetTex"), offsetTexBg.s, offsetTexBg.t);
+		// Câmera segue o personagem (em vez de deslocar a textura do fundo)
+		camera.follow(vec2(vampirao.position), (float)(currTime - prevFrame));
+		prevFrame = currTime;
 
+		mat4 viewProjection = camera.projection() * camera.view();
+		glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, value_ptr(viewProjection));
 
-		glBindVertexArray(background.VAO); // Conectando ao buffer de geometria
-		glBindTexture(GL_TEXTURE_2D, background.texID); // Conectando ao buffer de textura
+		// Só desenha o que está dentro da área visível
+		Rect2D visible = camera.viewRect();
 
-		// Chamada de desenho - drawcall
-		// Poligono Preenchido - GL_TRIANGLES
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		// Desenho do background
+		if (visible.intersects(background.position.x, background.position.y, background.dimensions.x / 2.0f, background.dimensions.y / 2.0f))
+		{
+			// Matriz de transformaçao do objeto - Matriz de modelo
+			mat4 model = mat4(1); //matriz identidade
+			model = translate(model,background.position);
+			model = rotate(model, radians(0.0f), vec3(0.0, 0.0, 1.0));
+			model = scale(model,background.dimensions);
+			glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(model));
+
+			glUniform2f(offsetTexLoc, 0.0f, 0.0f);
+			setSpriteAlpha(background.alpha);
+
+			glBindVertexArray(background.VAO); // Conectando ao buffer de geometria
+			glBindTexture(GL_TEXTURE_2D, background.texID); // Conectando ao buffer de textura
+
+			// Chamada de desenho - drawcall
+			// Poligono Preenchido - GL_TRIANGLES
+			glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		}
 
 
 		//---------------------------------------------------------------------
 		// Desenho do vampirao
-		// Matriz de transformaçao do objeto - Matriz de modelo
-		model = mat4(1); //matriz identidade
-		model = translate(model,vampirao.position);
-		model = rotate(model, radians(0.0f), vec3(0.0, 0.0, 1.0));
-		vec3 scaleFactor = vampirao.dimensions;
-		if (vampirao.flipHorizontal) {
-    		scaleFactor.x *= -1.0f;}
-		model = scale(model,scaleFactor);
-		glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
-
-		vec2 offsetTex;
-
-		offsetTex.s = vampirao.iFrame * vampirao.ds;
-		offsetTex.t = vampirao.iAnimation * vampirao.dt;
-		glUniform2f(glGetUniformLocation(shaderID, "offsetTex"),offsetTex.s, offsetTex.t);
-
-		glBindVertexArray(vampirao.VAO); // Conectando ao buffer de geometria
-		glBindTexture(GL_TEXTURE_2D, vampirao.texID); // Conectando ao buffer de textura
-
-		// Chamada de desenho - drawcall
-		// Poligono Preenchido - GL_TRIANGLES
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		if (visible.intersects(vampirao.position.x, vampirao.position.y, vampirao.dimensions.x / 2.0f, vampirao.dimensions.y / 2.0f))
+		{
+			// Matriz de transformaçao do objeto - Matriz de modelo
+			mat4 model = mat4(1); //matriz identidade
+			model = translate(model,vampirao.position);
+			model = rotate(model, radians(0.0f), vec3(0.0, 0.0, 1.0));
+			vec3 scaleFactor = vampirao.dimensions;
+			if (vampirao.flipHorizontal) {
+				scaleFactor.x *= -1.0f;}
+			model = scale(model,scaleFactor);
+			glUniformMatrix4fv(modelLoc, 1, GL_FALSE, value_ptr(model));
+
+			vec2 offsetTex;
+
+			offsetTex.s = vampirao.iFrame * vampirao.ds;
+			offsetTex.t = vampirao.iAnimation * vampirao.dt;
+			glUniform2f(offsetTexLoc, offsetTex.s, offsetTex.t);
+			setSpriteAlpha(vampirao.alpha);
+
+			glBindVertexArray(vampirao.VAO); // Conectando ao buffer de geometria
+			glBindTexture(GL_TEXTURE_2D, vampirao.texID); // Conectando ao buffer de textura
+
+			// Chamada de desenho - drawcall
+			// Poligono Preenchido - GL_TRIANGLES
+			if (vampirao.nIndices > 0)
+				glDrawElements(GL_TRIANGLES, vampirao.nIndices, GL_UNSIGNED_INT, 0);
+			else
+				glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+		}
 		//---------------------------------------------------------------------------
+		// o glClear da profundidade respeita o glDepthMask
+		glDepthMask(GL_TRUE);
+
+		// HUD em coordenadas da janela, por cima de tudo
+		int winW, winH;
+		glfwGetWindowSize(window, &winW, &winH);
+		hud.begin(winW, winH);
+		hud.add(fpsText, 10.0f, 8.0f, 2.0f, vec4(1.0f, 1.0f, 0.4f, 1.0f));
+		hud.flush();
 
 		// Troca os buffers da tela
 		glfwSwapBuffers(window);
 	}
+	hud.destroy();
 		
 	// Finaliza a execução da GLFW, limpando os recursos alocados por ela
 	glfwTerminate();
@@ -337,6 +431,13 @@ void key_callback(GLFWwindow *window, int key, int scancode, int action, int mod
 		glfwSetWindowShouldClose(window, GL_TRUE);
 }
 
+// Função de callback de redimensionamento: ajusta a viewport e a projeção da câmera
+void framebuffer_size_callback(GLFWwindow *window, int width, int height)
+{
+	glViewport(0, 0, width, height);
+	camera.setViewport(width, height);
+}
+
 // Esta função está bastante hardcoded - objetivo é compilar e "buildar" um programa de
 //  shader simples e único neste exemplo de código
 //  O código fonte do vertex e fragment shader está nos arrays vertexShaderSource e
@@ -430,7 +531,58 @@ int setupSprite(int nAnimations, int nFrames, float &ds, float &dt)
 	return VAO;
 }
 
-int loadTexture(string filePath, int &width, int &height)
+// mesmo s e t do quad do setupSprite (o shader faz 1 - t e soma o offsetTex),
+// mas so nos pontos do mesh: o canto (0, 0) do frame eh o V0 do quad
+int setupSpriteMesh(const SpriteMesh &mesh, int nAnimations, int nFrames, float &ds, float &dt)
+{
+	ds = 1.0 / (float) nFrames;
+	dt = 1.0 / (float) nAnimations;
+
+	std::vector<GLfloat> vertices;
+	for (const glm::vec2 &p : mesh.points)
+	{
+		// x   y    z    s     t
+		GLfloat v[] = { p.x - 0.5f, 0.5f - p.y, 0.0f, p.x * ds, (1.0f - p.y) * dt };
+		vertices.insert(vertices.end(), v, v + 5);
+	}
+
+	GLuint VBO, EBO, VAO;
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+
+	glBindVertexArray(VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
+	// o EBO fica preso ao VAO
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(uint32_t), mesh.indices.data(), GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid *)0);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid *)(3 * sizeof(GLfloat)));
+	glEnableVertexAttribArray(1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return VAO;
+}
+
+// opaco: sem blending e escrevendo profundidade; recorte e translucido com
+// blending e so lendo a profundidade (o shader nao descarta pixels)
+void setSpriteAlpha(SpriteAlpha alpha)
+{
+	if (alpha == SPRITE_OPAQUE)
+		glDisable(GL_BLEND);
+	else
+		glEnable(GL_BLEND);
+	glDepthMask(alpha == SPRITE_OPAQUE ? GL_TRUE : GL_FALSE);
+}
+
+// pixels != nullptr: fica com uma copia dos pixels se a imagem tiver alfa
+int loadTexture(string filePath, int &width, int &height, std::vector<unsigned char> *pixels)
 {
 	GLuint texID;
 
@@ -446,7 +598,7 @@ int loadTexture(string filePath, int &width, int &height)
 
 	int nrChannels;
 
-	unsigned char *data = stbi_load(filePath.c_str(), &width, &height, &nrChannels, 0);
+	unsigned char *data = loadImageAsset(filePath, &width, &height, &nrChannels, 0);
 
 	if (data)
 	{
@@ -457,6 +609,8 @@ int loadTexture(string filePath, int &width, int &height)
 		else // png
 		{
 			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+			if (pixels)
+				pixels->assign(data, data + (size_t)width * height * 4);
 		}
 		glGenerateMipmap(GL_TEXTURE_2D);
 	}
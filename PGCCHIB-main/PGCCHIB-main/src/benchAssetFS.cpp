@@ -0,0 +1,145 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include "AssetFS.h"
+#include "Lz4.h"
+
+// Compara os dois jeitos de montar os assets (so CPU, sem janela):
+//   pasta   - um fopen + fread por arquivo
+//   pacote  - o .pak mapeado: busca no indice por hash e leitura sem copia
+//             (ou LZ4 para os arquivos de texto)
+// Confere que os bytes das duas montagens sao iguais, mede buscas, leituras e
+// a decodificacao dos PNGs a partir da memoria, e testa o LZ4 ida e volta.
+//
+// benchAssetFS [pasta include]
+
+#ifndef PG_ASSET_DIR
+#define PG_ASSET_DIR "include"
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+static double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::string directory = argc > 1 ? argv[1] : PG_ASSET_DIR;
+    const std::string packPath = "benchAssetFS.pak";
+    const std::vector<std::string> extensions = { ".png", ".tmx" };
+
+    auto start = Clock::now();
+    AssetPackStats stats;
+    if (!writeAssetPack(directory, packPath, extensions, false, &stats))
+        return 1;
+    printf("pacote: %zu arquivos (%zu em LZ4), %.2f MB -> %.2f MB, empacotar %.1f ms\n", stats.files,
+           stats.compressed, stats.originalBytes / 1048576.0, stats.storedBytes / 1048576.0, msSince(start));
+
+    AssetFS loose, packed;
+    start = Clock::now();
+    if (!loose.mountDirectory(directory) || !packed.mountArchive(packPath))
+        return 1;
+    printf("montar o pacote: %.3f ms\n", msSince(start));
+
+    AssetPack pack;
+    pack.open(packPath);
+    std::vector<std::string> names;
+    for (uint32_t i = 0; i < pack.entryCount(); ++i)
+        names.push_back(pack.entryName(pack.entry(i)));
+
+    // mesmos bytes nas duas montagens
+    long mismatches = 0, zeroCopy = 0;
+    for (const std::string& name : names) {
+        AssetData a, b;
+        if (!loose.read(name, a) || !packed.read(name, b) || a.size != b.size || memcmp(a.data, b.data, a.size) != 0)
+            mismatches++;
+        if (b.zeroCopy()) zeroCopy++;
+    }
+    printf("arquivos diferentes entre pasta e pacote: %ld (%ld lidos sem copia)\n", mismatches, zeroCopy);
+
+    // buscas: o indice do pacote contra perguntar ao sistema de arquivos
+    const int lookupRounds = 2000;
+    start = Clock::now();
+    long found = 0;
+    for (int r = 0; r < lookupRounds; ++r)
+        for (const std::string& name : names)
+            found += packed.exists(name);
+    double packLookup = msSince(start) * 1e6 / ((double)lookupRounds * names.size());
+    start = Clock::now();
+    for (int r = 0; r < lookupRounds / 100; ++r)
+        for (const std::string& name : names)
+            found += loose.exists(name);
+    double looseLookup = msSince(start) * 1e6 / ((double)(lookupRounds / 100) * names.size());
+    printf("busca: pacote %.0f ns, pasta %.0f ns por caminho (%ld encontrados)\n", packLookup, looseLookup, found);
+
+    // leitura de tudo e leitura + decodificacao dos PNGs, como os programas fazem
+    const int rounds = 5;
+    for (int m = 0; m < 2; ++m) {
+        const AssetFS& fs = m == 0 ? loose : packed;
+        size_t bytes = 0;
+        start = Clock::now();
+        for (int r = 0; r < rounds; ++r)
+            for (const std::string& name : names) {
+                AssetData data;
+                fs.read(name, data);
+                bytes += data.size;
+            }
+        double readMs = msSince(start) / rounds;
+
+        start = Clock::now();
+        for (const std::string& name : names) {
+            if (name.size() < 4 || name.compare(name.size() - 4, 4, ".png") != 0) continue;
+            AssetData data;
+            int w, h, channels;
+            if (!fs.read(name, data)) continue;
+            unsigned char* pixels = stbi_load_from_memory(data.data, (int)data.size, &w, &h, &channels, 4);
+            stbi_image_free(pixels);
+        }
+        printf("%-7s ler tudo %.2f ms (%.1f MB), ler + decodificar os PNGs %.1f ms\n", m == 0 ? "pasta:" : "pacote:",
+               readMs, bytes / (double)rounds / 1048576.0, msSince(start));
+    }
+
+    // LZ4: texto repetitivo, bytes aleatorios e um caso com sobreposicao
+    std::string text;
+    for (int i = 0; i < 2000; ++i)
+        text += "<tile gid=\"" + std::to_string(i % 7 + 1) + "\"/>\n";
+    std::vector<unsigned char> noise(100000);
+    uint32_t seed = 12345;
+    for (unsigned char& c : noise) {
+        seed = seed * 1664525u + 1013904223u;
+        c = (unsigned char)(seed >> 24);
+    }
+    std::vector<unsigned char> runs(50000, 'a');
+    struct Case { const char* name; const unsigned char* data; size_t size; };
+    const Case cases[] = {
+        { "xml", (const unsigned char*)text.data(), text.size() },
+        { "aleatorio", noise.data(), noise.size() },
+        { "repeticao", runs.data(), runs.size() },
+        { "curto", (const unsigned char*)"abc", 3 },
+    };
+    for (const Case& c : cases) {
+        std::vector<unsigned char> compressed, back(c.size);
+        start = Clock::now();
+        lz4Compress(c.data, c.size, compressed);
+        double compressMs = msSince(start);
+        start = Clock::now();
+        bool ok = lz4Decompress(compressed.data(), compressed.size(), back.data(), back.size()) &&
+                  memcmp(back.data(), c.data, c.size) == 0;
+        double decompressMs = msSince(start);
+        printf("lz4 %-10s %7zu -> %7zu bytes, comprimir %.3f ms, descomprimir %.3f ms, %s\n", c.name, c.size,
+               compressed.size(), compressMs, decompressMs, ok ? "ok" : "ERRO");
+        if (!ok) mismatches++;
+    }
+
+    pack.close();
+    packed.unmountAll();
+    remove(packPath.c_str());
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,266 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ColorGame.h"
+#include "ColorBot.h"
+#include "ParallelFor.h"
+
+// Mede o ColorBot e o SimilarityGrid sem janela.
+// 0) conferencia: em posicoes com ate 5 jogadas restantes o bot (sem prazo)
+//    tem que bater com um minimax completo, sem poda.
+// 1) partidas bot x gulosa (o bot alterna entre jogador 1 e 2): tempo por
+//    decisao, nos visitados, quantas decisoes foram exatas e vitorias do bot.
+//    Com as regras padrao quem comeca sempre ganha (a penalidade cresce a cada
+//    jogada), entao a comparacao que importa eh o saldo: a mesma grade eh jogada
+//    de novo com a gulosa no lugar do bot.
+// 2) grades grandes com o SimilarityGrid: montar os baldes, melhor clique com o
+//    prazo (media e pior de 6 jogadas), remover as celulas, cliques contados um
+//    a um e quantas jogadas foram provadas melhores. Ate 128 x 128 cada jogada
+//    eh conferida sem prazo contra o teste de todos os pares. Depois o planMove
+//    (uma jogada a frente) joga como jogador 1 contra a gulosa: tempo por
+//    jogada e saldo do jogador 1, contra o saldo da gulosa no lugar dele.
+//
+// benchColorBot [partidas] [budgetMs] [threads]   (padrao 200, 16 e todos os nucleos)
+
+typedef std::chrono::steady_clock Clock;
+
+int greedyCell(const ColorGame& game) {
+    int best = -1, bestCount = 0;
+    for (uint64_t bits = game.visible; bits; bits &= bits - 1) {
+        int cell = lowestBit(bits);
+        int count = game.removalCount(cell);
+        if (count > bestCount) {
+            bestCount = count;
+            best = cell;
+        }
+    }
+    return best;
+}
+
+void benchBot(long games, double budgetMs, int threads) {
+    ColorBot bot;
+    bot.budgetMs = budgetMs;
+    bot.threads = threads;
+
+    GameRng rng(7);
+    ColorGame game;
+    long decisions = 0, solved = 0, totalNodes = 0, wins[3] = { 0, 0, 0 }; // empate, bot, gulosa
+    long long botScore = 0, greedyScore = 0, botMargin = 0, baselineMargin = 0;
+    double totalMs = 0.0, worstMs = 0.0;
+
+    for (long g = 0; g < games; ++g) {
+        int botPlayer = g % 2 == 0 ? 1 : 2;
+        game.reset(rng);
+        ColorGame baseline = game;
+        while (!baseline.gameOver && baseline.visible)
+            baseline.play(greedyCell(baseline));
+        baselineMargin += baseline.scores[botPlayer - 1] - baseline.scores[2 - botPlayer];
+
+        while (!game.gameOver && game.visible) {
+            if (game.currentPlayer == botPlayer) {
+                game.play(bot.chooseMove(game));
+                decisions++;
+                solved += bot.solved;
+                totalNodes += bot.nodes;
+                totalMs += bot.lastMs;
+                if (bot.lastMs > worstMs) worstMs = bot.lastMs;
+            } else {
+                game.play(greedyCell(game));
+            }
+        }
+        int winner = game.winner();
+        wins[winner == 0 ? 0 : (winner == botPlayer ? 1 : 2)]++;
+        botScore += game.scores[botPlayer - 1];
+        greedyScore += game.scores[2 - botPlayer];
+        botMargin += game.scores[botPlayer - 1] - game.scores[2 - botPlayer];
+    }
+
+    double n = (double)games;
+    printf("bot x gulosa: %ld partidas, %ld decisoes\n", games, decisions);
+    printf("  decisao: %.3f ms em media, pior %.3f ms, %.0f nos, %.1f%% exatas\n",
+           totalMs / decisions, worstMs, (double)totalNodes / decisions, 100.0 * solved / decisions);
+    printf("  pontos: bot %.1f, gulosa %.1f; vence bot %.1f%%, gulosa %.1f%%, empate %.1f%%\n",
+           botScore / n, greedyScore / n, 100.0 * wins[1] / n, 100.0 * wins[2] / n, 100.0 * wins[0] / n);
+    printf("  saldo no lugar do bot: bot %+.1f, gulosa %+.1f\n", botMargin / n, baselineMargin / n);
+}
+
+// minimax sem poda nem ordenacao, para conferir o bot: todas as celulas
+// visiveis, pulando so cliques com a mesma mascara de um clique anterior
+int exhaustiveValue(const ColorGame& game, uint64_t visible, int attempts) {
+    if (attempts >= game.rules.maxAttempts || visible == 0)
+        return 0;
+    int best = -(1 << 20);
+    for (uint64_t bits = visible; bits; bits &= bits - 1) {
+        int cell = lowestBit(bits);
+        uint64_t mask = game.similar[cell] & visible;
+        bool repeated = false;
+        for (uint64_t before = visible & ((1ull << cell) - 1); before && !repeated; before &= before - 1)
+            repeated = (game.similar[lowestBit(before)] & visible) == mask;
+        if (repeated) continue;
+        int points = bitCount(mask) * game.rules.pointsPerCell - attempts * game.rules.penaltyPerAttempt;
+        if (points < 0) points = 0;
+        int value = points - exhaustiveValue(game, visible & ~mask, attempts + 1);
+        if (value > best) best = value;
+    }
+    return best;
+}
+
+// posicoes do meio da partida (algumas jogadas aleatorias ja feitas), busca sem
+// prazo: o bot tem que dar exato o valor do minimax e escolher uma jogada que o alcanca
+void checkBot(int positions, int threads) {
+    ColorBot bot;
+    bot.budgetMs = 1e9;
+    bot.threads = threads;
+    GameRng rng(2024);
+    ColorGame game;
+    int wrongMove = 0, wrongValue = 0, unsolved = 0;
+    for (int p = 0; p < positions; ++p) {
+        game.reset(rng);
+        int opening = 1 + rng.nextInt(4);
+        for (int m = 0; m < opening && !game.gameOver && game.visible; ++m) {
+            int cell;
+            do cell = rng.nextInt(ColorGame::CELLS);
+            while (!game.cellVisible(cell));
+            game.play(cell);
+        }
+        if (game.gameOver || game.visible == 0) continue;
+
+        int expected = exhaustiveValue(game, game.visible, game.attempts);
+        int cell = bot.chooseMove(game);
+        uint64_t mask = game.removalMask(cell);
+        int points = bitCount(mask) * game.rules.pointsPerCell - game.attempts * game.rules.penaltyPerAttempt;
+        if (points < 0) points = 0;
+        int chosen = points - exhaustiveValue(game, game.visible & ~mask, game.attempts + 1);
+        unsolved += !bot.solved;
+        wrongValue += bot.bestValue != expected;
+        wrongMove += chosen != expected;
+    }
+    printf("conferencia com o minimax completo: %d posicoes, %d jogadas erradas, %d valores errados, %d sem resolver%s\n",
+           positions, wrongMove, wrongValue, unsolved, wrongMove || wrongValue || unsolved ? "  ERRO" : "");
+}
+
+// melhor clique testando todos os pares (so para grades pequenas)
+int bruteForceBest(const std::vector<Color>& colors, const std::vector<unsigned char>& visible, float threshold) {
+    float limit = threshold * threshold;
+    int best = 0;
+    for (size_t i = 0; i < colors.size(); ++i) {
+        if (!visible[i]) continue;
+        int count = 0;
+        for (size_t j = 0; j < colors.size(); ++j) {
+            float dr = colors[i].r - colors[j].r, dg = colors[i].g - colors[j].g, db = colors[i].b - colors[j].b;
+            count += visible[j] && dr * dr + dg * dg + db * db < limit;
+        }
+        if (count > best) best = count;
+    }
+    return best;
+}
+
+void benchGrid(int side, double budgetMs, int threads) {
+    int cells = side * side;
+    std::vector<Color> colors(cells);
+    GameRng rng(side);
+    for (Color& c : colors) {
+        c.r = 0.5f + rng.nextFloat() * 0.5f;
+        c.g = 0.5f + rng.nextFloat() * 0.5f;
+        c.b = 0.5f + rng.nextFloat() * 0.5f;
+    }
+    const float threshold = 0.25f;
+
+    SimilarityGrid grid;
+    auto start = Clock::now();
+    grid.build(colors.data(), cells, threshold);
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // uma partida so com a melhor jogada; nas grades pequenas cada jogada sem prazo
+    // eh conferida contra todos os pares
+    bool check = cells <= 128 * 128;
+    int moves = 0, proven = 0, wrong = 0;
+    long evaluated = 0;
+    double worstMs = 0.0, totalMs = 0.0, removeMs = 0.0;
+    std::vector<unsigned char> visible(cells, 1);
+    while (moves < 6) {
+        int removed = 0;
+        int cell = grid.bestMove(budgetMs, threads, &removed);
+        if (cell < 0) break;
+        moves++;
+        proven += grid.exact;
+        evaluated += grid.evaluated;
+        totalMs += grid.lastMs;
+        if (grid.lastMs > worstMs) worstMs = grid.lastMs;
+        if (check) {
+            int exactRemoved = 0;
+            grid.bestMove(1e9, threads, &exactRemoved);
+            wrong += exactRemoved != bruteForceBest(colors, visible, threshold) || grid.removalCount(cell) != removed;
+        }
+
+        start = Clock::now();
+        int count = grid.remove(cell);
+        removeMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (count != removed) wrong++;
+        for (int i = 0; i < cells; ++i)
+            visible[i] = grid.visible(i);
+    }
+
+    // a mesma grade de novo, o jogador 1 com o planMove (uma jogada a frente)
+    // contra a gulosa, e depois a gulosa dos dois lados: saldo do jogador 1
+    ColorGameRules rules;
+    int margins[2] = { 0, 0 }, planned = 0;
+    double planMs = 0.0, planWorstMs = 0.0;
+    for (int plan = 0; plan < 2; ++plan) {
+        grid.showAll();
+        for (int attempts = 0; attempts < rules.maxAttempts; ++attempts) {
+            int removed = 0, cell;
+            if (plan && attempts % 2 == 0) {
+                std::vector<unsigned char> before(cells);
+                for (int i = 0; i < cells && check; ++i)
+                    before[i] = grid.visible(i);
+                cell = grid.planMove(rules, attempts, budgetMs, threads, &removed);
+                planned++;
+                planMs += grid.lastMs;
+                if (grid.lastMs > planWorstMs) planWorstMs = grid.lastMs;
+                // o que o planMove jogou para ver a resposta tem que ter voltado
+                for (int i = 0; i < cells && check; ++i)
+                    wrong += before[i] != grid.visible(i);
+            } else {
+                cell = grid.bestMove(budgetMs, threads, &removed);
+            }
+            if (cell < 0) break;
+            int points = std::max(0, removed * rules.pointsPerCell - attempts * rules.penaltyPerAttempt);
+            margins[plan] += attempts % 2 == 0 ? points : -points;
+            grid.remove(cell);
+        }
+    }
+
+    printf("%4d x %-4d %10.1f %10.3f %10.3f %10.3f %8.0f %6d/%d %9.3f %9.3f %+8d %+8d", side, side, buildMs,
+           totalMs / moves, worstMs, removeMs / moves, (double)evaluated / moves, proven, moves, planMs / planned,
+           planWorstMs, margins[1], margins[0]);
+    if (check) printf("   %d erradas%s", wrong, wrong ? "  ERRO" : "");
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    long games = argc > 1 ? atol(argv[1]) : 200;
+    double budgetMs = argc > 2 ? atof(argv[2]) : 16.0;
+    int threads = argc > 3 ? atoi(argv[3]) : 0;
+    if (games <= 0 || budgetMs <= 0.0) {
+        std::cerr << "uso: benchColorBot [partidas] [budgetMs] [threads]\n";
+        return -1;
+    }
+
+    printf("%d threads, prazo de %.1f ms por decisao\n", threads > 0 ? threads : defaultThreadCount(), budgetMs);
+    checkBot(400, 1);
+    checkBot(100, 4); // alfa compartilhado entre threads
+    benchBot(games, budgetMs, threads);
+
+    printf("\npartidas de 6 jogadas com o SimilarityGrid, prazo de %.1f ms por jogada\n", budgetMs);
+    printf("%-11s %10s %10s %10s %10s %8s %8s %9s %9s %8s %8s\n", "grade", "montar", "jogada", "pior", "remover",
+           "cliques", "exatas", "plano", "pior", "saldo", "guloso");
+    const int sides[] = { 32, 64, 128, 256, 1000 };
+    for (int side : sides)
+        benchGrid(side, budgetMs, threads);
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ColorGame.h"
+#include "ParallelFor.h"
+#include "AllocationCounter.h"
+
+// Simulador do jogo das cores sem janela, para balancear as regras.
+// Joga milhoes de partidas em todos os nucleos com o ColorGame (sem GLFW, sem
+// alocacao) e mostra, para cada limiar de similaridade e estrategia:
+// partidas por segundo, celulas removidas, pontos e vitorias de cada jogador.
+// As partidas sao divididas em blocos fixos e cada bloco tem o seu GameRng
+// (semente = bloco), entao o resultado nao depende do numero de threads.
+//
+// benchColorGame [partidas] [threads]   (padrao 1000000 e todos os nucleos)
+
+const int BLOCKS = 256;
+
+enum Strategy {
+    STRATEGY_RANDOM,  // qualquer celula visivel
+    STRATEGY_GREEDY   // a celula que remove mais (empate: a primeira)
+};
+
+struct Tally {
+    long games = 0;
+    long wins[3] = { 0, 0, 0 }; // empate, jogador 1, jogador 2
+    long long removed = 0;
+    long long scores[2] = { 0, 0 };
+};
+
+int chooseCell(const ColorGame& game, Strategy strategy, GameRng& rng) {
+    if (strategy == STRATEGY_RANDOM) {
+        // k-esimo bit ligado da mascara
+        int k = rng.nextInt(bitCount(game.visible));
+        uint64_t bits = game.visible;
+        for (int i = 0; i < k; ++i) bits &= bits - 1;
+        return lowestBit(bits);
+    }
+    int best = -1, bestCount = 0;
+    for (uint64_t bits = game.visible; bits; bits &= bits - 1) {
+        int cell = lowestBit(bits);
+        int count = game.removalCount(cell);
+        if (count > bestCount) {
+            bestCount = count;
+            best = cell;
+        }
+    }
+    return best;
+}
+
+void simulate(const ColorGameRules& rules, Strategy strategy, long games, int threads, std::vector<Tally>& tallies) {
+    tallies.assign(BLOCKS, Tally());
+    parallelFor(BLOCKS, threads, 1, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block) {
+            long first = games * (long)block / BLOCKS, last = games * (long)(block + 1) / BLOCKS;
+            GameRng rng(block);
+            ColorGame game;
+            game.rules = rules;
+            Tally& tally = tallies[block];
+            for (long g = first; g < last; ++g) {
+                game.reset(rng);
+                while (!game.gameOver && game.visible)
+                    game.play(chooseCell(game, strategy, rng));
+                tally.games++;
+                tally.wins[game.winner()]++;
+                tally.removed += ColorGame::CELLS - bitCount(game.visible);
+                tally.scores[0] += game.scores[0];
+                tally.scores[1] += game.scores[1];
+            }
+        }
+    });
+}
+
+int main(int argc, char** argv) {
+    long games = argc > 1 ? atol(argv[1]) : 1000000;
+    int threads = argc > 2 ? atoi(argv[2]) : 0;
+    if (games <= 0) {
+        std::cerr << "uso: benchColorGame [partidas] [threads]\n";
+        return -1;
+    }
+
+    printf("%ld partidas por configuracao, %d threads\n", games, threads > 0 ? threads : defaultThreadCount());
+    printf("%-8s %-9s %12s %9s %9s %9s %8s %8s %8s\n", "limiar", "jogada", "partidas/s", "removidas",
+           "pontos 1", "pontos 2", "vence 1", "vence 2", "empate");
+
+    const float thresholds[] = { 0.15f, 0.20f, 0.25f, 0.30f, 0.35f };
+    const Strategy strategies[] = { STRATEGY_RANDOM, STRATEGY_GREEDY };
+    const char* strategyNames[] = { "aleatoria", "gulosa" };
+    std::vector<Tally> tallies;
+    double totalGames = 0.0, totalSeconds = 0.0;
+    size_t allocationsBefore = allocationCount();
+
+    for (float threshold : thresholds) {
+        for (Strategy strategy : strategies) {
+            ColorGameRules rules;
+            rules.similarityThreshold = threshold;
+
+            auto start = std::chrono::steady_clock::now();
+            simulate(rules, strategy, games, threads, tallies);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            Tally sum;
+            for (const Tally& t : tallies) {
+                sum.games += t.games;
+                for (int i = 0; i < 3; ++i) sum.wins[i] += t.wins[i];
+                sum.removed += t.removed;
+                sum.scores[0] += t.scores[0];
+                sum.scores[1] += t.scores[1];
+            }
+            double n = (double)sum.games;
+            printf("%-8.2f %-9s %12.0f %9.2f %9.1f %9.1f %7.1f%% %7.1f%% %7.1f%%\n",
+                   threshold, strategyNames[strategy], n / seconds, sum.removed / n,
+                   sum.scores[0] / n, sum.scores[1] / n,
+                   100.0 * sum.wins[1] / n, 100.0 * sum.wins[2] / n, 100.0 * sum.wins[0] / n);
+            totalGames += n;
+            totalSeconds += seconds;
+        }
+    }
+
+    printf("total: %.0f partidas em %.2f s (%.0f partidas/s), %zu alocacoes (threads e vetor dos blocos)\n",
+           totalGames, totalSeconds, totalGames / totalSeconds, allocationCount() - allocationsBefore);
+    return 0;
+}
@@ -0,0 +1,188 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include "FrameCapture.h"
+
+// Benchmark do FrameCapture, sem janela visivel (headless).
+// Uma cena 1920x1080 (fundo em degrade por faixas e retangulos animados) a
+// 60 frames por segundo: cada frame desenha, captura e dorme o resto dos 16.7 ms,
+// como um jogo com vsync. Compara o tempo gasto na thread principal por frame:
+//   - glReadPixels direto para a memoria (espera a GPU e copia na hora);
+//   - FrameCapture com PBOs em anel, gravando Y4M, RGB cru e PNG.
+// Depois confere um PNG gravado contra a leitura direta do mesmo frame e o
+// tamanho do Y4M. Os arquivos sao apagados no final.
+// Depois de desenhar, cada frame faz um glFinish fora da medicao: em rasterizadores de CPU
+// (llvmpipe) o desenho so acontece quando alguem espera por ele, e sem isso o
+// custo do desenho apareceria como custo da captura.
+
+const int WIDTH = 1920;
+const int HEIGHT = 1080;
+const int FRAMES = 120;
+const double FRAME_MS = 1000.0 / 60.0;
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// cena deterministica pelo numero do frame, para poder desenhar de novo e comparar
+void drawScene(int frame) {
+    glEnable(GL_SCISSOR_TEST);
+    for (int band = 0; band < 8; ++band) {
+        glScissor(0, band * HEIGHT / 8, WIDTH, HEIGHT / 8 + 1);
+        glClearColor(0.1f, 0.1f + band * 0.05f, 0.2f + band * 0.08f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    for (int i = 0; i < 24; ++i) {
+        int x = (i * 211 + frame * (3 + i % 5) * 4) % (WIDTH - 160);
+        int y = (i * 137 + frame * (2 + i % 3) * 3) % (HEIGHT - 120);
+        glScissor(x, y, 160, 120);
+        glClearColor((i % 3) / 2.0f, (i % 4) / 3.0f, (i % 5) / 4.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    glDisable(GL_SCISSOR_TEST);
+}
+
+void waitFrameEnd(std::chrono::steady_clock::time_point frameStart) {
+    double left = FRAME_MS - msSince(frameStart);
+    if (left > 0.0) std::this_thread::sleep_for(std::chrono::microseconds((long)(left * 1000.0)));
+}
+
+void benchSync() {
+    std::vector<unsigned char> pixels((size_t)WIDTH * HEIGHT * 4);
+    double mainMs = 0.0;
+    for (int f = 0; f < FRAMES; ++f) {
+        auto frameStart = std::chrono::steady_clock::now();
+        drawScene(f);
+        glFinish();
+        auto t0 = std::chrono::steady_clock::now();
+        glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        mainMs += msSince(t0);
+        waitFrameEnd(frameStart);
+    }
+    printf("glReadPixels direto:  %.3f ms/frame na thread principal (sem gravar nada)\n", mainMs / FRAMES);
+}
+
+// devolve os frames gravados
+long benchCapture(const char* label, const std::string& path) {
+    FrameCapture capture;
+    if (!capture.start(path, WIDTH, HEIGHT)) return 0;
+    double worstMs = 0.0;
+    for (int f = 0; f < FRAMES; ++f) {
+        auto frameStart = std::chrono::steady_clock::now();
+        drawScene(f);
+        glFinish();
+        double before = capture.mainThreadMs;
+        capture.capture();
+        if (capture.mainThreadMs - before > worstMs) worstMs = capture.mainThreadMs - before;
+        waitFrameEnd(frameStart);
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    capture.stop();
+    printf("%-21s %.3f ms/frame na thread principal (pior %.3f ms), %ld gravados, %ld descartados, stop %.1f ms\n",
+           label, capture.mainThreadMs / FRAMES, worstMs, capture.written.load(), capture.dropped, msSince(t0));
+    return capture.written.load();
+}
+
+void checkPng(const std::string& prefix) {
+    // o primeiro frame que existir (com o anel cheio alguns podem ter sido descartados)
+    for (int f = 0; f < FRAMES; ++f) {
+        char name[32];
+        snprintf(name, sizeof(name), "%06d.png", f + 1);
+        int w, h, channels;
+        unsigned char* png = stbi_load((prefix + name).c_str(), &w, &h, &channels, 3);
+        if (!png) continue;
+
+        drawScene(f);
+        std::vector<unsigned char> pixels((size_t)WIDTH * HEIGHT * 4);
+        glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        size_t differing = 0;
+        for (int y = 0; y < HEIGHT; ++y)
+            for (int x = 0; x < WIDTH; ++x)
+                if (memcmp(&png[((size_t)y * WIDTH + x) * 3], &pixels[((size_t)(HEIGHT - 1 - y) * WIDTH + x) * 4], 3) != 0)
+                    differing++;
+        printf("PNG %s: %dx%d, %zu pixels diferentes da leitura direta\n", name, w, h, differing);
+        stbi_image_free(png);
+        return;
+    }
+    printf("nenhum PNG pode ser lido\n");
+}
+
+void checkY4m(const std::string& path, long frames) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return;
+    char header[128];
+    fgets(header, sizeof(header), f);
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fclose(f);
+    long expected = (long)strlen(header) + frames * (6 + WIDTH * HEIGHT * 3 / 2);
+    printf("Y4M: %ld bytes, esperado %ld (%s)\n", size, expected, size == expected ? "ok" : "DIFERENTE");
+}
+
+int main() {
+    if (!glfwInit()) {
+        std::cerr << "Falha ao inicializar GLFW\n";
+        return -1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "benchFrameCapture", NULL, NULL);
+    if (!window) {
+        std::cerr << "Falha ao criar contexto GLFW\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Falha ao inicializar GLAD\n";
+        return -1;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << "\n";
+
+    // o FrameCapture le do framebuffer ligado, aqui o FBO
+    GLuint fbo, color;
+    glGenFramebuffers(1, &fbo);
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WIDTH, HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glViewport(0, 0, WIDTH, HEIGHT);
+
+    printf("%dx%d, %d frames a 60 fps\n", WIDTH, HEIGHT, FRAMES);
+    benchSync();
+    long y4mFrames = benchCapture("FrameCapture Y4M:", "benchFrameCapture.y4m");
+    benchCapture("FrameCapture RGB:", "benchFrameCapture.rgb");
+    benchCapture("FrameCapture PNG:", "benchFrameCapture_");
+
+    checkY4m("benchFrameCapture.y4m", y4mFrames);
+    checkPng("benchFrameCapture_");
+
+    std::remove("benchFrameCapture.y4m");
+    std::remove("benchFrameCapture.rgb");
+    for (int f = 0; f < FRAMES; ++f) {
+        char name[48];
+        snprintf(name, sizeof(name), "benchFrameCapture_%06d.png", f + 1);
+        std::remove(name);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+
+#include "GLHandles.h"
+
+// Benchmark dos handles OpenGL e do pool de buffers, sem janela visivel.
+// Simula uma sessao longa do GBAV1Davi: a cada frame aparecem alguns
+// triangulos (um VBO pequeno cada) e de tempos em tempos a tela eh limpa.
+//   - "sem liberar": o codigo antigo, que criava VAO+VBO por triangulo e so
+//     apagava no fim do programa;
+//   - "cria/apaga": handles RAII, apagados quando a tela eh limpa;
+//   - "pool": VBOs tirados do GLBufferPool e devolvidos ao limpar.
+// Imprime objetos vivos e bytes a cada checkpoint: so o primeiro cresce.
+
+const int FRAMES = 6000;
+const int PER_FRAME = 4;      // triangulos novos por frame
+const int CLEAR_EVERY = 300;  // frames entre uma limpeza e outra
+const int CHECKPOINTS = 4;
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct TriangleObjects {
+    GLVertexArray vao;
+    GLBuffer vbo;
+};
+
+void fillTriangle(float* vertices, int i) {
+    float x = (float)(i % 800), y = (float)((i * 7) % 600);
+    const float v[9] = { x, y, 0.0f, x + 20.0f, y, 0.0f, x + 10.0f, y + 20.0f, 0.0f };
+    for (int k = 0; k < 9; ++k) vertices[k] = v[k];
+}
+
+void bindAttribute() {
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+}
+
+void checkpoint(const char* name, int frame, long createdBefore) {
+    const GLResourceStats& s = glResourceStats();
+    printf("  %-12s frame %5d: %6ld buffers vivos %8.1f KB, %6ld VAOs vivos (%ld buffers criados)\n", name, frame,
+           s.live[GL_RES_BUFFER], s.bytes[GL_RES_BUFFER] / 1024.0, s.live[GL_RES_VERTEX_ARRAY],
+           s.created[GL_RES_BUFFER] - createdBefore);
+}
+
+// mode 0: sem liberar, 1: cria/apaga, 2: pool
+void runSession(const char* name, int mode) {
+    std::vector<TriangleObjects> leaked;  // so cresce (modo 0)
+    std::vector<TriangleObjects> current; // tela atual
+    GLBufferPool pool;
+    long createdBefore = glResourceStats().created[GL_RES_BUFFER];
+
+    float vertices[9];
+    int serial = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 1; frame <= FRAMES; ++frame) {
+        for (int i = 0; i < PER_FRAME; ++i) {
+            fillTriangle(vertices, serial++);
+            TriangleObjects t;
+            if (mode == 2) {
+                // so o buffer vem do pool: na hora de desenhar um VAO compartilhado aponta para ele
+                t.vbo = pool.acquire(sizeof(vertices));
+                t.vbo.subData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+            } else {
+                t.vao.create();
+                glBindVertexArray(t.vao.get());
+                t.vbo.data(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+                bindAttribute();
+                glBindVertexArray(0);
+            }
+            current.push_back(std::move(t));
+        }
+
+        // medido logo antes de limpar, com a tela cheia
+        if (frame % (FRAMES / CHECKPOINTS) == 0) checkpoint(name, frame, createdBefore);
+        if (frame % CLEAR_EVERY == 0) {
+            for (TriangleObjects& t : current) {
+                if (mode == 0) leaked.push_back(std::move(t));
+                else if (mode == 2) pool.release(std::move(t.vbo));
+            }
+            current.clear(); // modo 1: os destrutores apagam
+        }
+        if (frame % 60 == 0) glFinish();
+    }
+    glFinish();
+    double ms = msSince(start);
+    printf("  %-12s %.2f us/frame, %ld buffers criados no total", name, ms * 1000.0 / FRAMES,
+           glResourceStats().created[GL_RES_BUFFER] - createdBefore);
+    if (mode == 2) printf(", pool: %ld acertos / %ld faltas", pool.hits, pool.misses);
+    printf("\n");
+}
+
+int main() {
+    if (!glfwInit()) {
+        std::cerr << "Falha ao inicializar GLFW\n";
+        return -1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "benchGLHandles", NULL, NULL);
+    if (!window) {
+        std::cerr << "Falha ao criar contexto GLFW\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Falha ao inicializar GLAD\n";
+        return -1;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << "\n";
+    printf("%d frames, %d triangulos por frame, tela limpa a cada %d frames\n", FRAMES, PER_FRAME, CLEAR_EVERY);
+
+    runSession("sem liberar", 0);
+    runSession("cria/apaga", 1);
+    runSession("pool", 2);
+
+    // tudo saiu de escopo: nada deve sobrar
+    if (!reportGLLeaks()) printf("nenhum objeto OpenGL vivo no fim\n");
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,247 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Camera2D.h"
+#include "IsoRenderer.h"
+#include "LayerCache.h"
+
+// Benchmark do LayerCache, sem janela visivel (headless).
+// Chao isometrico de 256 x 256 tiles de 64 x 32 pixels (tileset gerado aqui,
+// com mipmap como no tilemap) em 1920x1080. Compara, por frame:
+//   - direto: monta e desenha todos os tiles visiveis;
+//   - cache rolando: a camera anda 2 pixels em x e 1 em y por frame, entao a
+//     cache so redesenha as faixas que entram pela margem;
+//   - cache parada: camera fixa, o frame eh so o blit da textura.
+// Mede com glFinish por frame e confere que a imagem da cache eh igual a do
+// desenho direto na mesma posicao da camera.
+
+const int WIDTH = 1920;
+const int HEIGHT = 1080;
+const int MAP_SIZE = 256;
+const int TILE_PIXELS_W = 64, TILE_PIXELS_H = 32;
+const int TILE_TYPES = 7;
+const int FRAMES = 120;
+
+const float TILE_WIDTH = 2.0f;
+const float TILE_HEIGHT = 1.0f;
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// tileset com TILE_TYPES losangos lado a lado, cada um com uma cor e um xadrez
+GLuint createTileset() {
+    int w = TILE_PIXELS_W * TILE_TYPES, h = TILE_PIXELS_H;
+    std::vector<unsigned char> pixels((size_t)w * h * 4);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            int t = x / TILE_PIXELS_W;
+            float lx = (x % TILE_PIXELS_W + 0.5f) / TILE_PIXELS_W * 2.0f - 1.0f;
+            float ly = (y + 0.5f) / TILE_PIXELS_H * 2.0f - 1.0f;
+            bool inside = std::abs(lx) + std::abs(ly) <= 1.0f;
+            bool checker = ((x / 8) + (y / 4)) % 2 == 0;
+            unsigned char* p = &pixels[((size_t)y * w + x) * 4];
+            p[0] = (unsigned char)(60 + t * 25 + (checker ? 20 : 0));
+            p[1] = (unsigned char)(200 - t * 20);
+            p[2] = (unsigned char)(80 + (t * 53) % 120 + (checker ? 0 : 30));
+            p[3] = inside ? 255 : 0;
+        }
+    }
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return texture;
+}
+
+// mesmo laco do tilemap: percorre o mapa e guarda o que cai em area
+void addFloorTiles(IsoRenderer& iso, const std::vector<int>& map, const Rect2D& area) {
+    float ds = 1.0f / TILE_TYPES;
+    for (int row = 0; row < MAP_SIZE; ++row) {
+        for (int col = 0; col < MAP_SIZE; ++col) {
+            glm::vec2 center((col - row) * (TILE_WIDTH / 2.0f), (col + row) * (TILE_HEIGHT / 2.0f));
+            if (!area.intersects(center.x, center.y, TILE_WIDTH / 2.0f, TILE_HEIGHT / 2.0f))
+                continue;
+            IsoItem tile = { center.x, center.y, TILE_WIDTH / 2.0f, TILE_HEIGHT / 2.0f,
+                             map[row * MAP_SIZE + col] * ds, 0.0f, ds, 1.0f, 0, isoKey(0, (float)(row + col), 0) };
+            iso.add(tile);
+        }
+    }
+}
+
+void drawDirect(IsoRenderer& iso, const std::vector<int>& map, const Camera2D& camera) {
+    glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    iso.clear();
+    addFloorTiles(iso, map, camera.viewRect());
+    iso.draw(camera.projection() * camera.view());
+}
+
+void drawCached(LayerCache& cache, IsoRenderer& iso, const std::vector<int>& map, const Camera2D& camera,
+                uint64_t version) {
+    int regions = cache.update(camera, version);
+    for (int i = 0; i < regions; ++i) {
+        glm::mat4 viewProjection;
+        Rect2D area = cache.beginRegion(i, viewProjection);
+        iso.clear();
+        addFloorTiles(iso, map, area);
+        iso.draw(viewProjection);
+    }
+    cache.endRegions();
+    glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    cache.draw();
+}
+
+std::vector<unsigned char> readImage() {
+    std::vector<unsigned char> image((size_t)WIDTH * HEIGHT * 4);
+    glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, image.data());
+    return image;
+}
+
+int maxDifference(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b) {
+    int worst = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        int d = abs((int)a[i] - (int)b[i]);
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+int main() {
+    if (!glfwInit()) {
+        std::cerr << "Falha ao inicializar GLFW\n";
+        return -1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "benchLayerCache", NULL, NULL);
+    if (!window) {
+        std::cerr << "Falha ao criar contexto GLFW\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Falha ao inicializar GLAD\n";
+        return -1;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << "\n";
+
+    // destino: FBO do tamanho da tela com profundidade (o IsoRenderer usa depth test)
+    GLuint fbo, color, depth;
+    glGenFramebuffers(1, &fbo);
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WIDTH, HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glGenRenderbuffers(1, &depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, WIDTH, HEIGHT);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth);
+    glViewport(0, 0, WIDTH, HEIGHT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    IsoRenderer iso;
+    LayerCache cache;
+    if (!iso.init() || !cache.init()) return -1;
+    GLuint tileset = createTileset();
+    iso.addTexture(tileset);
+
+    std::vector<int> map((size_t)MAP_SIZE * MAP_SIZE);
+    srand(7);
+    for (int& t : map) t = rand() % TILE_TYPES;
+
+    // 32 pixels por unidade: o tile de 2 x 1 unidades ocupa 64 x 32 pixels
+    Camera2D camera;
+    camera.pixelsPerUnit = 32.0f;
+    camera.setViewport(WIDTH, HEIGHT);
+    glm::vec2 start(0.0f, MAP_SIZE * TILE_HEIGHT / 2.0f);
+    glm::vec2 step(2.0f / camera.pixelsPerUnit, 1.0f / camera.pixelsPerUnit);
+
+    printf("%dx%d, mapa %dx%d, camera andando (2, 1) pixels por frame, %d frames\n",
+           WIDTH, HEIGHT, MAP_SIZE, MAP_SIZE, FRAMES);
+
+    // direto
+    camera.position = start;
+    drawDirect(iso, map, camera); // aquece
+    glFinish();
+    auto t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; ++f) {
+        camera.position = start + step * (float)f;
+        drawDirect(iso, map, camera);
+        glFinish();
+    }
+    double directMs = msSince(t0) / FRAMES;
+    printf("%-28s %8.3f ms/frame (%d tiles por frame)\n", "direto", directMs, iso.lastItemCount);
+
+    // cache rolando (o primeiro frame, completo, fica fora da media)
+    camera.position = start;
+    drawCached(cache, iso, map, camera, 0);
+    glFinish();
+    long pixelsBefore = (long)cache.pixelsRedrawn;
+    long hitsBefore = cache.framesWithoutRedraw;
+    t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; ++f) {
+        camera.position = start + step * (float)f;
+        drawCached(cache, iso, map, camera, 0);
+        glFinish();
+    }
+    double scrollMs = msSince(t0) / FRAMES;
+    printf("%-28s %8.3f ms/frame (%ld de %d frames sem redesenhar, %.0f pixels redesenhados por frame)\n",
+           "cache rolando", scrollMs, cache.framesWithoutRedraw - hitsBefore, FRAMES,
+           (double)(cache.pixelsRedrawn - pixelsBefore) / FRAMES);
+
+    // imagem igual a do desenho direto na ultima posicao
+    std::vector<unsigned char> cached = readImage();
+    drawDirect(iso, map, camera);
+    int scrollDifference = maxDifference(cached, readImage());
+
+    // cache parada
+    t0 = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; ++f) {
+        drawCached(cache, iso, map, camera, 0);
+        glFinish();
+    }
+    double staticMs = msSince(t0) / FRAMES;
+    printf("%-28s %8.3f ms/frame (so o blit)\n", "cache parada", staticMs);
+
+    // tile trocado: version nova redesenha tudo
+    map[0] = (map[0] + 1) % TILE_TYPES;
+    t0 = std::chrono::steady_clock::now();
+    drawCached(cache, iso, map, camera, 1);
+    glFinish();
+    printf("%-28s %8.3f ms (redesenho completo)\n", "cache invalidada", msSince(t0));
+
+    printf("diferenca maxima para o desenho direto: %d\n", scrollDifference);
+
+    cache.destroy();
+    iso.destroy();
+    glDeleteTextures(1, &tileset);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    glDeleteRenderbuffers(1, &depth);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,210 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Lighting2D.h"
+
+// Benchmark do Lighting2D, sem janela visivel (headless).
+// Cena 1920x1080 (padrao de tijolos com normal em relevo, desenhado por um
+// shader de tela cheia nos dois alvos) com 1000 luzes pontuais de raio entre
+// 40 e 120 pixels espalhadas pela tela. Compara:
+//   - sem agrupar: um tile do tamanho da tela, cada pixel avalia todas as luzes;
+//   - tiles de 16 e 32 pixels;
+//   - tiles de 16 com a acumulacao em meia resolucao (downscale 2).
+// Mede o frame inteiro (cena + agrupamento + acumulacao + composicao) com
+// glFinish e confere que agrupar nao muda a imagem.
+
+const int WIDTH = 1920;
+const int HEIGHT = 1080;
+const int LIGHTS = 1000;
+const int FRAMES = 10;
+
+const char* sceneVertexSource = R"(
+#version 330 core
+void main()
+{
+    vec2 p = vec2((gl_VertexID & 1) != 0 ? 3.0 : -1.0, (gl_VertexID & 2) != 0 ? 3.0 : -1.0);
+    gl_Position = vec4(p, 0.0, 1.0);
+}
+)";
+
+// tijolos de 64x32 com rejunte afundado: a normal aponta para fora nas bordas
+const char* sceneFragmentSource = R"(
+#version 330 core
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out vec4 NormalColor;
+void main()
+{
+    vec2 p = gl_FragCoord.xy;
+    float row = floor(p.y / 32.0);
+    vec2 q = vec2(mod(p.x + mod(row, 2.0) * 32.0, 64.0), mod(p.y, 32.0));
+    vec2 edge = min(q, vec2(64.0, 32.0) - q);
+    vec2 slope = vec2(edge.x < 4.0 ? (q.x < 32.0 ? -1.0 : 1.0) : 0.0, edge.y < 4.0 ? (q.y < 16.0 ? -1.0 : 1.0) : 0.0);
+    vec3 n = normalize(vec3(slope * 0.7, 1.0));
+    FragColor = vec4(vec3(0.75, 0.45, 0.35) * (0.8 + 0.2 * fract(row * 0.37)), 1.0);
+    NormalColor = vec4(n * 0.5 + 0.5, 1.0);
+}
+)";
+
+GLuint createSceneProgram() {
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vs, 1, &sceneVertexSource, NULL);
+    glCompileShader(vs);
+    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fs, 1, &sceneFragmentSource, NULL);
+    glCompileShader(fs);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cerr << "Erro ao linkar shader da cena: " << infoLog << std::endl;
+        return 0;
+    }
+    return program;
+}
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+float randomRange(float a, float b) {
+    return a + (b - a) * (rand() / (float)RAND_MAX);
+}
+
+struct Result {
+    double frameMs;
+    std::vector<unsigned char> image;
+};
+
+Result run(Lighting2D& lighting, GLuint sceneProgram, GLuint sceneVAO, const glm::mat4& projection, int frames) {
+    Result result;
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; ++f) {
+        lighting.beginScene(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        glUseProgram(sceneProgram);
+        glBindVertexArray(sceneVAO);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+        lighting.endScene(projection);
+        glFinish();
+    }
+    result.frameMs = msSince(start) / frames;
+    result.image.resize((size_t)WIDTH * HEIGHT * 4);
+    glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, result.image.data());
+    return result;
+}
+
+int maxDifference(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b) {
+    int worst = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        int d = abs((int)a[i] - (int)b[i]);
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+int main() {
+    if (!glfwInit()) {
+        std::cerr << "Falha ao inicializar GLFW\n";
+        return -1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "benchLighting2D", NULL, NULL);
+    if (!window) {
+        std::cerr << "Falha ao criar contexto GLFW\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Falha ao inicializar GLAD\n";
+        return -1;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << "\n";
+
+    // destino final: um FBO do tamanho da cena
+    GLuint fbo, color;
+    glGenFramebuffers(1, &fbo);
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WIDTH, HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+
+    GLuint sceneProgram = createSceneProgram();
+    if (!sceneProgram) return -1;
+    GLuint sceneVAO;
+    glGenVertexArrays(1, &sceneVAO);
+
+    // mundo em pixels
+    glm::mat4 projection = glm::ortho(0.0f, (float)WIDTH, 0.0f, (float)HEIGHT, -1.0f, 1.0f);
+
+    Lighting2D lighting;
+    if (!lighting.init(WIDTH, HEIGHT)) return -1;
+    lighting.ambient = glm::vec3(0.1f);
+    srand(3);
+    for (int i = 0; i < LIGHTS; ++i) {
+        Light2D light;
+        light.position = glm::vec2(randomRange(0.0f, (float)WIDTH), randomRange(0.0f, (float)HEIGHT));
+        light.radius = randomRange(40.0f, 120.0f);
+        light.color = glm::vec3(randomRange(0.2f, 1.0f), randomRange(0.2f, 1.0f), randomRange(0.2f, 1.0f)) * 0.6f;
+        light.height = 30.0f;
+        lighting.lights.push_back(light);
+    }
+
+    printf("%dx%d, %d luzes (raio 40 a 120 px)\n", WIDTH, HEIGHT, LIGHTS);
+
+    struct Config {
+        const char* name;
+        int tileSize, downscale, frames;
+    };
+    const Config configs[] = {
+        { "sem agrupar (todas as luzes em todo pixel)", WIDTH, 1, 1 },
+        { "tiles de 32", 32, 1, FRAMES },
+        { "tiles de 16", 16, 1, FRAMES },
+        { "tiles de 16, luz em meia resolucao", 16, 2, FRAMES },
+    };
+    std::vector<unsigned char> reference;
+    for (const Config& c : configs) {
+        lighting.tileSize = c.tileSize;
+        lighting.downscale = c.downscale;
+        lighting.resize(WIDTH, HEIGHT);
+        run(lighting, sceneProgram, sceneVAO, projection, 1); // aquece
+        Result r = run(lighting, sceneProgram, sceneVAO, projection, c.frames);
+        if (reference.empty()) reference = r.image;
+        printf("%-44s %8.2f ms/frame, agrupar %.3f ms, %zu pares luz-tile (media %.1f e maximo %d por tile), "
+               "diferenca maxima %d\n",
+               c.name, r.frameMs, lighting.binMs, lighting.lightTilePairs,
+               (double)lighting.lightTilePairs / (((WIDTH + c.tileSize - 1) / c.tileSize) * ((HEIGHT + c.tileSize - 1) / c.tileSize)),
+               lighting.maxLightsPerTile, maxDifference(reference, r.image));
+    }
+
+    lighting.destroy();
+    glDeleteProgram(sceneProgram);
+    glDeleteVertexArrays(1, &sceneVAO);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+
+#include "MapGenerator.h"
+#include "ParallelFor.h"
+
+// Benchmark do MapGenerator (so CPU, sem janela).
+// 1) mapa inteiro com o ruido escalar e com SSE2, com 1 thread e com todas;
+//    o resultado tem que ser igual nos quatro casos (nao depende de threads);
+// 2) confere as vizinhancas no mapa todo, separando as que cruzam a emenda
+//    entre chunks das de dentro do chunk;
+// 3) streaming: quanto tempo ate o primeiro chunk e o chunk do foco ficarem
+//    prontos, com a geracao numa thread.
+// Opcionalmente grava uma previa com um pixel por tile (PPM).
+//
+// benchMapGen [tamanho] [previa.ppm]   (padrao 4096)
+
+typedef std::chrono::steady_clock Clock;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+const char* TILE_NAMES[] = { "areia", "grama", "pedra", "lava", "gelo", "agua funda", "flores" };
+const unsigned char TILE_COLORS[][3] = {
+    { 230, 220, 170 }, { 90, 150, 60 }, { 80, 75, 75 }, { 240, 120, 20 },
+    { 170, 210, 240 }, { 40, 80, 180 }, { 240, 140, 180 }
+};
+
+bool writePreview(const MapGenerator& gen, const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        std::cerr << "nao abriu " << path << std::endl;
+        return false;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", gen.width, gen.height);
+    std::vector<unsigned char> row(gen.width * 3);
+    for (int y = 0; y < gen.height; ++y) {
+        for (int x = 0; x < gen.width; ++x) {
+            size_t cell = (size_t)y * gen.width + x;
+            for (int k = 0; k < 3; ++k) {
+                int c = TILE_COLORS[gen.floor[cell]][k];
+                row[x * 3 + k] = (unsigned char)(gen.wall[cell] >= 0 ? c / 2 : c); // parede mais escura
+            }
+        }
+        fwrite(row.data(), 1, row.size(), f);
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int size = argc > 1 ? atoi(argv[1]) : 4096;
+    if (size < 64) {
+        std::cerr << "uso: benchMapGen [tamanho >= 64] [previa.ppm]\n";
+        return -1;
+    }
+    int cores = defaultThreadCount();
+    printf("mapa %dx%d, chunks de 64, SSE2: %s, %d threads\n\n", size, size, mapGeneratorHasSimd() ? "sim" : "nao", cores);
+
+    // 1) tempos; o primeiro caso fica como referencia
+    MapGenerator gen;
+    gen.width = gen.height = size;
+    gen.rules = isoTerrainRules();
+    std::vector<uint8_t> reference;
+    struct Case { const char* name; bool simd; int threads; };
+    const Case cases[] = {
+        { "escalar, 1 thread", false, 1 },
+        { "SSE2,    1 thread", true, 1 },
+        { "SSE2,    todas   ", true, 0 },
+        { "SSE2,    4 threads", true, 4 },
+    };
+    for (const Case& c : cases) {
+        gen.simd = c.simd;
+        gen.threadCount = c.threads;
+        if (!gen.generate())
+            return -1;
+        bool same = reference.empty() || gen.floor == reference;
+        if (reference.empty())
+            reference = gen.floor;
+        int chunks = gen.chunksX() * gen.chunksY();
+        printf("  %-18s %8.1f ms  (%.3f ms/chunk)  conflitos %ld  %s\n", c.name, gen.elapsedMs,
+               gen.elapsedMs / chunks, gen.conflicts.load(), same ? "igual" : "DIFERENTE");
+    }
+
+    // 2) vizinhancas e contagem dos tiles
+    long inside = 0, insideBad = 0, seams = 0, seamBad = 0, solid = 0;
+    std::vector<long> histogram(gen.rules.tileCount, 0);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            size_t cell = (size_t)y * size + x;
+            histogram[gen.floor[cell]]++;
+            solid += gen.solid[cell];
+            const int nx[] = { x + 1, x }, ny[] = { y, y + 1 };
+            for (int k = 0; k < 2; ++k) {
+                if (nx[k] >= size || ny[k] >= size)
+                    continue;
+                bool ok = (gen.rules.compatible[gen.floor[cell]] >> gen.floor[(size_t)ny[k] * size + nx[k]]) & 1;
+                bool seam = (k == 0 && nx[k] % gen.chunkSize == 0) || (k == 1 && ny[k] % gen.chunkSize == 0);
+                if (seam) {
+                    seams++;
+                    seamBad += !ok;
+                } else {
+                    inside++;
+                    insideBad += !ok;
+                }
+            }
+        }
+    }
+    printf("\nvizinhancas fora das regras: %ld de %ld dentro dos chunks, %ld de %ld na emenda\n",
+           insideBad, inside, seamBad, seams);
+    printf("tiles:");
+    for (int t = 0; t < gen.rules.tileCount; ++t)
+        printf(" %s %.1f%%", TILE_NAMES[t], 100.0 * histogram[t] / ((double)size * size));
+    printf("\nbloqueadas: %.1f%%\n", 100.0 * solid / ((double)size * size));
+
+    if (argc > 2 && writePreview(gen, argv[2]))
+        printf("previa em %s\n", argv[2]);
+
+    // 3) streaming com foco no centro
+    gen.threadCount = 0;
+    std::vector<int> chunks;
+    int focusChunk = (size / 2 / gen.chunkSize) * gen.chunksX() + size / 2 / gen.chunkSize;
+    double firstMs = -1.0, focusMs = -1.0;
+    auto start = Clock::now();
+    if (!gen.start(size / 2, size / 2))
+        return -1;
+    for (;;) {
+        // finished antes do collect: o que ficou pronto antes do fim ja esta na fila
+        bool finished = gen.finished();
+        if (gen.collect(chunks) == 0) {
+            if (finished)
+                break;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            continue;
+        }
+        if (firstMs < 0.0)
+            firstMs = msSince(start);
+        for (int c : chunks)
+            if (c == focusChunk && focusMs < 0.0)
+                focusMs = msSince(start);
+        chunks.clear();
+    }
+    gen.stop();
+    printf("\nstreaming: primeiro chunk em %.2f ms, chunk do foco em %.2f ms, tudo em %.1f ms\n",
+           firstMs, focusMs, msSince(start));
+    return 0;
+}
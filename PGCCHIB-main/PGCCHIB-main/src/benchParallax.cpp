@@ -0,0 +1,248 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+#include "ParallaxRenderer.h"
+
+// Benchmark de fill-rate do parallax, sem janela visivel (headless).
+// Compara o caminho antigo (5 quads de tela cheia com blending, um por camada)
+// com o ParallaxRenderer (uma passada so) renderizando em um FBO de 1080p e 4K.
+// As camadas sao geradas proceduralmente com o mesmo tamanho das do
+// Cartoon_Forest_BG_04 (1920x1080): ceu opaco e 4 camadas com recortes alfa.
+
+const int LAYER_WIDTH = 1920;
+const int LAYER_HEIGHT = 1080;
+const int NUM_LAYERS = 5;
+const int FRAMES = 60;
+
+// shader do caminho antigo (igual ao de parallaxScrolling.cpp)
+const char* legacyVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+out vec2 TexCoord;
+uniform float offset;
+void main()
+{
+    gl_Position = vec4(aPos, 0.0, 1.0);
+    TexCoord = vec2(aTexCoord.x + offset, aTexCoord.y);
+}
+)";
+
+const char* legacyFragmentSource = R"(
+#version 330 core
+out vec4 FragColor;
+in vec2 TexCoord;
+uniform sampler2D texture1;
+void main()
+{
+    FragColor = texture(texture1, TexCoord);
+}
+)";
+
+GLuint buildProgram(const char* vs, const char* fs) {
+    GLuint v = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(v, 1, &vs, NULL);
+    glCompileShader(v);
+    GLuint f = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(f, 1, &fs, NULL);
+    glCompileShader(f);
+    GLuint p = glCreateProgram();
+    glAttachShader(p, v);
+    glAttachShader(p, f);
+    glLinkProgram(p);
+    glDeleteShader(v);
+    glDeleteShader(f);
+    return p;
+}
+
+// camada 0 eh opaca; as outras tem um "morro" que ocupa uma faixa cada vez mais baixa
+void generateLayer(int layer, std::vector<unsigned char>& pixels) {
+    pixels.resize(LAYER_WIDTH * LAYER_HEIGHT * 4);
+    for (int y = 0; y < LAYER_HEIGHT; ++y) {
+        for (int x = 0; x < LAYER_WIDTH; ++x) {
+            unsigned char* p = &pixels[(y * LAYER_WIDTH + x) * 4];
+            float fx = (float)x / LAYER_WIDTH;
+            float fy = (float)y / LAYER_HEIGHT;
+            if (layer == 0) {
+                p[0] = 120; p[1] = (unsigned char)(180 + 60 * fy); p[2] = 255; p[3] = 255;
+                continue;
+            }
+            float hill = 0.6f - 0.12f * layer + 0.08f * sinf(fx * 6.2831f * (layer + 1));
+            bool inside = fy < hill;
+            p[0] = (unsigned char)(40 * layer);
+            p[1] = (unsigned char)(100 + 25 * layer);
+            p[2] = 60;
+            p[3] = inside ? 255 : 0;
+        }
+    }
+}
+
+struct Target {
+    GLuint fbo, color;
+};
+
+Target createTarget(int w, int h) {
+    Target t;
+    glGenFramebuffers(1, &t.fbo);
+    glGenTextures(1, &t.color);
+    glBindTexture(GL_TEXTURE_2D, t.color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, t.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, t.color, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "FBO incompleto " << w << "x" << h << std::endl;
+    return t;
+}
+
+void destroyTarget(Target& t) {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &t.fbo);
+    glDeleteTextures(1, &t.color);
+}
+
+// mede o tempo de FRAMES frames (com glFinish no final), retorna ms por frame.
+// tempo de parede em vez de timer query: alguns drivers (llvmpipe) so
+// rasterizam no flush e a query nao enxerga esse trabalho
+template <typename DrawFn>
+double timeFrames(DrawFn draw) {
+    draw(0); // aquecimento
+    glFinish();
+
+    double start = glfwGetTime();
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        draw(frame);
+        glFlush();
+    }
+    glFinish();
+    return (glfwGetTime() - start) * 1000.0 / FRAMES;
+}
+
+int main() {
+    if (!glfwInit()) {
+        std::cerr << "Falha ao inicializar GLFW\n";
+        return -1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "benchParallax", NULL, NULL);
+    if (!window) {
+        std::cerr << "Falha ao criar contexto GLFW\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Falha ao inicializar GLAD\n";
+        return -1;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << "\n";
+
+    // mesmas camadas para os dois caminhos
+    ParallaxRenderer parallax;
+    parallax.init(LAYER_WIDTH, LAYER_HEIGHT, NUM_LAYERS);
+    parallax.backgroundColor[0] = 0.2f;
+    parallax.backgroundColor[1] = 0.3f;
+    parallax.backgroundColor[2] = 0.3f;
+
+    GLuint legacyTextures[NUM_LAYERS];
+    glGenTextures(NUM_LAYERS, legacyTextures);
+
+    std::vector<unsigned char> pixels;
+    for (int i = 0; i < NUM_LAYERS; ++i) {
+        generateLayer(i, pixels);
+        parallax.setLayer(i, pixels.data());
+
+        glBindTexture(GL_TEXTURE_2D, legacyTextures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, LAYER_WIDTH, LAYER_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    GLuint legacyProgram = buildProgram(legacyVertexSource, legacyFragmentSource);
+    GLint legacyOffsetLoc = glGetUniformLocation(legacyProgram, "offset");
+    glUseProgram(legacyProgram);
+    glUniform1i(glGetUniformLocation(legacyProgram, "texture1"), 0);
+
+    // o VAO do renderer tem o mesmo layout (pos, texcoord) e serve para os dois
+    GLuint quadVAO = parallax.VAO;
+
+    const float speeds[NUM_LAYERS] = {0.07f, 0.15f, 0.25f, 0.35f, 0.5f};
+
+    const int resolutions[2][2] = {{1920, 1080}, {3840, 2160}};
+    for (int r = 0; r < 2; ++r) {
+        int w = resolutions[r][0], h = resolutions[r][1];
+        Target target = createTarget(w, h);
+        glViewport(0, 0, w, h);
+
+        auto drawLegacy = [&](int frame) {
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glUseProgram(legacyProgram);
+            glBindVertexArray(quadVAO);
+            glActiveTexture(GL_TEXTURE0);
+            for (int i = 0; i < NUM_LAYERS; ++i) {
+                glBindTexture(GL_TEXTURE_2D, legacyTextures[i]);
+                glUniform1f(legacyOffsetLoc, frame * speeds[i] * 0.01f);
+                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+            }
+            glDisable(GL_BLEND);
+        };
+
+        auto drawSinglePass = [&](int frame) {
+            for (int i = 0; i < NUM_LAYERS; ++i)
+                parallax.offsets[i] = frame * speeds[i] * 0.01f;
+            parallax.draw(1.0f);
+        };
+
+        double legacyMs = timeFrames(drawLegacy);
+        double singlePassMs = timeFrames(drawSinglePass);
+
+        // confere que os dois caminhos geram a mesma imagem (frame 0)
+        std::vector<unsigned char> legacyImage(w * h * 4), singlePassImage(w * h * 4);
+        drawLegacy(0);
+        glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, legacyImage.data());
+        drawSinglePass(0);
+        glReadPixels(0, 0, w, h, GL_RGBA, GL_UNSIGNED_BYTE, singlePassImage.data());
+        // pixels na borda dos recortes podem variar por arredondamento da coordenada
+        int differentPixels = 0;
+        for (size_t i = 0; i < legacyImage.size(); i += 4) {
+            int diff = 0;
+            for (int c = 0; c < 3; ++c)
+                diff = std::max(diff, std::abs((int)legacyImage[i + c] - (int)singlePassImage[i + c]));
+            if (diff > 2) differentPixels++;
+        }
+
+        double mpix = (double)w * h / 1.0e6;
+        printf("%dx%d  legado (5 passadas): %7.3f ms/frame  %8.1f Mpix/s efetivos\n",
+               w, h, legacyMs, mpix / (legacyMs / 1000.0));
+        printf("%dx%d  passada unica      : %7.3f ms/frame  %8.1f Mpix/s efetivos  (%.2fx)\n",
+               w, h, singlePassMs, mpix / (singlePassMs / 1000.0), legacyMs / singlePassMs);
+        printf("%dx%d  pixels diferentes entre os dois caminhos: %d (%.4f%%)\n",
+               w, h, differentPixels, 100.0 * differentPixels / (w * h));
+
+        destroyTarget(target);
+    }
+
+    glDeleteTextures(NUM_LAYERS, legacyTextures);
+    glDeleteProgram(legacyProgram);
+    parallax.destroy();
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
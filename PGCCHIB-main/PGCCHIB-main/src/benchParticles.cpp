@@ -0,0 +1,194 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "ParticleSystem.h"
+#include "ParallelFor.h"
+
+// Benchmark do ParticleSystem, sem janela visivel (headless).
+// Para 100k e 1M particulas mede:
+//   - a atualizacao na CPU: escalar, SSE em 1 thread e SSE em todas as threads
+//     (esta ultima pelo ParticleSystem, incluindo o upload para a GPU);
+//   - a atualizacao na GPU por transform feedback;
+//   - o desenho (um glDrawArrays de point sprites em um FBO de 1280x720).
+// Confere tambem que escalar e SSE dao o mesmo resultado e quanto a GPU se
+// afasta da CPU depois de alguns passos (o float da GPU pode arredondar diferente).
+// A folha de animacao eh gerada aqui (6 frames de uma bola de fumaca).
+
+const int WIDTH = 1280;
+const int HEIGHT = 720;
+const int FRAMES = 60;
+const int CHECK_STEPS = 120;
+const float DT = 1.0f / 60.0f;
+
+GLuint createSheet() {
+    const int frameSize = 48, frames = 6;
+    std::vector<unsigned char> pixels(frameSize * frames * frameSize * 4);
+    for (int y = 0; y < frameSize; ++y)
+        for (int x = 0; x < frameSize * frames; ++x) {
+            int f = x / frameSize;
+            float dx = (x % frameSize - 23.5f) / 24.0f, dy = (y - 23.5f) / 24.0f;
+            float r = std::sqrt(dx * dx + dy * dy) * (1.0f + 0.1f * f);
+            unsigned char* p = &pixels[(y * frameSize * frames + x) * 4];
+            p[0] = p[1] = p[2] = (unsigned char)(120 + 15 * f);
+            p[3] = (unsigned char)(std::max(0.0f, 1.0f - r) * 255.0f);
+        }
+
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, frameSize * frames, frameSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return texture;
+}
+
+// fumaca subindo do centro de baixo da tela (mundo em pixels)
+ParticleEmitter smokeEmitter() {
+    ParticleEmitter e;
+    e.position = glm::vec2(WIDTH * 0.5f, 60.0f);
+    e.radius = 40.0f;
+    e.velocity = glm::vec2(10.0f, 120.0f);
+    e.velocitySpread = glm::vec2(60.0f, 40.0f);
+    e.acceleration = glm::vec2(15.0f, 30.0f);
+    e.drag = 0.3f;
+    e.minLife = 2.0f;
+    e.maxLife = 4.0f;
+    return e;
+}
+
+template <typename Fn>
+double cpuMs(int steps, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / steps;
+}
+
+// tempo de parede com glFinish (o llvmpipe so trabalha de verdade no flush)
+template <typename Fn>
+double gpuMs(int steps, Fn fn) {
+    fn();
+    glFinish();
+    double start = glfwGetTime();
+    for (int s = 0; s < steps; ++s) {
+        fn();
+        glFlush();
+    }
+    glFinish();
+    return (glfwGetTime() - start) * 1000.0 / steps;
+}
+
+float maxPositionDiff(const ParticlePool& a, const ParticlePool& b) {
+    float diff = 0.0f;
+    for (size_t i = 0; i < a.count; ++i)
+        diff = std::max(diff, std::max(std::fabs(a.x[i] - b.x[i]), std::fabs(a.y[i] - b.y[i])));
+    return diff;
+}
+
+int main() {
+    if (!glfwInit()) {
+        std::cerr << "Falha ao inicializar GLFW\n";
+        return -1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "benchParticles", NULL, NULL);
+    if (!window) {
+        std::cerr << "Falha ao criar contexto GLFW\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Falha ao inicializar GLAD\n";
+        return -1;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << "\n";
+    printf("SSE2: %s, %d threads\n", particlesHaveSimd() ? "sim" : "nao", defaultThreadCount());
+
+    GLuint fbo, color;
+    glGenFramebuffers(1, &fbo);
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WIDTH, HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glViewport(0, 0, WIDTH, HEIGHT);
+
+    ParticleSheet sheet;
+    sheet.texture = createSheet();
+    sheet.frames = 6;
+
+    glm::mat4 viewProjection = glm::ortho(0.0f, (float)WIDTH, 0.0f, (float)HEIGHT, -1.0f, 1.0f);
+    ParticleEmitter emitter = smokeEmitter();
+
+    const size_t counts[2] = { 100000, 1000000 };
+    for (size_t n : counts) {
+        printf("\n%zu particulas\n", n);
+
+        // CPU sem GL: escalar x SSE na mesma thread, partindo do mesmo estado
+        ParticlePool scalar, simd;
+        scalar.init(n, emitter);
+        simd.init(n, emitter);
+        double scalarMs = cpuMs(FRAMES, [&]() { updateParticlesScalar(scalar, 0, scalar.count, emitter, DT); });
+        double simdMs = cpuMs(FRAMES, [&]() { updateParticlesSimd(simd, 0, simd.count, emitter, DT); });
+        bool same = maxPositionDiff(scalar, simd) == 0.0f;
+        printf("  cpu escalar 1 thread      %8.3f ms/passo\n", scalarMs);
+        printf("  cpu sse 1 thread          %8.3f ms/passo (%.2fx)  %s\n", simdMs, scalarMs / simdMs,
+               same ? "igual ao escalar" : "DIFERENTE DO ESCALAR");
+
+        ParticleSystem cpu, gpu;
+        cpu.emitter = gpu.emitter = emitter;
+        cpu.sheet = gpu.sheet = sheet;
+        cpu.size = gpu.size = 12.0f;
+        cpu.init(n, PARTICLES_CPU);
+        gpu.init(n, PARTICLES_GPU);
+
+        // mesmo numero de passos nos dois backends antes de comparar
+        for (int s = 0; s < CHECK_STEPS; ++s) {
+            cpu.update(DT);
+            gpu.update(DT);
+        }
+        ParticlePool fromCpu, fromGpu;
+        cpu.download(fromCpu);
+        gpu.download(fromGpu);
+        float gpuDiff = maxPositionDiff(fromCpu, fromGpu);
+
+        double cpuUpdateMs = gpuMs(FRAMES, [&]() { cpu.update(DT); });
+        double gpuUpdateMs = gpuMs(FRAMES, [&]() { gpu.update(DT); });
+        printf("  cpu sse %2d threads + upload %6.3f ms/passo\n", defaultThreadCount(), cpuUpdateMs);
+        printf("  gpu transform feedback    %8.3f ms/passo  (diferenca para a cpu apos %d passos: %.4f px)\n",
+               gpuUpdateMs, CHECK_STEPS, gpuDiff);
+
+        auto drawWith = [&](ParticleSystem& ps) {
+            return gpuMs(FRAMES, [&]() {
+                glClearColor(0.4f, 0.6f, 0.8f, 1.0f);
+                glClear(GL_COLOR_BUFFER_BIT);
+                ps.draw(viewProjection, 1.0f);
+            });
+        };
+        printf("  desenho cpu / gpu         %8.3f / %.3f ms/frame\n", drawWith(cpu), drawWith(gpu));
+
+        cpu.destroy();
+        gpu.destroy();
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    glDeleteTextures(1, &sheet.texture);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,278 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include "Pathfinding.h"
+
+// Benchmark do Pathfinding (so CPU, sem janela).
+// Mapa de salas com portas e blocos soltos. Mede:
+// 1) A* comum x JPS x HPA* (busca abstrata + refinamento) nos mesmos pares,
+//    conferindo que o JPS acha o mesmo custo do A* e quanto o HPA* perde;
+// 2) refazer a hierarquia depois de trocar um tile (so os clusters tocados)
+//    contra montar tudo de novo;
+// 3) montar um flow field e andar uma multidao por ele; refazer o campo em
+//    fatias dentro do orcamento do PathScheduler; o campo so numa janela;
+// 4) milhares de agentes pedindo caminho no mesmo frame, com e sem o
+//    orcamento do PathScheduler: pior frame e quantos frames ate acabar; e com
+//    a busca dos trechos so no retangulo de cada um.
+//
+// benchPathfinding [tamanho] [consultas] [agentes]   (padrao 1024, 100 e 1000)
+
+typedef std::chrono::steady_clock Clock;
+
+double msSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void buildMap(TileCollisionMap& map, int size, std::mt19937& rng) {
+    map.init(size, size);
+    std::uniform_int_distribution<int> coord(0, size - 1);
+    std::uniform_int_distribution<int> roomSize(8, 40);
+
+    // salas: contorno de parede com uma porta de 2 tiles em cada lado
+    for (int i = 0; i < size * size / 1500; ++i) {
+        int x0 = coord(rng), y0 = coord(rng);
+        int w = roomSize(rng), h = roomSize(rng);
+        for (int x = x0; x < x0 + w; ++x) {
+            map.set(x, y0, TILE_SOLID);
+            map.set(x, y0 + h - 1, TILE_SOLID);
+        }
+        for (int y = y0; y < y0 + h; ++y) {
+            map.set(x0, y, TILE_SOLID);
+            map.set(x0 + w - 1, y, TILE_SOLID);
+        }
+        for (int d = 0; d < 2; ++d) {
+            map.set(x0 + w / 2 + d, y0, TILE_EMPTY);
+            map.set(x0 + w / 2 + d, y0 + h - 1, TILE_EMPTY);
+            map.set(x0, y0 + h / 2 + d, TILE_EMPTY);
+            map.set(x0 + w - 1, y0 + h / 2 + d, TILE_EMPTY);
+        }
+    }
+
+    // blocos soltos
+    for (int i = 0; i < size * size / 20; ++i)
+        map.set(coord(rng), coord(rng), TILE_SOLID);
+}
+
+PathPoint randomFree(const TileCollisionMap& map, std::mt19937& rng) {
+    std::uniform_int_distribution<int> x(0, map.width - 1), y(0, map.height - 1);
+    for (;;) {
+        PathPoint p = { x(rng), y(rng) };
+        if (map.get(p.x, p.y) == TILE_EMPTY) return p;
+    }
+}
+
+double pathCost(const std::vector<PathPoint>& path) {
+    double cost = 0.0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        int dx = std::abs(path[i].x - path[i - 1].x), dy = std::abs(path[i].y - path[i - 1].y);
+        cost += std::max(dx, dy) - std::min(dx, dy) + std::min(dx, dy) * std::sqrt(2.0);
+    }
+    return cost;
+}
+
+// caminho refinado pela hierarquia: um GridSearch por trecho
+bool hierarchicalPath(const TileCollisionMap& map, PathHierarchy& hierarchy, GridSearch& search,
+                      PathPoint start, PathPoint goal, std::vector<PathPoint>& path) {
+    static std::vector<PathPoint> waypoints, leg;
+    path.clear();
+    if (!hierarchy.findPath(start, goal, waypoints)) return false;
+    path.push_back(start);
+    for (size_t i = 0; i + 1 < waypoints.size(); ++i) {
+        if (!search.findPath(map, waypoints[i], waypoints[i + 1], leg)) return false;
+        path.insert(path.end(), leg.begin() + 1, leg.end());
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int size = argc > 1 ? atoi(argv[1]) : 1024;
+    int queries = argc > 2 ? atoi(argv[2]) : 100;
+    int agents = argc > 3 ? atoi(argv[3]) : 1000;
+    if (size < 64 || queries <= 0 || agents <= 0) {
+        std::cerr << "uso: benchPathfinding [tamanho >= 64] [consultas] [agentes]\n";
+        return -1;
+    }
+
+    std::mt19937 rng(42);
+    TileCollisionMap map;
+    buildMap(map, size, rng);
+
+    auto start = Clock::now();
+    PathHierarchy hierarchy;
+    hierarchy.build(map, 16);
+    double buildMs = msSince(start);
+    printf("mapa %dx%d, hierarquia: %zu entradas em %d clusters, montada em %.1f ms\n",
+           size, size, hierarchy.nodeCount(), hierarchy.clustersX * hierarchy.clustersY, buildMs);
+
+    // 1) consultas
+    GridSearch astar, jps;
+    astar.jump = false;
+    std::vector<PathPoint> path;
+    double msAstar = 0, msJps = 0, msHpa = 0, costAstar = 0, costHpa = 0;
+    long expAstar = 0, expJps = 0, expHpa = 0;
+    int found = 0, mismatches = 0, hpaFailures = 0;
+    for (int q = 0; q < queries; ++q) {
+        PathPoint a = randomFree(map, rng), b = randomFree(map, rng);
+
+        start = Clock::now();
+        bool ok = astar.findPath(map, a, b, path);
+        msAstar += msSince(start);
+        if (!ok) continue; // sem caminho: fica fora da media
+        found++;
+        expAstar += astar.expanded;
+        double optimal = pathCost(path);
+        costAstar += optimal;
+
+        start = Clock::now();
+        ok = jps.findPath(map, a, b, path);
+        msJps += msSince(start);
+        expJps += jps.expanded;
+        if (!ok || std::fabs(pathCost(path) - optimal) > 1e-3) mismatches++;
+
+        start = Clock::now();
+        ok = hierarchicalPath(map, hierarchy, jps, a, b, path);
+        msHpa += msSince(start);
+        expHpa += hierarchy.expanded;
+        if (ok) costHpa += pathCost(path);
+        else hpaFailures++;
+    }
+    printf("\n%d consultas com caminho (custo medio %.1f)\n", found, costAstar / found);
+    printf("  A*   %8.3f ms/consulta %9.0f nos\n", msAstar / found, (double)expAstar / found);
+    printf("  JPS  %8.3f ms/consulta %9.0f nos   custo diferente do A*: %d\n", msJps / found, (double)expJps / found, mismatches);
+    printf("  HPA* %8.3f ms/consulta %9.0f nos abstratos, caminho %.1f%% mais longo, falhas %d\n",
+           msHpa / found, (double)expHpa / found, 100.0 * (costHpa / costAstar - 1.0), hpaFailures);
+
+    // 2) troca de tiles
+    const int CHANGES = 200;
+    start = Clock::now();
+    for (int i = 0; i < CHANGES; ++i) {
+        PathPoint p = randomFree(map, rng);
+        map.set(p.x, p.y, TILE_SOLID);
+        hierarchy.tileChanged(p.x, p.y);
+        hierarchy.update();
+    }
+    double incrementalMs = msSince(start) / CHANGES;
+    printf("\ntroca de tile: %.3f ms refazendo %.1f clusters (montar tudo: %.1f ms)\n",
+           incrementalMs, (double)hierarchy.rebuilds / CHANGES, buildMs);
+
+    // 3) flow field
+    // o objetivo eh sorteado ate cair na regiao principal (nao numa sala fechada
+    // pelos blocos soltos)
+    FlowField flow;
+    PathPoint goal;
+    double flowMs;
+    size_t reached;
+    do {
+        goal = randomFree(map, rng);
+        start = Clock::now();
+        flow.build(map, goal);
+        flowMs = msSince(start);
+        reached = 0;
+        for (float d : flow.distance) reached += d < 1e29f;
+    } while (reached < flow.distance.size() / 2);
+    std::vector<PathPoint> crowd(agents);
+    for (PathPoint& p : crowd) p = randomFree(map, rng);
+    start = Clock::now();
+    long moves = 0;
+    for (int step = 0; step < 100; ++step) {
+        for (PathPoint& p : crowd) {
+            int dx, dy;
+            if (flow.directionAt(p.x, p.y, dx, dy)) {
+                p.x += dx;
+                p.y += dy;
+                moves++;
+            }
+        }
+    }
+    double crowdMs = msSince(start) / 100;
+    printf("flow field: montado em %.1f ms; %d agentes lendo a direcao: %.3f ms por passo (%ld movimentos)\n",
+           flowMs, agents, crowdMs, moves);
+
+    // o mesmo campo refeito aos poucos pelo PathScheduler (objetivo novo, como
+    // quando o personagem muda de celula): o antigo vale ate o novo ficar pronto
+    {
+        PathScheduler scheduler;
+        scheduler.budgetMs = 2.0;
+        scheduler.flowFields.push_back(&flow);
+        std::vector<PathResult> none;
+        PathPoint moved = { goal.x + 1, goal.y };
+        if (map.get(moved.x, moved.y) != TILE_EMPTY) moved = { goal.x - 1, goal.y };
+        flow.request(map, moved);
+        int frames = 0;
+        start = Clock::now();
+        while (scheduler.flowPending()) {
+            scheduler.update(map, none);
+            frames++;
+        }
+        double totalMs = msSince(start);
+        FlowField check;
+        check.build(map, moved);
+        printf("flow field em fatias, orcamento %.1f ms: %d frames, pior frame %.2f ms, %.1f ms no total, %s o de uma vez\n",
+               scheduler.budgetMs, frames, scheduler.worstMs, totalMs,
+               check.direction == flow.direction && flow.goal.x == moved.x ? "igual a" : "DIFERENTE d");
+        flow.build(map, goal);
+    }
+
+    // campo so numa janela em volta do objetivo (como a multidao do tilemap):
+    // o custo nao depende do tamanho do mapa
+    {
+        FlowField window;
+        window.radius = 32;
+        start = Clock::now();
+        for (int i = 0; i < 10; ++i)
+            window.build(map, goal);
+        printf("flow field numa janela de %dx%d: montado em %.2f ms\n", window.width, window.height, msSince(start) / 10);
+    }
+
+    // 4) todos pedem caminho no mesmo frame, para o objetivo do flow field e
+    // saindo de lugares que chegam nele (o flow field diz quais)
+    PathPoint target = goal;
+    std::vector<PathPoint> starts(agents);
+    for (PathPoint& p : starts) {
+        int dx, dy;
+        do p = randomFree(map, rng); while (!flow.directionAt(p.x, p.y, dx, dy));
+    }
+    std::vector<PathResult> done;
+
+    // por ultimo, o mesmo com os trechos refinados so no retangulo de cada um
+    // (GridSearch::window): os vetores da busca deixam de ter o tamanho do mapa
+    printf("\n%d agentes pedindo caminho no mesmo frame:\n", agents);
+    const double budgets[] = { 1e9, 2.0, 2.0 };
+    for (int run = 0; run < 3; ++run) {
+        double budget = budgets[run];
+        PathScheduler scheduler;
+        scheduler.hierarchy = &hierarchy;
+        scheduler.budgetMs = budget;
+        if (run == 2)
+            scheduler.search.window = hierarchy.clusterSize;
+        scheduler.search.prepare(map, hierarchy.clusterSize);
+        for (int i = 0; i < agents; ++i)
+            scheduler.request(i, starts[i], target);
+
+        int frames = 0;
+        done.clear();
+        start = Clock::now();
+        while (scheduler.pending() > 0) {
+            scheduler.update(map, done);
+            frames++;
+        }
+        double totalMs = msSince(start);
+        double cost = 0.0;
+        for (const PathResult& result : done)
+            cost += pathCost(result.path);
+        if (budget > 1e6)
+            printf("  sem orcamento: %d frame, %.1f ms no frame\n", frames, scheduler.worstMs);
+        else
+            printf("  orcamento %.1f ms%s: %d frames, pior frame %.2f ms, %.1f ms no total\n",
+                   budget, run == 2 ? ", busca no retangulo do trecho" : "", frames, scheduler.worstMs, totalMs);
+        printf("    %ld caminhos, %ld sem caminho, %ld passos, custo total %.1f, vetores da busca %.1f MB\n",
+               scheduler.completed, scheduler.failed, scheduler.steps, cost,
+               scheduler.search.g.size() * 16.0 / (1024 * 1024));
+    }
+    return 0;
+}
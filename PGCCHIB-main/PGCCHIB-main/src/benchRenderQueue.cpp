@@ -0,0 +1,395 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "RenderQueue.h"
+#include "GLHandles.h"
+
+// Benchmark da RenderQueue, sem janela visivel (headless).
+// Uma cena 2D com 2000 sprites por frame espalhados em 4 camadas (cada uma com
+// 8 planos de profundidade), 3 programas (2 translucidos), 8 texturas e 2
+// meshes, submetidos em ordem aleatoria (como sistemas independentes fariam).
+// Compara:
+//   - um draw por sprite na ordem da chave: glUseProgram + glBindTexture +
+//     glBindVertexArray + uniform model + glDrawElements, como o Sprite::draw
+//     do cenaSprites fazia;
+//   - a fila: radix sort + binds so quando mudam + pacotes vizinhos juntos em
+//     um draw instanciado.
+// Conta trocas de estado e draws por frame, confere que as duas imagens sao
+// iguais e mede o radix sort contra std::stable_sort.
+
+const int WIDTH = 1280;
+const int HEIGHT = 720;
+const int SPRITES = 2000;
+const int FRAMES = 300;
+const int PROGRAMS = 3;
+const int TEXTURES = 8;
+const int MESHES = 2;
+const int LAYERS = 4;
+
+const char* queueVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 iModel;
+layout (location = 3) in vec2 iTranslate;
+layout (location = 4) in vec4 iUvRect;
+uniform mat4 projection;
+out vec2 TexCoord;
+void main() {
+    gl_Position = projection * vec4(mat2(iModel.xy, iModel.zw) * aPos + iTranslate, 0.0, 1.0);
+    TexCoord = mix(iUvRect.xy, iUvRect.zw, aTexCoord);
+}
+)";
+
+// o mesmo desenho com uniforms, um sprite por draw
+const char* uniformVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+uniform mat3x2 model;
+uniform vec4 uvRect;
+uniform mat4 projection;
+out vec2 TexCoord;
+void main() {
+    gl_Position = projection * vec4(model * vec3(aPos, 1.0), 0.0, 1.0);
+    TexCoord = mix(uvRect.xy, uvRect.zw, aTexCoord);
+}
+)";
+
+const char* fragmentSource = R"(
+#version 330 core
+in vec2 TexCoord;
+out vec4 FragColor;
+uniform sampler2D texture1;
+uniform vec4 tint;
+void main() {
+    FragColor = texture(texture1, TexCoord) * tint;
+}
+)";
+
+GLuint compileProgram(const char* vertexSource) {
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER), fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(vs, 1, &vertexSource, NULL);
+    glCompileShader(vs);
+    glShaderSource(fs, 1, &fragmentSource, NULL);
+    glCompileShader(fs);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint ok;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[512];
+        glGetProgramInfoLog(program, 512, NULL, log);
+        std::cerr << "Erro ao linkar shader:\n" << log << std::endl;
+        return 0;
+    }
+    return program;
+}
+
+float randomRange(float lo, float hi) {
+    return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// programas com o mesmo shader e tints diferentes (para a troca aparecer na imagem)
+struct SceneGL {
+    GLuint queuePrograms[PROGRAMS], uniformPrograms[PROGRAMS];
+    GLint modelLoc[PROGRAMS], uvLoc[PROGRAMS];
+    GLuint textures[TEXTURES];
+    GLuint vaos[MESHES], vbos[MESHES], ebo;
+};
+
+bool initScene(SceneGL& gl, const glm::mat4& projection) {
+    const glm::vec4 tints[PROGRAMS] = { glm::vec4(1.0f), glm::vec4(1.0f, 0.6f, 0.6f, 0.8f), glm::vec4(0.6f, 0.6f, 1.0f, 0.6f) };
+    for (int p = 0; p < PROGRAMS; ++p) {
+        gl.queuePrograms[p] = compileProgram(queueVertexSource);
+        gl.uniformPrograms[p] = compileProgram(uniformVertexSource);
+        if (!gl.queuePrograms[p] || !gl.uniformPrograms[p]) return false;
+        GLuint both[2] = { gl.queuePrograms[p], gl.uniformPrograms[p] };
+        for (GLuint program : both) {
+            glUseProgram(program);
+            glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, &projection[0][0]);
+            glUniform4fv(glGetUniformLocation(program, "tint"), 1, &tints[p][0]);
+            glUniform1i(glGetUniformLocation(program, "texture1"), 0);
+        }
+        gl.modelLoc[p] = glGetUniformLocation(gl.uniformPrograms[p], "model");
+        gl.uvLoc[p] = glGetUniformLocation(gl.uniformPrograms[p], "uvRect");
+    }
+
+    // texturas 32x32 xadrez, uma cor por textura
+    glGenTextures(TEXTURES, gl.textures);
+    std::vector<unsigned char> pixels(32 * 32 * 4);
+    for (int t = 0; t < TEXTURES; ++t) {
+        for (int y = 0; y < 32; ++y)
+            for (int x = 0; x < 32; ++x) {
+                unsigned char* px = &pixels[(y * 32 + x) * 4];
+                bool dark = ((x / 8) + (y / 8)) & 1;
+                px[0] = (unsigned char)(dark ? 40 : 80 + t * 20);
+                px[1] = (unsigned char)(dark ? 40 : 240 - t * 25);
+                px[2] = (unsigned char)(dark ? 60 : 60 + t * 24);
+                px[3] = (unsigned char)((x + y) % 5 == 0 ? 0 : 255);
+            }
+        glBindTexture(GL_TEXTURE_2D, gl.textures[t]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 32, 32, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    }
+
+    // dois meshes: quad inteiro e um losango, os dois com 6 indices
+    const float shapes[MESHES][16] = {
+        { -0.5f, -0.5f, 0, 0, 0.5f, -0.5f, 1, 0, 0.5f, 0.5f, 1, 1, -0.5f, 0.5f, 0, 1 },
+        { 0.0f, -0.5f, 0.5f, 0, 0.5f, 0.0f, 1, 0.5f, 0.0f, 0.5f, 0.5f, 1, -0.5f, 0.0f, 0, 0.5f },
+    };
+    const unsigned int indices[6] = { 0, 1, 2, 2, 3, 0 };
+    glGenVertexArrays(MESHES, gl.vaos);
+    glGenBuffers(MESHES, gl.vbos);
+    glGenBuffers(1, &gl.ebo);
+    for (int m = 0; m < MESHES; ++m) {
+        glBindVertexArray(gl.vaos[m]);
+        glBindBuffer(GL_ARRAY_BUFFER, gl.vbos[m]);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(shapes[m]), shapes[m], GL_STATIC_DRAW);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gl.ebo);
+        if (m == 0) glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+    }
+    glBindVertexArray(0);
+    return true;
+}
+
+void destroyScene(SceneGL& gl) {
+    for (int p = 0; p < PROGRAMS; ++p) {
+        glDeleteProgram(gl.queuePrograms[p]);
+        glDeleteProgram(gl.uniformPrograms[p]);
+    }
+    glDeleteTextures(TEXTURES, gl.textures);
+    glDeleteVertexArrays(MESHES, gl.vaos);
+    glDeleteBuffers(MESHES, gl.vbos);
+    glDeleteBuffers(1, &gl.ebo);
+}
+
+// sprite da cena em indices (programa, textura, mesh); o programa da fila e o
+// de uniforms com o mesmo indice desenham igual
+struct SceneSprite {
+    int program, texture, mesh, layer;
+    bool translucent;
+    float depth;
+    Affine2D model;
+    glm::vec4 uvRect;
+};
+
+std::vector<SceneSprite> makeSprites() {
+    std::vector<SceneSprite> sprites(SPRITES);
+    for (SceneSprite& s : sprites) {
+        s.program = rand() % PROGRAMS;
+        s.texture = rand() % TEXTURES;
+        s.mesh = rand() % MESHES;
+        s.layer = rand() % LAYERS;
+        s.translucent = s.program != 0;
+        // profundidade em 8 planos por camada (o que fica na frente do que dentro da camada)
+        s.depth = (float)(rand() % 8) / 7.0f;
+        float size = randomRange(12.0f, 40.0f);
+        s.model = composeAffine(glm::vec2(randomRange(0.0f, (float)WIDTH), randomRange(0.0f, (float)HEIGHT)),
+                                randomRange(-3.0f, 3.0f), glm::vec2(size));
+        float u = randomRange(0.0f, 0.5f), v = randomRange(0.0f, 0.5f);
+        s.uvRect = glm::vec4(u, v, u + 0.5f, v + 0.5f);
+    }
+    return sprites;
+}
+
+DrawPacket toPacket(const SceneGL& gl, const SceneSprite& s) {
+    DrawPacket p;
+    p.program = gl.queuePrograms[s.program];
+    p.texture = gl.textures[s.texture];
+    p.vao = gl.vaos[s.mesh];
+    p.indexCount = 6;
+    p.key = makeDrawKey(s.layer, s.translucent, p.program, p.texture, p.vao, s.depth);
+    p.model = s.model;
+    p.uvRect = s.uvRect;
+    return p;
+}
+
+// caminho antigo: a ordem de desenho vem pronta (a mesma da fila), cada sprite
+// liga tudo de novo
+void drawOneByOne(const SceneGL& gl, const std::vector<SceneSprite>& sprites, const std::vector<uint32_t>& order) {
+    glActiveTexture(GL_TEXTURE0);
+    for (uint32_t i : order) {
+        const SceneSprite& s = sprites[i];
+        glUseProgram(gl.uniformPrograms[s.program]);
+        glUniformMatrix3x2fv(gl.modelLoc[s.program], 1, GL_FALSE, s.model.data());
+        glUniform4fv(gl.uvLoc[s.program], 1, &s.uvRect[0]);
+        glBindTexture(GL_TEXTURE_2D, gl.textures[s.texture]);
+        glBindVertexArray(gl.vaos[s.mesh]);
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    }
+    glBindVertexArray(0);
+}
+
+void submitAll(RenderQueue& queue, const SceneGL& gl, const std::vector<SceneSprite>& sprites) {
+    for (const SceneSprite& s : sprites) queue.submit(toPacket(gl, s));
+}
+
+std::vector<unsigned char> readImage() {
+    std::vector<unsigned char> pixels(WIDTH * HEIGHT * 4);
+    glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    return pixels;
+}
+
+void benchSort() {
+    const size_t n = 100000;
+    RenderQueue queue;
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; ++i) {
+        DrawPacket p = {};
+        p.key = makeDrawKey(rand() % LAYERS, rand() % 2 == 0, 1 + rand() % 16, 1 + rand() % 64, 1 + rand() % 8, randomRange(0.0f, 1.0f));
+        keys[i] = p.key;
+        queue.submit(p);
+    }
+    const int reps = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) queue.sort();
+    double radixMs = msSince(start) / reps;
+
+    std::vector<std::pair<uint64_t, uint32_t>> items(n);
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) {
+        for (size_t i = 0; i < n; ++i) items[i] = { keys[i], (uint32_t)i };
+        std::stable_sort(items.begin(), items.end(),
+                         [](const std::pair<uint64_t, uint32_t>& a, const std::pair<uint64_t, uint32_t>& b) { return a.first < b.first; });
+    }
+    double stdMs = msSince(start) / reps;
+
+    bool same = true;
+    for (size_t i = 0; i < n; ++i)
+        if (queue.sortedIndex(i) != items[i].second) same = false;
+    printf("ordenar %zu chaves: radix %.3f ms, std::stable_sort %.3f ms (%s)\n", n, radixMs, stdMs,
+           same ? "mesma ordem" : "ORDEM DIFERENTE");
+}
+
+int main() {
+    if (!glfwInit()) {
+        std::cerr << "Falha ao inicializar GLFW\n";
+        return -1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "benchRenderQueue", NULL, NULL);
+    if (!window) {
+        std::cerr << "Falha ao criar contexto GLFW\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Falha ao inicializar GLAD\n";
+        return -1;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << "\n";
+
+    GLuint fbo, color;
+    glGenFramebuffers(1, &fbo);
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WIDTH, HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glViewport(0, 0, WIDTH, HEIGHT);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    srand(7);
+    glm::mat4 projection = glm::ortho(0.0f, (float)WIDTH, 0.0f, (float)HEIGHT, -1.0f, 1.0f);
+    SceneGL gl;
+    if (!initScene(gl, projection)) return -1;
+    std::vector<SceneSprite> sprites = makeSprites();
+    RenderQueue queue;
+
+    // a ordem da fila, para o caminho antigo desenhar na mesma ordem
+    submitAll(queue, gl, sprites);
+    queue.sort();
+    std::vector<uint32_t> order(SPRITES);
+    for (int i = 0; i < SPRITES; ++i) order[i] = (uint32_t)queue.sortedIndex(i);
+    queue.clear();
+
+    printf("%d sprites, %d camadas, %d programas, %d texturas, %d meshes, submetidos em ordem aleatoria\n", SPRITES,
+           LAYERS, PROGRAMS, TEXTURES, MESHES);
+
+    // imagens: as duas ordens sao a mesma, entao os pixels tem que bater
+    glClear(GL_COLOR_BUFFER_BIT);
+    drawOneByOne(gl, sprites, order);
+    std::vector<unsigned char> before = readImage();
+    glClear(GL_COLOR_BUFFER_BIT);
+    submitAll(queue, gl, sprites);
+    queue.execute();
+    std::vector<unsigned char> after = readImage();
+    size_t differing = 0;
+    for (size_t i = 0; i < before.size(); i += 4)
+        if (memcmp(&before[i], &after[i], 4) != 0) differing++;
+    printf("pixels diferentes entre os dois caminhos: %zu\n", differing);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; ++f) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        drawOneByOne(gl, sprites, order);
+        if (f % 30 == 29) glFinish();
+    }
+    glFinish();
+    double oneByOneMs = msSince(start) / FRAMES;
+
+    double submitMs = 0.0, executeMs = 0.0;
+    start = std::chrono::steady_clock::now();
+    for (int f = 0; f < FRAMES; ++f) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        auto t0 = std::chrono::steady_clock::now();
+        submitAll(queue, gl, sprites);
+        auto t1 = std::chrono::steady_clock::now();
+        queue.execute();
+        submitMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        executeMs += msSince(t1);
+        if (f % 30 == 29) glFinish();
+    }
+    glFinish();
+    double queueMs = msSince(start) / FRAMES;
+
+    printf("um draw por sprite: %4d draws, %4d trocas de estado, %.3f ms/frame (com a GPU)\n", SPRITES, 3 * SPRITES,
+           oneByOneMs);
+    printf("na ordem de submissao, so pulando binds repetidos: %zu trocas\n", queue.stats.unsortedChanges);
+    printf("fila:               %4zu draws, %4zu trocas de estado (%zu programa, %zu textura, %zu VAO), %.3f ms/frame "
+           "(submit %.3f ms, execute %.3f ms)\n",
+           queue.stats.drawCalls, queue.stats.stateChanges(), queue.stats.programChanges, queue.stats.textureChanges,
+           queue.stats.vaoChanges, queueMs, submitMs / FRAMES, executeMs / FRAMES);
+
+    benchSort();
+
+    queue.destroy();
+    destroyScene(gl);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    glfwTerminate();
+    return 0;
+}
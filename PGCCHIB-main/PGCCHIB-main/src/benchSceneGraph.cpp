@@ -0,0 +1,141 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "SceneGraph.h"
+#include "ParallelFor.h"
+
+// Benchmark do SceneGraph (so CPU, sem janela).
+// Cena de 100k nos: 1000 objetos, cada um com uma raiz, 9 partes e 10 pecas
+// em cada parte (1 + 9 + 90 = 100 nos). Mede:
+//   - o recalculo completo (tudo sujo), em 1 thread e em todas;
+//   - mover uma folha, uma parte e a raiz de um objeto (setPosition + update);
+//   - mover 1000 nos espalhados por frame;
+//   - adicionar e remover nos depois da cena montada.
+// Confere que o update incremental da o mesmo resultado que recalcular tudo.
+
+const int OBJECTS = 1000;
+const int PARTS = 9;
+const int PIECES = 10;
+const int REPEAT = 10000;
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+float randomRange(float lo, float hi) {
+    return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+Transform2D randomTransform(float spread) {
+    Transform2D t;
+    t.position = glm::vec2(randomRange(-spread, spread), randomRange(-spread, spread));
+    t.rotation = randomRange(-3.14f, 3.14f);
+    t.scale = glm::vec2(randomRange(0.5f, 1.5f), randomRange(0.5f, 1.5f));
+    return t;
+}
+
+int main() {
+    srand(3);
+    printf("%d threads\n", defaultThreadCount());
+
+    SceneGraph scene;
+    std::vector<int> roots, parts, leaves;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int o = 0; o < OBJECTS; ++o) {
+        int root = scene.add(randomTransform(1000.0f));
+        roots.push_back(root);
+        for (int p = 0; p < PARTS; ++p) {
+            int part = scene.add(randomTransform(20.0f), root);
+            parts.push_back(part);
+            for (int l = 0; l < PIECES; ++l) leaves.push_back(scene.add(randomTransform(5.0f), part));
+        }
+    }
+    double buildMs = msSince(start);
+    start = std::chrono::steady_clock::now();
+    scene.update();
+    printf("%zu nos: montar %.2f ms, primeiro update %.2f ms\n", scene.size(), buildMs, msSince(start));
+
+    // recalculo completo, o que seria percorrer a cena toda todo frame
+    const int FULL = 50;
+    double fullMs[2];
+    int threadCounts[2] = { 1, 0 };
+    for (int t = 0; t < 2; ++t) {
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < FULL; ++i) {
+            scene.markAllDirty();
+            scene.update(threadCounts[t]);
+        }
+        fullMs[t] = msSince(start) / FULL;
+    }
+    printf("recalcular tudo:            %9.3f ms (1 thread)  %9.3f ms (%d threads)\n", fullMs[0], fullMs[1],
+           defaultThreadCount());
+
+    // mover um no e atualizar
+    struct Case { const char* name; const std::vector<int>* nodes; };
+    const Case cases[3] = {
+        { "mover 1 folha", &leaves },
+        { "mover 1 parte (11 nos)", &parts },
+        { "mover 1 raiz (100 nos)", &roots },
+    };
+    for (const Case& c : cases) {
+        std::vector<int> picks(REPEAT);
+        for (int& p : picks) p = (*c.nodes)[rand() % c.nodes->size()];
+        size_t updated = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPEAT; ++i) {
+            scene.setPosition(picks[i], glm::vec2((float)i, 1.0f));
+            updated += scene.update();
+        }
+        printf("%-27s %9.3f us  (%zu nos refeitos)\n", c.name, msSince(start) * 1000.0 / REPEAT, updated / REPEAT);
+    }
+
+    const int FRAMES = 200;
+    start = std::chrono::steady_clock::now();
+    size_t updated = 0;
+    for (int f = 0; f < FRAMES; ++f) {
+        for (int i = 0; i < 1000; ++i) {
+            int node = scene.nodeAt(rand() % scene.size());
+            Transform2D t = scene.local(node);
+            t.rotation += 0.01f;
+            scene.setLocal(node, t);
+        }
+        updated += scene.update();
+    }
+    printf("1000 nos espalhados/frame   %9.3f ms  (%zu nos refeitos)\n", msSince(start) / FRAMES, updated / FRAMES);
+
+    // conferencia: o incremental bate com recalcular tudo
+    std::vector<Affine2D> incremental = scene.worldMatrices();
+    scene.markAllDirty();
+    scene.update();
+    bool same = memcmp(incremental.data(), scene.worldMatrices().data(), incremental.size() * sizeof(Affine2D)) == 0;
+    printf("incremental == completo: %s\n", same ? "sim" : "NAO");
+    // e a divisao em threads tambem (forca 4 threads mesmo com menos nucleos)
+    scene.markAllDirty();
+    scene.update(4);
+    same = memcmp(incremental.data(), scene.worldMatrices().data(), incremental.size() * sizeof(Affine2D)) == 0;
+    printf("4 threads == 1 thread: %s\n", same ? "sim" : "NAO");
+
+    // adicionar no meio (filho de um objeto antigo) e remover desloca os vetores
+    const int CHURN = 200;
+    start = std::chrono::steady_clock::now();
+    std::vector<int> added;
+    for (int i = 0; i < CHURN; ++i) added.push_back(scene.add(randomTransform(5.0f), parts[rand() % 10]));
+    double addMs = msSince(start) / CHURN;
+    start = std::chrono::steady_clock::now();
+    for (int node : added) scene.remove(node);
+    double removeMs = msSince(start) / CHURN;
+    scene.update();
+    printf("adicionar no meio %.3f ms, remover %.3f ms (por no)\n", addMs, removeMs);
+
+    incremental = scene.worldMatrices();
+    scene.markAllDirty();
+    scene.update();
+    same = memcmp(incremental.data(), scene.worldMatrices().data(), incremental.size() * sizeof(Affine2D)) == 0;
+    printf("depois de adicionar/remover, incremental == completo: %s\n", same ? "sim" : "NAO");
+    return 0;
+}
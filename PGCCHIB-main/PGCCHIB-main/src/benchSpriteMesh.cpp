@@ -0,0 +1,111 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include "SpriteMesh.h"
+
+// Mede o SpriteMesh nas folhas do projeto (so CPU, sem janela): para cada
+// orcamento de vertices, quanto da area do quad sobra para o fragment shader
+// (media dos frames), o tempo para tracar a folha e se algum pixel com alfa
+// ficou de fora do poligono (tem que ser 0).
+//
+// benchSpriteMesh [pasta include]
+
+#ifndef PG_ASSET_DIR
+#define PG_ASSET_DIR "include"
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+struct Sheet {
+    const char* file;
+    int columns, rows;
+};
+
+// ponto (x, y) dentro de algum triangulo do mesh (coordenadas do frame, 0 a 1)
+bool insideMesh(const SpriteMesh& mesh, float x, float y) {
+    for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+        glm::vec2 a = mesh.points[mesh.indices[i]], b = mesh.points[mesh.indices[i + 1]], c = mesh.points[mesh.indices[i + 2]];
+        float d1 = (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+        float d2 = (c.x - b.x) * (y - b.y) - (c.y - b.y) * (x - b.x);
+        float d3 = (a.x - c.x) * (y - c.y) - (a.y - c.y) * (x - c.x);
+        const float eps = 1e-5f;
+        bool hasNeg = d1 < -eps || d2 < -eps || d3 < -eps;
+        bool hasPos = d1 > eps || d2 > eps || d3 > eps;
+        if (!(hasNeg && hasPos))
+            return true;
+    }
+    return false;
+}
+
+// pixels com alfa cujo centro ficou fora do mesh do frame
+long uncovered(const unsigned char* rgba, int imageWidth, int x0, int y0, int w, int h, const SpriteMesh& mesh) {
+    long missing = 0;
+    for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+            if (rgba[((size_t)(y0 + y) * imageWidth + x0 + x) * 4 + 3] > 0 &&
+                !insideMesh(mesh, (x + 0.5f) / w, (y + 0.5f) / h))
+                missing++;
+    return missing;
+}
+
+int main(int argc, char** argv) {
+    std::string dir = argc > 1 ? argv[1] : PG_ASSET_DIR;
+    if (!dir.empty() && dir.back() != '/')
+        dir += '/';
+
+    const Sheet sheets[] = {
+        { "donatello.png", 3, 3 },
+        { "Cartoon_Forest_BG_04/Layers/homernorm.png", 1, 1 },
+        { "Cartoon_Forest_BG_04/Layers/homeresq.png", 1, 1 },
+        { "tilesetIso.png", 7, 1 },
+        { "8bitLib/PNG/exterior.png", 1, 1 },
+    };
+    const int budgets[] = { 4, 8, 16, 32 };
+
+    printf("%-42s %6s %9s %9s %10s %9s\n", "folha (frames)", "verts", "area", "tracar", "fora", "frame");
+    for (const Sheet& sheet : sheets) {
+        int w, h, channels;
+        unsigned char* rgba = stbi_load((dir + sheet.file).c_str(), &w, &h, &channels, 4);
+        if (!rgba) {
+            std::cerr << "nao carregou " << dir + sheet.file << std::endl;
+            continue;
+        }
+        int fw = w / sheet.columns, fh = h / sheet.rows;
+        for (int budget : budgets) {
+            std::vector<SpriteMesh> meshes;
+            auto start = Clock::now();
+            traceSpriteSheet(rgba, w, h, sheet.columns, sheet.rows, budget, meshes);
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            double coverage = 0.0;
+            long missing = 0;
+            size_t vertices = 0;
+            for (int r = 0; r < sheet.rows; ++r) {
+                for (int c = 0; c < sheet.columns; ++c) {
+                    const SpriteMesh& mesh = meshes[r * sheet.columns + c];
+                    coverage += mesh.coverage;
+                    vertices = std::max(vertices, mesh.points.size());
+                    missing += uncovered(rgba, w, c * fw, r * fh, fw, fh, mesh);
+                }
+            }
+            coverage /= meshes.size();
+            char name[64];
+            snprintf(name, sizeof(name), "%s (%d)", sheet.file, sheet.columns * sheet.rows);
+            printf("%-42s %6zu %8.1f%% %7.3f ms %10ld %4dx%d\n", budget == budgets[0] ? name : "", vertices,
+                   100.0 * coverage, ms, missing, fw, fh);
+        }
+
+        SpriteMesh all;
+        traceSpriteSheetUnion(rgba, w, h, sheet.columns, sheet.rows, 16, all);
+        if (sheet.columns * sheet.rows > 1)
+            printf("%-42s %6zu %8.1f%%   (uniao dos frames, 16 vertices)\n", "", all.points.size(), 100.0 * all.coverage);
+        stbi_image_free(rgba);
+    }
+    return 0;
+}
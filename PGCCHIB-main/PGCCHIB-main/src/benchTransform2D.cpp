@@ -0,0 +1,358 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Transform2D.h"
+#include "ParallelFor.h"
+
+// Benchmark do Transform2D, sem janela visivel (headless).
+// 1M transformacoes (posicao, rotacao, escala) por frame, em quatro caminhos:
+//   - mat4: translate -> rotate -> scale do glm, como os exercicios fazem hoje,
+//     64 bytes por objeto para a GPU;
+//   - Affine2D escalar e Affine2D SSE (1 thread e todas as threads), 24 bytes;
+//   - sem composicao: posicao/rotacao/escala crus (20 bytes) e a matriz eh
+//     montada no vertex shader.
+// Para cada um mede compor na CPU, enviar para a GPU e desenhar 1M quads
+// instanciados em um FBO de 1280x720. Confere tambem que os caminhos dao a
+// mesma matriz e a mesma imagem.
+
+const int WIDTH = 1280;
+const int HEIGHT = 720;
+const size_t COUNT = 1000000;
+const int FRAMES = 20;
+const int DRAW_FRAMES = 3;
+const size_t IMAGE_COUNT = 20000;
+
+const char* fragmentSource = R"(
+#version 330 core
+out vec4 FragColor;
+void main() {
+    FragColor = vec4(1.0, 0.8, 0.2, 1.0);
+}
+)";
+
+const char* mat4VertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in mat4 iModel;
+uniform mat4 projection;
+void main() {
+    gl_Position = projection * iModel * vec4(aPos, 0.0, 1.0);
+}
+)";
+
+const char* affineVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec4 iLinear;    // a, b, c, d
+layout (location = 2) in vec2 iTranslate; // tx, ty
+uniform mat4 projection;
+void main() {
+    vec2 p = mat2(iLinear.xy, iLinear.zw) * aPos + iTranslate;
+    gl_Position = projection * vec4(p, 0.0, 1.0);
+}
+)";
+
+const char* rawVertexSource = R"(
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in float iX;
+layout (location = 2) in float iY;
+layout (location = 3) in float iRotation;
+layout (location = 4) in float iScaleX;
+layout (location = 5) in float iScaleY;
+uniform mat4 projection;
+void main() {
+    float s = sin(iRotation), c = cos(iRotation);
+    vec2 q = aPos * vec2(iScaleX, iScaleY);
+    vec2 p = vec2(c * q.x - s * q.y + iX, s * q.x + c * q.y + iY);
+    gl_Position = projection * vec4(p, 0.0, 1.0);
+}
+)";
+
+GLuint compileProgram(const char* vertexSource) {
+    GLuint vs = glCreateShader(GL_VERTEX_SHADER), fs = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(vs, 1, &vertexSource, NULL);
+    glCompileShader(vs);
+    glShaderSource(fs, 1, &fragmentSource, NULL);
+    glCompileShader(fs);
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint ok;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[512];
+        glGetProgramInfoLog(program, 512, NULL, log);
+        std::cerr << "Erro ao linkar shader:\n" << log << std::endl;
+        return 0;
+    }
+    return program;
+}
+
+enum Path { PATH_MAT4, PATH_AFFINE, PATH_RAW, PATH_COUNT };
+
+// um VAO por caminho: o quad unitario em 0 e os atributos por instancia lendo
+// do buffer de instancias no formato daquele caminho
+struct PathGL {
+    GLuint program = 0, vao = 0;
+    GLint projectionLoc = -1;
+};
+
+float randomRange(float lo, float hi) {
+    return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+void fillTransforms(TransformArray& t, size_t n, float minScale, float maxScale) {
+    t.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        Transform2D tr;
+        tr.position = glm::vec2(randomRange(0.0f, (float)WIDTH), randomRange(0.0f, (float)HEIGHT));
+        tr.rotation = randomRange(-20.0f, 20.0f);
+        tr.scale = glm::vec2(randomRange(minScale, maxScale), randomRange(minScale, maxScale));
+        t.set(i, tr);
+    }
+}
+
+void composeMat4(const TransformArray& t, size_t begin, size_t end, glm::mat4* out) {
+    for (size_t i = begin; i < end; ++i) {
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(t.x[i], t.y[i], 0.0f));
+        model = glm::rotate(model, t.rotation[i], glm::vec3(0.0f, 0.0f, 1.0f));
+        model = glm::scale(model, glm::vec3(t.scaleX[i], t.scaleY[i], 1.0f));
+        out[i] = model;
+    }
+}
+
+// envia as instancias no formato do caminho (orfaniza o buffer antes)
+size_t upload(Path path, GLuint instanceVBO, const TransformArray& t, const std::vector<glm::mat4>& mats,
+              const std::vector<Affine2D>& affines) {
+    size_t n = t.count, bytes;
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (path == PATH_MAT4) {
+        bytes = n * sizeof(glm::mat4);
+        glBufferData(GL_ARRAY_BUFFER, bytes, NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, mats.data());
+    } else if (path == PATH_AFFINE) {
+        bytes = n * sizeof(Affine2D);
+        glBufferData(GL_ARRAY_BUFFER, bytes, NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, affines.data());
+    } else {
+        // os vetores do SoA vao em sequencia, cada atributo le a sua faixa
+        const std::vector<float>* fields[5] = { &t.x, &t.y, &t.rotation, &t.scaleX, &t.scaleY };
+        bytes = n * 5 * sizeof(float);
+        glBufferData(GL_ARRAY_BUFFER, bytes, NULL, GL_STREAM_DRAW);
+        for (int f = 0; f < 5; ++f)
+            glBufferSubData(GL_ARRAY_BUFFER, f * n * sizeof(float), n * sizeof(float), fields[f]->data());
+    }
+    return bytes;
+}
+
+// aponta os atributos de instancia para o buffer (depois do upload, porque o
+// caminho cru depende de n para achar cada faixa)
+void bindInstances(Path path, const PathGL& gl, GLuint instanceVBO, size_t n) {
+    glBindVertexArray(gl.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (path == PATH_MAT4) {
+        for (int col = 0; col < 4; ++col) {
+            glVertexAttribPointer(1 + col, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(col * 4 * sizeof(float)));
+            glEnableVertexAttribArray(1 + col);
+            glVertexAttribDivisor(1 + col, 1);
+        }
+    } else if (path == PATH_AFFINE) {
+        glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(Affine2D), (void*)0);
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Affine2D), (void*)(4 * sizeof(float)));
+        for (int a = 1; a <= 2; ++a) {
+            glEnableVertexAttribArray(a);
+            glVertexAttribDivisor(a, 1);
+        }
+    } else {
+        for (int f = 0; f < 5; ++f) {
+            glVertexAttribPointer(1 + f, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(f * n * sizeof(float)));
+            glEnableVertexAttribArray(1 + f);
+            glVertexAttribDivisor(1 + f, 1);
+        }
+    }
+}
+
+void drawInstances(const PathGL& gl, const glm::mat4& projection, size_t n) {
+    glUseProgram(gl.program);
+    glUniformMatrix4fv(gl.projectionLoc, 1, GL_FALSE, &projection[0][0]);
+    glBindVertexArray(gl.vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)n);
+}
+
+double msSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    if (!glfwInit()) {
+        std::cerr << "Falha ao inicializar GLFW\n";
+        return -1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow* window = glfwCreateWindow(64, 64, "benchTransform2D", NULL, NULL);
+    if (!window) {
+        std::cerr << "Falha ao criar contexto GLFW\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "Falha ao inicializar GLAD\n";
+        return -1;
+    }
+    std::cout << "Renderer: " << glGetString(GL_RENDERER) << "\n";
+    printf("SSE2: %s, %d threads\n", transformsHaveSimd() ? "sim" : "nao", defaultThreadCount());
+
+    GLuint fbo, color;
+    glGenFramebuffers(1, &fbo);
+    glGenTextures(1, &color);
+    glBindTexture(GL_TEXTURE_2D, color);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, WIDTH, HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+    glViewport(0, 0, WIDTH, HEIGHT);
+
+    float quad[] = { -0.5f, -0.5f, 0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f };
+    GLuint quadVBO, instanceVBO;
+    glGenBuffers(1, &quadVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+    glGenBuffers(1, &instanceVBO);
+
+    const char* sources[PATH_COUNT] = { mat4VertexSource, affineVertexSource, rawVertexSource };
+    PathGL paths[PATH_COUNT];
+    for (int p = 0; p < PATH_COUNT; ++p) {
+        paths[p].program = compileProgram(sources[p]);
+        if (!paths[p].program) return -1;
+        paths[p].projectionLoc = glGetUniformLocation(paths[p].program, "projection");
+        glGenVertexArrays(1, &paths[p].vao);
+        glBindVertexArray(paths[p].vao);
+        glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+    }
+    glm::mat4 projection = glm::ortho(0.0f, (float)WIDTH, 0.0f, (float)HEIGHT, -1.0f, 1.0f);
+
+    // --- conferencia: as tres formas de compor dao a mesma matriz
+    TransformArray transforms;
+    srand(7);
+    fillTransforms(transforms, COUNT, 1.0f, 4.0f);
+    std::vector<glm::mat4> mats(COUNT);
+    std::vector<Affine2D> scalar(COUNT), simd(COUNT);
+    composeMat4(transforms, 0, COUNT, mats.data());
+    composeAffineScalar(transforms, 0, COUNT, scalar.data());
+    composeAffineSimd(transforms, 0, COUNT, simd.data());
+    float diffMat4 = 0.0f, diffSimd = 0.0f;
+    for (size_t i = 0; i < COUNT; ++i) {
+        glm::mat4 fromAffine = affineToMat4(scalar[i]);
+        for (int c = 0; c < 4; ++c)
+            for (int r = 0; r < 4; ++r)
+                diffMat4 = std::max(diffMat4, std::fabs(fromAffine[c][r] - mats[i][c][r]));
+        const float* a = scalar[i].data();
+        const float* b = simd[i].data();
+        for (int k = 0; k < 6; ++k) diffSimd = std::max(diffSimd, std::fabs(a[k] - b[k]));
+    }
+    printf("diferenca maxima affine x mat4: %g, sse x escalar: %g\n", diffMat4, diffSimd);
+
+    // --- tempos por frame com 1M transformacoes
+    printf("\n%zu transformacoes por frame\n", COUNT);
+    printf("%-24s %10s %10s %10s %9s\n", "caminho", "compor ms", "enviar ms", "desenho ms", "MB/frame");
+
+    struct Case { const char* name; Path path; int compose; }; // compose: 0 nada, 1 mat4, 2 escalar, 3 sse, 4 sse mt
+    const Case cases[5] = {
+        { "mat4 (glm)", PATH_MAT4, 1 },
+        { "affine escalar", PATH_AFFINE, 2 },
+        { "affine sse 1 thread", PATH_AFFINE, 3 },
+        { "affine sse todas", PATH_AFFINE, 4 },
+        { "cru, matriz no shader", PATH_RAW, 0 },
+    };
+    for (const Case& c : cases) {
+        auto start = std::chrono::steady_clock::now();
+        for (int f = 0; f < FRAMES; ++f) {
+            // a rotacao muda a cada frame, como em uma cena animada
+            transforms.rotation[f] += 0.01f;
+            if (c.compose == 1) composeMat4(transforms, 0, COUNT, mats.data());
+            else if (c.compose == 2) composeAffineScalar(transforms, 0, COUNT, scalar.data());
+            else if (c.compose == 3) composeAffineSimd(transforms, 0, COUNT, simd.data());
+            else if (c.compose == 4)
+                parallelFor(COUNT, 0, 65536, [&](size_t b, size_t e) { composeAffineSimd(transforms, b, e, simd.data()); });
+        }
+        double composeMs = msSince(start) / FRAMES;
+
+        size_t bytes = 0;
+        glFinish();
+        start = std::chrono::steady_clock::now();
+        for (int f = 0; f < FRAMES; ++f) bytes = upload(c.path, instanceVBO, transforms, mats, simd);
+        glFinish();
+        double uploadMs = msSince(start) / FRAMES;
+
+        bindInstances(c.path, paths[c.path], instanceVBO, COUNT);
+        glFinish();
+        start = std::chrono::steady_clock::now();
+        for (int f = 0; f < DRAW_FRAMES; ++f) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            drawInstances(paths[c.path], projection, COUNT);
+        }
+        glFinish();
+        double drawMs = msSince(start) / DRAW_FRAMES;
+
+        printf("%-24s %10.3f %10.3f %10.3f %9.1f\n", c.name, composeMs, uploadMs, drawMs, bytes / (1024.0 * 1024.0));
+    }
+
+    // --- conferencia: os tres shaders desenham a mesma imagem (quads maiores)
+    TransformArray few;
+    fillTransforms(few, IMAGE_COUNT, 8.0f, 24.0f);
+    std::vector<glm::mat4> fewMats(IMAGE_COUNT);
+    std::vector<Affine2D> fewAffines(IMAGE_COUNT);
+    composeMat4(few, 0, IMAGE_COUNT, fewMats.data());
+    composeAffineSimd(few, 0, IMAGE_COUNT, fewAffines.data());
+
+    std::vector<unsigned char> images[PATH_COUNT];
+    for (int p = 0; p < PATH_COUNT; ++p) {
+        upload((Path)p, instanceVBO, few, fewMats, fewAffines);
+        bindInstances((Path)p, paths[p], instanceVBO, IMAGE_COUNT);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        drawInstances(paths[p], projection, IMAGE_COUNT);
+        images[p].resize(WIDTH * HEIGHT * 4);
+        glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, images[p].data());
+    }
+    for (int p = 1; p < PATH_COUNT; ++p) {
+        size_t differ = 0;
+        for (size_t i = 0; i < images[0].size(); i += 4)
+            if (images[p][i] != images[0][i]) differ++;
+        printf("pixels diferentes do mat4 (%s): %zu de %d\n", p == PATH_AFFINE ? "affine" : "cru", differ, WIDTH * HEIGHT);
+    }
+
+    for (int p = 0; p < PATH_COUNT; ++p) {
+        glDeleteVertexArrays(1, &paths[p].vao);
+        glDeleteProgram(paths[p].program);
+    }
+    glDeleteBuffers(1, &quadVBO);
+    glDeleteBuffers(1, &instanceVBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fbo);
+    glDeleteTextures(1, &color);
+    glfwTerminate();
+    return 0;
+}
@@ -5,43 +5,81 @@
 #include <iostream>
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#include "Console.h"
+#include "Transform2D.h"
+#include "AllocationCounter.h"
+#include "RenderQueue.h"
+#include "GLHandles.h"
+#include "Lighting2D.h"
+#include "SpriteMesh.h"
+#include "AssetImage.h"
+
 // Vertex Shader
 const char* vertexShaderSource = R"(
 #version 330 core
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aTexCoord;
+// por instancia (RenderQueue): afim 2D do sprite e recorte na textura
+layout (location = 2) in vec4 iModel;
+layout (location = 3) in vec2 iTranslate;
+layout (location = 4) in vec4 iUvRect;
+// profundidade do pacote (RenderQueue::depthTest)
+layout (location = 5) in float iDepth;
 
-uniform mat4 model;
 uniform mat4 projection;
 
 out vec2 TexCoord;
+// rotacao do sprite, para girar a normal junto
+flat out vec4 NormalRotation;
 
 void main()
 {
-    gl_Position = projection * model * vec4(aPos, 0.0, 1.0);
-    TexCoord = aTexCoord;
+    vec2 world = mat2(iModel.xy, iModel.zw) * aPos + iTranslate;
+    gl_Position = projection * vec4(world, 0.0, 1.0);
+    gl_Position.z = iDepth;
+    TexCoord = mix(iUvRect.xy, iUvRect.zw, aTexCoord);
+    NormalRotation = vec4(normalize(iModel.xy), normalize(iModel.zw));
 }
 )";
 
-// Fragment Shader
+// Fragment Shader (o #version e o CUTOUT vem do createShaderProgram)
 const char* fragmentShaderSource = R"(
-#version 330 core
-out vec4 FragColor;
+layout (location = 0) out vec4 FragColor;
+// normal para o Lighting2D (z = 0: sem normal map, normal reta)
+layout (location = 1) out vec4 NormalColor;
 
 in vec2 TexCoord;
+flat in vec4 NormalRotation;
 
 uniform sampler2D texture1;
+uniform sampler2D normalMap;
 
 void main()
 {
     FragColor = texture(texture1, TexCoord);
+#ifdef CUTOUT
+    // recorte desenhado como opaco: o transparente nao pode escrever profundidade
+    if (FragColor.a < 0.5)
+        discard;
+#endif
+    vec4 n = texture(normalMap, TexCoord);
+    if (n.z > 0.0) {
+        vec3 v = n.xyz * 2.0 - 1.0;
+        v.xy = mat2(NormalRotation.xy, NormalRotation.zw) * v.xy;
+        n.xyz = v * 0.5 + 0.5;
+    }
+    NormalColor = vec4(n.xyz, FragColor.a);
 }
 )";
 
-GLuint createShaderProgram() {
+// cutout: versao com discard, para os adesivos de recorte (SPRITE_CUTOUT)
+GLuint createShaderProgram(bool cutout) {
     GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
     GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
     GLuint shaderProgram = glCreateProgram();
@@ -57,7 +95,8 @@ GLuint createShaderProgram() {
         std::cout << "ERROR: Vertex Shader compilation failed\n" << infoLog << std::endl;
     }
 
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
+    const char* fragmentSources[] = { "#version 330 core\n", cutout ? "#define CUTOUT\n" : "", fragmentShaderSource };
+    glShaderSource(fragmentShader, 3, fragmentSources, NULL);
     glCompileShader(fragmentShader);
 
     glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
@@ -83,23 +122,29 @@ GLuint createShaderProgram() {
     return shaderProgram;
 }
 
-GLuint loadTexture(const char* path) {
+// normalMap != nullptr: tambem cria um normal map a partir do brilho da imagem;
+// pixels != nullptr: fica com uma copia dos pixels RGBA (para tracar os meshes)
+GLuint loadTexture(const char* path, GLuint* normalMap = nullptr, std::vector<unsigned char>* pixels = nullptr) {
     GLuint textureID;
     glGenTextures(1, &textureID);
 
     int width, height, nrChannels;
-    unsigned char *data = stbi_load(path, &width, &height, &nrChannels, 0);
+    unsigned char *data = loadImageAsset(path, &width, &height, &nrChannels, 4);
 
     if (data) {
-        GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
         glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
         glGenerateMipmap(GL_TEXTURE_2D);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        // stbi_set_flip_vertically_on_load: a primeira linha eh a de baixo
+        if (normalMap)
+            *normalMap = createNormalMap(data, width, height, false);
+        if (pixels)
+            pixels->assign(data, data + (size_t)width * height * 4);
     } else {
         std::cout << "Failed to load texture" << std::endl;
     }
@@ -107,76 +152,154 @@ GLuint loadTexture(const char* path) {
     return textureID;
 }
 
+// quad unitario centrado na origem com uv de 0 a 1, ou so a parte dele coberta
+// por um SpriteMesh (mesmos atributos, menos pixels transparentes no blending)
+struct QuadMesh {
+    GLVertexArray vao;
+    GLBuffer vbo, ebo;
+    GLsizei indexCount = 0;
+
+    void init() {
+        SpriteMesh quad;
+        quad.quad();
+        init(quad);
+    }
+
+    // pontos do mesh (no recorte, 0 a 1): aPos = p - 0.5 e aTexCoord = p
+    void init(const SpriteMesh& mesh) {
+        std::vector<float> vertices;
+        for (const glm::vec2& p : mesh.points)
+            vertices.insert(vertices.end(), { p.x - 0.5f, p.y - 0.5f, p.x, p.y });
+        indexCount = (GLsizei)mesh.indices.size();
+
+        vao.create();
+        glBindVertexArray(vao.get());
+        vbo.data(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+        ebo.data(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(uint32_t), mesh.indices.data(), GL_STATIC_DRAW);
+
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+        glBindVertexArray(0);
+    }
+};
+
+// Os sprites usam o quad unitario ou o mesh justo do adesivo; o recorte
+// (uvMin, uvMax) e a transformacao vao por instancia na RenderQueue.
 struct Sprite {
-    GLuint VAO, VBO, EBO;
     glm::vec2 position, scale;
     float rotation;
     glm::vec2 uvMin, uvMax;
     GLuint textureID;
+    GLuint normalMap;
     GLuint shaderProgram;
     bool visible;
+    const QuadMesh* mesh = nullptr; // nullptr: o quad passado no submit
+    SpriteAlpha alpha = SPRITE_TRANSLUCENT; // so os translucidos vao com blending
 
-    Sprite(GLuint shaderProgram, GLuint textureID, glm::vec2 uvMin, glm::vec2 uvMax)
-        : shaderProgram(shaderProgram), textureID(textureID), uvMin(uvMin), uvMax(uvMax),
+    Sprite(GLuint shaderProgram, GLuint textureID, glm::vec2 uvMin, glm::vec2 uvMax, GLuint normalMap = 0)
+        : shaderProgram(shaderProgram), textureID(textureID), normalMap(normalMap), uvMin(uvMin), uvMax(uvMax),
           position(0.0f), scale(1.0f), rotation(0.0f), visible(true)
     {
-        setupSprite();
     }
 
-    void setupSprite() {
-        float vertices[] = {
-            -0.5f, -0.5f,  uvMin.x, uvMin.y,
-             0.5f, -0.5f,  uvMax.x, uvMin.y,
-             0.5f,  0.5f,  uvMax.x, uvMax.y,
-            -0.5f,  0.5f,  uvMin.x, uvMax.y
-        };
-        unsigned int indices[] = { 0, 1, 2, 2, 3, 0 };
-
-        glGenVertexArrays(1, &VAO);
-        glGenBuffers(1, &VBO);
-        glGenBuffers(1, &EBO);
+    // depth em [0, 1], 1 = mais longe na camada
+    void submit(RenderQueue& queue, const QuadMesh& quad, unsigned layer, float depth) const {
+        if (!visible) return;
 
-        glBindVertexArray(VAO);
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+        const QuadMesh& m = mesh ? *mesh : quad;
+        DrawPacket packet;
+        packet.key = makeDrawKey(layer, alpha == SPRITE_TRANSLUCENT, shaderProgram, textureID, m.vao.get(), depth);
+        packet.program = shaderProgram;
+        packet.texture = textureID;
+        packet.vao = m.vao.get();
+        packet.indexCount = m.indexCount;
+        packet.model = composeAffine(position, glm::radians(rotation), scale);
+        packet.uvRect = glm::vec4(uvMin, uvMax);
+        packet.normalMap = normalMap;
+        queue.submit(packet);
+    }
+};
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+// Sprites da cena guardados em um vetor continuo (para desenhar) com um indice
+// nome -> posicao, em vez de procurar o nome comparando um por um.
+// Remover troca o sprite com o ultimo do vetor, entao a ordem de desenho dos
+// que sobram pode mudar.
+struct SpriteRegistry {
+    std::vector<Sprite> sprites;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, size_t> index;
+
+    Sprite* find(const std::string& name) {
+        auto it = index.find(name);
+        return it == index.end() ? nullptr : &sprites[it->second];
+    }
 
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
+    bool add(const std::string& name, const Sprite& sprite) {
+        if (!index.emplace(name, sprites.size()).second) return false;
+        sprites.push_back(sprite);
+        names.push_back(name);
+        return true;
+    }
 
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-        glEnableVertexAttribArray(1);
+    bool remove(const std::string& name) {
+        auto it = index.find(name);
+        if (it == index.end()) return false;
 
-        glBindVertexArray(0);
+        size_t i = it->second, last = sprites.size() - 1;
+        if (i != last) {
+            sprites[i] = sprites[last];
+            names[i] = std::move(names[last]);
+            index[names[i]] = i;
+        }
+        sprites.pop_back();
+        names.pop_back();
+        index.erase(it);
+        return true;
     }
 
-    void draw(glm::mat4& projection) {
-        if (!visible) return;
-
-        glUseProgram(shaderProgram);
+    void clear() {
+        sprites.clear();
+        names.clear();
+        index.clear();
+    }
+};
 
-        glm::mat4 model = glm::mat4(1.0f);
-        model = glm::translate(model, glm::vec3(position, 0.0f));
-        model = glm::rotate(model, glm::radians(rotation), glm::vec3(0.0f, 0.0f, 1.0f));
-        model = glm::scale(model, glm::vec3(scale, 1.0f));
+// imagem com adesivos e o normal map gerado para ela
+struct SpriteSheet {
+    GLuint texture, normalMap;
+    float width, height;
+};
 
-        GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
-        GLint projLoc = glGetUniformLocation(shaderProgram, "projection");
+// recorte de um adesivo dentro de um sprite sheet (em pixels, y para baixo)
+struct Sticker {
+    float x, y, w, h;
+    int sheet; // 0 = exterior.png, 1 = Doors_windows_animation.png
+    const QuadMesh* mesh = nullptr; // mesh justo tracado do alfa do recorte
+    SpriteAlpha alpha = SPRITE_TRANSLUCENT;
+};
 
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
-        glUniformMatrix4fv(projLoc, 1, GL_FALSE, &projection[0][0]);
+// luz com nome (comandos light/unlight); as tochas oscilam
+struct SceneLight {
+    std::string name;
+    Light2D light;
+    bool flicker;
+};
 
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureID);
+// tempo maximo por frame aplicando comandos do console; o que sobrar fica para o proximo
+const double CONSOLE_BUDGET_S = 0.002;
 
-        glBindVertexArray(VAO);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    }
-};
+void printHelp() {
+    std::cout << "Comandos:\n"
+              << "  add <nome> <adesivo> <x> <y>   adesivos: house tree fence scarecrow window\n"
+              << "  remove <nome> | toggle <nome> | show <nome> | hide <nome>\n"
+              << "  scale <nome> <fator> | move <nome> <x> <y>\n"
+              << "  light <nome> <x> <y> [raio] [r g b] | unlight <nome> | lights on|off | ambient <r> [g b]\n"
+              << "  list | stats | clear | help | quit\n";
+}
 
-int main()
+int main(int argc, char** argv)
 {
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -199,69 +322,269 @@ int main()
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     stbi_set_flip_vertically_on_load(true);
 
-    GLuint shaderProgram = createShaderProgram();
-    GLuint textureBG = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/8bitLib/PNG/grass.png");
-    GLuint textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/8bitLib/PNG/exterior.png");
+    // opacos e translucidos sem discard; recortes com discard (escrevem profundidade)
+    GLuint shaderProgram = createShaderProgram(false);
+    GLuint cutoutProgram = createShaderProgram(true);
+    GLuint normalBG = 0;
+    std::vector<unsigned char> pixelsBG;
+    GLuint textureBG = loadTexture("8bitLib/PNG/grass.png", &normalBG, &pixelsBG);
+    SpriteSheet sheets[2];
+    std::vector<unsigned char> sheetPixels[2];
+    sheets[0] = { 0, 0, 240.0f, 800.0f };
+    sheets[0].texture = loadTexture("8bitLib/PNG/exterior.png", &sheets[0].normalMap, &sheetPixels[0]);
+    sheets[1] = { 0, 0, 272.0f, 192.0f };
+    sheets[1].texture = loadTexture("8bitLib/Tiled_files/Doors_windows_animation.png", &sheets[1].normalMap, &sheetPixels[1]);
 
     glm::mat4 projection = glm::ortho(0.0f, 800.0f, 0.0f, 600.0f, -1.0f, 1.0f);
+    for (GLuint program : { shaderProgram, cutoutProgram }) {
+        glUseProgram(program);
+        glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, &projection[0][0]);
+        glUniform1i(glGetUniformLocation(program, "texture1"), 0);
+        glUniform1i(glGetUniformLocation(program, "normalMap"), 1);
+    }
 
-    Sprite background(shaderProgram, textureBG, glm::vec2(0,0), glm::vec2(1,1));
+    QuadMesh quad;
+    quad.init();
+    // opacos e recortes primeiro, da frente para tras com depth test (o fundo
+    // so eh pintado onde nenhum adesivo ja pintou); so os translucidos com blending
+    RenderQueue renderQueue;
+    renderQueue.depthTest = true;
+
+    Sprite background(shaderProgram, textureBG, glm::vec2(0,0), glm::vec2(1,1), normalBG);
     background.position = glm::vec2(400, 300);
     background.scale = glm::vec2(800, 600);
+    // a imagem inteira como uma linha so
+    int pixelCountBG = (int)pixelsBG.size() / 4;
+    background.alpha = pixelCountBG > 0 ? classifySpriteAlpha(pixelsBG.data(), pixelCountBG, 0, 0, pixelCountBG, 1)
+                                        : SPRITE_TRANSLUCENT;
+    if (background.alpha == SPRITE_CUTOUT)
+        background.shaderProgram = cutoutProgram;
+
+    std::unordered_map<std::string, Sticker> stickers = {
+        { "house", { 0, 0, 145, 128, 0 } },
+        { "tree", { 0, 315, 61, 79, 0 } },
+        { "fence", { 160, 0, 39, 64, 0 } },
+        { "scarecrow", { 0, 542, 58, 61, 0 } },
+        { "window", { 105, 3, 17, 20, 1 } },
+    };
+
+    // um mesh por adesivo, tracado uma vez do alfa da folha: o blending so
+    // passa pelos pixels do contorno, nao pelo retangulo todo. A folha foi
+    // carregada de cabeca para baixo, entao o recorte comeca na linha
+    // height - (y + h) e o ponto (0, 0) do mesh eh o canto de baixo (uvMin)
+    std::vector<QuadMesh> stickerMeshes(stickers.size());
+    size_t meshIndex = 0;
+    for (auto& entry : stickers) {
+        Sticker& st = entry.second;
+        const std::vector<unsigned char>& pixels = sheetPixels[st.sheet];
+        SpriteMesh mesh;
+        if (!pixels.empty())
+            traceSpriteMesh(pixels.data(), (int)sheets[st.sheet].width, (int)st.x,
+                            (int)(sheets[st.sheet].height - st.y - st.h), (int)st.w, (int)st.h, 16, mesh);
+        if (mesh.indices.empty())
+            mesh.quad();
+        stickerMeshes[meshIndex].init(mesh);
+        st.mesh = &stickerMeshes[meshIndex++];
+        if (!pixels.empty())
+            st.alpha = mesh.alpha;
+        static const char* alphaNames[] = { "opaco", "recorte", "translucido" };
+        std::cout << "adesivo " << entry.first << ": " << mesh.points.size() << " vertices, "
+                  << (int)std::lround(mesh.coverage * 100.0f) << "% do quad, " << alphaNames[st.alpha] << std::endl;
+    }
 
-    std::vector<std::pair<std::string, Sprite>> sprites;
+    SpriteRegistry scene;
 
     // Adesivos:
-    auto add_sprite = [&](const std::string& name, float x, float y, float w, float h, float posX, float posY) {
-        glm::vec2 uv_min(x/240.0f, 1.0f - (y+h)/800.0f);
-        glm::vec2 uv_max((x+w)/240.0f, 1.0f - y/800.0f);
-        Sprite spr(shaderProgram, textureID, uv_min, uv_max);
+    auto add_sprite = [&](const std::string& name, const Sticker& st, float posX, float posY) {
+        const SpriteSheet& sheet = sheets[st.sheet];
+        glm::vec2 uv_min(st.x/sheet.width, 1.0f - (st.y+st.h)/sheet.height);
+        glm::vec2 uv_max((st.x+st.w)/sheet.width, 1.0f - st.y/sheet.height);
+        Sprite spr(st.alpha == SPRITE_CUTOUT ? cutoutProgram : shaderProgram, sheet.texture, uv_min, uv_max,
+                   sheet.normalMap);
+        spr.mesh = st.mesh;
+        spr.alpha = st.alpha;
         spr.position = glm::vec2(posX, posY);
-        spr.scale = glm::vec2(w*2, h*2);
-        sprites.push_back({name, spr});
+        spr.scale = glm::vec2(st.w*2, st.h*2);
+        return scene.add(name, spr);
     };
 
-    add_sprite("house", 0, 0, 145, 128, 400, 300);
-    add_sprite("tree", 0, 315, 61, 79, 200, 250);
-    add_sprite("fence", 160, 0, 39, 64, 600, 100);
-    add_sprite("scarecrow", 0, 542, 58, 61, 550, 500);
+    add_sprite("house", stickers["house"], 400, 300);
+    add_sprite("tree", stickers["tree"], 200, 250);
+    add_sprite("fence", stickers["fence"], 600, 100);
+    add_sprite("scarecrow", stickers["scarecrow"], 550, 500);
 
-    while (!glfwWindowShouldClose(window))
-    {
-        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+    // fim de tarde: as janelas da casa acesas e uma tocha no espantalho
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    Lighting2D lighting;
+    if (!lighting.init(fbWidth, fbHeight))
+        return -1;
+    lighting.ambient = glm::vec3(0.35f, 0.35f, 0.5f);
+    bool lightsOn = true;
+    std::vector<SceneLight> sceneLights = {
+        { "janela1", { glm::vec2(345, 285), 170.0f, glm::vec3(1.6f, 1.1f, 0.5f), 40.0f }, false },
+        { "janela2", { glm::vec2(455, 285), 170.0f, glm::vec3(1.6f, 1.1f, 0.5f), 40.0f }, false },
+        { "tocha", { glm::vec2(590, 520), 170.0f, glm::vec3(1.3f, 0.7f, 0.3f), 30.0f }, true },
+    };
+    add_sprite("janela1", stickers["window"], 345, 285);
+    add_sprite("janela2", stickers["window"], 455, 285);
 
-        background.draw(projection);
-        for (auto& sp : sprites) sp.second.draw(projection);
+    // Console em outra thread: o render nunca espera o usuario digitar.
+    // Uso: cenaSprites [script.txt] (o script roda antes do terminal)
+    Console console;
+    if (!console.start(argc > 1 ? argv[1] : ""))
+        return -1;
+    printHelp();
+
+    size_t commandsApplied = 0;
+    double statsStart = glfwGetTime();
+    AllocationMeter allocations;
+
+    // chaves para as buscas por nome, reaproveitadas entre comandos (a string
+    // so aloca quando aparece um nome maior que todos os anteriores)
+    std::string name, stickerName;
+
+    // aplica um comando; so o comando errado eh avisado, o resto eh silencioso
+    // para scripts com milhares de linhas nao encherem o terminal
+    auto apply = [&](const ConsoleCommand& cmd) {
+        name.assign(cmd.word(1));
+        Sprite* spr = nullptr;
+        if (cmd.is("toggle") || cmd.is("show") || cmd.is("hide") || cmd.is("scale") || cmd.is("move")) {
+            spr = scene.find(name);
+            if (!spr) {
+                std::cout << "sprite nao encontrado: " << name << std::endl;
+                return;
+            }
+        }
 
-        glfwSwapBuffers(window);
+        if (cmd.is("add")) {
+            stickerName.assign(cmd.word(2));
+            auto st = stickers.find(stickerName);
+            if (cmd.count < 5 || st == stickers.end())
+                std::cout << "uso: add <nome> <adesivo> <x> <y>" << std::endl;
+            else if (!add_sprite(name, st->second, cmd.number(3), cmd.number(4)))
+                std::cout << "ja existe um sprite chamado " << name << std::endl;
+        } else if (cmd.is("remove")) {
+            if (!scene.remove(name))
+                std::cout << "sprite nao encontrado: " << name << std::endl;
+        } else if (cmd.is("toggle")) {
+            spr->visible = !spr->visible;
+        } else if (cmd.is("show") || cmd.is("hide")) {
+            spr->visible = cmd.is("show");
+        } else if (cmd.is("scale")) {
+            float scale = cmd.number(2, 1.0f);
+            spr->scale = glm::vec2(spr->scale.x * scale, spr->scale.y * scale);
+        } else if (cmd.is("move")) {
+            spr->position = glm::vec2(cmd.number(2, spr->position.x), cmd.number(3, spr->position.y));
+        } else if (cmd.is("list")) {
+            std::cout << "\nAvailable sprites:\n";
+            for (size_t i = 0; i < scene.sprites.size(); ++i)
+                std::cout << scene.names[i] << " (visible: " << (scene.sprites[i].visible ? "yes" : "no") << ", scale: "
+                          << scene.sprites[i].scale.x << ")\n";
+            std::cout << std::flush;
+        } else if (cmd.is("stats")) {
+            double elapsed = glfwGetTime() - statsStart;
+            std::cout << scene.sprites.size() << " sprites, " << commandsApplied << " comandos em "
+                      << elapsed << " s (" << commandsApplied / elapsed << " comandos/s), "
+                      << allocations.last << " alocacoes no ultimo frame (pior: " << allocations.worst << ")" << std::endl;
+            // antes da fila cada sprite fazia glUseProgram + glBindTexture + glBindVertexArray + draw
+            const RenderQueueStats& rs = renderQueue.stats;
+            std::cout << "render: " << rs.packets << " pacotes, " << rs.drawCalls << " draws e " << rs.stateChanges()
+                      << " trocas de estado por frame (um draw por sprite: " << rs.packets << " draws e "
+                      << 3 * rs.packets << " trocas), " << rs.translucentPackets << " translucidos com blending"
+                      << std::endl;
+            if (lightsOn)
+                std::cout << "luz: " << lighting.visibleLights << " luzes visiveis, " << lighting.lightTilePairs
+                          << " pares luz-tile (maximo " << lighting.maxLightsPerTile << " por tile), agrupar "
+                          << lighting.binMs << " ms" << std::endl;
+        } else if (cmd.is("light")) {
+            if (cmd.count < 4) {
+                std::cout << "uso: light <nome> <x> <y> [raio] [r g b]" << std::endl;
+                return;
+            }
+            auto it = std::find_if(sceneLights.begin(), sceneLights.end(),
+                                   [&](const SceneLight& l) { return l.name == name; });
+            if (it == sceneLights.end())
+                it = sceneLights.insert(it, { name, { glm::vec2(0.0f), 150.0f, glm::vec3(1.0f), 40.0f }, false });
+            SceneLight* light = &*it;
+            light->light.position = glm::vec2(cmd.number(2), cmd.number(3));
+            light->light.radius = cmd.number(4, light->light.radius);
+            light->light.color = glm::vec3(cmd.number(5, light->light.color.r), cmd.number(6, light->light.color.g),
+                                           cmd.number(7, light->light.color.b));
+        } else if (cmd.is("unlight")) {
+            auto it = std::find_if(sceneLights.begin(), sceneLights.end(),
+                                   [&](const SceneLight& l) { return l.name == name; });
+            if (it == sceneLights.end())
+                std::cout << "luz nao encontrada: " << name << std::endl;
+            else
+                sceneLights.erase(it);
+        } else if (cmd.is("lights")) {
+            lightsOn = name != "off";
+        } else if (cmd.is("ambient")) {
+            float r = cmd.number(1, lighting.ambient.r);
+            lighting.ambient = glm::vec3(r, cmd.number(2, r), cmd.number(3, r));
+        } else if (cmd.is("clear")) {
+            scene.clear();
+        } else if (cmd.is("help")) {
+            printHelp();
+        } else if (cmd.is("quit")) {
+            glfwSetWindowShouldClose(window, true);
+        } else {
+            std::cout << "comando desconhecido: " << cmd.word(0) << std::endl;
+        }
+    };
+
+    while (!glfwWindowShouldClose(window))
+    {
+        allocations.frame();
         glfwPollEvents();
 
-        // Terminal control
-        std::cout << "\nAvailable sprites:\n";
-        for (auto& sp : sprites) {
-            std::cout << sp.first << " (visible: " << (sp.second.visible ? "yes" : "no") << ", scale: "
-                      << sp.second.scale.x << ")\n";
+        // comandos entram so na fronteira do frame, com limite de tempo
+        ConsoleCommand cmd;
+        double budgetEnd = glfwGetTime() + CONSOLE_BUDGET_S;
+        while (glfwGetTime() < budgetEnd && console.poll(cmd)) {
+            apply(cmd);
+            commandsApplied++;
         }
-        std::cout << "Enter sprite name to toggle/scale (or 'skip'):\n";
-        std::string input;
-        std::cin >> input;
-        if (input == "skip") continue;
-
-        for (auto& sp : sprites) {
-            if (sp.first == input) {
-                std::cout << "1) Toggle visibility\n2) Change scale\nChoice: ";
-                int choice; std::cin >> choice;
-                if (choice == 1) {
-                    sp.second.visible = !sp.second.visible;
-                } else if (choice == 2) {
-                    std::cout << "Enter new scale factor (0.1 - 2.0): ";
-                    float scale; std::cin >> scale;
-                    sp.second.scale = glm::vec2(sp.second.scale.x * scale, sp.second.scale.y * scale);
+
+        if (lightsOn) {
+            float t = (float)glfwGetTime();
+            lighting.lights.clear();
+            for (const SceneLight& l : sceneLights) {
+                Light2D light = l.light;
+                if (l.flicker) {
+                    float f = 0.9f + 0.1f * std::sin(t * 13.0f) * std::sin(t * 7.3f);
+                    light.radius *= f;
+                    light.color *= f;
                 }
+                lighting.lights.push_back(light);
             }
+            lighting.beginScene(glm::vec4(0.2f, 0.3f, 0.3f, 1.0f));
+        } else {
+            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         }
+
+        // fundo na camada 0; adesivos na 1, na ordem do registro (o primeiro fica atras)
+        background.submit(renderQueue, quad, 0, 0.0f);
+        size_t count = scene.sprites.size();
+        for (size_t i = 0; i < count; ++i)
+            scene.sprites[i].submit(renderQueue, quad, 1, 1.0f - (float)i / count);
+        renderQueue.execute();
+        if (lightsOn)
+            lighting.endScene(projection);
+
+        glfwSwapBuffers(window);
     }
+    console.stop();
+    scene.clear();
+    renderQueue.destroy();
+    lighting.destroy();
+    glDeleteTextures(1, &normalBG);
+    for (const SpriteSheet& sheet : sheets)
+        glDeleteTextures(1, &sheet.normalMap);
+    quad = QuadMesh();
+    stickerMeshes.clear();
     glfwTerminate();
     return 0;
 }
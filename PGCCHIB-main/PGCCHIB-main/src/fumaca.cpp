@@ -0,0 +1,152 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+#include "ParticleSystem.h"
+#include "Input.h"
+#include "AssetImage.h"
+
+// tamanho da janela (o mundo eh em pixels)
+const unsigned int SCR_WIDTH = 800;
+const unsigned int SCR_HEIGHT = 600;
+
+// Smoke_animation.png: 6 frames de 48x48 lado a lado; a fumaca ocupa a parte de
+// cima de cada frame (x de 4 a 32, y de 0 a 28), embaixo fica a chamine
+const int SHEET_FRAMES = 6;
+const float FRAME_PIXELS = 48.0f;
+
+enum Action { ACTION_SWITCH_BACKEND, ACTION_TOGGLE_EMIT, ACTION_QUIT };
+
+GLuint loadTexture(const char* path) {
+    int width, height, channels;
+    unsigned char* data = loadImageAsset(path, &width, &height, &channels, 4);
+    if (!data) {
+        std::cout << "Falha ao carregar textura " << path << std::endl;
+        return 0;
+    }
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    stbi_image_free(data);
+    return texture;
+}
+
+// Fumaca com o ParticleSystem. Uso: fumaca [numero de particulas] (padrao 1M)
+// B troca entre CPU (SSE) e GPU (transform feedback), espaco liga/desliga a
+// emissao e a fumaca sai de onde estiver o mouse.
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? (size_t)strtoul(argv[1], NULL, 10) : 1000000;
+
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "fumaca", NULL, NULL);
+    if (window == NULL) {
+        std::cout << "failed to create glfw window\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+    glfwSwapInterval(0);
+
+    Input input;
+    input.install(window);
+    input.bindKey(GLFW_KEY_B, ACTION_SWITCH_BACKEND);
+    input.bindKey(GLFW_KEY_SPACE, ACTION_TOGGLE_EMIT);
+    input.bindKey(GLFW_KEY_ESCAPE, ACTION_QUIT);
+
+    stbi_set_flip_vertically_on_load(true);
+    ParticleSystem smoke;
+    smoke.sheet.texture = loadTexture("8bitLib/PNG/Smoke_animation.png");
+    smoke.sheet.frames = SHEET_FRAMES;
+    // com a imagem virada o y = 0 do arquivo vira v = 1
+    float frameU = 1.0f / SHEET_FRAMES;
+    smoke.sheet.rect = glm::vec4(4.0f / FRAME_PIXELS * frameU, 1.0f - 28.0f / FRAME_PIXELS,
+                                 32.0f / FRAME_PIXELS * frameU, 1.0f);
+    smoke.size = 28.0f;
+
+    smoke.emitter.position = glm::vec2(SCR_WIDTH * 0.5f, 80.0f);
+    smoke.emitter.radius = 12.0f;
+    smoke.emitter.velocity = glm::vec2(0.0f, 90.0f);
+    smoke.emitter.velocitySpread = glm::vec2(40.0f, 30.0f);
+    smoke.emitter.acceleration = glm::vec2(0.0f, 25.0f);
+    smoke.emitter.drag = 0.4f;
+    smoke.emitter.minLife = 2.0f;
+    smoke.emitter.maxLife = 5.0f;
+
+    ParticleBackend backend = PARTICLES_GPU;
+    if (!smoke.init(count, backend)) return -1;
+
+    glm::mat4 projection = glm::ortho(0.0f, (float)SCR_WIDTH, 0.0f, (float)SCR_HEIGHT, -1.0f, 1.0f);
+
+    double lastTime = glfwGetTime();
+    double titleTime = lastTime;
+    int titleFrames = 0;
+
+    while (!glfwWindowShouldClose(window)) {
+        double now = glfwGetTime();
+        float dt = (float)(now - lastTime);
+        lastTime = now;
+        // limita o passo depois de travadas (arrastar a janela etc.)
+        if (dt > 0.1f) dt = 0.1f;
+
+        glfwPollEvents();
+        input.beginFrame(dt);
+        if (input.pressed(ACTION_QUIT)) glfwSetWindowShouldClose(window, true);
+        if (input.pressed(ACTION_TOGGLE_EMIT)) smoke.emitter.emitting = !smoke.emitter.emitting;
+        if (input.pressed(ACTION_SWITCH_BACKEND)) {
+            backend = backend == PARTICLES_GPU ? PARTICLES_CPU : PARTICLES_GPU;
+            if (!smoke.init(count, backend)) return -1;
+        }
+
+        // a fumaca sai do mouse (y da janela eh para baixo) e o vento oscila
+        int winW, winH;
+        glfwGetWindowSize(window, &winW, &winH);
+        if (winW > 0 && winH > 0)
+            smoke.emitter.position = glm::vec2(input.cursorX * SCR_WIDTH / winW, SCR_HEIGHT - input.cursorY * SCR_HEIGHT / winH);
+        smoke.emitter.acceleration.x = 20.0f * std::sin((float)now * 0.5f);
+
+        smoke.update(dt);
+
+        int fbW, fbH;
+        glfwGetFramebufferSize(window, &fbW, &fbH);
+        glViewport(0, 0, fbW, fbH);
+        glClearColor(0.45f, 0.65f, 0.85f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        smoke.draw(projection, (float)fbH / SCR_HEIGHT);
+
+        glfwSwapBuffers(window);
+
+        titleFrames++;
+        if (now - titleTime >= 0.5) {
+            char title[128];
+            snprintf(title, sizeof(title), "fumaca -- %zu particulas (%s) -- FPS %.1f", smoke.count(),
+                     backend == PARTICLES_GPU ? "GPU" : "CPU", titleFrames / (now - titleTime));
+            glfwSetWindowTitle(window, title);
+            titleTime = now;
+            titleFrames = 0;
+        }
+    }
+
+    smoke.destroy();
+    glDeleteTextures(1, &smoke.sheet.texture);
+    glfwTerminate();
+    return 0;
+}
@@ -36,6 +36,10 @@ int currentPlayer = 1; // seleciona player 1 ou 2
 int scorePlayer1 = 0, scorePlayer2 = 0;   //guarda score
 bool gameOver = false;  //seta final do jogo
 
+// a tela so muda com clique ou hover: o laco dorme ate um evento e so
+// redesenha quando alguem marcar isso aqui
+bool needsRedraw = true;
+
 // Botão reiniciar na parte inferior
 struct Button {
     float x, y, width, height;
@@ -73,6 +77,7 @@ void generateGrid() {    //gera a grade com os retangulos de cor aleatoria
     scorePlayer1 = 0;
     scorePlayer2 = 0;
     gameOver = false;
+    needsRedraw = true;
 }
 
 void drawRectangle(const Rectangle& rect) {   //desenha retangulo na tela
@@ -143,6 +148,7 @@ void processClick(double xpos, double ypos) {
                 if (other.visible && selectedColor.distance(other.color) < SIMILARITY_THRESHOLD) {
                     other.visible = false;
                     removed++;
+                    needsRedraw = true;
                 }
             }
 
@@ -182,12 +188,12 @@ void cursorPositionCallback(GLFWwindow* window, double xpos, double ypos) {  //d
     float x, y;
     cursorPosToGLCoords(xpos, ypos, x, y);
 
-    // atualiza hover do botão
-    if (x >= restartButton.x && x <= restartButton.x + restartButton.width &&
-        y >= restartButton.y && y <= restartButton.y + restartButton.height) {
-        restartButton.hovered = true;
-    } else {
-        restartButton.hovered = false;
+    // atualiza hover do botão (so redesenha quando entra ou sai dele)
+    bool hovered = x >= restartButton.x && x <= restartButton.x + restartButton.width &&
+                   y >= restartButton.y && y <= restartButton.y + restartButton.height;
+    if (hovered != restartButton.hovered) {
+        restartButton.hovered = hovered;
+        needsRedraw = true;
     }
 }
 
@@ -225,15 +231,25 @@ int main() {  //funcao principal para rodar o jogo
     });
 
     glfwSetCursorPosCallback(window, cursorPositionCallback);
+    // janela descoberta ou redimensionada: o back buffer nao vale mais
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* window) {
+        needsRedraw = true;
+    });
 
     while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT);
+        // redesenho inteiro (sem FBO no GL 1.x nao da para guardar a tela entre frames),
+        // mas so quando algo mudou
+        if (needsRedraw) {
+            glClear(GL_COLOR_BUFFER_BIT);
 
-        for (const Rectangle& rect : grid) drawRectangle(rect);
-        drawButton(restartButton);
+            for (const Rectangle& rect : grid) drawRectangle(rect);
+            drawButton(restartButton);
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            glfwSwapBuffers(window);
+            needsRedraw = false;
+        }
+        // dorme ate chegar um evento (CPU parada em vez de 100%)
+        glfwWaitEvents();
     }
 
     glfwTerminate();
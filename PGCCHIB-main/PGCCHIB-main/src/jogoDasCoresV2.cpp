@@ -7,17 +7,16 @@
 #include <cstdlib>
 #include <ctime>
 #include <cmath>
+#include <string>
+#include <cstdio>
 
-// estrutura de cor
-struct Color {
-    float r, g, b;
-
-    float distance(const Color& other) const { //calculo da distancia euclidiana
-        return sqrtf((r - other.r) * (r - other.r) + 
-                     (g - other.g) * (g - other.g) + 
-                     (b - other.b) * (b - other.b));
-    }
-};
+#include "TextRenderer.h"
+#include "Transform2D.h"
+#include "FrameArena.h"
+#include "AllocationCounter.h"
+#include "RedrawScheduler.h"
+#include "ColorGame.h"
+#include "ColorBot.h"
 
 struct Rectangle {  //representacao do retangulo
     float x, y, width, height;
@@ -25,18 +24,15 @@ struct Rectangle {  //representacao do retangulo
     bool visible = true;
 };
 
-// constantes do jogo
-const int ROWS = 6, COLS = 8;
-const float SIMILARITY_THRESHOLD = 0.25f;
-const int MAX_ATTEMPTS = 6;
+// regras e estado da partida (grade, tentativas, placar) ficam no ColorGame;
+// aqui so a janela, o desenho e o input
+ColorGame game;
+GameRng rng;
 
-std::vector<Rectangle> grid;  //grade 
-
-Color selectedColor = {-1, -1, -1};  //cor selecionada
-int attempts = 0;   //variaveis do jogo
-int currentPlayer = 1;
-int scorePlayer1 = 0, scorePlayer2 = 0;
-bool gameOver = false;
+// H mostra a melhor jogada (borda branca), B liga o bot como jogador 2
+ColorBot bot;
+bool botEnabled = false;
+int hintCell = -1;
 
 struct Button {  //botao de reinicio
     float x, y, width, height;
@@ -46,31 +42,42 @@ struct Button {  //botao de reinicio
 
 unsigned int shaderProgram, VAO;  //shader e vao dos retangulos
 
-void generateGrid() {  
-    grid.clear();   //limpa grade
-    for (int i = 0; i < ROWS; ++i) {
-        for (int j = 0; j < COLS; ++j) {
-            Rectangle rect;
-            rect.x = -1.0f + j * 0.25f;
-            rect.y = 1.0f - i * 0.25f - 0.25f;
-            rect.width = 0.2f;
-            rect.height = 0.2f;
-
-            //gera cores claras aleatorias
-            float r = 0.5f + static_cast<float>(rand()) / RAND_MAX * 0.5f;
-            float g = 0.5f + static_cast<float>(rand()) / RAND_MAX * 0.5f;
-            float b = 0.5f + static_cast<float>(rand()) / RAND_MAX * 0.5f;
-
-            rect.color = {r, g, b};
-            grid.push_back(rect);
-        }
-    }
-    attempts = 0;   //reinicia jogo
-    selectedColor = {-1, -1, -1};
-    currentPlayer = 1;
-    scorePlayer1 = 0;
-    scorePlayer2 = 0;
-    gameOver = false;
+TextRenderer hud;          //placar e mensagens na tela
+std::string lastMessage;   //ultima mensagem do jogo (tambem vai para o terminal)
+
+// so redesenha o que mudou; cada mudanca de estado marca a sua area
+RedrawScheduler redraw;
+
+// tudo abaixo da grade: placar, mensagens e botao (o texto fica em pixels fixos,
+// entao em janela pequena ele desce ate o botao)
+void invalidateHud() {
+    redraw.invalidateNdc(-1.0f, -1.0f, 1.0f, -0.5f);
+}
+
+void report(const char* message) {
+    std::cout << message << "\n";
+    lastMessage = message;
+    invalidateHud();
+}
+
+// retangulo da celula na tela (NDC): 8 colunas de 0.25 a partir do canto de cima
+Rectangle cellRect(int cell) {
+    int i = cell / ColorGame::COLS, j = cell % ColorGame::COLS;
+    Rectangle rect;
+    rect.x = -1.0f + j * 0.25f;
+    rect.y = 1.0f - i * 0.25f - 0.25f;
+    rect.width = 0.2f;
+    rect.height = 0.2f;
+    rect.color = game.colors[cell];
+    rect.visible = game.cellVisible(cell);
+    return rect;
+}
+
+void generateGrid() {
+    game.reset(rng);   //cores novas e placar zerado
+    lastMessage.clear();
+    hintCell = -1;
+    redraw.invalidateAll();
 }
 
 void cursorPosToGLCoords(double xpos, double ypos, float &xOut, float &yOut) {  //converte coordenadas do mouse
@@ -78,6 +85,72 @@ void cursorPosToGLCoords(double xpos, double ypos, float &xOut, float &yOut) {
     yOut = 1.0f - static_cast<float>(ypos) / 300.0f;
 }
 
+// borda da dica: um pouco maior que a celula, desenhada antes dela
+Rectangle hintRect(int cell) {
+    Rectangle rect = cellRect(cell);
+    const float border = 0.015f;
+    rect.x -= border;
+    rect.y -= border;
+    rect.width += 2.0f * border;
+    rect.height += 2.0f * border;
+    rect.color = {1.0f, 1.0f, 1.0f};
+    return rect;
+}
+
+void setHint(int cell) {
+    if (hintCell >= 0) {
+        Rectangle old = hintRect(hintCell);
+        redraw.invalidateNdc(old.x, old.y, old.x + old.width, old.y + old.height);
+    }
+    hintCell = cell;
+    if (hintCell >= 0) {
+        Rectangle rect = hintRect(hintCell);
+        redraw.invalidateNdc(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+    }
+}
+
+// joga a celula pelo jogador da vez (clique ou bot) e marca o que mudou
+void playCell(int cell) {
+    int player = game.currentPlayer;
+    int points = game.play(cell);  //remove as cores parecidas e pontua
+    if (points < 0) {
+        invalidateHud();
+        return;
+    }
+    setHint(-1);
+
+    for (uint64_t bits = game.lastRemoved; bits; bits &= bits - 1) {
+        Rectangle removed = cellRect(lowestBit(bits));
+        redraw.invalidateNdc(removed.x, removed.y, removed.x + removed.width, removed.y + removed.height);
+    }
+    report(frameArena().format("Jogador %d fez %d pontos.", player, points));
+
+    if (game.gameOver) {
+        int winner = game.winner();
+        if (winner == 1)
+            report("Jogo acabou! Jogador 1 venceu!");
+        else if (winner == 2)
+            report("Jogo acabou! Jogador 2 venceu!");
+        else
+            report("Jogo acabou! Empate!");
+    }
+}
+
+void playBot() {
+    int cell = bot.chooseMove(game);
+    printf("bot: profundidade %d%s, %ld nos, saldo %+d, %.2f ms\n", bot.depthReached,
+           bot.solved ? " (exata)" : "", bot.nodes, bot.bestValue, bot.lastMs);
+    if (cell >= 0) playCell(cell);
+}
+
+void showHint() {
+    if (game.gameOver) return;
+    int cell = bot.chooseMove(game);
+    setHint(cell);
+    if (cell >= 0)
+        report(frameArena().format("Dica: a celula com borda (saldo %+d ate o fim).", bot.bestValue));
+}
+
 void processClick(double xpos, double ypos) {
     float x, y;
     cursorPosToGLCoords(xpos, ypos, x, y);
@@ -85,59 +158,23 @@ void processClick(double xpos, double ypos) {
     if (x >= restartButton.x && x <= restartButton.x + restartButton.width &&  //reconhece clique no botao de reinicio
         y >= restartButton.y && y <= restartButton.y + restartButton.height) {
         generateGrid();
-        std::cout << "Jogo reiniciado pelo botao.\n";
-        return;
-    }
-
-    if (gameOver) {
-        std::cout << "O jogo acabou. Reinicie para jogar novamente usando o clique direito do mouse ou o botao azul na parte inferior da tela.\n";
+        report("Jogo reiniciado pelo botão.");
         return;
     }
 
-    if (attempts >= MAX_ATTEMPTS) {  //maximo de tentativas
-        gameOver = true;
+    if (game.gameOver) {
+        report("O jogo acabou. Reinicie com o clique direito ou o botão azul.");
         return;
     }
 
-    for (Rectangle& rect : grid) {
+    for (int cell = 0; cell < ColorGame::CELLS; ++cell) {
+        Rectangle rect = cellRect(cell);
         if (rect.visible &&
             x >= rect.x && x <= rect.x + rect.width &&
             y >= rect.y && y <= rect.y + rect.height) {
-            
-            selectedColor = rect.color;
-            int removed = 0;
-
-            for (Rectangle& other : grid) {  //remove retangulos similares
-                if (other.visible && selectedColor.distance(other.color) < SIMILARITY_THRESHOLD) {
-                    other.visible = false;
-                    removed++;
-                }
-            }
-
-            int points = std::max(0, removed * 10 - attempts * 5);  //calculo de pontos
-
-            if (currentPlayer == 1) {
-                scorePlayer1 += points;
-            } else {
-                scorePlayer2 += points;
-            }
-
-            attempts++;
-            std::cout << "Jogador " << currentPlayer << " fez " << points << " pontos. "
-                      << "Placar: Jogador1 = " << scorePlayer1 << ", Jogador2 = " << scorePlayer2 << "\n";
-
-            if (attempts >= MAX_ATTEMPTS) {
-                gameOver = true;
-                std::cout << "Jogo acabou! ";
-                if (scorePlayer1 > scorePlayer2)
-                    std::cout << "Jogador 1 venceu!\n";
-                else if (scorePlayer2 > scorePlayer1)
-                    std::cout << "Jogador 2 venceu!\n";
-                else
-                    std::cout << "Empate!\n";
-            }
-
-            currentPlayer = (currentPlayer == 1) ? 2 : 1;
+            playCell(cell);
+            if (botEnabled && !game.gameOver && game.currentPlayer == 2)
+                playBot();
             break;
         }
     }
@@ -147,8 +184,14 @@ void cursorPositionCallback(GLFWwindow* window, double xpos, double ypos) {
     float x, y;
     cursorPosToGLCoords(xpos, ypos, x, y);
 
-    restartButton.hovered = (x >= restartButton.x && x <= restartButton.x + restartButton.width &&
-                             y >= restartButton.y && y <= restartButton.y + restartButton.height);
+    bool hovered = (x >= restartButton.x && x <= restartButton.x + restartButton.width &&
+                    y >= restartButton.y && y <= restartButton.y + restartButton.height);
+    // mexer o mouse fora do botao nao muda nada na tela
+    if (hovered != restartButton.hovered) {
+        restartButton.hovered = hovered;
+        redraw.invalidateNdc(restartButton.x, restartButton.y,
+                             restartButton.x + restartButton.width, restartButton.y + restartButton.height);
+    }
 }
 
 void setupRectangle() { 
@@ -182,9 +225,9 @@ void setupShader() {
     const char* vertexShaderSrc = R"(
         #version 330 core
         layout (location = 0) in vec2 aPos;
-        uniform mat4 model;
+        uniform mat3x2 model;
         void main() {
-            gl_Position = model * vec4(aPos, 0.0, 1.0);
+            gl_Position = vec4(model * vec3(aPos, 1.0), 0.0, 1.0);
         }
     )";
 
@@ -214,11 +257,15 @@ void drawRectangle(const Rectangle& rect) {  //desenho dos retangulos
 
     glUseProgram(shaderProgram);
 
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(rect.x, rect.y, 0.0f));
-    model = glm::scale(model, glm::vec3(rect.width, rect.height, 1.0f));
+    // so translada e escala: a matriz afim sai direto, sem seno nem cosseno
+    Affine2D model;
+    model.a = rect.width;
+    model.d = rect.height;
+    model.tx = rect.x;
+    model.ty = rect.y;
 
     int modelLoc = glGetUniformLocation(shaderProgram, "model");
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, &model[0][0]);
+    glUniformMatrix3x2fv(modelLoc, 1, GL_FALSE, model.data());
 
     int colorLoc = glGetUniformLocation(shaderProgram, "uColor");
     glUniform3f(colorLoc, rect.color.r, rect.color.g, rect.color.b);
@@ -237,8 +284,46 @@ void drawButton(const Button& btn) {  //desenho do botao de reinicio
     drawRectangle(btnRect);
 }
 
-int main() {  //logica principal
-    srand(static_cast<unsigned>(time(0)));
+// placar, vez, tentativas e a ultima mensagem entre a grade e o botao.
+// As strings so mudam quando alguem joga, entao quase sempre saem do cache do TextRenderer;
+// elas sao montadas na arena do frame, sem passar pelo heap
+void drawHud(int windowWidth, int windowHeight) {
+    const float scale = 2.0f;
+    const glm::vec4 white(1.0f), dim(0.6f, 0.6f, 0.6f, 1.0f), highlight(1.0f, 0.85f, 0.3f, 1.0f);
+
+    hud.begin(windowWidth, windowHeight);
+
+    // a grade ocupa ate y = -0.5 em NDC (75% da altura da janela)
+    float y = windowHeight * 0.75f + 10.0f;
+    bool turn1 = !game.gameOver && game.currentPlayer == 1, turn2 = !game.gameOver && game.currentPlayer == 2;
+    FrameArena& arena = frameArena();
+    hud.add(arena.format("Jogador 1: %d pontos", game.scores[0]), 20.0f, y, scale, turn1 ? highlight : white);
+    hud.add(arena.format("Jogador 2: %d pontos", game.scores[1]), windowWidth * 0.5f + 20.0f, y, scale, turn2 ? highlight : white);
+
+    const char* status = game.gameOver ? "Fim de jogo" :
+        arena.format("Vez do jogador %d - tentativa %d de %d", game.currentPlayer, game.attempts + 1, game.rules.maxAttempts);
+    hud.add(status, 20.0f, y + 26.0f, scale, white);
+    if (!lastMessage.empty())
+        hud.add(lastMessage, 20.0f, y + 52.0f, scale, dim);
+
+    // rotulo centralizado no botao (coordenadas do botao em NDC)
+    const char* label = "Reiniciar";
+    glm::vec2 size = hud.measure(label, scale);
+    float centerX = (restartButton.x + restartButton.width * 0.5f + 1.0f) * 0.5f * windowWidth;
+    float centerY = (1.0f - (restartButton.y + restartButton.height * 0.5f)) * 0.5f * windowHeight;
+    hud.add(label, centerX - size.x * 0.5f, centerY - size.y * 0.5f, scale, white);
+
+    hud.flush();
+}
+
+// jogoDasCoresV2 [--continuo]
+// --continuo desliga o redesenho por evento e volta a redesenhar tudo em todo frame
+// teclas: H mostra a melhor jogada (ColorBot), B liga/desliga o bot como jogador 2
+int main(int argc, char** argv) {  //logica principal
+    for (int i = 1; i < argc; ++i)
+        if (std::string(argv[i]) == "--continuo") redraw.eventDriven = false;
+
+    rng.seed(static_cast<uint64_t>(time(0)));
     if (!glfwInit()) return -1;
 
     GLFWwindow* window = glfwCreateWindow(800, 600, "Jogo das Cores - Modern OpenGL", NULL, NULL);
@@ -250,6 +335,19 @@ int main() {  //logica principal
     generateGrid();
     setupRectangle();
     setupShader();
+    if (!hud.init()) return -1;
+
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    if (!redraw.init(fbWidth, fbHeight)) return -1;
+    glfwSetFramebufferSizeCallback(window, [](GLFWwindow* window, int width, int height) {
+        glViewport(0, 0, width, height);
+        redraw.resize(width, height);
+    });
+    // a janela foi descoberta: o canvas ainda vale, so mostra de novo
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* window) {
+        redraw.requestPresent();
+    });
 
     restartButton = {-0.5f, -0.95f, 1.0f, 0.1f, {0.2f, 0.6f, 0.8f}, false};
 
@@ -261,23 +359,65 @@ int main() {  //logica principal
         }
         if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS) {
             generateGrid();
-            std::cout << "Jogo reiniciado pelo clique direito.\n";
+            report("Jogo reiniciado pelo clique direito.");
         }
     });
 
     glfwSetCursorPosCallback(window, cursorPositionCallback);
 
+    glfwSetKeyCallback(window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
+        if (action != GLFW_PRESS) return;
+        if (key == GLFW_KEY_H) showHint();
+        if (key == GLFW_KEY_B) {
+            botEnabled = !botEnabled;
+            report(botEnabled ? "Bot ligado: ele joga como jogador 2." : "Bot desligado.");
+            if (botEnabled && !game.gameOver && game.currentPlayer == 2)
+                playBot();
+        }
+    });
+
+    // alocacoes no heap por frame, no titulo da janela: depois de aquecer o
+    // laco deve ficar em 0 (so clicar gera mensagens novas). Parado, o laco
+    // acorda uma vez por segundo (idleTimeout) e o titulo continua atualizando
+    AllocationMeter allocations;
+    double titleTime = glfwGetTime();
+
     while (!glfwWindowShouldClose(window)) {
-        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        // dorme ate chegar input (os callbacks marcam o que mudou)
+        redraw.waitEvents();
+
+        frameArena().reset();
+        allocations.frame();
+        if (glfwGetTime() - titleTime >= 1.0) {
+            char title[128];
+            snprintf(title, sizeof(title), "Jogo das Cores - %zu alocacoes no ultimo frame (pior: %zu)",
+                     allocations.last, allocations.worst);
+            glfwSetWindowTitle(window, title);
+            titleTime = glfwGetTime();
+        }
 
-        for (const Rectangle& rect : grid) drawRectangle(rect);
-        drawButton(restartButton);
+        // nada mudou: nem desenha nem troca os buffers
+        if (redraw.begin()) {
+            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            if (hintCell >= 0) drawRectangle(hintRect(hintCell));
+            for (int cell = 0; cell < ColorGame::CELLS; ++cell) drawRectangle(cellRect(cell));
+            drawButton(restartButton);
+
+            int windowWidth, windowHeight;
+            glfwGetWindowSize(window, &windowWidth, &windowHeight);
+            drawHud(windowWidth, windowHeight);
+        }
+        redraw.end(window);
     }
 
+    printf("%ld voltas do laco, %ld redesenhos (%ld completos), %.0f pixels por redesenho\n",
+           redraw.loops, redraw.redraws, redraw.fullRedraws,
+           redraw.redraws > 0 ? (double)redraw.pixelsRedrawn / redraw.redraws : 0.0);
+
+    redraw.destroy();
+    hud.destroy();
     glfwTerminate();
     return 0;
 }
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#include "AssetFS.h"
+
+// Empacota os assets da pasta include num arquivo so (ver AssetFS.h), para
+// distribuir os programas sem a pasta do projeto: copie o assets.pak para a
+// pasta de onde o programa roda.
+//
+// packAssets [pasta] [saida.pak] [--store] [--ext .png,.tmx,...]
+//   pasta     padrao: a include do projeto (PG_ASSET_DIR)
+//   saida     padrao: assets.pak na pasta atual
+//   --store   sem LZ4 (tudo lido direto do arquivo mapeado)
+//   --ext     extensoes incluidas (padrao: imagens e mapas, sem os headers)
+
+#ifndef PG_ASSET_DIR
+#define PG_ASSET_DIR "include"
+#endif
+
+typedef std::chrono::steady_clock Clock;
+
+int main(int argc, char** argv) {
+    std::string directory = PG_ASSET_DIR, output = "assets.pak";
+    std::vector<std::string> extensions = { ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".tmx", ".tsx", ".json" };
+    bool storeOnly = false;
+
+    int positional = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--store") == 0) {
+            storeOnly = true;
+        } else if (strcmp(argv[i], "--ext") == 0 && i + 1 < argc) {
+            extensions.clear();
+            std::string list = argv[++i];
+            for (size_t start = 0; start <= list.size();) {
+                size_t comma = list.find(',', start);
+                if (comma == std::string::npos) comma = list.size();
+                std::string ext = list.substr(start, comma - start);
+                if (!ext.empty()) extensions.push_back(ext[0] == '.' ? ext : "." + ext);
+                start = comma + 1;
+            }
+        } else if (positional == 0) {
+            directory = argv[i];
+            positional++;
+        } else if (positional == 1) {
+            output = argv[i];
+            positional++;
+        } else {
+            std::cerr << "uso: packAssets [pasta] [saida.pak] [--store] [--ext .png,.tmx]" << std::endl;
+            return 1;
+        }
+    }
+
+    auto start = Clock::now();
+    AssetPackStats stats;
+    if (!writeAssetPack(directory, output, extensions, storeOnly, &stats))
+        return 1;
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    printf("%s: %zu arquivos (%zu em LZ4), %.2f MB -> %.2f MB em %.1f ms\n", output.c_str(), stats.files,
+           stats.compressed, stats.originalBytes / 1048576.0, stats.storedBytes / 1048576.0, ms);
+
+    // abre de volta e confere que todo arquivo eh encontrado
+    AssetFS check;
+    if (!check.mountArchive(output))
+        return 1;
+    AssetPack pack;
+    pack.open(output);
+    for (uint32_t i = 0; i < pack.entryCount(); ++i) {
+        std::string name = pack.entryName(pack.entry(i));
+        AssetData data;
+        if (!check.read(name, data) || data.size != pack.entry(i).size) {
+            std::cerr << "pacote invalido: " << name << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
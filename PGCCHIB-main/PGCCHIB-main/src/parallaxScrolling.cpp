@@ -5,79 +5,29 @@
 
 #include <iostream>
 
+#include "ParallaxRenderer.h"
+#include "AssetImage.h"
+
 // tamanho da janela
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 
 // struct para camada
 struct Layer {
-    unsigned int textureID;
     float speed;
     float offset;
 };
 
-// funcao para carregar textura forcando canal alfa
-unsigned int loadTexture(const char* path) {
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
-    
-    int width, height, nrChannels;
+// funcao para carregar os pixels da camada forcando canal alfa
+unsigned char* loadLayerPixels(const char* path, int& width, int& height) {
+    int nrChannels;
     stbi_set_flip_vertically_on_load(true); 
     // força carregar com 4 canais rgba
-    unsigned char *data = stbi_load(path, &width, &height, &nrChannels, STBI_rgb_alpha);
-    
-    if (data) {
-        GLenum format = GL_RGBA;
-        
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-        
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);	
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    } else {
+    unsigned char *data = loadImageAsset(path, &width, &height, &nrChannels, STBI_rgb_alpha);
+    if (!data)
         std::cout << "failed to load texture " << path << std::endl;
-    }
-    
-    stbi_image_free(data);
-    return textureID;
-}
-
-// vertex shader
-const char* vertexShaderSource = R"(
-#version 330 core
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec2 aTexCoord;
-
-out vec2 TexCoord;
-
-uniform float offset;
-uniform float scale;
-
-void main()
-{
-    vec3 pos = aPos * scale;
-    gl_Position = vec4(pos, 1.0);
-    TexCoord = vec2(aTexCoord.x + offset, aTexCoord.y);
-}
-)";
-
-// fragment shader
-const char* fragmentShaderSource = R"(
-#version 330 core
-out vec4 FragColor;
-
-in vec2 TexCoord;
-
-uniform sampler2D texture1;
-
-void main()
-{
-    FragColor = texture(texture1, TexCoord);
+    return data;
 }
-)";
 
 int main() {
     glfwInit();
@@ -94,61 +44,42 @@ int main() {
     glfwMakeContextCurrent(window);
     gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 
-    // habilita blending para transparencia canal alfa
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    // build shaders
-    unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-    glCompileShader(vertexShader);
-    
-    unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-    glCompileShader(fragmentShader);
-    
-    unsigned int shaderProgram = glCreateProgram();
-    glAttachShader(shaderProgram, vertexShader);
-    glAttachShader(shaderProgram, fragmentShader);
-    glLinkProgram(shaderProgram);
-    
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-
-    // quad
-    float quadVertices[] = {
-        // positions        // texcoords
-        -1.0f,  1.0f, 0.0f,  0.0f, 1.0f, 
-        -1.0f, -1.0f, 0.0f,  0.0f, 0.0f, 
-         1.0f, -1.0f, 0.0f,  1.0f, 0.0f, 
-
-        -1.0f,  1.0f, 0.0f,  0.0f, 1.0f, 
-         1.0f, -1.0f, 0.0f,  1.0f, 0.0f, 
-         1.0f,  1.0f, 0.0f,  1.0f, 1.0f
+    // layers
+    const char* layerPaths[5] = {
+        "Cartoon_Forest_BG_04/Layers/Sky.png",
+        "Cartoon_Forest_BG_04/Layers/BG_Decor.png",
+        "Cartoon_Forest_BG_04/Layers/Middle_Decor.png",
+        "Cartoon_Forest_BG_04/Layers/Foreground.png",
+        "Cartoon_Forest_BG_04/Layers/Ground.png"
     };
 
-    unsigned int VBO, VAO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    
-    glBindVertexArray(VAO);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
-    
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // todas as camadas vao para um unico array de texturas (mesmo tamanho)
+    ParallaxRenderer parallax;
+    for (int i = 0; i < 5; ++i) {
+        int width, height;
+        unsigned char* data = loadLayerPixels(layerPaths[i], width, height);
+        if (!data) continue;
+        if (parallax.layerCount == 0 && !parallax.init(width, height, 5)) {
+            stbi_image_free(data);
+            glfwTerminate();
+            return -1;
+        }
+        if (width == parallax.width && height == parallax.height)
+            parallax.setLayer(i, data);
+        else
+            std::cout << "camada com tamanho diferente das outras: " << layerPaths[i] << std::endl;
+        stbi_image_free(data);
+    }
+    if (parallax.layerCount == 0) {
+        glfwTerminate();
+        return -1;
+    }
+
+    parallax.backgroundColor[0] = 0.2f;
+    parallax.backgroundColor[1] = 0.3f;
+    parallax.backgroundColor[2] = 0.3f;
 
-    // layers
     Layer layers[5];
-    layers[0].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/Sky.png");
-    layers[1].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/BG_Decor.png");
-    layers[2].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/Middle_Decor.png");
-    layers[3].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/Foreground.png");
-    layers[4].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/Ground.png");
 
     // velocidades da mais lenta a mais rapida
     layers[0].speed = 0.07f;
@@ -162,9 +93,6 @@ int main() {
 
     float scale = 1.0f;
 
-    glUseProgram(shaderProgram);
-    glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0);
-
     // loop principal
     while (!glfwWindowShouldClose(window)) {
         // input
@@ -191,25 +119,16 @@ int main() {
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glBindVertexArray(VAO);
-        glUseProgram(shaderProgram);
-
-        for (int i = 0; i < 5; ++i) {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, layers[i].textureID);
-
-            glUniform1f(glGetUniformLocation(shaderProgram, "offset"), layers[i].offset);
-            glUniform1f(glGetUniformLocation(shaderProgram, "scale"), scale);
-
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-        }
+        // todas as camadas em um unico draw
+        for (int i = 0; i < 5; ++i)
+            parallax.offsets[i] = layers[i].offset;
+        parallax.draw(scale);
 
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+    parallax.destroy();
 
     glfwTerminate();
     return 0;
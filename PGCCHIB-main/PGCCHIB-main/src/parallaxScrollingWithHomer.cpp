@@ -4,25 +4,33 @@
 #include "stb_image.h"
 
 #include <iostream>
+#include <vector>
+
+#include "ParallaxRenderer.h"
+#include "SceneGraph.h"
+#include "AssetImage.h"
+#include "SpriteMesh.h"
 
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 
 struct Layer {
-    unsigned int textureID;
     float speed;
     float offset;
 };
 
-unsigned int loadTexture(const char* path) {
+// pixels, se pedido, fica com a imagem RGBA (para tracar o mesh do alfa)
+unsigned int loadTexture(const char* path, int& width, int& height, std::vector<unsigned char>* pixels = nullptr) {
     unsigned int textureID;
     glGenTextures(1, &textureID);
 
-    int width, height, nrChannels;
+    int nrChannels;
     stbi_set_flip_vertically_on_load(true);
-    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, STBI_rgb_alpha);
+    unsigned char* data = loadImageAsset(path, &width, &height, &nrChannels, STBI_rgb_alpha);
 
     if (data) {
+        if (pixels)
+            pixels->assign(data, data + (size_t)width * height * 4);
         glBindTexture(GL_TEXTURE_2D, textureID);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
         glGenerateMipmap(GL_TEXTURE_2D);
@@ -39,6 +47,15 @@ unsigned int loadTexture(const char* path) {
     return textureID;
 }
 
+unsigned char* loadLayerPixels(const char* path, int& width, int& height) {
+    int nrChannels;
+    stbi_set_flip_vertically_on_load(true);
+    unsigned char* data = loadImageAsset(path, &width, &height, &nrChannels, STBI_rgb_alpha);
+    if (!data)
+        std::cout << "Failed to load texture: " << path << std::endl;
+    return data;
+}
+
 const char* vertexShaderSource = R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
@@ -47,14 +64,11 @@ layout (location = 1) in vec2 aTexCoord;
 out vec2 TexCoord;
 
 uniform float offset;
-uniform float scale;
-uniform vec2 translation;
-uniform float flipX;
+uniform mat3x2 model; // afim 2D (Transform2D.h)
 
 void main()
 {
-    vec3 pos = aPos * vec3(flipX * scale, scale, 1.0) + vec3(translation, 0.0);
-    gl_Position = vec4(pos, 1.0);
+    gl_Position = vec4(model * vec3(aPos.xy, 1.0), aPos.z, 1.0);
     TexCoord = vec2(aTexCoord.x + offset, aTexCoord.y);
 }
 )";
@@ -114,50 +128,101 @@ int main() {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
-    float quadVertices[] = {
-        -1.0f,  1.0f, 0.0f,  0.0f, 1.0f,
-        -1.0f, -1.0f, 0.0f,  0.0f, 0.0f,
-         1.0f, -1.0f, 0.0f,  1.0f, 0.0f,
+    float homerWidth = 45.0f / (SCR_WIDTH / 2.0f);
+    float homerHeight = 72.0f / (SCR_HEIGHT / 2.0f);
 
-        -1.0f,  1.0f, 0.0f,  0.0f, 1.0f,
-         1.0f, -1.0f, 0.0f,  1.0f, 0.0f,
-         1.0f,  1.0f, 0.0f,  1.0f, 1.0f
+    // camadas do fundo em um unico array de texturas, desenhadas em uma passada
+    const char* layerPaths[5] = {
+        "Cartoon_Forest_BG_04/Layers/Sky.png",
+        "Cartoon_Forest_BG_04/Layers/BG_Decor.png",
+        "Cartoon_Forest_BG_04/Layers/Middle_Decor.png",
+        "Cartoon_Forest_BG_04/Layers/Foreground.png",
+        "Cartoon_Forest_BG_04/Layers/Ground.png"
     };
 
-    unsigned int VBO, VAO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    ParallaxRenderer parallax;
+    for (int i = 0; i < 5; ++i) {
+        int width, height;
+        unsigned char* data = loadLayerPixels(layerPaths[i], width, height);
+        if (!data) continue;
+        if (parallax.layerCount == 0 && !parallax.init(width, height, 5)) {
+            stbi_image_free(data);
+            glfwTerminate();
+            return -1;
+        }
+        if (width == parallax.width && height == parallax.height)
+            parallax.setLayer(i, data);
+        else
+            std::cout << "Layer size differs from the others: " << layerPaths[i] << std::endl;
+        stbi_image_free(data);
+    }
+    if (parallax.layerCount == 0) {
+        glfwTerminate();
+        return -1;
+    }
 
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    parallax.backgroundColor[0] = 0.5f;
+    parallax.backgroundColor[1] = 0.8f;
+    parallax.backgroundColor[2] = 1.0f;
 
-    float homerWidth = 45.0f / (SCR_WIDTH / 2.0f);
-    float homerHeight = 72.0f / (SCR_HEIGHT / 2.0f);
+    Layer layers[5];
+    layers[0].speed = 0.07f;
+    layers[1].speed = 0.15f;
+    layers[2].speed = 0.25f;
+    layers[3].speed = 0.35f;
+    layers[4].speed = 0.5f;
 
-    float homerVertices[] = {
-        -homerWidth,  homerHeight, 0.0f,  0.0f, 1.0f,
-        -homerWidth, -homerHeight, 0.0f,  0.0f, 0.0f,
-         homerWidth, -homerHeight, 0.0f,  1.0f, 0.0f,
+    for (int i = 0; i < 5; ++i)
+        layers[i].offset = 0.0f;
 
-        -homerWidth,  homerHeight, 0.0f,  0.0f, 1.0f,
-         homerWidth, -homerHeight, 0.0f,  1.0f, 0.0f,
-         homerWidth,  homerHeight, 0.0f,  1.0f, 1.0f
+    const char* homerPaths[3] = {
+        "Cartoon_Forest_BG_04/Layers/homernorm.png",
+        "Cartoon_Forest_BG_04/Layers/homeresq.png",
+        "Cartoon_Forest_BG_04/Layers/homerdir.png"
     };
 
-    unsigned int homerVBO, homerVAO;
+    // um mesh justo por textura do Homer, tracado do alfa: o blending so passa
+    // pelo contorno dele e nao pelo quad inteiro. Os tres ficam no mesmo
+    // buffer, cada frame desenha o seu trecho dos indices. A imagem foi
+    // carregada de cabeca para baixo, entao o ponto (0, 0) do mesh eh o canto
+    // de baixo do quad e a coordenada de textura eh o proprio ponto
+    unsigned int homerTextures[3];
+    GLsizei homerIndexCount[3];
+    size_t homerFirstIndex[3];
+    std::vector<float> homerVertices;
+    std::vector<uint32_t> homerIndices;
+    for (int i = 0; i < 3; ++i) {
+        int width = 0, height = 0;
+        std::vector<unsigned char> pixels;
+        homerTextures[i] = loadTexture(homerPaths[i], width, height, &pixels);
+        SpriteMesh mesh;
+        if (!pixels.empty())
+            traceSpriteMesh(pixels.data(), width, 0, 0, width, height, 16, mesh);
+        if (mesh.indices.empty())
+            mesh.quad();
+
+        uint32_t base = (uint32_t)(homerVertices.size() / 5);
+        for (const glm::vec2& p : mesh.points) {
+            float vertex[5] = { (p.x * 2.0f - 1.0f) * homerWidth, (p.y * 2.0f - 1.0f) * homerHeight, 0.0f, p.x, p.y };
+            homerVertices.insert(homerVertices.end(), vertex, vertex + 5);
+        }
+        homerFirstIndex[i] = homerIndices.size();
+        homerIndexCount[i] = (GLsizei)mesh.indices.size();
+        for (uint32_t index : mesh.indices)
+            homerIndices.push_back(base + index);
+    }
+
+    unsigned int homerVBO, homerEBO, homerVAO;
     glGenVertexArrays(1, &homerVAO);
     glGenBuffers(1, &homerVBO);
+    glGenBuffers(1, &homerEBO);
 
     glBindVertexArray(homerVAO);
     glBindBuffer(GL_ARRAY_BUFFER, homerVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(homerVertices), homerVertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, homerVertices.size() * sizeof(float), homerVertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, homerEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, homerIndices.size() * sizeof(uint32_t), homerIndices.data(),
+                 GL_STATIC_DRAW);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
@@ -165,27 +230,6 @@ int main() {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    Layer layers[5];
-    layers[0].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/Sky.png");
-    layers[1].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/BG_Decor.png");
-    layers[2].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/Middle_Decor.png");
-    layers[3].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/Foreground.png");
-    layers[4].textureID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/Ground.png");
-
-    layers[0].speed = 0.07f;
-    layers[1].speed = 0.15f;
-    layers[2].speed = 0.25f;
-    layers[3].speed = 0.35f;
-    layers[4].speed = 0.5f;
-
-    for (int i = 0; i < 5; ++i)
-        layers[i].offset = 0.0f;
-
-    unsigned int homerTextures[3];
-    homerTextures[0] = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/homernorm.png");
-    homerTextures[1] = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/homeresq.png");
-    homerTextures[2] = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/Cartoon_Forest_BG_04/Layers/homerdir.png");
-
     int homerFrame = 0;
     bool keyHeld = false;
     float lastSwitchTime = 0.0f;
@@ -193,11 +237,23 @@ int main() {
 
     float homerOffsetY = -150.0f / (SCR_HEIGHT / 2.0f);
 
+    // o Homer fica preso ao chao: mover o chao (ou trocar o lado) leva ele junto
+    SceneGraph scene;
+    Transform2D groundLocal;
+    groundLocal.position = glm::vec2(0.0f, homerOffsetY - homerHeight);
+    int groundNode = scene.add(groundLocal);
+    Transform2D homerLocal;
+    homerLocal.position = glm::vec2(0.0f, homerHeight); // pes na linha do chao
+    int homerNode = scene.add(homerLocal, groundNode);
+
     Direction currentDirection = NONE;
 
     glUseProgram(shaderProgram);
     glUniform1i(glGetUniformLocation(shaderProgram, "texture1"), 0);
 
+    GLint offsetLoc = glGetUniformLocation(shaderProgram, "offset");
+    GLint modelLoc = glGetUniformLocation(shaderProgram, "model");
+
     float lastFrame = glfwGetTime();
 
     while (!glfwWindowShouldClose(window)) {
@@ -256,41 +312,37 @@ int main() {
         glClearColor(0.5f, 0.8f, 1.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glUseProgram(shaderProgram);
-
-        // Desenha camadas do fundo
-        glBindVertexArray(VAO);
-        for (int i = 0; i < 5; ++i) {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, layers[i].textureID);
-            glUniform1f(glGetUniformLocation(shaderProgram, "offset"), layers[i].offset);
-            glUniform1f(glGetUniformLocation(shaderProgram, "scale"), 1.0f);
-            glUniform2f(glGetUniformLocation(shaderProgram, "translation"), 0.0f, 0.0f);
-            glUniform1f(glGetUniformLocation(shaderProgram, "flipX"), 1.0f);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-        }
+        // Desenha camadas do fundo (um unico draw para as 5 camadas)
+        for (int i = 0; i < 5; ++i)
+            parallax.offsets[i] = layers[i].offset;
+        parallax.draw(1.0f);
 
-        // Define flipX para Homer: -1 para esquerda (espelhado), 1 para direita ou parado
+        // Espelha o Homer para a esquerda (escala x = -1), 1 para direita ou parado
         float flipX = (currentDirection == LEFT) ? -1.0f : 1.0f;
+        if (scene.local(homerNode).scale.x != flipX) {
+            homerLocal.scale.x = flipX;
+            scene.setLocal(homerNode, homerLocal);
+        }
+        scene.update(1);
 
         // Desenha Homer com animação e espelhamento
+        glUseProgram(shaderProgram);
         glBindVertexArray(homerVAO);
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, homerTextures[homerFrame]);
-        glUniform1f(glGetUniformLocation(shaderProgram, "offset"), 0.0f);
-        glUniform1f(glGetUniformLocation(shaderProgram, "scale"), 1.0f);
-        glUniform2f(glGetUniformLocation(shaderProgram, "translation"), 0.0f, homerOffsetY);
-        glUniform1f(glGetUniformLocation(shaderProgram, "flipX"), flipX);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+        glUniform1f(offsetLoc, 0.0f);
+        glUniformMatrix3x2fv(modelLoc, 1, GL_FALSE, scene.world(homerNode).data());
+        glDrawElements(GL_TRIANGLES, homerIndexCount[homerFrame], GL_UNSIGNED_INT,
+                       (void*)(homerFirstIndex[homerFrame] * sizeof(uint32_t)));
 
         glfwSwapBuffers(window);
         glfwPollEvents();
     }
 
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+    parallax.destroy();
     glDeleteVertexArrays(1, &homerVAO);
     glDeleteBuffers(1, &homerVBO);
+    glDeleteBuffers(1, &homerEBO);
 
     glfwTerminate();
     return 0;
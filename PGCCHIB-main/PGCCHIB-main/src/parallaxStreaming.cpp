@@ -0,0 +1,114 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <iostream>
+#include <string>
+
+#include "BackgroundStreamer.h"
+
+// tamanho da janela
+const unsigned int SCR_WIDTH = 800;
+const unsigned int SCR_HEIGHT = 600;
+
+// cada camada do Cartoon_Forest_BG_04 (1920x1080) vira 8 colunas de 240 px
+const int SEGMENT_WIDTH = 240;
+const int SEGMENT_HEIGHT = 1080;
+const int RESIDENT_SLOTS = 12;
+
+// quantas vezes a sequencia de colunas se repete: o nivel fica com
+// 8 * LEVEL_REPEATS segmentos por camada, mas so RESIDENT_SLOTS ficam na memoria
+const int LEVEL_REPEATS = 500;
+
+int main() {
+    glfwInit();
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "parallax com streaming", NULL, NULL);
+    if (window == NULL) {
+        std::cout << "failed to create glfw window\n";
+        glfwTerminate();
+        return -1;
+    }
+    glfwMakeContextCurrent(window);
+    gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    const std::string layerDir = "Cartoon_Forest_BG_04/Layers/";
+    const char* layerFiles[5] = { "Sky.png", "BG_Decor.png", "Middle_Decor.png", "Foreground.png", "Ground.png" };
+
+    // velocidades da mais lenta a mais rapida
+    const float speeds[5] = { 0.07f, 0.15f, 0.25f, 0.35f, 0.5f };
+
+    // uma camada com streaming por arquivo; o nivel eh so a lista de colunas
+    BackgroundStreamer layers[5];
+    for (int i = 0; i < 5; ++i) {
+        layers[i].init(SEGMENT_WIDTH, SEGMENT_HEIGHT, RESIDENT_SLOTS);
+        for (int r = 0; r < LEVEL_REPEATS; ++r)
+            layers[i].addImageColumns(layerDir + layerFiles[i]);
+    }
+
+    // a janela mostra a altura inteira da imagem; a largura segue o aspecto da janela
+    float viewWidth = SEGMENT_HEIGHT * (float)SCR_WIDTH / SCR_HEIGHT;
+    float cameraX = 0.0f;
+    bool autoScroll = false;
+    bool spaceHeld = false;
+
+    float lastFrame = glfwGetTime();
+    float lastReport = lastFrame;
+
+    // loop principal
+    while (!glfwWindowShouldClose(window)) {
+        float currentFrame = glfwGetTime();
+        float deltaTime = currentFrame - lastFrame;
+        lastFrame = currentFrame;
+
+        // input
+        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+            glfwSetWindowShouldClose(window, true);
+
+        bool spacePressed = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
+        if (spacePressed && !spaceHeld)
+            autoScroll = !autoScroll;
+        spaceHeld = spacePressed;
+
+        float scrollSpeed = 2000.0f; // px por segundo na camada mais rapida
+        if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS || autoScroll)
+            cameraX += scrollSpeed * deltaTime;
+        if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
+            cameraX -= scrollSpeed * deltaTime;
+        if (cameraX < 0.0f) cameraX = 0.0f;
+
+        // cada camada anda na sua velocidade, entao cada uma tem sua propria camera
+        for (int i = 0; i < 5; ++i)
+            layers[i].update(cameraX * speeds[i] / speeds[4], viewWidth);
+
+        glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        for (int i = 0; i < 5; ++i)
+            layers[i].draw(cameraX * speeds[i] / speeds[4], viewWidth);
+
+        if (currentFrame - lastReport > 1.0f) {
+            std::cout << "camera " << (int)cameraX << " px, residentes:";
+            for (int i = 0; i < 5; ++i)
+                std::cout << " " << layers[i].residentCount() << "/" << layers[i].segments.size();
+            std::cout << std::endl;
+            lastReport = currentFrame;
+        }
+
+        glfwSwapBuffers(window);
+        glfwPollEvents();
+    }
+
+    for (int i = 0; i < 5; ++i)
+        layers[i].destroy();
+
+    glfwTerminate();
+    return 0;
+}
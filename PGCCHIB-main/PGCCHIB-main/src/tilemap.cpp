@@ -2,6 +2,13 @@
 #include <GLFW/glfw3.h>
 #include <iostream>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <random>
+#include <thread>
+#include <chrono>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -10,171 +17,147 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#include "Camera2D.h"
+#include "IsoRenderer.h"
+#include "TileCollision.h"
+#include "Input.h"
+#include "SceneGraph.h"
+#include "FrameCapture.h"
+#include "Lighting2D.h"
+#include "LayerCache.h"
+#include "Pathfinding.h"
+#include "MapGenerator.h"
+#include "AssetImage.h"
+
 // Struct Sprite
 struct Sprite
 {
-    GLuint VAO;
-    GLuint texID;
+    int texture; // indice no IsoRenderer
     glm::vec3 position;
     glm::vec3 dimensions; // tamanho do frame
     float ds, dt;
     int iAnimation, iFrame;
     int nAnimations, nFrames;
     bool flipHorizontal = false;
+    int firstMesh = 0; // mesh do frame (0, 0) no IsoRenderer, os outros em seguida
 };
 
-// Vertex shader
-const char* vertexShaderSrc = R"(
-#version 330 core
-layout(location = 0) in vec2 position;
-layout(location = 1) in vec2 texCoord;
+// camera global para o callback de resize conseguir atualizar a projecao
+Camera2D camera;
+Lighting2D lighting;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+// tamanho de um tile na tela (o losango ocupa um quad de 2 x 1)
+const float TILE_WIDTH = 2.0f;
+const float TILE_HEIGHT = 1.0f;
 
-out vec2 TexCoord;
+// velocidade do personagem em unidades de tela por segundo
+const float PLAYER_SPEED = 1.5f;
 
-void main()
-{
-    gl_Position = projection * view * model * vec4(position, 0.0, 1.0);
-    TexCoord = texCoord;
-}
-)";
+// NPCs andam na grade, em tiles por segundo
+const float NPC_SPEED = 1.2f;
+const int CROWD_SIZE = 40;
+// janela do flow field da multidao (65 x 65 tiles em volta do personagem) e
+// lado dos clusters da hierarquia de caminhos
+const int CROWD_RADIUS = 32;
+const int PATH_CLUSTER = 16;
 
-// Fragment shader
-const char* fragmentShaderSrc = R"(
-#version 330 core
-in vec2 TexCoord;
-out vec4 FragColor;
+// acoes do jogo (o teclado eh mapeado para elas no main)
+enum Action
+{
+    ACTION_RIGHT,
+    ACTION_LEFT,
+    ACTION_UP,
+    ACTION_DOWN,
+    ACTION_ZOOM_IN,
+    ACTION_ZOOM_OUT,
+    ACTION_CAPTURE,
+    ACTION_LIGHTS,
+    ACTION_CACHE,
+    ACTION_PAINT,
+    ACTION_CROWD,
+    ACTION_MESHES,
+    ACTION_PREPASS,
+    ACTION_QUIT
+};
 
-uniform sampler2D tileTexture;
-uniform vec2 offsetTex;
-uniform vec2 scaleTex;
+// a colisao e o movimento acontecem na grade (x = coluna, y = linha, 1 = um tile);
+// o centro da celula (col, row) fica em ((col - row) * w/2, (col + row) * h/2 + 0.25) na tela
+glm::vec2 gridToScreen(glm::vec2 g)
+{
+    return glm::vec2((g.x - g.y) * (TILE_WIDTH / 2.0f), (g.x + g.y - 1.0f) * (TILE_HEIGHT / 2.0f) + 0.25f);
+}
 
-void main()
+// direcao na tela -> direcao na grade (inverso linear de gridToScreen)
+glm::vec2 screenDirToGrid(glm::vec2 d)
 {
-    vec2 tex = offsetTex + TexCoord * scaleTex;
-    FragColor = texture(tileTexture, tex);
+    float a = d.x / (TILE_WIDTH / 2.0f);
+    float b = d.y / (TILE_HEIGHT / 2.0f);
+    return glm::vec2((a + b) / 2.0f, (b - a) / 2.0f);
 }
-)";
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height)
 {
     glViewport(0, 0, width, height);
+    camera.setViewport(width, height);
+    lighting.resize(width, height);
 }
 
-GLuint compileShader(GLenum type, const char* source)
+// celulas da camada cujo centro pode cair em area (o retangulo na grade que
+// contem o losango visivel), com margin tiles a mais para as paredes empilhadas;
+// assim um mapa grande nao eh percorrido inteiro a cada frame
+void visibleCells(const Rect2D& area, const TmxLayer& layer, int margin, int& col0, int& row0, int& col1, int& row1)
 {
-    GLuint shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, NULL);
-    glCompileShader(shader);
-
-    int success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success)
-    {
-        char infoLog[512];
-        glGetShaderInfoLog(shader, 512, NULL, infoLog);
-        std::cerr << "Erro ao compilar shader: " << infoLog << std::endl;
-    }
-    return shader;
+    float minCol = 1e30f, maxCol = -1e30f, minRow = 1e30f, maxRow = -1e30f;
+    const float xs[] = { area.minX, area.maxX }, ys[] = { area.minY, area.maxY };
+    for (float x : xs)
+        for (float y : ys)
+        {
+            // inverso de gridToScreen
+            float a = x / (TILE_WIDTH / 2.0f);
+            float b = (y - 0.25f) / (TILE_HEIGHT / 2.0f) + 1.0f;
+            minCol = std::min(minCol, (a + b) / 2.0f);
+            maxCol = std::max(maxCol, (a + b) / 2.0f);
+            minRow = std::min(minRow, (b - a) / 2.0f);
+            maxRow = std::max(maxRow, (b - a) / 2.0f);
+        }
+    col0 = std::max(0, (int)std::floor(minCol) - margin);
+    row0 = std::max(0, (int)std::floor(minRow) - margin);
+    col1 = std::min(layer.width - 1, (int)std::floor(maxCol) + margin);
+    row1 = std::min(layer.height - 1, (int)std::floor(maxRow) + margin);
 }
 
-GLuint createShaderProgram()
+// tiles do chao (altura 0) que caem em area, na camada 0 do IsoRenderer;
+// o tile i usa o mesh firstMesh + i
+void addFloorTiles(IsoRenderer& iso, const TmxLayer& floorLayer, const Rect2D& area, int texture, float ds, float dt,
+                   int firstMesh)
 {
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSrc);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSrc);
-
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-
-    int success;
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success)
+    int col0, row0, col1, row1;
+    visibleCells(area, floorLayer, 1, col0, row0, col1, row1);
+    for (int row = row0; row <= row1; ++row)
     {
-        char infoLog[512];
-        glGetProgramInfoLog(program, 512, NULL, infoLog);
-        std::cerr << "Erro ao linkar shader program: " << infoLog << std::endl;
+        for (int col = col0; col <= col1; ++col)
+        {
+            int tileIndex = floorLayer.gid(col, row) - 1;
+            if (tileIndex < 0)
+                continue;
+            glm::vec2 center = gridToScreen(glm::vec2(col + 0.5f, row + 0.5f));
+            if (!area.intersects(center.x, center.y, TILE_WIDTH / 2.0f, TILE_HEIGHT / 2.0f))
+                continue;
+            IsoItem tile = { center.x, center.y, TILE_WIDTH / 2.0f, TILE_HEIGHT / 2.0f,
+                             tileIndex * ds, 0.0f, ds, dt, texture, isoKey(0, (float)(row + col), 0),
+                             firstMesh + tileIndex };
+            iso.add(tile);
+        }
     }
-
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
-    return program;
 }
 
-GLuint setupTileVAO(float& ds, float& dt)
-{
-    float vertices[] = {
-        // pos      // tex coords
-       -1.0f,  0.5f,  0.0f, 0.0f,
-       -1.0f, -0.5f,  0.0f, 1.0f,
-        1.0f,  0.5f,  1.0f, 0.0f,
-        1.0f, -0.5f,  1.0f, 1.0f,
-    };
-
-    GLuint VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
-
-    ds = 1.0f / 7.0f;
-    dt = 1.0f;
-
-    return VAO;
-}
-
-GLuint setupSprite(int nAnimations, int nFrames, float& ds, float& dt)
-{
-    float vertices[] = {
-        // pos      // tex coords
-       -0.5f,  0.5f,  0.0f, 0.0f,
-       -0.5f, -0.5f,  0.0f, 1.0f,
-        0.5f,  0.5f,  1.0f, 0.0f,
-        0.5f, -0.5f,  1.0f, 1.0f,
-    };
-
-    GLuint VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    glBindVertexArray(0);
-
-    ds = 1.0f / nFrames;
-    dt = 1.0f / nAnimations;
-
-    return VAO;
-}
-
-GLuint loadTexture(const char* path, int& width, int& height)
+// normalMap != nullptr: tambem cria um normal map a partir do brilho da imagem;
+// pixels != nullptr: fica com uma copia dos pixels RGBA (para tracar os meshes)
+GLuint loadTexture(const char* path, int& width, int& height, GLuint* normalMap = nullptr,
+                   std::vector<unsigned char>* pixels = nullptr)
 {
     int nrChannels;
-    unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 4);
+    unsigned char* data = loadImageAsset(path, &width, &height, &nrChannels, 4);
     if (!data)
     {
         std::cerr << "Falha ao carregar textura: " << path << std::endl;
@@ -195,96 +178,169 @@ GLuint loadTexture(const char* path, int& width, int& height)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
+    if (normalMap)
+        *normalMap = createNormalMap(data, width, height, true);
+    if (pixels)
+        pixels->assign(data, data + (size_t)width * height * 4);
+
     stbi_image_free(data);
 
     return textureID;
 }
 
-void drawSprite(Sprite& s, GLuint shaderProgram, GLint uniModelLoc, GLint uniOffsetTexLoc, GLint uniScaleTexLoc)
+// copia um chunk pronto do MapGenerator para as camadas e a colisao; a
+// hierarquia de caminhos refaz so os clusters que mudaram
+void copyChunk(const MapGenerator& generator, int chunk, TmxLayer& floorLayer, TmxLayer& wallLayer,
+               TileCollisionMap& collision, PathHierarchy& hierarchy)
 {
-    glBindTexture(GL_TEXTURE_2D, s.texID);
-    glBindVertexArray(s.VAO);
+    int x0, y0, w, h;
+    generator.chunkRect(chunk, x0, y0, w, h);
+    for (int y = y0; y < y0 + h; ++y)
+    {
+        for (int x = x0; x < x0 + w; ++x)
+        {
+            size_t cell = (size_t)y * generator.width + x;
+            floorLayer.setGid(x, y, generator.floor[cell] + 1);
+            wallLayer.setGid(x, y, generator.wall[cell] + 1);
+            uint8_t shape = generator.solid[cell] ? TILE_SOLID : TILE_EMPTY;
+            if (collision.get(x, y) != shape)
+            {
+                collision.set(x, y, shape);
+                hierarchy.tileChanged(x, y);
+            }
+        }
+    }
+}
 
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), s.position);
+// celula livre mais perto de (x, y) ate radius tiles; false se nao tem
+bool nearestFree(const TileCollisionMap& collision, int x, int y, int radius, PathPoint& out)
+{
+    int best = -1;
+    for (int dy = -radius; dy <= radius; ++dy)
+        for (int dx = -radius; dx <= radius; ++dx)
+            if (collision.get(x + dx, y + dy) == TILE_EMPTY && (best < 0 || dx * dx + dy * dy < best))
+            {
+                best = dx * dx + dy * dy;
+                out = { x + dx, y + dy };
+            }
+    return best >= 0;
+}
 
-    // Se flipHorizontal estiver true, inverta o X
-    glm::vec3 scale = s.dimensions;
-    if (s.flipHorizontal)
-        scale.x *= -1.0f;
+// NPC que segue um caminho do PathScheduler de centro em centro de celula
+struct Walker
+{
+    TileActor body;
+    std::vector<PathPoint> path;
+    size_t next = 0;       // proximo ponto do caminho
+    bool waiting = false;  // pedido na fila do PathScheduler
+};
 
-    model = glm::scale(model, scale);
+// velocidade na grade ate o centro de (x, y); zero se ja chegou
+glm::vec2 steerTo(const TileActor& body, float x, float y, float speed)
+{
+    glm::vec2 to(x + 0.5f - body.x, y + 0.5f - body.y);
+    float distance = glm::length(to);
+    if (distance < 0.05f)
+        return glm::vec2(0.0f);
+    return to / distance * speed;
+}
 
-    glUniformMatrix4fv(uniModelLoc, 1, GL_FALSE, glm::value_ptr(model));
+// anima o sprite pela direcao na tela, como o personagem (0 = lado, 1 = desce, 2 = sobe)
+void animateWalk(Sprite& sprite, glm::vec2 gridVelocity)
+{
+    if (gridVelocity == glm::vec2(0.0f))
+        return;
+    glm::vec2 screen((gridVelocity.x - gridVelocity.y) * (TILE_WIDTH / 2.0f),
+                     (gridVelocity.x + gridVelocity.y) * (TILE_HEIGHT / 2.0f));
+    if (std::fabs(screen.x) > std::fabs(screen.y))
+    {
+        sprite.iAnimation = 0;
+        sprite.flipHorizontal = screen.x < 0.0f;
+    }
+    else
+    {
+        sprite.iAnimation = screen.y > 0.0f ? 2 : 1;
+    }
+    sprite.iFrame = (sprite.iFrame + 1) % sprite.nFrames;
+}
 
-    float offsetX = s.iFrame * s.ds;
-    float offsetY = s.iAnimation * s.dt;
-    glUniform2f(uniOffsetTexLoc, offsetX, offsetY);
-    glUniform2f(uniScaleTexLoc, s.ds, s.dt);
+// anda pelo caminho; no fim (ou sem caminho) pede outro ate uma celula livre sorteada
+void updateWalker(Walker& walker, int agent, const TileCollisionMap& collision, PathScheduler& paths,
+                  std::mt19937& rng, Sprite& sprite, float deltaTime)
+{
+    glm::vec2 velocity(0.0f);
+    while (walker.next < walker.path.size())
+    {
+        const PathPoint& p = walker.path[walker.next];
+        velocity = steerTo(walker.body, (float)p.x, (float)p.y, NPC_SPEED);
+        if (velocity != glm::vec2(0.0f))
+            break;
+        walker.next++;
+    }
 
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    if (walker.next >= walker.path.size() && !walker.waiting)
+    {
+        std::uniform_int_distribution<int> col(0, collision.width - 1), row(0, collision.height - 1);
+        PathPoint goal = { col(rng) + collision.originX, row(rng) + collision.originY };
+        if (collision.get(goal.x, goal.y) == TILE_EMPTY)
+        {
+            PathPoint start = { (int)std::floor(walker.body.x), (int)std::floor(walker.body.y) };
+            paths.request(agent, start, goal);
+            walker.waiting = true;
+        }
+    }
+
+    walker.body.vx = velocity.x;
+    walker.body.vy = velocity.y;
+    moveActor(collision, walker.body, deltaTime);
+    animateWalk(sprite, velocity);
 }
 
-void processMovement(GLFWwindow* window, Sprite &vampirao)
+// le as acoes do frame, move a caixa do personagem na grade contra a colisao e
+// poe o no dos pes no ponto correspondente da tela (o sprite segue pelo SceneGraph)
+void processMovement(const Input &input, Sprite &vampirao, TileActor &body, const TileCollisionMap &collision,
+                     SceneGraph &scene, int feetNode, float deltaTime)
 {
     bool moved = false;
-    float speed = 0.0005f; 
-
-    float newX = vampirao.position.x;
-    float newY = vampirao.position.y;
+    glm::vec2 dir(0.0f);
 
-    if ((glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS))
+    if (input.held(ACTION_RIGHT))
     {
-        newX += speed;
+        dir.x += 1.0f;
         vampirao.iAnimation = 0;
         vampirao.flipHorizontal = false;
         moved = true;
     }
-    else if ((glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS))
+    else if (input.held(ACTION_LEFT))
     {
-        newX -= speed;
+        dir.x -= 1.0f;
         vampirao.iAnimation = 0;
         vampirao.flipHorizontal = true;
         moved = true;
     }
 
-    if ((glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS))
+    if (input.held(ACTION_UP))
     {
-        newY += speed;
+        dir.y += 1.0f;
         vampirao.iAnimation = 2;
         moved = true;
     }
-    else if ((glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS))
+    else if (input.held(ACTION_DOWN))
     {
-        newY -= speed;
+        dir.y -= 1.0f;
         vampirao.iAnimation = 1;
         moved = true;
     }
 
-    // Dimensões do mapa
-    float tileWidth = 1.9f;
-    float tileHeight = 0.95f;
-    int mapCols = 3;
-    int mapRows = 3;
-
-    float mapWidth = (mapCols + mapRows) * (tileWidth / 2.0f);    // 6.0f
-    float mapHeight = (mapCols + mapRows) * (tileHeight / 2.0f);  // 3.0f
-
-    float centerX = 0.0f;
-    float centerY = mapHeight / 2.0f;  // 1.5f
-
-    // Calcula posição relativa ao centro
-    float relativeX = newX - centerX;
-    float relativeY = newY - centerY;
-
-    // Checa se está dentro do losango (área do mapa)
-    float normX = fabs(relativeX) / (mapWidth / 2.0f);
-    float normY = fabs(relativeY) / (mapHeight / 2.0f);
+    // mesma velocidade na diagonal; a conversao para a grade fica por conta da projecao
+    if (moved)
+        dir = glm::normalize(dir) * PLAYER_SPEED;
+    glm::vec2 velocity = screenDirToGrid(dir);
+    body.vx = velocity.x;
+    body.vy = velocity.y;
+    moveActor(collision, body, deltaTime);
 
-    if (normX + normY <= 1.0f)
-    {
-        vampirao.position.x = newX;
-        vampirao.position.y = newY;
-    }
+    scene.setPosition(feetNode, gridToScreen(glm::vec2(body.x, body.y)));
 
     if (moved)
     {
@@ -292,8 +348,27 @@ void processMovement(GLFWwindow* window, Sprite &vampirao)
     }
 }
 
-int main()
+// tilemap [--record arquivo | --replay arquivo] [--capture destino] [--generate tamanho]
+// --record grava o input da sessao; --replay roda a sessao gravada sem janela visivel,
+// o mais rapido possivel, e mostra o tempo por frame e o estado final.
+// --capture grava os frames desde o inicio (F12 liga/desliga) em destino: video.y4m,
+// video.rgb ou um prefixo de PNG (frames/f -> frames/f000001.png...). Sem
+// --capture o F12 grava em captura.y4m. Com --replay da o video de uma sessao sem janela.
+// --generate troca o mapa do Tiled por um mapa gerado de tamanho x tamanho
+// (MapGenerator); os chunks aparecem conforme ficam prontos, a partir do centro.
+int main(int argc, char** argv)
 {
+    std::string recordPath, replayPath, capturePath;
+    int generateSize = 0;
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (strcmp(argv[i], "--record") == 0) recordPath = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0) replayPath = argv[++i];
+        else if (strcmp(argv[i], "--capture") == 0) capturePath = argv[++i];
+        else if (strcmp(argv[i], "--generate") == 0) generateSize = atoi(argv[++i]);
+    }
+    bool headless = !replayPath.empty();
+
     const int WIDTH = 800;
     const int HEIGHT = 600;
 
@@ -306,6 +381,8 @@ int main()
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    if (headless)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     GLFWwindow* window = glfwCreateWindow(800, 600, "Tilemap com Vampirão", NULL, NULL);
     if (!window)
@@ -325,100 +402,584 @@ int main()
     glViewport(0, 0, 800, 600);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
-    GLuint shaderProgram = createShaderProgram();
-    glUseProgram(shaderProgram);
+    Input input;
+    input.install(window);
+    input.bindKey(GLFW_KEY_D, ACTION_RIGHT);
+    input.bindKey(GLFW_KEY_RIGHT, ACTION_RIGHT);
+    input.bindKey(GLFW_KEY_A, ACTION_LEFT);
+    input.bindKey(GLFW_KEY_LEFT, ACTION_LEFT);
+    input.bindKey(GLFW_KEY_W, ACTION_UP);
+    input.bindKey(GLFW_KEY_UP, ACTION_UP);
+    input.bindKey(GLFW_KEY_S, ACTION_DOWN);
+    input.bindKey(GLFW_KEY_DOWN, ACTION_DOWN);
+    input.bindKey(GLFW_KEY_EQUAL, ACTION_ZOOM_IN);
+    input.bindKey(GLFW_KEY_MINUS, ACTION_ZOOM_OUT);
+    input.bindKey(GLFW_KEY_F12, ACTION_CAPTURE);
+    input.bindKey(GLFW_KEY_L, ACTION_LIGHTS);
+    input.bindKey(GLFW_KEY_C, ACTION_CACHE);
+    input.bindKey(GLFW_KEY_T, ACTION_PAINT);
+    input.bindKey(GLFW_KEY_N, ACTION_CROWD);
+    input.bindKey(GLFW_KEY_M, ACTION_MESHES);
+    input.bindKey(GLFW_KEY_P, ACTION_PREPASS);
+    input.bindKey(GLFW_KEY_ESCAPE, ACTION_QUIT);
+
+    if (!recordPath.empty() && !input.startRecording(recordPath))
+        return -1;
+    if (headless && !input.startReplay(replayPath))
+        return -1;
 
-    float ds, dt;
-    GLuint tileVAO = setupTileVAO(ds, dt);
+    // iso desenha o que muda todo frame (colunas e personagens); floorIso so
+    // redesenha as faixas do chao que a cache pedir
+    IsoRenderer iso, floorIso;
+    if (!iso.init() || !floorIso.init())
+        return -1;
+
+    // tileset com 7 tiles lado a lado
+    float ds = 1.0f / 7.0f;
+    float dt = 1.0f;
 
     int texWidth, texHeight;
-    GLuint tileTexID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/tilesetIso.png", texWidth, texHeight);
+    GLuint tileNormalID = 0;
+    std::vector<unsigned char> tilePixels, vampPixels;
+    GLuint tileTexID = loadTexture("tilesetIso.png", texWidth, texHeight, &tileNormalID, &tilePixels);
     if (tileTexID == 0)
         return -1;
 
     // Setup vampirao
     int vampWidth, vampHeight;
-    GLuint vampTexID = loadTexture("C:/Users/I588364/OneDrive - SAP SE/PG/PGCCHIB-main/PGCCHIB-main/include/donatello.png", vampWidth, vampHeight);
+    GLuint vampTexID = loadTexture("donatello.png", vampWidth, vampHeight, nullptr, &vampPixels);
+
+    int tileTex = iso.addTexture(tileTexID, tileNormalID);
+    int vampTex = iso.addTexture(vampTexID);
+    floorIso.addTexture(tileTexID, tileNormalID);
+
+    // meshes justos dos frames: os losangos com 8 vertices ja ficam em ~60% do
+    // quad, o boneco com 16 em ~18% (o resto do quad eh transparente)
+    std::vector<SpriteMesh> tileMeshes, vampMeshes;
+    traceSpriteSheet(tilePixels.data(), texWidth, texHeight, 7, 1, 8, tileMeshes);
+    int firstTileMesh = 0;
+    for (size_t i = 0; i < tileMeshes.size(); ++i)
+    {
+        int mesh = iso.addMesh(tileMeshes[i]);
+        floorIso.addMesh(tileMeshes[i]);
+        if (i == 0)
+            firstTileMesh = mesh;
+    }
+    int firstVampMesh = 0;
+    if (vampTexID != 0)
+    {
+        traceSpriteSheet(vampPixels.data(), vampWidth, vampHeight, 3, 3, 16, vampMeshes);
+        for (size_t i = 0; i < vampMeshes.size(); ++i)
+        {
+            int mesh = iso.addMesh(vampMeshes[i]);
+            if (i == 0)
+                firstVampMesh = mesh;
+        }
+    }
 
     Sprite vampirao;
     vampirao.nAnimations = 3;
     vampirao.nFrames = 3;
-    vampirao.VAO = setupSprite(vampirao.nAnimations, vampirao.nFrames, vampirao.ds, vampirao.dt);
+    vampirao.ds = 1.0f / vampirao.nFrames;
+    vampirao.dt = 1.0f / vampirao.nAnimations;
     vampirao.position = glm::vec3(0.0f, 0.0f, 0.0f);
     vampirao.dimensions = glm::vec3(0.8f, 0.8f, 1.0f);
-    vampirao.texID = vampTexID;
+    vampirao.texture = vampTex;
     vampirao.iAnimation = 1;
     vampirao.iFrame = 0;
+    vampirao.firstMesh = firstVampMesh;
+
+    // segundo personagem: comeca atras da coluna (testa a ordem entre
+    // personagens) e passeia pelo mapa com caminhos do PathScheduler
+    Sprite npc = vampirao;
+    npc.position = glm::vec3(1.0f, 2.15f, 0.0f);
+    npc.flipHorizontal = true;
+
+    // chao e colisao vem do mapa do Tiled; tiles com a propriedade solid viram colunas.
+    // No mapa gerado as duas camadas comecam vazias e tudo eh parede ate o chunk chegar
+    TmxMap tmx;
+    TileCollisionMap collision;
+    MapGenerator generator;
+    if (generateSize > 0)
+    {
+        tmx.layers.resize(2);
+        tmx.layers[0].name = "Floor";
+        tmx.layers[1].name = "Collision";
+        for (TmxLayer& layer : tmx.layers)
+        {
+            layer.width = layer.height = generateSize;
+            layer.gids.assign((size_t)generateSize * generateSize, 0);
+        }
+        collision.init(generateSize, generateSize);
+        collision.cells.assign(collision.cells.size(), TILE_SOLID);
+        generator.width = generator.height = generateSize;
+        generator.rules = isoTerrainRules();
+    }
+    else if (!tmx.load("tilemapIso.tmx"))
+    {
+        return -1;
+    }
+    TmxLayer* floorLayer = tmx.layer("Floor");
+    TmxLayer* wallLayer = tmx.layer("Collision");
+    if (!floorLayer || !wallLayer || (generateSize == 0 && !collision.loadFromTmx(tmx, "Collision")))
+        return -1;
 
-    int map[3][3] = {
-        {1, 3, 6},
-        {3, 4, 2},
-        {4, 5, 2}
-    };
-
-    float tileWidth = 2.0f;
-    float tileHeight = 1.0f;
+    int stackHeight = 6;     // quantos tiles uma parede empilha
+    float stackStep = 0.12f; // quanto cada tile empilhado sobe na tela
+
+    // caixa do personagem na grade, comecando no meio da celula (0, 0)
+    TileActor body = { 0.5f, 0.5f, 0.2f, 0.2f, 0.0f, 0.0f, 0 };
+
+    // NPCs: hierarquia de caminhos sobre a colisao (refeita por cluster se um
+    // tile mudar) e fila com orcamento por frame. Gravando ou no replay a fila
+    // eh esvaziada todo frame, senao o caminho chegaria em outro frame no replay.
+    // Os trechos refinados ficam dentro de um ou dois clusters, entao a busca
+    // usa so o retangulo deles (num mapa de 4096 x 4096 os vetores do mapa
+    // inteiro seriam 268 MB)
+    PathHierarchy pathHierarchy;
+    pathHierarchy.build(collision, PATH_CLUSTER);
+    PathScheduler paths;
+    paths.hierarchy = &pathHierarchy;
+    paths.budgetMs = headless || !recordPath.empty() ? 1e9 : 1.0;
+    paths.search.window = PATH_CLUSTER;
+    paths.search.prepare(collision, PATH_CLUSTER);
+    std::vector<PathResult> pathResults;
+    std::mt19937 npcRng(7);
+    Walker npcWalker;
+    npcWalker.body = { 2.5f, 1.5f, 0.2f, 0.2f, 0.0f, 0.0f, 0 };
+
+    // mapa gerado: espera so o chunk do centro (o resto chega durante o jogo)
+    // e poe os dois personagens na celula livre mais perto dele
+    std::vector<int> readyChunks;
+    if (generateSize > 0)
+    {
+        int center = generateSize / 2;
+        int centerChunk = (center / generator.chunkSize) * generator.chunksX() + center / generator.chunkSize;
+        if (!generator.start(center, center))
+            return -1;
+        bool centerReady = false;
+        while (!centerReady)
+        {
+            bool finished = generator.finished();
+            readyChunks.clear();
+            if (generator.collect(readyChunks) == 0)
+            {
+                if (finished)
+                    break;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+            for (int chunk : readyChunks)
+            {
+                copyChunk(generator, chunk, *floorLayer, *wallLayer, collision, pathHierarchy);
+                centerReady = centerReady || chunk == centerChunk;
+            }
+        }
+        PathPoint spawn;
+        if (!nearestFree(collision, center, center, generator.chunkSize, spawn))
+        {
+            std::cerr << "Nenhuma celula livre perto do centro do mapa gerado\n";
+            return -1;
+        }
+        body.x = spawn.x + 0.5f;
+        body.y = spawn.y + 0.5f;
+        if (nearestFree(collision, spawn.x + 2, spawn.y + 1, generator.chunkSize, spawn))
+        {
+            npcWalker.body.x = spawn.x + 0.5f;
+            npcWalker.body.y = spawn.y + 0.5f;
+        }
+    }
 
-    glm::mat4 projection = glm::ortho(-4.0f, 4.0f, -1.0f, 5.0f, -1.0f, 1.0f);
-    glm::mat4 view = glm::mat4(1.0f);
+    // multidao (N liga/desliga): todos vao ate a celula do personagem lendo o
+    // mesmo flow field, refeito so quando ele muda de celula. O campo novo eh
+    // montado aos poucos pelo PathScheduler, dentro do orcamento; ate ficar
+    // pronto a multidao segue o antigo. O campo cobre so a janela em volta do
+    // personagem, entao refazer custa o mesmo em qualquer tamanho de mapa
+    FlowField crowdFlow;
+    crowdFlow.radius = CROWD_RADIUS;
+    paths.flowFields.push_back(&crowdFlow);
+    std::vector<TileActor> crowd;
+    std::vector<Sprite> crowdSprites;
+    bool crowdOn = false;
+    std::vector<Sprite*> characters;
+
+    // cada personagem eh um no nos pes com o sprite como filho, meia altura acima;
+    // o jogo so move os pes
+    SceneGraph scene;
+    Transform2D feetLocal, spriteLocal;
+    spriteLocal.position = glm::vec2(0.0f, vampirao.dimensions.y / 2.0f);
+    feetLocal.position = gridToScreen(glm::vec2(body.x, body.y));
+    int playerFeet = scene.add(feetLocal);
+    int playerSprite = scene.add(spriteLocal, playerFeet);
+    feetLocal.position = gridToScreen(glm::vec2(npcWalker.body.x, npcWalker.body.y));
+    int npcFeet = scene.add(feetLocal);
+    int npcSprite = scene.add(spriteLocal, npcFeet);
+    scene.update(1);
+    vampirao.position = glm::vec3(scene.worldPosition(playerSprite), 0.0f);
+    npc.position = glm::vec3(scene.worldPosition(npcSprite), 0.0f);
+
+    // 100 pixels por unidade: em 800x600 mostra a mesma area de ortho(-4, 4, -1, 5)
+    camera.pixelsPerUnit = 100.0f;
+    camera.position = generateSize > 0 ? glm::vec2(vampirao.position) : glm::vec2(0.0f, 2.0f);
+    camera.followSharpness = 4.0f;
+    int fbWidth, fbHeight;
+    glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+    camera.setViewport(fbWidth, fbHeight);
+
+    // noite: luz ambiente fraca, uma tocha com o personagem e uma luz fria no
+    // alto de cada coluna; L liga/desliga
+    if (!lighting.init(fbWidth, fbHeight))
+        return -1;
+    lighting.ambient = glm::vec3(0.3f, 0.3f, 0.45f);
+    bool lightsOn = true;
+    float torchTime = 0.0f;
+
+    // area que passou pelo fragment shader contra a dos quads inteiros (tecla M compara)
+    double shadedArea = 0.0, quadArea = 0.0;
+    long alphaItems[3] = {}; // itens desenhados por SpriteAlpha (opaco, recorte, translucido)
+    // (no mapa gerado as paredes sao morros inteiros, fica so a tocha)
+    std::vector<Light2D> columnLights;
+    for (int row = 0; row < collision.height && generateSize == 0; ++row)
+        for (int col = 0; col < collision.width; ++col)
+            if (collision.get(col + collision.originX, row + collision.originY) == TILE_SOLID)
+            {
+                glm::vec2 top = gridToScreen(glm::vec2(col + collision.originX + 0.5f, row + collision.originY + 0.5f));
+                top.y += stackHeight * stackStep + 0.3f;
+                columnLights.push_back({ top, 2.0f, glm::vec3(0.4f, 0.6f, 1.0f), 0.5f });
+            }
 
-    GLint uniModelLoc = glGetUniformLocation(shaderProgram, "model");
-    GLint uniViewLoc = glGetUniformLocation(shaderProgram, "view");
-    GLint uniProjectionLoc = glGetUniformLocation(shaderProgram, "projection");
-    GLint uniOffsetTexLoc = glGetUniformLocation(shaderProgram, "offsetTex");
-    GLint uniScaleTexLoc = glGetUniformLocation(shaderProgram, "scaleTex");
+    // o chao nao muda entre frames: fica em uma textura e so as bordas que
+    // entram na tela sao redesenhadas; C liga/desliga, T troca o tile sob o personagem
+    LayerCache floorCache;
+    if (!floorCache.init())
+        return -1;
+    bool cacheOn = true;
 
-    glUniformMatrix4fv(uniViewLoc, 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(uniProjectionLoc, 1, GL_FALSE, glm::value_ptr(projection));
+    FrameCapture capture;
+    if (!capturePath.empty() && !capture.start(capturePath, fbWidth, fbHeight))
+        return -1;
+    if (capturePath.empty())
+        capturePath = "captura.y4m";
 
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    double lastTime = glfwGetTime();
+    double startTime = lastTime;
+    int frames = 0;
+
     while (!glfwWindowShouldClose(window))
     {
         glfwPollEvents();
 
-        if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) vampirao.position.x += 0.02f;
-        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) vampirao.position.x -= 0.02f;
-        if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) vampirao.position.y += 0.02f;
-        if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) vampirao.position.y -= 0.02f;
+        double currTime = glfwGetTime();
+        // no replay o dt vem da gravacao, entao a simulacao repete os mesmos passos
+        float deltaTime = input.beginFrame((float)(currTime - lastTime));
+        lastTime = currTime;
+
+        if (input.replayFinished())
+            break;
+        if (input.pressed(ACTION_QUIT))
+            glfwSetWindowShouldClose(window, true);
+        if (input.pressed(ACTION_LIGHTS))
+            lightsOn = !lightsOn;
+        if (input.pressed(ACTION_CACHE))
+        {
+            cacheOn = !cacheOn;
+            floorCache.invalidate();
+        }
+        if (input.pressed(ACTION_CROWD))
+        {
+            crowdOn = !crowdOn;
+            crowd.clear();
+            crowdSprites.clear();
+            // em volta do personagem (num mapa grande o resto nem aparece na tela)
+            std::uniform_real_distribution<float> col(body.x - 6.0f, body.x + 6.0f), row(body.y - 6.0f, body.y + 6.0f);
+            while (crowdOn && (int)crowd.size() < CROWD_SIZE)
+            {
+                TileActor member = { col(npcRng), row(npcRng), 0.1f, 0.1f, 0.0f, 0.0f, 0 };
+                if (overlapsSolid(collision, member.x, member.y, member.halfW, member.halfH))
+                    continue;
+                crowd.push_back(member);
+                Sprite sprite = vampirao;
+                sprite.dimensions = glm::vec3(0.4f, 0.4f, 1.0f);
+                sprite.iFrame = (int)crowd.size() % sprite.nFrames;
+                crowdSprites.push_back(sprite);
+            }
+        }
+        if (input.pressed(ACTION_MESHES))
+        {
+            iso.useMeshes = floorIso.useMeshes = !iso.useMeshes;
+            std::cout << "meshes justos " << (iso.useMeshes ? "ligados" : "desligados") << std::endl;
+        }
+        if (input.pressed(ACTION_PREPASS))
+        {
+            iso.depthPrepass = floorIso.depthPrepass = !iso.depthPrepass;
+            std::cout << "prepass de profundidade " << (iso.depthPrepass ? "ligado" : "desligado") << std::endl;
+        }
+        if (input.pressed(ACTION_PAINT))
+        {
+            int col = (int)std::floor(body.x), row = (int)std::floor(body.y);
+            floorLayer->setGid(col, row, floorLayer->gid(col, row) % 7 + 1);
+        }
+        if (input.pressed(ACTION_CAPTURE))
+        {
+            if (capture.recording())
+            {
+                capture.stop();
+                capture.printStats();
+            }
+            else
+            {
+                glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+                if (capture.start(capturePath, fbWidth, fbHeight))
+                    std::cout << "gravando " << capturePath << std::endl;
+            }
+        }
+
+        // chunks gerados desde o ultimo frame
+        if (generateSize > 0)
+        {
+            readyChunks.clear();
+            generator.collect(readyChunks);
+            for (int chunk : readyChunks)
+                copyChunk(generator, chunk, *floorLayer, *wallLayer, collision, pathHierarchy);
+        }
+
+        processMovement(input, vampirao, body, collision, scene, playerFeet, deltaTime);
 
-        glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
+        if (crowdOn)
+        {
+            PathPoint goal = { (int)std::floor(body.x), (int)std::floor(body.y) };
+            crowdFlow.request(collision, goal);
+        }
 
-        glBindVertexArray(tileVAO);
-        glBindTexture(GL_TEXTURE_2D, tileTexID);
+        // caminhos prontos neste frame (dentro do orcamento) e o passeio do NPC
+        pathResults.clear();
+        paths.update(collision, pathResults);
+        for (PathResult& result : pathResults)
+        {
+            npcWalker.waiting = false;
+            npcWalker.path.swap(result.path);
+            npcWalker.next = 0;
+        }
+        updateWalker(npcWalker, 0, collision, paths, npcRng, npc, deltaTime);
+        scene.setPosition(npcFeet, gridToScreen(glm::vec2(npcWalker.body.x, npcWalker.body.y)));
 
-        for (int row = 0; row < 3; ++row)
+        if (crowdOn)
         {
-            for (int col = 0; col < 3; ++col)
+            for (size_t i = 0; i < crowd.size(); ++i)
+            {
+                int dx = 0, dy = 0;
+                glm::vec2 velocity(0.0f);
+                int col = (int)std::floor(crowd[i].x), row = (int)std::floor(crowd[i].y);
+                if (crowdFlow.directionAt(col, row, dx, dy))
+                    velocity = steerTo(crowd[i], (float)(col + dx), (float)(row + dy), NPC_SPEED);
+                crowd[i].vx = velocity.x;
+                crowd[i].vy = velocity.y;
+                animateWalk(crowdSprites[i], velocity);
+            }
+            moveActors(collision, crowd.data(), crowd.size(), deltaTime, 1);
+            for (size_t i = 0; i < crowd.size(); ++i)
             {
-                int tileIndex = map[row][col];
-                float x = (col - row) * (tileWidth / 2.0f);
-                float y = (col + row) * (tileHeight / 2.0f) + 0.25f;
+                glm::vec2 feet = gridToScreen(glm::vec2(crowd[i].x, crowd[i].y));
+                crowdSprites[i].position = glm::vec3(feet.x, feet.y + crowdSprites[i].dimensions.y / 2.0f, 0.0f);
+            }
+        }
+
+        scene.update(1);
+        vampirao.position = glm::vec3(scene.worldPosition(playerSprite), 0.0f);
+        npc.position = glm::vec3(scene.worldPosition(npcSprite), 0.0f);
+
+        // zoom com + e -
+        if (input.held(ACTION_ZOOM_IN)) camera.setZoom(camera.zoom * (1.0f + deltaTime));
+        if (input.held(ACTION_ZOOM_OUT)) camera.setZoom(camera.zoom / (1.0f + deltaTime));
+
+        camera.follow(glm::vec2(vampirao.position), deltaTime);
 
-                glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, 0.0f));
-                glUniformMatrix4fv(uniModelLoc, 1, GL_FALSE, glm::value_ptr(model));
+        glm::mat4 viewProjection = camera.projection() * camera.view();
 
-                float offsetX = tileIndex * ds;
-                glUniform2f(uniOffsetTexLoc, offsetX, 0.0f);
-                glUniform2f(uniScaleTexLoc, ds, dt);
+        // so entra na fila o que cai dentro da area visivel da camera
+        Rect2D visible = camera.viewRect();
+        iso.clear();
+
+        // faixas do chao que faltam na cache (tudo no primeiro frame, zoom ou tile trocado)
+        if (cacheOn)
+        {
+            int regions = floorCache.update(camera, floorLayer->version);
+            for (int i = 0; i < regions; ++i)
+            {
+                glm::mat4 regionViewProjection;
+                Rect2D area = floorCache.beginRegion(i, regionViewProjection);
+                floorIso.clear();
+                addFloorTiles(floorIso, *floorLayer, area, 0, ds, dt, firstTileMesh);
+                floorIso.draw(regionViewProjection);
+                shadedArea += floorIso.lastShadedArea;
+                quadArea += floorIso.lastQuadArea;
+                for (int a = 0; a < 3; ++a)
+                    alphaItems[a] += floorIso.lastAlphaCount[a];
+            }
+            floorCache.endRegions();
+        }
+        else
+        {
+            addFloorTiles(iso, *floorLayer, visible, tileTex, ds, dt, firstTileMesh);
+        }
+
+        int col0, row0, col1, row1;
+        visibleCells(visible, *floorLayer, 2, col0, row0, col1, row1);
+        for (int row = row0; row <= row1; ++row)
+        {
+            for (int col = col0; col <= col1; ++col)
+            {
+                int tileIndex = floorLayer->gid(col, row) - 1;
+                if (tileIndex < 0)
+                    continue;
+                glm::vec2 center = gridToScreen(glm::vec2(col + 0.5f, row + 0.5f));
+
+                // parede: o tile da camada de colisao empilhado por cima do chao
+                int wallIndex = wallLayer->gid(col, row) - 1;
+                int stack = collision.get(col, row) == TILE_SOLID && wallIndex >= 0 ? stackHeight : 0;
+
+                // o chao (h = 0) ja foi acima; os tiles empilhados ficam na camada dos
+                // personagens, assim uma coluna alta tampa quem estiver atras dela
+                for (int h = 1; h <= stack; ++h)
+                {
+                    float ty = center.y + h * stackStep;
+
+                    // o quad do tile vai de -1 a 1 em x e -0.5 a 0.5 em y
+                    if (!visible.intersects(center.x, ty, TILE_WIDTH / 2.0f, TILE_HEIGHT / 2.0f))
+                        continue;
+
+                    IsoItem tile = { center.x, ty, TILE_WIDTH / 2.0f, TILE_HEIGHT / 2.0f,
+                                     wallIndex * ds, 0.0f, ds, dt, tileTex,
+                                     isoKey(1, (float)(row + col), h), firstTileMesh + wallIndex };
+                    iso.add(tile);
+                }
+            }
+        }
 
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        // personagens na camada 1, ordenados pela diagonal dos pes
+        characters.clear();
+        characters.push_back(&vampirao);
+        characters.push_back(&npc);
+        for (Sprite& member : crowdSprites)
+            characters.push_back(&member);
+        for (Sprite* s : characters)
+        {
+            float halfW = s->dimensions.x / 2.0f;
+            float halfH = s->dimensions.y / 2.0f;
+            if (!visible.intersects(s->position.x, s->position.y, halfW, halfH))
+                continue;
+
+            // y da tela -> row + col (inverso do y usado nos tiles)
+            float feetY = s->position.y - halfH;
+            float rowPlusCol = (feetY - 0.25f) / (TILE_HEIGHT / 2.0f);
+
+            float u = s->iFrame * s->ds;
+            float du = s->ds;
+            if (s->flipHorizontal)
+            {
+                u += s->ds;
+                du = -du;
             }
+            IsoItem item = { s->position.x, s->position.y, halfW, halfH,
+                             u, s->iAnimation * s->dt, du, s->dt, s->texture,
+                             isoKey(1, rowPlusCol, 0), s->firstMesh + s->iAnimation * s->nFrames + s->iFrame };
+            iso.add(item);
         }
 
-        drawSprite(vampirao, shaderProgram, uniModelLoc, uniOffsetTexLoc, uniScaleTexLoc);
+        if (lightsOn)
+        {
+            // a tocha oscila um pouco; o tempo vem do frame para o replay repetir igual
+            torchTime += deltaTime;
+            float flicker = 0.9f + 0.1f * std::sin(torchTime * 13.0f) * std::sin(torchTime * 7.3f);
+            lighting.lights = columnLights;
+            lighting.lights.push_back({ glm::vec2(vampirao.position) + glm::vec2(0.25f, 0.1f), 2.5f * flicker,
+                                        glm::vec3(1.4f, 0.8f, 0.4f) * flicker, 0.4f });
+
+            lighting.beginScene(glm::vec4(0.1f, 0.1f, 0.15f, 1.0f));
+            if (cacheOn) floorCache.draw();
+            iso.draw(viewProjection);
+            lighting.endScene(viewProjection);
+        }
+        else
+        {
+            glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            if (cacheOn) floorCache.draw();
+            iso.draw(viewProjection);
+        }
+        shadedArea += iso.lastShadedArea;
+        quadArea += iso.lastQuadArea;
+        for (int a = 0; a < 3; ++a)
+            alphaItems[a] += iso.lastAlphaCount[a];
 
-        processMovement(window, vampirao);
+        // o tamanho dos frames eh fixo durante a gravacao
+        if (capture.recording())
+        {
+            glfwGetFramebufferSize(window, &fbWidth, &fbHeight);
+            if (fbWidth != capture.frameWidth() || fbHeight != capture.frameHeight())
+            {
+                capture.stop();
+                std::cout << "janela redimensionada, gravacao parada" << std::endl;
+                capture.printStats();
+            }
+        }
+        capture.capture();
 
         glfwSwapBuffers(window);
+        frames++;
+    }
+
+    // o estado final da gravacao e do replay tem que bater
+    if (headless || !recordPath.empty())
+    {
+        glFinish();
+        double elapsed = glfwGetTime() - startTime;
+        printf("%s: %d frames em %.3f s (%.3f ms/frame)\n", headless ? "replay" : "gravacao",
+               frames, elapsed, frames > 0 ? elapsed * 1000.0 / frames : 0.0);
+        printf("estado final: grade (%.5f, %.5f) camera (%.5f, %.5f) zoom %.5f\n",
+               body.x, body.y, camera.position.x, camera.position.y, camera.zoom);
+    }
+    input.close();
+
+    if (generateSize > 0)
+    {
+        generator.stop();
+        if (generator.finished())
+            printf("mapa gerado: %dx%d em %.1f ms, %ld vizinhancas fora das regras\n",
+                   generateSize, generateSize, generator.elapsedMs, generator.conflicts.load());
+    }
+
+    if (paths.requests > 0)
+        printf("caminhos: %ld pedidos, %ld prontos, %ld sem caminho, pior frame %.3f ms\n",
+               paths.requests, paths.completed, paths.failed, paths.worstMs);
+
+    if (quadArea > 0.0)
+        printf("meshes justos: %.1f%% da area dos quads chegou ao fragment shader\n", 100.0 * shadedArea / quadArea);
+    if (frames > 0)
+        printf("alfa: %.1f opacos, %.1f recortados, %.1f translucidos por frame (so os translucidos com blending)\n",
+               (double)alphaItems[0] / frames, (double)alphaItems[1] / frames, (double)alphaItems[2] / frames);
+
+    if (floorCache.frames > 0)
+        printf("cache do chao: %ld frames, %ld sem redesenhar, %ld redesenhos completos, %.1f pixels redesenhados por frame\n",
+               floorCache.frames, floorCache.framesWithoutRedraw, floorCache.fullRedraws,
+               (double)floorCache.pixelsRedrawn / floorCache.frames);
+
+    if (capture.recording())
+    {
+        capture.stop();
+        capture.printStats();
     }
 
-    glDeleteVertexArrays(1, &tileVAO);
+    iso.destroy();
+    floorIso.destroy();
+    floorCache.destroy();
+    lighting.destroy();
+    glDeleteTextures(1, &tileNormalID);
     glDeleteTextures(1, &tileTexID);
     glDeleteTextures(1, &vampTexID);
-    glDeleteProgram(shaderProgram);
 
     glfwDestroyWindow(window);
     glfwTerminate();